@@ -0,0 +1,235 @@
+#include "Impedance_Calc.h"
+
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <cmath>
+
+namespace {
+
+// 場解網格：走線寬度方向格數、銅厚方向格數、放大倍率
+struct Resolution {
+    int cellsAcrossTrace;
+    int cellsPerCopper;
+    double grading;
+};
+constexpr Resolution RESOLUTIONS[] = { { 24, 4, 1.15 }, { 48, 8, 1.1 }, { 96, 16, 1.05 } };
+
+QString ohms(double z)
+{
+    return std::isfinite(z) ? QString::number(z, 'f', 2) + " Ω" : QStringLiteral("-");
+}
+
+} // namespace
+
+Impedance_Calc::Impedance_Calc(UnitConverterHandler *sharedHandler, QWidget *parent) :
+    QWidget(parent),
+    handler(sharedHandler)
+{
+    const sc::LineGeometry defaults;
+    type_comboBox = new QComboBox(this);
+    type_comboBox->addItems({ tr("微帶線"), tr("帶狀線"), tr("差動微帶線"), tr("差動帶狀線") });
+    width_lineEdit = new QLineEdit(QString::number(defaults.width_mm), this);
+    thickness_lineEdit = new QLineEdit(QString::number(defaults.thickness_mm), this);
+    height_label = new QLabel(this);
+    height_lineEdit = new QLineEdit(QString::number(defaults.height_mm), this);
+    spacing_lineEdit = new QLineEdit(QString::number(defaults.spacing_mm), this);
+    spacing_lineEdit->setToolTip(tr("兩條線的邊到邊間距"));
+    er_lineEdit = new QLineEdit(QString::number(defaults.er), this);
+    er_lineEdit->setToolTip(tr("FR-4 約 4.2 ~ 4.6 (1 GHz)"));
+    closedForm_label = new QLabel(this);
+    closedForm_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    target_lineEdit = new QLineEdit("50", this);
+    targetWidth_label = new QLabel(this);
+
+    resolution_comboBox = new QComboBox(this);
+    resolution_comboBox->addItems({ tr("粗 (快)"), tr("標準"), tr("細") });
+    resolution_comboBox->setCurrentIndex(1);
+    field_button = new QPushButton(tr("場解"), this);
+    fieldWidth_button = new QPushButton(tr("場解反算線寬"), this);
+    field_label = new QLabel(this);
+    field_label->setWordWrap(true);
+    field_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    // 截面尺寸
+    QGroupBox *geometryBox = new QGroupBox(tr("截面 (mm)"), this);
+    QFormLayout *geometryForm = new QFormLayout(geometryBox);
+    geometryForm->addRow(tr("類型"), type_comboBox);
+    geometryForm->addRow(tr("線寬"), width_lineEdit);
+    geometryForm->addRow(tr("銅厚"), thickness_lineEdit);
+    geometryForm->addRow(height_label, height_lineEdit);
+    geometryForm->addRow(tr("差動間距"), spacing_lineEdit);
+    geometryForm->addRow(tr("介電常數 εr"), er_lineEdit);
+
+    // 封閉公式 (即時) 與反算
+    QGroupBox *closedBox = new QGroupBox(tr("封閉公式 (Hammerstad / Wheeler)"), this);
+    QFormLayout *closedForm = new QFormLayout(closedBox);
+    closedForm->addRow(closedForm_label);
+    closedForm->addRow(tr("目標阻抗 (Ω)"), target_lineEdit);
+    closedForm->addRow(tr("所需線寬"), targetWidth_label);
+
+    // 場解
+    QGroupBox *fieldBox = new QGroupBox(tr("場解 (2D Laplace)"), this);
+    QVBoxLayout *fieldLayout = new QVBoxLayout(fieldBox);
+    QHBoxLayout *fieldButtons = new QHBoxLayout;
+    fieldButtons->addWidget(new QLabel(tr("網格"), fieldBox));
+    fieldButtons->addWidget(resolution_comboBox);
+    fieldButtons->addWidget(field_button);
+    fieldButtons->addWidget(fieldWidth_button);
+    fieldButtons->addStretch(1);
+    fieldLayout->addLayout(fieldButtons);
+    fieldLayout->addWidget(field_label);
+
+    QHBoxLayout *top = new QHBoxLayout;
+    top->addWidget(geometryBox);
+    top->addWidget(closedBox, 1);
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(top);
+    layout->addWidget(fieldBox);
+    layout->addStretch(1);
+
+    for (QLineEdit *e : { width_lineEdit, thickness_lineEdit, height_lineEdit, spacing_lineEdit, er_lineEdit,
+                          target_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &Impedance_Calc::updateClosedForm);
+    connect(type_comboBox, &QComboBox::currentIndexChanged, this, [this]() {
+        // 差動對的目標是差動阻抗，預設值跟著換
+        const bool diff = sc::isDifferential(static_cast<sc::LineType>(type_comboBox->currentIndex()));
+        const QString target = target_lineEdit->text().trimmed();
+        if (diff && target == "50") target_lineEdit->setText("100");
+        else if (!diff && target == "100") target_lineEdit->setText("50");
+        updateClosedForm();
+    });
+    connect(field_button, &QPushButton::clicked, this, &Impedance_Calc::solveField);
+    connect(fieldWidth_button, &QPushButton::clicked, this, &Impedance_Calc::solveFieldWidth);
+
+    updateClosedForm();
+}
+
+Impedance_Calc::~Impedance_Calc()
+{
+    if (fieldThread) fieldThread->wait();
+}
+
+bool Impedance_Calc::readGeometry(sc::LineGeometry &g) const
+{
+    bool okW, okT, okH, okS, okE;
+    g.type = static_cast<sc::LineType>(type_comboBox->currentIndex());
+    g.width_mm = handler->parseValue(width_lineEdit->text(), &okW);
+    g.thickness_mm = handler->parseValue(thickness_lineEdit->text(), &okT);
+    g.height_mm = handler->parseValue(height_lineEdit->text(), &okH);
+    g.spacing_mm = handler->parseValue(spacing_lineEdit->text(), &okS);
+    g.er = handler->parseValue(er_lineEdit->text(), &okE);
+    return okW && okT && okH && okE && (okS || !sc::isDifferential(g.type));
+}
+
+sc::FieldSolverOptions Impedance_Calc::fieldOptions() const
+{
+    const Resolution res = RESOLUTIONS[resolution_comboBox->currentIndex()];
+    sc::FieldSolverOptions opt;
+    opt.cellsAcrossTrace = res.cellsAcrossTrace;
+    opt.cellsPerCopper = res.cellsPerCopper;
+    opt.grading = res.grading;
+    return opt;
+}
+
+void Impedance_Calc::updateClosedForm()
+{
+    const sc::LineType type = static_cast<sc::LineType>(type_comboBox->currentIndex());
+    height_label->setText(sc::isStripline(type) ? tr("平面間距 b") : tr("介質厚度 h"));
+    height_lineEdit->setToolTip(sc::isStripline(type) ? tr("上下參考平面的間距，走線在正中央")
+                                                      : tr("走線底面到參考平面的介質厚度"));
+    spacing_lineEdit->setEnabled(sc::isDifferential(type));
+
+    sc::LineGeometry g;
+    const sc::ImpedanceResult r = readGeometry(g) ? sc::impedanceClosedForm(g) : sc::ImpedanceResult();
+    if (!r.converged) {
+        closedForm_label->setText(tr("請輸入正的尺寸 (帶狀線銅厚需小於平面間距)，εr >= 1"));
+        targetWidth_label->clear();
+        return;
+    }
+    QString text = tr("Z0 = %1\nεeff = %2").arg(ohms(r.z0_ohm)).arg(r.eEff, 0, 'f', 3);
+    if (sc::isDifferential(type)) text += tr("\nZdiff = %1 (IPC-2141 耦合修正)").arg(ohms(r.zDiff_ohm));
+    closedForm_label->setText(text);
+
+    bool ok;
+    const double target = handler->parseValue(target_lineEdit->text(), &ok);
+    const double w = ok ? sc::impedanceWidthClosedForm(g, target) : NAN;
+    targetWidth_label->setText(std::isfinite(w) ? tr("%1 mm").arg(w, 0, 'f', 4) : tr("超出範圍"));
+}
+
+void Impedance_Calc::solveField()
+{
+    runField(false);
+}
+
+void Impedance_Calc::solveFieldWidth()
+{
+    runField(true);
+}
+
+void Impedance_Calc::runField(bool inverse)
+{
+    if (fieldThread) return;
+
+    sc::LineGeometry g;
+    bool okT = true;
+    const double target = inverse ? handler->parseValue(target_lineEdit->text(), &okT) : 0;
+    if (!readGeometry(g) || !okT || !sc::impedanceClosedForm(g).converged || !(g.thickness_mm > 0) ||
+        (inverse && !(target > 0))) {
+        field_label->setText(tr("請輸入有效的尺寸 (場解需要銅厚 > 0) 與目標阻抗"));
+        return;
+    }
+    const sc::FieldSolverOptions opt = fieldOptions();
+
+    field_button->setEnabled(false);
+    fieldWidth_button->setEnabled(false);
+    field_label->setText(tr("計算中..."));
+
+    fieldThread = QThread::create([this, g, opt, inverse, target]() {
+        QElapsedTimer timer;
+        timer.start();
+        sc::ImpedanceWidthResult w;
+        if (inverse) {
+            w = sc::impedanceWidthFieldSolve(g, target, opt);
+        } else {
+            w.impedance = sc::impedanceFieldSolve(g, opt);
+            w.width_mm = g.width_mm;
+            w.fieldSolves = 1;
+            w.converged = w.impedance.converged;
+        }
+        const double elapsed = timer.nsecsElapsed() / 1e6;
+        QMetaObject::invokeMethod(this, [this, g, w, inverse, elapsed]() {
+            const sc::ImpedanceResult &r = w.impedance;
+            QString text;
+            if (inverse) {
+                text = std::isfinite(w.width_mm) ? tr("線寬 %1 mm (%2 次場解)\n").arg(w.width_mm, 0, 'f', 4).arg(w.fieldSolves)
+                                                 : tr("目標阻抗超出範圍\n");
+            }
+            if (sc::isDifferential(g.type)) {
+                text += tr("Zdiff = %1，Zcommon = %2，奇模 εeff = %3")
+                            .arg(ohms(r.zDiff_ohm)).arg(ohms(r.zCommon_ohm)).arg(r.eEff, 0, 'f', 3);
+            } else {
+                text += tr("Z0 = %1，εeff = %2").arg(ohms(r.z0_ohm)).arg(r.eEff, 0, 'f', 3);
+            }
+            text += tr("\n%1 格 (半截面)，%2 次迭代，%3 ms").arg(r.cells).arg(r.iterations).arg(elapsed, 0, 'f', 1);
+            if (!w.converged) text += tr("\n未收斂，結果僅供參考");
+            field_label->setText(text);
+        }, Qt::QueuedConnection);
+    });
+    connect(fieldThread, &QThread::finished, this, [this]() {
+        fieldThread->deleteLater();
+        fieldThread = nullptr;
+        field_button->setEnabled(true);
+        fieldWidth_button->setEnabled(true);
+    });
+    fieldThread->start();
+}
@@ -0,0 +1,58 @@
+#ifndef IMPEDANCE_CALC_H
+#define IMPEDANCE_CALC_H
+
+#include "UnitConverterHandler.h"
+#include "Impedance.h"
+
+#include <QWidget>
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QThread;
+
+// 控制阻抗：輸入時以封閉公式即時更新，場解 (2D Laplace) 按鈕給準確值
+class Impedance_Calc : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Impedance_Calc(UnitConverterHandler *sharedHandler, QWidget *parent = nullptr);
+    ~Impedance_Calc();
+
+private:
+    UnitConverterHandler *handler;
+
+    QComboBox *type_comboBox = nullptr;
+    QLineEdit *width_lineEdit = nullptr;
+    QLineEdit *thickness_lineEdit = nullptr;
+    QLabel *height_label = nullptr;
+    QLineEdit *height_lineEdit = nullptr;
+    QLineEdit *spacing_lineEdit = nullptr;
+    QLineEdit *er_lineEdit = nullptr;
+    QLabel *closedForm_label = nullptr;
+
+    QLineEdit *target_lineEdit = nullptr;
+    QLabel *targetWidth_label = nullptr;
+
+    QComboBox *resolution_comboBox = nullptr;
+    QPushButton *field_button = nullptr;
+    QPushButton *fieldWidth_button = nullptr;
+    QLabel *field_label = nullptr;
+
+    // 場解在工作執行緒上跑 (細網格的差動對反算要數百毫秒)
+    QThread *fieldThread = nullptr;
+
+    // 輸入框無效時回傳 false
+    bool readGeometry(sc::LineGeometry &geometry) const;
+    sc::FieldSolverOptions fieldOptions() const;
+    void runField(bool inverse);
+
+private slots:
+    void updateClosedForm();
+    void solveField();
+    void solveFieldWidth();
+};
+
+#endif // IMPEDANCE_CALC_H
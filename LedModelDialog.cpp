@@ -0,0 +1,296 @@
+#include "LedModelDialog.h"
+#include "ScConstants.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPushButton>
+#include <QRegularExpression>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// 掃描點數上限 (一次批次呼叫)
+constexpr int MAX_SWEEP_POINTS = 1000000;
+
+} // namespace
+
+// --- CurvePlotWidget ---
+
+CurvePlotWidget::CurvePlotWidget(QWidget *parent) : QWidget(parent)
+{
+    setMinimumHeight(220);
+}
+
+void CurvePlotWidget::setData(const QString &name, std::vector<double> xs, QList<Curve> cs)
+{
+    xName = name;
+    x = std::move(xs);
+    curves = std::move(cs);
+    update();
+}
+
+void CurvePlotWidget::clear()
+{
+    x.clear();
+    curves.clear();
+    update();
+}
+
+void CurvePlotWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), palette().base());
+    if (x.size() < 2 || curves.isEmpty()) return;
+
+    const int margin = 6;
+    const int textH = fontMetrics().height();
+    const QRect plotRect(margin, margin + textH, width() - 2 * margin, height() - 2 * margin - 2 * textH);
+    if (plotRect.width() <= 0 || plotRect.height() <= 0) return;
+
+    // 所有曲線共用縱軸範圍
+    double yMin = std::numeric_limits<double>::infinity(), yMax = -yMin;
+    for (const Curve &c : curves) {
+        for (double v : c.y) {
+            if (!std::isfinite(v)) continue;
+            yMin = std::min(yMin, v);
+            yMax = std::max(yMax, v);
+        }
+    }
+    if (!(yMax >= yMin)) return;
+    if (yMax == yMin) yMax = yMin + 1;
+
+    const double x0 = x.front(), x1 = x.back();
+    if (!(x1 > x0)) return;
+    auto px = [&](double v) { return plotRect.left() + (v - x0) / (x1 - x0) * plotRect.width(); };
+    auto py = [&](double v) { return plotRect.bottom() - (v - yMin) / (yMax - yMin) * plotRect.height(); };
+
+    p.setPen(palette().mid().color());
+    p.drawRect(plotRect);
+
+    // 每個像素欄畫一條最小 ~ 最大的垂直線段，再連到下一欄
+    int legendX = plotRect.left();
+    for (const Curve &c : curves) {
+        p.setPen(QPen(c.color, 1.5));
+        QPainterPath path;
+        const std::size_t n = std::min(x.size(), c.y.size());
+        int column = -1;
+        double lo = 0, hi = 0;
+        auto flush = [&]() {
+            if (column < 0) return;
+            if (path.elementCount() == 0) path.moveTo(column, py(lo));
+            path.lineTo(column, py(lo));
+            if (hi != lo) path.lineTo(column, py(hi));
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(c.y[i])) continue;
+            const int col = static_cast<int>(px(x[i]));
+            if (col != column) {
+                flush();
+                column = col;
+                lo = hi = c.y[i];
+            } else {
+                lo = std::min(lo, c.y[i]);
+                hi = std::max(hi, c.y[i]);
+            }
+        }
+        flush();
+        p.drawPath(path);
+
+        p.drawText(legendX, margin + textH - 2, c.name);
+        legendX += fontMetrics().horizontalAdvance(c.name) + 16;
+    }
+
+    // 軸範圍
+    p.setPen(palette().text().color());
+    const QRect bottomText(plotRect.left(), plotRect.bottom() + 2, plotRect.width(), textH);
+    p.drawText(bottomText, Qt::AlignLeft, QString::number(x0, 'g', 4));
+    p.drawText(bottomText, Qt::AlignHCenter, xName);
+    p.drawText(bottomText, Qt::AlignRight, QString::number(x1, 'g', 4));
+    p.drawText(plotRect.adjusted(4, 2, 0, 0), Qt::AlignLeft | Qt::AlignTop, QString::number(yMax, 'g', 4));
+    p.drawText(plotRect.adjusted(4, 0, 0, -2), Qt::AlignLeft | Qt::AlignBottom, QString::number(yMin, 'g', 4));
+}
+
+// --- LedModelDialog ---
+
+LedModelDialog::LedModelDialog(UnitConverterHandler *sharedHandler, QWidget *parent) :
+    QDialog(parent),
+    handler(sharedHandler)
+{
+    setWindowTitle(tr("LED 模型 (Shockley)"));
+    resize(560, 620);
+
+    const sc::LedModel defaults;
+    enable_checkBox = new QCheckBox(tr("計算頁以模型計算 Vd (取代固定壓降)"), this);
+    is_lineEdit = new QLineEdit(QString::number(defaults.Is_A, 'g', 6), this);
+    n_lineEdit = new QLineEdit(QString::number(defaults.n, 'g', 6), this);
+    rs_lineEdit = new QLineEdit(QString::number(defaults.Rs_ohm, 'g', 6), this);
+    temp_lineEdit = new QLineEdit(QString::number(defaults.temperature_C, 'g', 6), this);
+    points_lineEdit = new QLineEdit("1m:1.80, 5m:1.88, 20m:1.99, 50m:2.10", this);
+    points_lineEdit->setToolTip(tr("規格書 I-V 曲線上的點，格式為 電流:電壓，以逗號分隔 (至少 3 點)"));
+    QPushButton *fit_button = new QPushButton(tr("擬合"), this);
+    fit_label = new QLabel(this);
+
+    vccMin_lineEdit = new QLineEdit("0", this);
+    vccMax_lineEdit = new QLineEdit("5", this);
+    sweepCount_lineEdit = new QLineEdit("100k", this);
+    curve_comboBox = new QComboBox(this);
+    curve_comboBox->addItems({tr("每串電流 (mA)"), tr("單顆 Vf (V)"), tr("功耗 (W)")});
+    sweep_label = new QLabel(this);
+    plot = new CurvePlotWidget(this);
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(enable_checkBox);
+    form->addRow(tr("飽和電流 Is (A)"), is_lineEdit);
+    form->addRow(tr("理想因子 n"), n_lineEdit);
+    form->addRow(tr("串聯電阻 Rs (Ω)"), rs_lineEdit);
+    form->addRow(tr("接面溫度 (°C)"), temp_lineEdit);
+    QHBoxLayout *fitRow = new QHBoxLayout;
+    fitRow->addWidget(points_lineEdit, 1);
+    fitRow->addWidget(fit_button);
+    form->addRow(tr("I-V 點"), fitRow);
+    form->addRow(fit_label);
+    QHBoxLayout *range = new QHBoxLayout;
+    range->addWidget(vccMin_lineEdit);
+    range->addWidget(new QLabel("~", this));
+    range->addWidget(vccMax_lineEdit);
+    form->addRow(tr("Vcc 掃描範圍 (V)"), range);
+    form->addRow(tr("掃描點數"), sweepCount_lineEdit);
+    form->addRow(tr("曲線"), curve_comboBox);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addWidget(plot, 1);
+    layout->addWidget(sweep_label);
+
+    connect(fit_button, &QPushButton::clicked, this, &LedModelDialog::fitFromPoints);
+    connect(enable_checkBox, &QCheckBox::toggled, this, &LedModelDialog::modelChanged);
+    for (QLineEdit *e : { is_lineEdit, n_lineEdit, rs_lineEdit, temp_lineEdit }) {
+        connect(e, &QLineEdit::textChanged, this, &LedModelDialog::modelChanged);
+        connect(e, &QLineEdit::textChanged, this, &LedModelDialog::updateSweep);
+    }
+    for (QLineEdit *e : { vccMin_lineEdit, vccMax_lineEdit, sweepCount_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &LedModelDialog::updateSweep);
+    connect(curve_comboBox, &QComboBox::currentIndexChanged, this, &LedModelDialog::updateSweep);
+}
+
+bool LedModelDialog::modelEnabled() const
+{
+    return enable_checkBox->isChecked();
+}
+
+sc::LedModel LedModelDialog::model() const
+{
+    // 欄位無效時保留預設值，計算頁不會因為打到一半的數字跳出奇怪的結果
+    sc::LedModel m;
+    bool ok;
+    double v = handler->parseValue(is_lineEdit->text(), &ok);
+    if (ok && v > 0) m.Is_A = v;
+    v = handler->parseValue(n_lineEdit->text(), &ok);
+    if (ok && v > 0) m.n = v;
+    v = handler->parseValue(rs_lineEdit->text(), &ok);
+    if (ok && v >= 0) m.Rs_ohm = v;
+    v = handler->parseValue(temp_lineEdit->text(), &ok);
+    if (ok && v > -sc::KELVIN_OFFSET) m.temperature_C = v;
+    return m;
+}
+
+void LedModelDialog::setCircuit(double r, int s, int p)
+{
+    R_ohm = r;
+    series = std::max(s, 1);
+    parallel = std::max(p, 1);
+    updateSweep();
+}
+
+void LedModelDialog::fitFromPoints()
+{
+    std::vector<double> currents, voltages;
+    const QStringList pairs = points_lineEdit->text().split(QRegularExpression("[,;]"), Qt::SkipEmptyParts);
+    for (const QString &pair : pairs) {
+        const QStringList iv = pair.split(':');
+        bool okI = false, okV = false;
+        if (iv.size() == 2) {
+            const double i = handler->parseValue(iv[0].trimmed(), &okI);
+            const double v = handler->parseValue(iv[1].trimmed(), &okV);
+            if (okI && okV) {
+                currents.push_back(i);
+                voltages.push_back(v);
+                continue;
+            }
+        }
+        fit_label->setText(tr("無法解析「%1」").arg(pair.trimmed()));
+        return;
+    }
+
+    sc::LedModel m = model();
+    if (!sc::ledModelFit(currents.data(), voltages.data(), currents.size(), m)) {
+        fit_label->setText(tr("擬合失敗：需要至少 3 個電流不同的點"));
+        return;
+    }
+
+    // 擬合誤差 (各點的 Vf 差)
+    double worst = 0;
+    for (std::size_t i = 0; i < currents.size(); ++i)
+        worst = std::max(worst, std::fabs(sc::ledForwardVoltage(m, currents[i]) - voltages[i]));
+
+    is_lineEdit->setText(QString::number(m.Is_A, 'g', 6));
+    n_lineEdit->setText(QString::number(m.n, 'g', 6));
+    rs_lineEdit->setText(QString::number(m.Rs_ohm, 'g', 6));
+    fit_label->setText(tr("最大誤差 %1 mV").arg(worst * 1e3, 0, 'g', 3));
+}
+
+void LedModelDialog::updateSweep()
+{
+    if (!isVisible()) return;
+
+    bool okMin, okMax, okN;
+    const double vMin = handler->parseValue(vccMin_lineEdit->text(), &okMin);
+    const double vMax = handler->parseValue(vccMax_lineEdit->text(), &okMax);
+    const double count = handler->parseValue(sweepCount_lineEdit->text(), &okN);
+    if (!okMin || !okMax || !okN || !(vMax > vMin) || count < 2 || !(R_ohm >= 0)) {
+        plot->clear();
+        sweep_label->clear();
+        return;
+    }
+
+    const std::size_t n = static_cast<std::size_t>(std::min<double>(count, MAX_SWEEP_POINTS));
+    std::vector<double> vcc(n), current(n), vf(n), ledPower(n), resistorPower(n);
+    for (std::size_t i = 0; i < n; ++i) vcc[i] = vMin + (vMax - vMin) * static_cast<double>(i) / (n - 1);
+
+    // 整段掃描一次批次呼叫 (R 固定)
+    QElapsedTimer timer;
+    timer.start();
+    sc::LedSweepIn in{ vcc.data(), nullptr, 0, R_ohm };
+    sc::LedSweepOut out{ current.data(), vf.data(), ledPower.data(), resistorPower.data() };
+    sc::ledOperatingPointBatch(model(), series, parallel, in, out, n);
+    const double elapsed = timer.nsecsElapsed() / 1e6;
+
+    QList<CurvePlotWidget::Curve> curves;
+    switch (curve_comboBox->currentIndex()) {
+    case 0:
+        for (double &i : current) i *= 1e3;
+        curves.append({ tr("每串電流 (mA)"), QColor(Qt::blue), std::move(current) });
+        break;
+    case 1:
+        curves.append({ tr("單顆 Vf (V)"), QColor(Qt::darkGreen), std::move(vf) });
+        break;
+    default:
+        curves.append({ tr("LED 總功耗 (W)"), QColor(Qt::darkYellow), std::move(ledPower) });
+        curves.append({ tr("電阻總功耗 (W)"), QColor(Qt::red), std::move(resistorPower) });
+        break;
+    }
+    plot->setData("Vcc (V)", std::move(vcc), std::move(curves));
+    sweep_label->setText(tr("每串 R = %1 Ω、%2 串 x %3 並，%4 點，%5 ms")
+                             .arg(R_ohm, 0, 'g', 5).arg(series).arg(parallel).arg(n).arg(elapsed, 0, 'f', 2));
+}
@@ -0,0 +1,86 @@
+#ifndef LEDMODELDIALOG_H
+#define LEDMODELDIALOG_H
+
+#include <QColor>
+#include <QDialog>
+#include <QList>
+#include <QString>
+#include <QWidget>
+#include "UnitConverterHandler.h"
+#include "LedModel.h"
+
+#include <vector>
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+
+// 折線圖：點數比寬度多時每個像素欄只畫最小 ~ 最大值 (10 萬點也不會拖慢重繪)
+class CurvePlotWidget : public QWidget
+{
+public:
+    struct Curve {
+        QString name;
+        QColor color;
+        std::vector<double> y;
+    };
+
+    explicit CurvePlotWidget(QWidget *parent = nullptr);
+
+    void setData(const QString &xName, std::vector<double> x, QList<Curve> curves);
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    QString xName;
+    std::vector<double> x;
+    QList<Curve> curves;
+};
+
+// LED Shockley 模型：參數 / 規格書 I-V 擬合 / 對 Vcc 掃描的電流、Vf、功耗曲線
+class LedModelDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    LedModelDialog(UnitConverterHandler *sharedHandler, QWidget *parent = nullptr);
+
+    // 計算頁是否以模型取代固定 Vd
+    bool modelEnabled() const;
+    sc::LedModel model() const;
+
+    // 計算頁目前的電路 (掃描時固定 R、串並數，只改變 Vcc)
+    void setCircuit(double R_ohm, int series, int parallel);
+
+signals:
+    void modelChanged();
+
+private:
+    UnitConverterHandler *handler;
+    double R_ohm = 0;
+    int series = 1;
+    int parallel = 1;
+
+    QCheckBox *enable_checkBox = nullptr;
+    QLineEdit *is_lineEdit = nullptr;
+    QLineEdit *n_lineEdit = nullptr;
+    QLineEdit *rs_lineEdit = nullptr;
+    QLineEdit *temp_lineEdit = nullptr;
+    QLineEdit *points_lineEdit = nullptr;
+    QLabel *fit_label = nullptr;
+    QLineEdit *vccMin_lineEdit = nullptr;
+    QLineEdit *vccMax_lineEdit = nullptr;
+    QLineEdit *sweepCount_lineEdit = nullptr;
+    QComboBox *curve_comboBox = nullptr;
+    QLabel *sweep_label = nullptr;
+    CurvePlotWidget *plot = nullptr;
+
+private slots:
+    void fitFromPoints();
+    void updateSweep();
+};
+
+#endif // LEDMODELDIALOG_H
@@ -1,9 +1,52 @@
 #include "Line_Width.h"
 #include "ui_Line_Width.h"
-
+#include "MonteCarloDialog.h"
+#include "PlaneDropDialog.h"
+#include "PulseDialog.h"
+#include "TraceThermalDialog.h"
+
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+#include "ScConstants.h"
+#include "SelfHeating.h"
+#include "TraceCalc.h"
+#include "TraceNetlist.h"
+#include "Units.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QThread>
+
+#include <algorithm>
 #include <cmath>
 
-const double OZ_TO_MM = 0.0342867;
+namespace {
+namespace u = sc::units;
+// 各下拉選單的單位表，index 與選單順序一致
+using ThicknessUnits = u::UnitList<u::mm, u::mil, u::um>;
+using TraceCurrentUnits = u::UnitList<u::A, u::mA>;
+using TraceLengthUnits = u::UnitList<u::mm, u::mil, u::cm>;
+using WidthUnits = u::UnitList<u::mm, u::mil>;
+using ImpedanceUnits = u::UnitList<u::mOhm, u::Ohm>;
+using DropUnits = u::UnitList<u::mV, u::V>;
+using LossUnits = u::UnitList<u::mW, u::W>;
+
+// 公差分析的輸入名稱與預設公差 (最差情況範圍共用)
+const char *const TOL_CURRENT = "電流 (A)";
+const char *const TOL_WIDTH = "外層線寬 (mm)";
+const char *const TOL_THICKNESS = "銅厚 (mm)";
+constexpr double DEFAULT_CURRENT_TOL = 0.1;
+constexpr double DEFAULT_WIDTH_TOL = 0.1;       // 蝕刻
+constexpr double DEFAULT_THICKNESS_TOL = 0.15;  // 電鍍
+}
 
 
 Line_Width::Line_Width(UnitConverterHandler *sharedHandler, QWidget *parent) :
@@ -16,39 +59,39 @@ Line_Width::Line_Width(UnitConverterHandler *sharedHandler, QWidget *parent) :
     // --- 1. 初始化 ComboBox 選項 ---
     // 銅厚單位 (mm/mil/um)
     if(ui->thickness_comboBox->count() == 0) {
-        ui->thickness_comboBox->addItems({"mm", "mil", "um"});
+        ui->thickness_comboBox->addItems(unitSymbols<ThicknessUnits>());
     }
 
     // 電流單位 (A/mA)
     if(ui->Current_comboBox->count() == 0) {
-        ui->Current_comboBox->addItems({"A", "mA"});
+        ui->Current_comboBox->addItems(unitSymbols<TraceCurrentUnits>());
     }
 
     // 長度單位 (mm/mil/cm)
     if(ui->Length_comboBox->count() == 0) {
-        ui->Length_comboBox->addItems({"mm", "mil", "cm"});
+        ui->Length_comboBox->addItems(unitSymbols<TraceLengthUnits>());
     }
 
     // 寬度輸出單位 (mm/mil)
-    QStringList distUnits = {"mm", "mil"};
+    QStringList distUnits = unitSymbols<WidthUnits>();
     ui->External_comboBox->addItems(distUnits);
     ui->Internal_comboBox->addItems(distUnits);
 
     // 總結區單位
-    ui->Impedance_comboBox->addItems({"mΩ", "Ω"});
-    ui->VoltageDrop_comboBox->addItems({"mV", "V"});
-    ui->Consumption_comboBox->addItems({"mW", "W"});
+    ui->Impedance_comboBox->addItems(unitSymbols<ImpedanceUnits>());
+    ui->VoltageDrop_comboBox->addItems(unitSymbols<DropUnits>());
+    ui->Consumption_comboBox->addItems(unitSymbols<LossUnits>());
 
     // --- 2. 設定初始預設值 ---
     ui->Mass_lineEdit->setText("1");     // 預設 1 oz
     ui->temp_lineEdit->setText("10");    // 預設溫升 10 度
     ui->Length_lineEdit->setText("1");  // 預設長度 10mm
     ui->Current_lineEdit->setText("1");  // 預設 1A
-    ui->thickness_lineEdit->setText(QString::number(OZ_TO_MM));
+    ui->thickness_lineEdit->setText(QString::number(sc::COPPER_MM_PER_OZ));
 
     connect(ui->Mass_lineEdit, &QLineEdit::textChanged, this, [this](const QString &text){
         bool ok;
-        double oz = text.toDouble(&ok);
+        double oz = handler->parseValue(text, &ok);
         if (ok) {
             // 使用者輸入 oz，我們只幫他換算成 mm 填進去
             ui->thickness_lineEdit->setText(QString::number(oz * 0.034287, 'g', 5));
@@ -75,137 +118,397 @@ Line_Width::Line_Width(UnitConverterHandler *sharedHandler, QWidget *parent) :
     for(auto box : boxes)
         connect(box, &QComboBox::currentIndexChanged, this, &Line_Width::updateCalculation);
 
+    // 公差分析：以目前的外層線寬看實際溫升的分布
+    QPushButton *toleranceButton = new QPushButton(tr("公差分析..."), this);
+    toleranceButton->setGeometry(260, 280, 211, 31);
+    toleranceDialog = new MonteCarloDialog(handler, tr("走線溫升公差分析"), this);
+    connect(toleranceButton, &QPushButton::clicked, this, &Line_Width::openToleranceAnalysis);
+
+    worstCase_label = new QLabel(this);
+    worstCase_label->setGeometry(10, 612, 355, 22);
+    worstCase_label->setToolTip(tr("外層線寬與銅厚公差下的載流能力 (依選擇的模型)"));
+    connect(toleranceDialog, &MonteCarloDialog::tolerancesChanged, this, &Line_Width::updateWorstCase);
+
+    // 載流模型選擇 (公差分析按鈕右邊一列)
+    QWidget *modelRow = new QWidget(this);
+    modelRow->setGeometry(480, 280, 470, 31);
+    QHBoxLayout *modelLayout = new QHBoxLayout(modelRow);
+    modelLayout->setContentsMargins(0, 0, 0, 0);
+    model_comboBox = new QComboBox(modelRow);
+    model_comboBox->addItems({ tr("IPC-2221"), tr("IPC-2152") });
+    model_comboBox->setToolTip(tr("IPC-2152 不分內外層 (以內層圖表計算，用在外層偏保守)"));
+    board_lineEdit = new QLineEdit(QStringLiteral("1.6"), modelRow);
+    plane_lineEdit = new QLineEdit(modelRow);
+    plane_lineEdit->setPlaceholderText(tr("無銅平面"));
+    plane_lineEdit->setToolTip(tr("走線與相鄰銅平面的距離，空白表示沒有銅平面"));
+    modelLayout->addWidget(model_comboBox);
+    modelLayout->addWidget(new QLabel(tr("板厚 (mm)"), modelRow));
+    modelLayout->addWidget(board_lineEdit);
+    modelLayout->addWidget(new QLabel(tr("銅平面距離 (mm)"), modelRow));
+    modelLayout->addWidget(plane_lineEdit);
+
+    auto modelToggled = [this]() {
+        board_lineEdit->setEnabled(useIpc2152());
+        plane_lineEdit->setEnabled(useIpc2152());
+        updateCalculation();
+    };
+    connect(model_comboBox, &QComboBox::currentIndexChanged, this, modelToggled);
+    connect(board_lineEdit, &QLineEdit::textChanged, this, &Line_Width::updateCalculation);
+    connect(plane_lineEdit, &QLineEdit::textChanged, this, &Line_Width::updateCalculation);
+    board_lineEdit->setEnabled(false);
+    plane_lineEdit->setEnabled(false);
+
+    // 自洽溫升：電阻 / 壓降 / 功耗改用 I²R 與溫升的固定點，而不是假設的允許溫升
+    selfHeating_checkBox = new QCheckBox(tr("自洽溫升"), this);
+    selfHeating_checkBox->setGeometry(240, 320, 115, 24);
+    selfHeating_checkBox->setToolTip(tr("以目前的電流與外層線寬求 ΔT = θ I² R(20°C + ΔT) 的固定點 (含熱失控判斷)，"
+                                        "θ 取載流模型在 10°C 溫升的工作點，與脈衝頁的穩態相同；"
+                                        "電阻、壓降與功耗改用實際溫度"));
+    selfHeating_label = new QLabel(this);
+    selfHeating_label->setGeometry(240, 346, 115, 30);
+    selfHeating_label->setWordWrap(true);
+    connect(selfHeating_checkBox, &QCheckBox::toggled, this, [this](bool on) {
+        if (!on) {
+            selfHeating_label->clear();
+            selfHeating_label->setStyleSheet("");
+        }
+        updateCalculation();
+    });
+
+    // 網路清單批次：整片板子的電源網路一次算完，使用本頁的模型、溫升與銅重作為預設值
+    netlist_button = new QPushButton(tr("網路清單批次..."), this);
+    netlist_button->setGeometry(812, 600, 141, 31);
+    netlist_button->setToolTip(tr("讀入 CSV / JSON 網路清單 (net, current, layer, oz, length, dt)，"
+                                  "輸出每個網路的線寬、電阻、壓降與功耗"));
+    connect(netlist_button, &QPushButton::clicked, this, &Line_Width::importNetlist);
+
+    // 截面熱分析：IPC 公式以外的檢查 (銅平面、板厚、散熱條件)
+    QPushButton *thermalButton = new QPushButton(tr("截面熱分析..."), this);
+    thermalButton->setGeometry(520, 600, 141, 31);
+    thermalButton->setToolTip(tr("以 2D 熱傳導解走線截面的溫度分布"));
+    thermalDialog = new TraceThermalDialog(handler, this);
+    connect(thermalButton, &QPushButton::clicked, this, &Line_Width::openThermalAnalysis);
+
+    // 鋪銅壓降：走線頁只處理均勻的長方形導體，大電流電源的鋪銅另外解
+    QPushButton *planeButton = new QPushButton(tr("鋪銅壓降..."), this);
+    planeButton->setGeometry(666, 600, 141, 31);
+    planeButton->setToolTip(tr("讀入鋪銅外框、焊墊與過孔，解出壓降與電流密度分布"));
+    planeDialog = new PlaneDropDialog(handler, this);
+    connect(planeButton, &QPushButton::clicked, this, [this]() {
+        planeDialog->show();
+        planeDialog->raise();
+    });
+
+    // 脈衝 / 熔斷：IPC 只給穩態，湧浪與故障電流另外積分
+    QPushButton *pulseButton = new QPushButton(tr("脈衝 / 熔斷..."), this);
+    pulseButton->setGeometry(374, 600, 141, 31);
+    pulseButton->setToolTip(tr("湧浪、短路電流波形下的溫度曲線與熔斷時間"));
+    pulseDialog = new PulseDialog(handler, this);
+    connect(pulseButton, &QPushButton::clicked, this, &Line_Width::openPulse);
 }
 
 Line_Width::~Line_Width()
 {
+    if (netlistThread) netlistThread->wait();
     delete ui;
 }
 
+bool Line_Width::useIpc2152() const {
+    return model_comboBox && model_comboBox->currentIndex() == 1;
+}
+
+sc::Ipc2152Options Line_Width::ipc2152Options() const {
+    sc::Ipc2152Options opt;
+    bool ok;
+    const double board = handler->parseValue(board_lineEdit->text(), &ok);
+    if (ok && board > 0) opt.boardThickness_mm = board;
+    const double plane = handler->parseValue(plane_lineEdit->text(), &ok);
+    opt.planeDistance_mm = (ok && plane > 0) ? plane : 0;
+    return opt;
+}
+
 void Line_Width::updateCalculation() {
     if (isCalculating) return;
     isCalculating = true;
 
     bool okI, okT, okL, okDelta;
 
-    double current = ui->Current_lineEdit->text().toDouble(&okI);
-    if (ui->Current_comboBox->currentIndex() == 1) current /= 1000.0; // mA -> A
+    const int currentIdx = ui->Current_comboBox->currentIndex();
+    double current = TraceCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text(), &okI), currentIdx).in<u::A>();
 
     //double deltaT = ui->temp_lineEdit->text().toDouble(&okDelta);
-    double deltaT = ui->temp_lineEdit->text().toDouble();
-    double length = ui->Length_lineEdit->text().toDouble(&okL);
+    double deltaT = handler->parseValue(ui->temp_lineEdit->text());
+    double length = handler->parseValue(ui->Length_lineEdit->text(), &okL);
 
     // 取得銅厚並轉換為 mm
     //double rawT = ui->thickness_lineEdit->text().toDouble(&okT);
-    double rawT = ui->thickness_lineEdit->text().toDouble();
+    double rawT = handler->parseValue(ui->thickness_lineEdit->text());
 
-    double thickness_mm = rawT;
-    if (ui->thickness_comboBox->currentIndex() == 1){
-        thickness_mm = rawT * 0.0254; // mil -> mm
-    }
-    else if (ui->thickness_comboBox->currentIndex() == 2) {
-        thickness_mm = rawT / 1000.0; // um -> mm
-    }
+    double thickness_mm = ThicknessUnits::from(rawT, ui->thickness_comboBox->currentIndex()).in<u::mm>();
 
     //double thickness_mm = ui->thickness_lineEdit->text().toDouble(&okT);
-    double thickness_mil = thickness_mm / 0.0254;
+    double thickness_mil = u::convert<u::mm, u::mil>(thickness_mm);
 
     if (deltaT <= 0 || thickness_mil <= 0){
         isCalculating = false; return;
     }
 
+    // 依選擇的模型：IPC-2221 內外層係數不同；IPC-2152 內外層相同 (k 不使用)
+    const bool ipc2152 = useIpc2152();
+    const sc::Ipc2152Options ipcOpt = ipc2152 ? ipc2152Options() : sc::Ipc2152Options();
+    auto currentFromWidth = [&](double width_mm, double k) {
+        return ipc2152 ? sc::ipc2152CurrentFromWidth(width_mm, thickness_mm, deltaT, ipcOpt)
+                       : sc::traceCurrentFromWidth(width_mm, thickness_mm, deltaT, k);
+    };
+
     // --- 核心邏輯：判斷是誰觸發的 ---
     QObject* s = sender();
 
     if (s == ui->External_lineEdit) {
         // A. 如果使用者在改【外層寬度】 -> 反推電流
-        double wExt = ui->External_lineEdit->text().toDouble();
-        if (ui->External_comboBox->currentIndex() == 1){
-            wExt *= 0.0254; // mil to mm
-            }
-        double area_mil2 = (wExt / 0.0254) * thickness_mil;
+        double wExt = WidthUnits::from(handler->parseValue(ui->External_lineEdit->text()),
+                                       ui->External_comboBox->currentIndex()).in<u::mm>();
         // 逆公式: I = 0.048 * dT^0.44 * Area^0.725
-        current = 0.048 * std::pow(deltaT, 0.44) * std::pow(area_mil2, 0.725);
+        current = currentFromWidth(wExt, sc::IPC2221_K_EXTERNAL);
 
         // 更新電流框
-        double dispI = (ui->Current_comboBox->currentIndex() == 1) ? current * 1000 : current;
+        double dispI = TraceCurrentUnits::to(u::quantity<u::A>(current), currentIdx);
         ui->Current_lineEdit->setText(QString::number(dispI, 'g', 5));
 
     } else if (s == ui->Internal_lineEdit) {
         // B. 如果使用者在改【內層寬度】 -> 反推電流
-        double wInt = ui->Internal_lineEdit->text().toDouble();
-        if (ui->Internal_comboBox->currentIndex() == 1) wInt *= 0.0254;
-        double area_mil2 = (wInt / 0.0254) * thickness_mil;
-        current = 0.024 * std::pow(deltaT, 0.44) * std::pow(area_mil2, 0.725);
+        double wInt = WidthUnits::from(handler->parseValue(ui->Internal_lineEdit->text()),
+                                       ui->Internal_comboBox->currentIndex()).in<u::mm>();
+        current = currentFromWidth(wInt, sc::IPC2221_K_INTERNAL);
 
-        double dispI = (ui->Current_comboBox->currentIndex() == 1) ? current * 1000 : current;
+        double dispI = TraceCurrentUnits::to(u::quantity<u::A>(current), currentIdx);
         ui->Current_lineEdit->setText(QString::number(dispI, 'g', 5));
     } else {
         // C. 其他情況 (改電流、改溫升、改銅厚) -> 正常算線寬
-        current = ui->Current_lineEdit->text().toDouble();
-        if (ui->Current_comboBox->currentIndex() == 1) current /= 1000.0;
+        current = TraceCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text()), currentIdx).in<u::A>();
     }
 
 
     // --- 最後：根據最終產出的 current，更新所有結果欄位 ---
     auto calcWidth = [&](double k) {
-        double area = std::pow((current / (k * std::pow(deltaT, 0.44))), (1.0 / 0.725));
-        return (area / thickness_mil) * 0.0254; // mm
+        return ipc2152 ? sc::ipc2152WidthFromCurrent(current, thickness_mm, deltaT, ipcOpt)
+                       : sc::traceWidthFromCurrent(current, thickness_mm, deltaT, k); // mm
     };
 
 
+    const int extIdx = ui->External_comboBox->currentIndex();
+    const int intIdx = ui->Internal_comboBox->currentIndex();
     double widthExt_mm = (s == ui->External_lineEdit) ?
-                             (ui->External_lineEdit->text().toDouble() *
-                             (ui->External_comboBox->currentIndex()==1?0.0254:1.0)) : calcWidth(0.048);
+                             WidthUnits::from(handler->parseValue(ui->External_lineEdit->text()), extIdx).in<u::mm>()
+                                                    : calcWidth(sc::IPC2221_K_EXTERNAL);
     double widthInt_mm = (s == ui->Internal_lineEdit) ?
-                             (ui->Internal_lineEdit->text().toDouble() *
-                             (ui->Internal_comboBox->currentIndex()==1?0.0254:1.0)) : calcWidth(0.024);
+                             WidthUnits::from(handler->parseValue(ui->Internal_lineEdit->text()), intIdx).in<u::mm>()
+                                                    : calcWidth(sc::IPC2221_K_INTERNAL);
 
 
     //double finalExt = calcWidth(0.048);
     //double finalInt = calcWidth(0.024);
 
     if (s != ui->External_lineEdit) {
-        double out = (ui->External_comboBox->currentIndex() == 1) ? widthExt_mm / 0.0254 : widthExt_mm;
+        double out = WidthUnits::to(u::quantity<u::mm>(widthExt_mm), extIdx);
         ui->External_lineEdit->setText(QString::number(out, 'f', 4));
     }
     if (s != ui->Internal_lineEdit) {
-        double out = (ui->Internal_comboBox->currentIndex() == 1) ? widthInt_mm / 0.0254 : widthInt_mm;
+        double out = WidthUnits::to(u::quantity<u::mm>(widthInt_mm), intIdx);
         ui->Internal_lineEdit->setText(QString::number(out, 'f', 4));
     }
 
         // --- 2. 電阻/壓降/功耗計算 (以外層寬度為例) ---
         if (okL && length > 0) {
-            // 長度統一換算為 cm (因為銅電阻率常用單位是 Ohm-cm)
-            double len_cm = length;
-            int lenIdx = ui->Length_comboBox->currentIndex();
-            if (lenIdx == 0) len_cm = length / 10.0;      // mm -> cm
-            else if (lenIdx == 1) len_cm = length * 0.00254; // mil -> cm
-            else if (lenIdx == 2) len_cm = length;        // cm -> cm
-
-            // 銅電阻率 (20°C) 約 1.72e-6 Ohm-cm
-            // 考慮溫升後的電阻率 ρ = ρ0 * (1 + α * ΔT), 銅的 α 約 0.00393
-            double res_at_temp = 1.72e-6 * (1 + 0.00393 * (deltaT));
-
-            // R = (ρ * L) / A  (注意單位：L是cm, Area要用 cm^2)
-            double area_cm2 = (widthExt_mm * 0.1) * (thickness_mm * 0.1);
-            double res_ohm = (res_at_temp * len_cm) / area_cm2;
+            // 長度統一換算為 mm
+            double len_mm = TraceLengthUnits::from(length, ui->Length_comboBox->currentIndex()).in<u::mm>();
+
+            // R = (ρ * L) / A，ρ = ρ0 * (1 + α * ΔT)
+            double res_ohm = sc::traceResistance(widthExt_mm, thickness_mm, len_mm, deltaT);
+
+            // 自洽溫升：不用允許溫升，改用這個電流與外層線寬實際的 I²R 溫升
+            if (selfHeating_checkBox && selfHeating_checkBox->isChecked()) {
+                const sc::SelfHeatingLane lane = sc::traceSelfHeatingLane(
+                    current, widthExt_mm, thickness_mm, len_mm, false,
+                    ipc2152 ? sc::TraceModel::IPC2152 : sc::TraceModel::IPC2221, ipcOpt, sc::TRACE_AMBIENT_C);
+                const sc::SelfHeatingResult heat = sc::selfHeatingSolve(lane);
+                if (heat.status == sc::SelfHeatingStatus::Runaway) {
+                    selfHeating_label->setText(tr("熱失控"));
+                    selfHeating_label->setStyleSheet("color: red; font-weight: bold;");
+                    ui->Impedance_lineEdit->clear();
+                    ui->VoltageDrop_lineEdit->clear();
+                    ui->Consumption_lineEdit->clear();
+                    updateWorstCase();
+                    isCalculating = false;
+                    return;
+                }
+                res_ohm = heat.resistance_ohm;
+                selfHeating_label->setText(tr("實際溫升 %1 °C").arg(heat.deltaT, 0, 'f', 1));
+                selfHeating_label->setStyleSheet(heat.deltaT > deltaT ? "color: red;" : "");
+            }
 
             // 更新電阻
-            double dispRes = (ui->Impedance_comboBox->currentIndex() == 0) ? res_ohm * 1000 : res_ohm;
+            double dispRes = ImpedanceUnits::to(u::quantity<u::Ohm>(res_ohm), ui->Impedance_comboBox->currentIndex());
             ui->Impedance_lineEdit->setText(QString::number(dispRes, 'g', 5));
 
             // 壓降 V = I * R
             double vDrop = current * res_ohm;
-            double dispV = (ui->VoltageDrop_comboBox->currentIndex() == 0) ? vDrop * 1000 : vDrop;
+            double dispV = DropUnits::to(u::quantity<u::V>(vDrop), ui->VoltageDrop_comboBox->currentIndex());
             ui->VoltageDrop_lineEdit->setText(QString::number(dispV, 'g', 5));
 
             // 功耗 P = I^2 * R
             double pLoss = current * current * res_ohm;
-            double dispP = (ui->Consumption_comboBox->currentIndex() == 0) ? pLoss * 1000 : pLoss;
+            double dispP = LossUnits::to(u::quantity<u::W>(pLoss), ui->Consumption_comboBox->currentIndex());
             ui->Consumption_lineEdit->setText(QString::number(dispP, 'g', 5));
         }
 
+    updateWorstCase();
     isCalculating = false;
 
 }
+
+void Line_Width::openToleranceAnalysis() {
+    bool okI, okW, okT;
+    const double current = TraceCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text(), &okI),
+                                                    ui->Current_comboBox->currentIndex()).in<u::A>();
+    const double width_mm = WidthUnits::from(handler->parseValue(ui->External_lineEdit->text(), &okW),
+                                             ui->External_comboBox->currentIndex()).in<u::mm>();
+    const double thickness_mm = ThicknessUnits::from(handler->parseValue(ui->thickness_lineEdit->text(), &okT),
+                                                     ui->thickness_comboBox->currentIndex()).in<u::mm>();
+
+    if (okI && okW && okT && current > 0 && width_mm > 0 && thickness_mm > 0) {
+        toleranceDialog->setModel({ { TOL_CURRENT, current, DEFAULT_CURRENT_TOL, sc::Distribution::Uniform },
+                                    { TOL_WIDTH, width_mm, DEFAULT_WIDTH_TOL, sc::Distribution::Normal },
+                                    { TOL_THICKNESS, thickness_mm, DEFAULT_THICKNESS_TOL, sc::Distribution::Normal } },
+                                  tr("溫升 (°C)"), sc::traceTempRiseModel(sc::IPC2221_K_EXTERNAL),
+                                  sc::traceTempRise(current, width_mm, thickness_mm, sc::IPC2221_K_EXTERNAL));
+    }
+    toleranceDialog->show();
+    toleranceDialog->raise();
+}
+
+void Line_Width::updateWorstCase() {
+    if (!worstCase_label) return;
+
+    bool okW, okT, okDelta;
+    const double width_mm = WidthUnits::from(handler->parseValue(ui->External_lineEdit->text(), &okW),
+                                             ui->External_comboBox->currentIndex()).in<u::mm>();
+    const double thickness_mm = ThicknessUnits::from(handler->parseValue(ui->thickness_lineEdit->text(), &okT),
+                                                     ui->thickness_comboBox->currentIndex()).in<u::mm>();
+    const double deltaT = handler->parseValue(ui->temp_lineEdit->text(), &okDelta);
+    if (!okW || !okT || !okDelta || !(width_mm > 0) || !(thickness_mm > 0) || !(deltaT > 0)) {
+        worstCase_label->clear();
+        return;
+    }
+
+    const sc::Interval width = sc::tolerance(width_mm, toleranceDialog->toleranceFor(TOL_WIDTH, DEFAULT_WIDTH_TOL));
+    const sc::Interval thickness =
+        sc::tolerance(thickness_mm, toleranceDialog->toleranceFor(TOL_THICKNESS, DEFAULT_THICKNESS_TOL));
+    sc::Interval current;
+    double nominal;
+    if (useIpc2152()) {
+        const sc::Ipc2152Options opt = ipc2152Options();
+        current = sc::ipc2152CurrentInterval(width, thickness, sc::point(deltaT), opt);
+        nominal = sc::ipc2152CurrentFromWidth(width_mm, thickness_mm, deltaT, opt);
+    } else {
+        current = sc::traceCurrentInterval(width, thickness, sc::point(deltaT), sc::IPC2221_K_EXTERNAL);
+        nominal = sc::traceCurrentFromWidth(width_mm, thickness_mm, deltaT, sc::IPC2221_K_EXTERNAL);
+    }
+    worstCase_label->setText(tr("外層載流最差情況：%1 ~ %2 A (標稱 %3 A)")
+                                 .arg(current.lower(), 0, 'g', 4).arg(current.upper(), 0, 'g', 4)
+                                 .arg(nominal, 0, 'g', 4));
+}
+
+void Line_Width::importNetlist() {
+    if (netlistThread) return;
+
+    const QString inPath = QFileDialog::getOpenFileName(this, tr("開啟網路清單"), QString(),
+                                                        tr("網路清單 (*.csv *.json *.txt);;所有檔案 (*)"));
+    if (inPath.isEmpty()) return;
+    const QFileInfo info(inPath);
+    const QString outPath = QFileDialog::getSaveFileName(
+        this, tr("儲存線寬結果"), info.dir().filePath(info.completeBaseName() + "_widths.csv"), tr("CSV (*.csv)"));
+    if (outPath.isEmpty()) return;
+
+    sc::TraceNetlistOptions opt;
+    opt.model = useIpc2152() ? sc::TraceModel::IPC2152 : sc::TraceModel::IPC2221;
+    opt.ipc2152 = ipc2152Options();
+    bool ok;
+    const double deltaT = handler->parseValue(ui->temp_lineEdit->text(), &ok);
+    if (ok && deltaT > 0) opt.defaultDeltaT = deltaT;
+    const double oz = handler->parseValue(ui->Mass_lineEdit->text(), &ok);
+    if (ok && oz > 0) opt.defaultCopperOz = oz;
+    opt.selfHeating = selfHeating_checkBox && selfHeating_checkBox->isChecked();
+
+    netlist_button->setEnabled(false);
+    netlist_button->setText(tr("計算中..."));
+
+    // 讀寫與計算都在工作執行緒，結束後以 queued 呼叫回到 GUI 執行緒顯示結果
+    const std::string in = inPath.toStdString();
+    const std::string out = outPath.toStdString();
+    netlistThread = QThread::create([this, in, out, opt]() {
+        sc::TraceNetlistStats stats;
+        QString error;
+        sc::MappedFile input;
+        sc::BufferedWriter writer;
+        if (!input.open(in)) {
+            error = QString::fromStdString(input.errorString());
+        } else if (!writer.open(out)) {
+            error = QString::fromStdString(writer.errorString());
+        } else {
+            bool done = sc::traceNetlist(input.view(), writer, opt, &stats);
+            done = writer.close() && done;
+            if (!done) error = QString::fromStdString(stats.error.empty() ? writer.errorString() : stats.error);
+        }
+        QMetaObject::invokeMethod(this, [this, stats, error]() {
+            if (!error.isEmpty()) {
+                QMessageBox::warning(this, tr("網路清單批次"), error);
+                return;
+            }
+            QString text = tr("%1 個網路，%2 個無法計算").arg(stats.rows).arg(stats.failedLines.size());
+            if (stats.runaway) text += tr("，%1 個熱失控").arg(stats.runaway);
+            const std::size_t shown = std::min<std::size_t>(stats.failedLines.size(), 10);
+            for (std::size_t i = 0; i < shown; ++i) text += tr("\n第 %1 行").arg(stats.failedLines[i]);
+            if (shown < stats.failedLines.size()) text += tr("\n...");
+            QMessageBox::information(this, tr("網路清單批次"), text);
+        }, Qt::QueuedConnection);
+    });
+    connect(netlistThread, &QThread::finished, this, [this]() {
+        netlistThread->deleteLater();
+        netlistThread = nullptr;
+        netlist_button->setEnabled(true);
+        netlist_button->setText(tr("網路清單批次..."));
+    });
+    netlistThread->start();
+}
+
+void Line_Width::openThermalAnalysis() {
+    bool okI, okW, okT;
+    const double current = TraceCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text(), &okI),
+                                                    ui->Current_comboBox->currentIndex()).in<u::A>();
+    const double width_mm = WidthUnits::from(handler->parseValue(ui->External_lineEdit->text(), &okW),
+                                             ui->External_comboBox->currentIndex()).in<u::mm>();
+    const double thickness_mm = ThicknessUnits::from(handler->parseValue(ui->thickness_lineEdit->text(), &okT),
+                                                     ui->thickness_comboBox->currentIndex()).in<u::mm>();
+    const sc::Ipc2152Options opt = ipc2152Options();
+    if (okI && okW && okT)
+        thermalDialog->setTrace(width_mm, thickness_mm, current, opt.boardThickness_mm, opt.planeDistance_mm);
+    thermalDialog->show();
+    thermalDialog->raise();
+}
+
+void Line_Width::openPulse() {
+    bool okI, okW, okT, okL;
+    const double current = TraceCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text(), &okI),
+                                                    ui->Current_comboBox->currentIndex()).in<u::A>();
+    const double width_mm = WidthUnits::from(handler->parseValue(ui->External_lineEdit->text(), &okW),
+                                             ui->External_comboBox->currentIndex()).in<u::mm>();
+    const double thickness_mm = ThicknessUnits::from(handler->parseValue(ui->thickness_lineEdit->text(), &okT),
+                                                     ui->thickness_comboBox->currentIndex()).in<u::mm>();
+    const double length_mm = TraceLengthUnits::from(handler->parseValue(ui->Length_lineEdit->text(), &okL),
+                                                    ui->Length_comboBox->currentIndex()).in<u::mm>();
+    pulseDialog->setTrace(okW ? width_mm : 0, okT ? thickness_mm : 0, okL ? length_mm : 0, false,
+                          useIpc2152() ? 1 : 0, okI ? current : 0, sc::TRACE_AMBIENT_C);
+    pulseDialog->show();
+    pulseDialog->raise();
+}
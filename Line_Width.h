@@ -2,9 +2,21 @@
 #define LINE_WIDTH_H
 
 #include "UnitConverterHandler.h"
+#include "Ipc2152.h"
 
 #include <QWidget>
 
+class MonteCarloDialog;
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QThread;
+class TraceThermalDialog;
+class PlaneDropDialog;
+class PulseDialog;
+
 namespace Ui {
 class Line_Width;
 }
@@ -29,11 +41,46 @@ public:
 private:
     Ui::Line_Width *ui;
 
+    // 公差分析 (Monte Carlo)：電流、蝕刻線寬、鍍銅厚度的公差對外層溫升的影響
+    MonteCarloDialog *toleranceDialog = nullptr;
+
+    // 最差情況載流範圍 (區間運算)，公差與公差分析視窗共用
+    QLabel *worstCase_label = nullptr;
+    void updateWorstCase();
+
+    // 載流模型：IPC-2221 (內外層係數) 或 IPC-2152 (板厚、銅平面修正)
+    QComboBox *model_comboBox = nullptr;
+    QLineEdit *board_lineEdit = nullptr;
+    QLineEdit *plane_lineEdit = nullptr;
+    bool useIpc2152() const;
+    sc::Ipc2152Options ipc2152Options() const;
+
+    // 自洽溫升 (電熱耦合)：勾選時電阻、壓降、功耗用實際溫升計算
+    QCheckBox *selfHeating_checkBox = nullptr;
+    QLabel *selfHeating_label = nullptr;
+
+    // 網路清單批次計算 (CSV / JSON -> CSV)，在工作執行緒上跑
+    QPushButton *netlist_button = nullptr;
+    QThread *netlistThread = nullptr;
+
+    // 截面 2D 熱傳導：以目前的外層線寬、銅厚、電流和 IPC-2221 溫升比較
+    TraceThermalDialog *thermalDialog = nullptr;
+
+    // 鋪銅 IR drop：不規則鋪銅 (瓶頸、挖空、過孔) 的壓降分布
+    PlaneDropDialog *planeDialog = nullptr;
+
+    // 脈衝 / 熔斷：湧浪、短路電流下的暫態溫度，帶入外層線寬、銅厚、長度與電流
+    PulseDialog *pulseDialog = nullptr;
+
 
 
 
 private slots:
     void updateCalculation();
+    void openToleranceAnalysis();
+    void importNetlist();
+    void openThermalAnalysis();
+    void openPulse();
 };
 
 #endif // LINE_WIDTH_H
@@ -0,0 +1,303 @@
+#include "MonteCarloDialog.h"
+
+#include <QComboBox>
+#include <QFormLayout>
+#include <QHeaderView>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPainter>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QTableWidget>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// 分布下拉選單的順序
+const sc::Distribution DISTRIBUTIONS[] = { sc::Distribution::Fixed, sc::Distribution::Uniform,
+                                           sc::Distribution::Normal, sc::Distribution::TruncatedNormal };
+
+int distributionIndex(sc::Distribution kind)
+{
+    for (int i = 0; i < 4; ++i)
+        if (DISTRIBUTIONS[i] == kind) return i;
+    return 0;
+}
+
+} // namespace
+
+// --- HistogramWidget ---
+
+HistogramWidget::HistogramWidget(QWidget *parent) : QWidget(parent)
+{
+    setMinimumHeight(180);
+}
+
+void HistogramWidget::setResult(const sc::MonteCarloResult &r, double sMin, double sMax, double s)
+{
+    result = r;
+    specMin = sMin;
+    specMax = sMax;
+    scale = s;
+    update();
+}
+
+void HistogramWidget::clear()
+{
+    result = sc::MonteCarloResult();
+    update();
+}
+
+void HistogramWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), palette().base());
+    if (result.histogram.empty() || !(result.histMax > result.histMin)) return;
+
+    const int margin = 6;
+    const int textH = fontMetrics().height();
+    const QRect plot(margin, margin, width() - 2 * margin, height() - 2 * margin - textH);
+    const std::uint64_t peak = *std::max_element(result.histogram.begin(), result.histogram.end());
+    if (peak == 0 || plot.width() <= 0 || plot.height() <= 0) return;
+
+    // 長條
+    const double barW = static_cast<double>(plot.width()) / static_cast<double>(result.histogram.size());
+    p.setPen(Qt::NoPen);
+    p.setBrush(palette().highlight());
+    for (std::size_t i = 0; i < result.histogram.size(); ++i) {
+        const double h = plot.height() * static_cast<double>(result.histogram[i]) / static_cast<double>(peak);
+        p.drawRect(QRectF(plot.left() + i * barW, plot.bottom() - h, std::max(barW - 1, 1.0), h));
+    }
+
+    // 規格上下限
+    const double lo = result.histMin * scale;
+    const double hi = result.histMax * scale;
+    auto xOf = [&](double v) { return plot.left() + (v - lo) / (hi - lo) * plot.width(); };
+    p.setPen(QPen(Qt::red, 1, Qt::DashLine));
+    for (double s : { specMin, specMax }) {
+        if (std::isfinite(s) && s >= lo && s <= hi) p.drawLine(QPointF(xOf(s), plot.top()), QPointF(xOf(s), plot.bottom()));
+    }
+
+    // 橫軸範圍
+    p.setPen(palette().text().color());
+    const QRect textRect(plot.left(), plot.bottom() + 2, plot.width(), textH);
+    p.drawText(textRect, Qt::AlignLeft, QString::number(lo, 'g', 5));
+    p.drawText(textRect, Qt::AlignRight, QString::number(hi, 'g', 5));
+}
+
+// --- MonteCarloDialog ---
+
+MonteCarloDialog::MonteCarloDialog(UnitConverterHandler *sharedHandler, const QString &title, QWidget *parent) :
+    QDialog(parent),
+    handler(sharedHandler)
+{
+    setWindowTitle(title);
+    resize(560, 600);
+
+    output_label = new QLabel(this);
+
+    inputTable = new QTableWidget(0, 4, this);
+    inputTable->setHorizontalHeaderLabels({tr("輸入"), tr("標稱值"), tr("分布"), tr("公差 (±%)")});
+    inputTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    inputTable->verticalHeader()->setVisible(false);
+
+    samples_lineEdit = new QLineEdit("1M", this);
+    seed_lineEdit = new QLineEdit("1", this);
+    specMin_lineEdit = new QLineEdit(this);
+    specMax_lineEdit = new QLineEdit(this);
+    specMin_lineEdit->setPlaceholderText(tr("不限制"));
+    specMax_lineEdit->setPlaceholderText(tr("不限制"));
+    run_button = new QPushButton(tr("計算"), this);
+    status_label = new QLabel(this);
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("樣本數"), samples_lineEdit);
+    form->addRow(tr("亂數種子"), seed_lineEdit);
+    QHBoxLayout *spec = new QHBoxLayout;
+    spec->addWidget(specMin_lineEdit);
+    spec->addWidget(new QLabel("~", this));
+    spec->addWidget(specMax_lineEdit);
+    form->addRow(tr("規格範圍"), spec);
+    form->addRow(run_button, status_label);
+
+    histogram = new HistogramWidget(this);
+    stats_label = new QLabel(this);
+    stats_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(output_label);
+    layout->addWidget(inputTable);
+    layout->addLayout(form);
+    layout->addWidget(histogram, 1);
+    layout->addWidget(stats_label);
+
+    connect(run_button, &QPushButton::clicked, this, &MonteCarloDialog::run);
+    connect(inputTable, &QTableWidget::itemChanged, this, [this](QTableWidgetItem *item) {
+        if (item->column() == 3) emit tolerancesChanged();
+    });
+}
+
+MonteCarloDialog::~MonteCarloDialog()
+{
+    // 背景計算還在跑的話先取消並等它結束
+    if (thread) {
+        cancel = true;
+        thread->wait();
+        delete thread;
+    }
+}
+
+void MonteCarloDialog::setModel(const QList<Input> &newInputs, const QString &outputName, sc::MonteCarloModel newModel,
+                                double nominal, double scale)
+{
+    // 計算中不更換公式，結果才會對應到表格中的輸入
+    if (thread) return;
+
+    // 保留同名輸入的公差與分布設定
+    QList<Input> merged = newInputs;
+    for (Input &in : merged) {
+        for (int row = 0; row < inputTable->rowCount(); ++row) {
+            if (inputTable->item(row, 0)->text() != in.name) continue;
+            auto *combo = qobject_cast<QComboBox *>(inputTable->cellWidget(row, 2));
+            in.kind = DISTRIBUTIONS[qBound(0, combo->currentIndex(), 3)];
+            bool ok;
+            double tol = handler->parseValue(inputTable->item(row, 3)->text(), &ok);
+            if (ok && tol >= 0) in.tolerance = tol / 100.0;
+        }
+    }
+
+    // 標稱輸出改變時，規格預設為標稱值 ±5%
+    if (nominal != nominalOutput || specMin_lineEdit->text().isEmpty()) {
+        const double shown = nominal * scale;
+        specMin_lineEdit->setText(QString::number(shown - std::fabs(shown) * 0.05, 'g', 6));
+        specMax_lineEdit->setText(QString::number(shown + std::fabs(shown) * 0.05, 'g', 6));
+    }
+
+    inputs = merged;
+    model = std::move(newModel);
+    nominalOutput = nominal;
+    outputScale = scale;
+    output_label->setText(tr("輸出：%1，標稱值 %2").arg(outputName).arg(nominal * scale, 0, 'g', 6));
+
+    const QSignalBlocker blocker(inputTable);
+    inputTable->setRowCount(static_cast<int>(inputs.size()));
+    for (int row = 0; row < inputs.size(); ++row) {
+        const Input &in = inputs[row];
+        QTableWidgetItem *name = new QTableWidgetItem(in.name);
+        name->setFlags(name->flags() & ~Qt::ItemIsEditable);
+        QTableWidgetItem *value = new QTableWidgetItem(QString::number(in.nominal, 'g', 6));
+        value->setFlags(value->flags() & ~Qt::ItemIsEditable);
+        inputTable->setItem(row, 0, name);
+        inputTable->setItem(row, 1, value);
+        inputTable->setItem(row, 3, new QTableWidgetItem(QString::number(in.tolerance * 100.0, 'g', 4)));
+
+        QComboBox *combo = new QComboBox(inputTable);
+        combo->addItems({tr("固定"), tr("均勻"), tr("常態 (3σ)"), tr("截斷常態 (3σ)")});
+        combo->setCurrentIndex(distributionIndex(in.kind));
+        inputTable->setCellWidget(row, 2, combo);
+    }
+    histogram->clear();
+    stats_label->clear();
+    status_label->clear();
+    emit tolerancesChanged();
+}
+
+double MonteCarloDialog::toleranceFor(const QString &name, double fallback) const
+{
+    for (int row = 0; row < inputTable->rowCount(); ++row) {
+        if (inputTable->item(row, 0)->text() != name) continue;
+        bool ok;
+        const double tol = handler->parseValue(inputTable->item(row, 3)->text(), &ok);
+        return (ok && tol >= 0) ? tol / 100.0 : fallback;
+    }
+    return fallback;
+}
+
+void MonteCarloDialog::run()
+{
+    // 計算中再按一次 = 停止，保留目前累積的結果
+    if (thread) {
+        cancel = true;
+        return;
+    }
+    if (!model) return;
+
+    bool okN, okSeed;
+    const double samples = handler->parseValue(samples_lineEdit->text(), &okN);
+    const double seed = handler->parseValue(seed_lineEdit->text(), &okSeed);
+    if (!okN || !(samples >= 1) || samples > 1e10) {
+        status_label->setText(tr("樣本數需介於 1 與 1e10 之間"));
+        return;
+    }
+
+    std::vector<sc::InputDistribution> dists;
+    for (int row = 0; row < inputs.size(); ++row) {
+        sc::InputDistribution d;
+        d.nominal = inputs[row].nominal;
+        d.kind = DISTRIBUTIONS[qBound(0, qobject_cast<QComboBox *>(inputTable->cellWidget(row, 2))->currentIndex(), 3)];
+        bool ok;
+        const double tol = handler->parseValue(inputTable->item(row, 3)->text(), &ok);
+        if (!ok || tol < 0) {
+            status_label->setText(tr("%1 的公差格式錯誤").arg(inputs[row].name));
+            return;
+        }
+        d.tolerance = tol / 100.0;
+        dists.push_back(d);
+    }
+
+    // 規格以顯示單位輸入，空白代表不限制
+    bool okMin, okMax;
+    const double specMin = handler->parseValue(specMin_lineEdit->text(), &okMin);
+    const double specMax = handler->parseValue(specMax_lineEdit->text(), &okMax);
+    shownSpecMin = okMin ? specMin : -std::numeric_limits<double>::infinity();
+    shownSpecMax = okMax ? specMax : std::numeric_limits<double>::infinity();
+
+    sc::MonteCarloOptions opt;
+    opt.samples = static_cast<std::uint64_t>(samples);
+    opt.seed = okSeed ? static_cast<std::uint64_t>(std::fabs(seed)) : 0;
+    opt.bins = 80;
+    opt.specMin = shownSpecMin / outputScale;
+    opt.specMax = shownSpecMax / outputScale;
+    if (outputScale < 0) std::swap(opt.specMin, opt.specMax);
+    opt.cancel = &cancel;
+
+    status_label->setText(tr("計算中..."));
+    run_button->setText(tr("停止"));
+    cancel = false;
+
+    // 每一段結果在工作執行緒上產生，透過 queued 呼叫轉回 GUI 執行緒
+    thread = QThread::create([this, dists, opt, m = model]() {
+        sc::runMonteCarlo(dists, m, opt, [this](const sc::MonteCarloResult &r) {
+            QMetaObject::invokeMethod(this, [this, r]() { showResult(r); }, Qt::QueuedConnection);
+        });
+    });
+    connect(thread, &QThread::finished, this, [this]() {
+        thread->deleteLater();
+        thread = nullptr;
+        run_button->setText(tr("計算"));
+        if (cancel) status_label->setText(tr("已停止：%1").arg(status_label->text()));
+    });
+    thread->start();
+}
+
+void MonteCarloDialog::showResult(const sc::MonteCarloResult &r)
+{
+    histogram->setResult(r, shownSpecMin, shownSpecMax, outputScale);
+
+    const double s = outputScale;
+    stats_label->setText(tr("平均 %1，σ %2\n最小 %3，最大 %4\nP0.1 %5，P50 %6，P99.9 %7\n良率 %8 %（無效 %9）")
+                             .arg(r.mean * s, 0, 'g', 6).arg(r.stddev * std::fabs(s), 0, 'g', 4)
+                             .arg(r.min * s, 0, 'g', 6).arg(r.max * s, 0, 'g', 6)
+                             .arg(r.percentile(0.001) * s, 0, 'g', 6).arg(r.percentile(0.5) * s, 0, 'g', 6)
+                             .arg(r.percentile(0.999) * s, 0, 'g', 6)
+                             .arg(r.yield() * 100, 0, 'f', 3).arg(r.invalid));
+    status_label->setText(r.complete
+        ? tr("完成 %1 個樣本，%2 ms").arg(r.samples).arg(r.elapsed_ms, 0, 'f', 0)
+        : tr("%1 個樣本...").arg(r.samples));
+}
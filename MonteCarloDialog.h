@@ -0,0 +1,95 @@
+#ifndef MONTECARLODIALOG_H
+#define MONTECARLODIALOG_H
+
+#include <QDialog>
+#include <QList>
+#include <QString>
+#include <QWidget>
+#include "UnitConverterHandler.h"
+#include "MonteCarlo.h"
+
+#include <atomic>
+
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QTableWidget;
+class QThread;
+
+// 直方圖 (含規格上下限的標示線)
+class HistogramWidget : public QWidget
+{
+public:
+    explicit HistogramWidget(QWidget *parent = nullptr);
+
+    void setResult(const sc::MonteCarloResult &result, double specMin, double specMax, double scale);
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    sc::MonteCarloResult result;
+    double specMin = 0;
+    double specMax = 0;
+    double scale = 1;           // 顯示單位倍率 (例如 A -> mA 為 1000)
+};
+
+// 公差 / 良率分析視窗：各計算頁開啟時填入目前的標稱值與公式，計算在背景執行緒進行
+class MonteCarloDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    struct Input {
+        QString name;                   // 顯示名稱，例如 "R1 (Ω)"
+        double nominal;                 // 公式使用的單位 (Ohm、A、mm ...)
+        double tolerance;               // 預設相對公差，0.01 = 1%
+        sc::Distribution kind;          // 預設分布
+    };
+
+    MonteCarloDialog(UnitConverterHandler *sharedHandler, const QString &title, QWidget *parent = nullptr);
+    ~MonteCarloDialog();
+
+    // outputName 為結果名稱 (含單位)，outputScale 把公式輸出換成顯示單位；
+    // 同名輸入會保留使用者上次設定的公差與分布
+    void setModel(const QList<Input> &inputs, const QString &outputName, sc::MonteCarloModel model,
+                  double nominalOutput, double outputScale = 1.0);
+
+    // 表格中某個輸入目前的相對公差；視窗還沒開過 (沒有該列) 時回傳 fallback。
+    // 計算頁的最差情況範圍也用這裡的公差，兩種分析的設定保持一致
+    double toleranceFor(const QString &name, double fallback) const;
+
+signals:
+    void tolerancesChanged();
+
+private:
+    UnitConverterHandler *handler;
+    QList<Input> inputs;
+    sc::MonteCarloModel model;
+    double nominalOutput = 0;
+    double outputScale = 1.0;
+
+    QLabel *output_label = nullptr;
+    QTableWidget *inputTable = nullptr;
+    QLineEdit *samples_lineEdit = nullptr;
+    QLineEdit *specMin_lineEdit = nullptr;
+    QLineEdit *specMax_lineEdit = nullptr;
+    QLineEdit *seed_lineEdit = nullptr;
+    QPushButton *run_button = nullptr;
+    QLabel *status_label = nullptr;
+    QLabel *stats_label = nullptr;
+    HistogramWidget *histogram = nullptr;
+
+    QThread *thread = nullptr;
+    std::atomic<bool> cancel{false};
+    double shownSpecMin = 0;            // 目前結果對應的規格 (顯示單位)
+    double shownSpecMax = 0;
+
+    void showResult(const sc::MonteCarloResult &result);
+
+private slots:
+    void run();
+};
+
+#endif // MONTECARLODIALOG_H
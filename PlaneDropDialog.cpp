@@ -0,0 +1,307 @@
+#include "PlaneDropDialog.h"
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPainter>
+#include <QPushButton>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 電流密度的色階上限取這個分位數 (焊墊邊緣、內角的奇異點會把最大值拉得很高)
+constexpr double DENSITY_SCALE_QUANTILE = 0.995;
+
+} // namespace
+
+// --- PlaneMapWidget ---
+
+PlaneMapWidget::PlaneMapWidget(QWidget *parent) : QWidget(parent)
+{
+    setMinimumHeight(260);
+}
+
+void PlaneMapWidget::setResult(std::shared_ptr<const sc::PlaneDropResult> r)
+{
+    result = std::move(r);
+    render();
+    update();
+}
+
+void PlaneMapWidget::setShowDensity(bool density)
+{
+    showDensity = density;
+    render();
+    update();
+}
+
+void PlaneMapWidget::clear()
+{
+    result.reset();
+    image = QImage();
+    update();
+}
+
+void PlaneMapWidget::resizeEvent(QResizeEvent *)
+{
+    render();
+}
+
+void PlaneMapWidget::render()
+{
+    image = QImage();
+    if (!result || result->nx <= 0 || result->ny <= 0) return;
+    const QSize size = contentsRect().size();
+    if (size.width() <= 0 || size.height() <= 0) return;
+
+    const std::vector<double> &field = showDensity ? result->density_A_per_mm2 : result->drop_V;
+    double top = showDensity ? result->maxDensity_A_per_mm2 : result->maxDrop_V;
+    if (showDensity) {
+        std::vector<double> values;
+        values.reserve(result->copperCells);
+        for (double v : field) {
+            if (!std::isnan(v)) values.push_back(v);
+        }
+        if (!values.empty()) {
+            const std::size_t q = static_cast<std::size_t>(DENSITY_SCALE_QUANTILE * (values.size() - 1));
+            std::nth_element(values.begin(), values.begin() + q, values.end());
+            top = values[q];
+        }
+    }
+    if (!(top > 0)) top = 1;
+
+    // 等比例縮放，每個像素取最近的格子
+    const double width = result->nx * result->cell_mm;
+    const double height = result->ny * result->cell_mm;
+    scale = std::min(size.width() / width, size.height() / height);
+    const int w = std::max(1, static_cast<int>(width * scale));
+    const int h = std::max(1, static_cast<int>(height * scale));
+    std::vector<int> column(w);
+    for (int px = 0; px < w; ++px)
+        column[px] = std::min(result->nx - 1, static_cast<int>((px + 0.5) / scale / result->cell_mm));
+
+    image = QImage(w, h, QImage::Format_RGB32);
+    const QRgb empty = palette().window().color().rgb();
+    for (int py = 0; py < h; ++py) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(py));
+        const int j = std::min(result->ny - 1, static_cast<int>((h - py - 0.5) / scale / result->cell_mm));
+        const double *row = &field[static_cast<std::size_t>(j) * result->nx];
+        for (int px = 0; px < w; ++px) {
+            const double v = row[column[px]];
+            if (std::isnan(v)) {
+                line[px] = empty;
+                continue;
+            }
+            const double t = std::clamp(v / top, 0.0, 1.0);
+            line[px] = QColor::fromHsvF(0.66 * (1 - t), 0.85, 0.95).rgb();
+        }
+    }
+}
+
+void PlaneMapWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), palette().base());
+    if (image.isNull()) return;
+
+    const QRect r = contentsRect();
+    const QPoint origin(r.left() + (r.width() - image.width()) / 2, r.top() + (r.height() - image.height()) / 2);
+    p.drawImage(origin, image);
+
+    // 熱點 (編號與摘要相同)
+    p.setPen(QPen(Qt::black, 1.5));
+    for (std::size_t k = 0; k < result->hotspots.size(); ++k) {
+        const sc::PlaneHotspot &s = result->hotspots[k];
+        const QPointF c(origin.x() + (s.x_mm - result->x0_mm) * scale,
+                        origin.y() + image.height() - (s.y_mm - result->y0_mm) * scale);
+        p.drawEllipse(c, 6, 6);
+        p.drawText(c + QPointF(8, -4), QString::number(k + 1));
+    }
+
+    p.setPen(palette().text().color());
+    p.drawText(r.adjusted(4, 2, -4, 0), Qt::AlignLeft | Qt::AlignTop,
+               showDensity ? tr("電流密度 (最大 %1 A/mm²)").arg(result->maxDensity_A_per_mm2, 0, 'g', 4)
+                           : tr("壓降 (最大 %1 mV)").arg(result->maxDrop_V * 1e3, 0, 'g', 4));
+}
+
+// --- PlaneDropDialog ---
+
+PlaneDropDialog::PlaneDropDialog(UnitConverterHandler *sharedHandler, QWidget *parent) :
+    QDialog(parent),
+    handler(sharedHandler)
+{
+    setWindowTitle(tr("鋪銅壓降 (IR drop)"));
+    resize(640, 720);
+
+    file_lineEdit = new QLineEdit(this);
+    file_lineEdit->setPlaceholderText(tr("外框、焊墊與過孔的描述檔 (文字或 JSON)"));
+    QPushButton *browseButton = new QPushButton(tr("瀏覽..."), this);
+    cell_lineEdit = new QLineEdit(this);
+    cell_lineEdit->setPlaceholderText(tr("自動 (約一百萬格)"));
+    cell_lineEdit->setToolTip(tr("正方形格子的邊長，越小越準但越慢 (格數與邊長平方成反比)"));
+    temperature_lineEdit = new QLineEdit(this);
+    temperature_lineEdit->setPlaceholderText(tr("依描述檔"));
+    temperature_lineEdit->setToolTip(tr("銅的溫度，電阻率以 ρ20 (1 + α (T - 20)) 修正"));
+    view_comboBox = new QComboBox(this);
+    view_comboBox->addItems({ tr("壓降"), tr("電流密度") });
+    solve_button = new QPushButton(tr("計算"), this);
+    export_button = new QPushButton(tr("匯出分布 (CSV)..."), this);
+    export_button->setEnabled(false);
+    result_label = new QLabel(this);
+    result_label->setWordWrap(true);
+    result_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    map = new PlaneMapWidget(this);
+
+    QHBoxLayout *fileRow = new QHBoxLayout;
+    fileRow->addWidget(file_lineEdit, 1);
+    fileRow->addWidget(browseButton);
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("描述檔"), fileRow);
+    form->addRow(tr("格子大小 (mm)"), cell_lineEdit);
+    form->addRow(tr("銅溫度 (°C)"), temperature_lineEdit);
+    form->addRow(tr("顯示"), view_comboBox);
+    QHBoxLayout *buttons = new QHBoxLayout;
+    buttons->addWidget(solve_button);
+    buttons->addWidget(export_button);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addLayout(buttons);
+    layout->addWidget(result_label);
+    layout->addWidget(map, 1);
+
+    connect(browseButton, &QPushButton::clicked, this, &PlaneDropDialog::browse);
+    connect(solve_button, &QPushButton::clicked, this, &PlaneDropDialog::solve);
+    connect(export_button, &QPushButton::clicked, this, &PlaneDropDialog::exportMap);
+    connect(view_comboBox, &QComboBox::currentIndexChanged, this,
+            [this](int index) { map->setShowDensity(index == 1); });
+}
+
+PlaneDropDialog::~PlaneDropDialog()
+{
+    if (solveThread) solveThread->wait();
+}
+
+void PlaneDropDialog::browse()
+{
+    const QString path = QFileDialog::getOpenFileName(this, tr("開啟鋪銅描述檔"), file_lineEdit->text(),
+                                                      tr("鋪銅描述 (*.txt *.json);;所有檔案 (*)"));
+    if (!path.isEmpty()) file_lineEdit->setText(path);
+}
+
+void PlaneDropDialog::solve()
+{
+    if (solveThread) return;
+
+    const QString path = file_lineEdit->text().trimmed();
+    if (path.isEmpty()) {
+        result_label->setText(tr("請選擇描述檔"));
+        return;
+    }
+    sc::PlaneDropOptions options;
+    bool ok;
+    if (!cell_lineEdit->text().trimmed().isEmpty()) {
+        options.cell_mm = handler->parseValue(cell_lineEdit->text(), &ok);
+        if (!ok || !(options.cell_mm > 0)) {
+            result_label->setText(tr("格子大小必須是正數 (空白為自動)"));
+            return;
+        }
+    }
+    bool hasTemperature = false;
+    double temperature = 0;
+    if (!temperature_lineEdit->text().trimmed().isEmpty()) {
+        temperature = handler->parseValue(temperature_lineEdit->text(), &hasTemperature);
+        if (!hasTemperature) {
+            result_label->setText(tr("銅溫度必須是數字 (空白為依描述檔)"));
+            return;
+        }
+    }
+
+    solve_button->setEnabled(false);
+    solve_button->setText(tr("計算中..."));
+
+    const std::string file = path.toStdString();
+    solveThread = QThread::create([this, file, options, hasTemperature, temperature]() {
+        QElapsedTimer timer;
+        timer.start();
+        auto r = std::make_shared<sc::PlaneDropResult>();
+        sc::PlaneLayout layout;
+        sc::MappedFile input;
+        std::string error;
+        if (!input.open(file)) {
+            r->error = input.errorString();
+        } else if (!sc::parsePlaneLayout(input.view(), layout, error)) {
+            r->error = error;
+        } else {
+            if (hasTemperature) layout.temperature_C = temperature;
+            *r = sc::planeDropSolve(layout, options);
+        }
+        const double elapsed = timer.nsecsElapsed() / 1e6;
+        QMetaObject::invokeMethod(this, [this, r, layout, elapsed]() {
+            if (!r->error.empty()) {
+                result_label->setText(QString::fromStdString(r->error));
+                map->clear();
+                lastResult.reset();
+                export_button->setEnabled(false);
+                return;
+            }
+            QString text = tr("最大壓降 %1 mV，總電流 %2 A，損耗 %3 W，最大電流密度 %4 A/mm²")
+                               .arg(r->maxDrop_V * 1e3, 0, 'g', 4).arg(r->totalCurrent_A, 0, 'g', 4)
+                               .arg(r->power_W, 0, 'g', 4).arg(r->maxDensity_A_per_mm2, 0, 'g', 4);
+            for (std::size_t s = 0; s < r->sinkDrop_V.size(); ++s) {
+                text += tr("\n負載 %1 (%2, %3)：%4 mV").arg(s + 1).arg(layout.sinks[s].x_mm).arg(layout.sinks[s].y_mm)
+                            .arg(r->sinkDrop_V[s] * 1e3, 0, 'g', 4);
+            }
+            for (std::size_t v = 0; v < r->viaDrop_V.size(); ++v) {
+                if (layout.vias[v].current_A == 0) continue;
+                text += tr("\n過孔 %1 (%2, %3)：%4 mV").arg(v + 1).arg(layout.vias[v].x_mm).arg(layout.vias[v].y_mm)
+                            .arg(r->viaDrop_V[v] * 1e3, 0, 'g', 4);
+            }
+            for (std::size_t h = 0; h < r->hotspots.size(); ++h) {
+                const sc::PlaneHotspot &s = r->hotspots[h];
+                text += tr("\n熱點 %1 (%2, %3)：%4 A/mm²").arg(h + 1).arg(s.x_mm, 0, 'f', 2).arg(s.y_mm, 0, 'f', 2)
+                            .arg(s.density_A_per_mm2, 0, 'g', 4);
+            }
+            text += tr("\n%1 x %2 格 (%3 mm)，銅 %4 格").arg(r->nx).arg(r->ny).arg(r->cell_mm, 0, 'g', 4).arg(r->copperCells);
+            if (r->islandCells) text += tr("，%1 格銅島未連到電源 (忽略)").arg(r->islandCells);
+            text += tr("，%1 次迭代，%2 ms").arg(r->iterations).arg(elapsed, 0, 'f', 0);
+            if (!r->converged) text += tr("\n未收斂，結果僅供參考");
+            result_label->setText(text);
+            lastResult = r;
+            map->setResult(r);
+            export_button->setEnabled(true);
+        }, Qt::QueuedConnection);
+    });
+    connect(solveThread, &QThread::finished, this, [this]() {
+        solveThread->deleteLater();
+        solveThread = nullptr;
+        solve_button->setEnabled(true);
+        solve_button->setText(tr("計算"));
+    });
+    solveThread->start();
+}
+
+void PlaneDropDialog::exportMap()
+{
+    if (!lastResult) return;
+    const QFileInfo info(file_lineEdit->text());
+    const QString path = QFileDialog::getSaveFileName(
+        this, tr("匯出壓降分布"), info.dir().filePath(info.completeBaseName() + "_drop.csv"), tr("CSV (*.csv)"));
+    if (path.isEmpty()) return;
+
+    sc::BufferedWriter out;
+    if (!out.open(path.toStdString()) || !sc::writePlaneMapCsv(*lastResult, out) || !out.close())
+        QMessageBox::warning(this, tr("匯出壓降分布"), QString::fromStdString(out.errorString()));
+}
@@ -0,0 +1,72 @@
+#ifndef PLANEDROPDIALOG_H
+#define PLANEDROPDIALOG_H
+
+#include <QDialog>
+#include <QImage>
+#include <QWidget>
+#include "UnitConverterHandler.h"
+#include "PlaneDrop.h"
+
+#include <memory>
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QThread;
+
+// 鋪銅的壓降或電流密度分布 (藍 = 0，紅 = 最大)，標出電流密度熱點
+class PlaneMapWidget : public QWidget
+{
+public:
+    explicit PlaneMapWidget(QWidget *parent = nullptr);
+
+    void setResult(std::shared_ptr<const sc::PlaneDropResult> result);
+    void setShowDensity(bool density);
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    std::shared_ptr<const sc::PlaneDropResult> result;
+    bool showDensity = false;
+    QImage image;
+    double scale = 0;       // 像素 / mm
+    void render();
+};
+
+// 鋪銅 IR drop：讀入外框 / 焊墊 / 過孔描述檔 (文字或 JSON，格式見 PlaneDrop.h)，解出壓降分布
+class PlaneDropDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    PlaneDropDialog(UnitConverterHandler *sharedHandler, QWidget *parent = nullptr);
+    ~PlaneDropDialog();
+
+private:
+    UnitConverterHandler *handler;
+
+    QLineEdit *file_lineEdit = nullptr;
+    QLineEdit *cell_lineEdit = nullptr;
+    QLineEdit *temperature_lineEdit = nullptr;
+    QComboBox *view_comboBox = nullptr;
+    QPushButton *solve_button = nullptr;
+    QPushButton *export_button = nullptr;
+    QLabel *result_label = nullptr;
+    PlaneMapWidget *map = nullptr;
+
+    std::shared_ptr<const sc::PlaneDropResult> lastResult;
+
+    // 數百萬格要數秒，在工作執行緒上解
+    QThread *solveThread = nullptr;
+
+private slots:
+    void browse();
+    void solve();
+    void exportMap();
+};
+
+#endif // PLANEDROPDIALOG_H
@@ -0,0 +1,377 @@
+#include "PulseDialog.h"
+#include "MappedFile.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+enum Kind { TRACE, VIA };
+enum Wave { RECTANGULAR, EXPONENTIAL, PIECEWISE };
+
+// 匯入的波形超過這個點數時不放進文字框 (只顯示檔名)，直接使用檔案
+constexpr int MAX_EDITABLE_POINTS = 2000;
+
+} // namespace
+
+// --- PulseCurveWidget ---
+
+PulseCurveWidget::PulseCurveWidget(QWidget *parent) : QWidget(parent)
+{
+    setMinimumHeight(220);
+}
+
+void PulseCurveWidget::setHistory(std::vector<sc::PulseSample> h, double ambient_C)
+{
+    history = std::move(h);
+    ambient = ambient_C;
+    update();
+}
+
+void PulseCurveWidget::clear()
+{
+    history.clear();
+    update();
+}
+
+void PulseCurveWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), palette().base());
+    if (history.size() < 2) return;
+
+    const QRectF r = QRectF(contentsRect()).adjusted(50, 20, -10, -24);
+    const double t0 = history.front().time_s, t1 = history.back().time_s;
+    double top = ambient + 1;
+    for (const sc::PulseSample &s : history) top = std::max(top, s.temperature_C);
+    // 接近熔點時把熔點線一起畫進來
+    if (top > 0.5 * sc::COPPER_MELT_C) top = std::max(top, sc::COPPER_MELT_C);
+    top += 0.05 * (top - ambient);
+    auto x = [&](double t) { return r.left() + (t - t0) / (t1 - t0) * r.width(); };
+    auto y = [&](double T) { return r.bottom() - (T - ambient) / (top - ambient) * r.height(); };
+
+    p.setPen(palette().mid().color());
+    p.drawRect(r);
+    if (top >= sc::COPPER_MELT_C) {
+        p.setPen(QPen(Qt::red, 1, Qt::DashLine));
+        p.drawLine(QPointF(r.left(), y(sc::COPPER_MELT_C)), QPointF(r.right(), y(sc::COPPER_MELT_C)));
+    }
+
+    QPainterPath path(QPointF(x(t0), y(history.front().temperature_C)));
+    for (const sc::PulseSample &s : history) path.lineTo(x(s.time_s), y(s.temperature_C));
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(QPen(palette().highlight().color(), 1.5));
+    p.drawPath(path);
+
+    p.setPen(palette().text().color());
+    p.drawText(QRectF(0, r.top() - 8, r.left() - 4, 16), Qt::AlignRight | Qt::AlignVCenter,
+               QString::number(top, 'f', 0));
+    p.drawText(QRectF(0, r.bottom() - 8, r.left() - 4, 16), Qt::AlignRight | Qt::AlignVCenter,
+               QString::number(ambient, 'f', 0));
+    p.drawText(QRectF(r.left(), r.bottom() + 4, r.width(), 16), Qt::AlignRight | Qt::AlignTop,
+               tr("%1 s").arg(t1, 0, 'g', 4));
+    p.drawText(QRectF(r.left(), r.bottom() + 4, r.width(), 16), Qt::AlignLeft | Qt::AlignTop,
+               tr("%1 s").arg(t0, 0, 'g', 4));
+    p.drawText(QRectF(r.left() + 4, r.top() - 18, r.width(), 16), Qt::AlignLeft | Qt::AlignVCenter, tr("溫度 (°C)"));
+}
+
+// --- PulseDialog ---
+
+PulseDialog::PulseDialog(UnitConverterHandler *sharedHandler, QWidget *parent) :
+    QDialog(parent),
+    handler(sharedHandler)
+{
+    setWindowTitle(tr("脈衝 / 熔斷"));
+    resize(820, 680);
+
+    kind_comboBox = new QComboBox(this);
+    kind_comboBox->addItems({ tr("走線"), tr("貫孔") });
+    sizeA_label = new QLabel(this);
+    sizeB_label = new QLabel(this);
+    sizeC_label = new QLabel(this);
+    sizeA_lineEdit = new QLineEdit("0.5", this);
+    sizeB_lineEdit = new QLineEdit("35", this);
+    sizeC_lineEdit = new QLineEdit("20", this);
+    internal_checkBox = new QCheckBox(tr("內層"), this);
+    model_comboBox = new QComboBox(this);
+    model_comboBox->addItems({ tr("IPC-2221"), tr("IPC-2152") });
+    rise_lineEdit = new QLineEdit(QString::number(sc::THERMAL_RATING_RISE_C), this);
+    rise_lineEdit->setToolTip(tr("散熱熱阻取載流模型在這個溫升的工作點 (穩態時與走線 / 貫孔頁一致)"));
+    ambient_lineEdit = new QLineEdit(QString::number(sc::VIA_AMBIENT_C), this);
+    adiabatic_checkBox = new QCheckBox(tr("絕熱 (不散熱)"), this);
+    adiabatic_checkBox->setToolTip(tr("Onderdonk 的假設：脈衝短於熱時間常數時，散熱可以忽略"));
+
+    wave_comboBox = new QComboBox(this);
+    wave_comboBox->addItems({ tr("矩形脈衝"), tr("指數衰減 (湧浪)"), tr("分段線性 / 取樣檔") });
+    current_lineEdit = new QLineEdit("30", this);
+    width_lineEdit = new QLineEdit("10m", this);
+    width_lineEdit->setToolTip(tr("矩形脈衝的寬度或指數衰減的時間常數 (s，可用 m、u 後綴)"));
+    duration_lineEdit = new QLineEdit("50m", this);
+    duration_lineEdit->setToolTip(tr("模擬到這個時間 (s)，包含脈衝結束後的冷卻"));
+    points_edit = new QPlainTextEdit(this);
+    points_edit->setPlaceholderText(tr("每列 時間 (s), 電流 (A)；相同時間的兩列表示跳變\n0, 0\n0.1m, 80\n2m, 80\n2m, 0\n20m, 0"));
+    points_edit->setMaximumHeight(110);
+    load_button = new QPushButton(tr("開啟取樣檔..."), this);
+    result_label = new QLabel(this);
+    result_label->setWordWrap(true);
+    result_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    curve = new PulseCurveWidget(this);
+
+    QFormLayout *left = new QFormLayout;
+    left->addRow(tr("導體"), kind_comboBox);
+    left->addRow(sizeA_label, sizeA_lineEdit);
+    left->addRow(sizeB_label, sizeB_lineEdit);
+    left->addRow(sizeC_label, sizeC_lineEdit);
+    left->addRow(QString(), internal_checkBox);
+    QFormLayout *middle = new QFormLayout;
+    middle->addRow(tr("散熱模型"), model_comboBox);
+    middle->addRow(tr("額定溫升 (°C)"), rise_lineEdit);
+    middle->addRow(tr("環境溫度 (°C)"), ambient_lineEdit);
+    middle->addRow(QString(), adiabatic_checkBox);
+    QFormLayout *right = new QFormLayout;
+    right->addRow(tr("波形"), wave_comboBox);
+    right->addRow(tr("電流 (A)"), current_lineEdit);
+    right->addRow(tr("寬度 / 時間常數 (s)"), width_lineEdit);
+    right->addRow(tr("模擬時間 (s)"), duration_lineEdit);
+    QHBoxLayout *inputs = new QHBoxLayout;
+    inputs->addLayout(left);
+    inputs->addLayout(middle);
+    inputs->addLayout(right);
+    QHBoxLayout *points = new QHBoxLayout;
+    points->addWidget(points_edit, 1);
+    points->addWidget(load_button, 0, Qt::AlignTop);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(inputs);
+    layout->addLayout(points);
+    layout->addWidget(result_label);
+    layout->addWidget(curve, 1);
+
+    for (QLineEdit *e : { sizeA_lineEdit, sizeB_lineEdit, sizeC_lineEdit, rise_lineEdit, ambient_lineEdit,
+                          current_lineEdit, width_lineEdit, duration_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &PulseDialog::solve);
+    for (QCheckBox *c : { internal_checkBox, adiabatic_checkBox })
+        connect(c, &QCheckBox::toggled, this, &PulseDialog::solve);
+    connect(kind_comboBox, &QComboBox::currentIndexChanged, this, &PulseDialog::kindChanged);
+    connect(model_comboBox, &QComboBox::currentIndexChanged, this, &PulseDialog::solve);
+    connect(wave_comboBox, &QComboBox::currentIndexChanged, this, [this]() {
+        const bool piecewise = wave_comboBox->currentIndex() == PIECEWISE;
+        current_lineEdit->setEnabled(!piecewise);
+        width_lineEdit->setEnabled(!piecewise);
+        duration_lineEdit->setEnabled(!piecewise);
+        points_edit->setEnabled(piecewise);
+        load_button->setEnabled(piecewise);
+        solve();
+    });
+    connect(points_edit, &QPlainTextEdit::textChanged, this, &PulseDialog::solve);
+    connect(load_button, &QPushButton::clicked, this, &PulseDialog::loadWaveform);
+    points_edit->setEnabled(false);
+    load_button->setEnabled(false);
+
+    kindChanged();
+}
+
+PulseDialog::~PulseDialog()
+{
+    if (scaleThread) scaleThread->wait();
+}
+
+void PulseDialog::setTrace(double width_mm, double thickness_mm, double length_mm, bool internal, int modelIndex,
+                           double current_A, double ambient_C)
+{
+    const QSignalBlocker block(kind_comboBox);
+    kind_comboBox->setCurrentIndex(TRACE);
+    kindChanged();
+    if (width_mm > 0) sizeA_lineEdit->setText(QString::number(width_mm, 'g', 5));
+    if (thickness_mm > 0) sizeB_lineEdit->setText(QString::number(thickness_mm * 1000, 'g', 4));
+    if (length_mm > 0) sizeC_lineEdit->setText(QString::number(length_mm, 'g', 5));
+    internal_checkBox->setChecked(internal);
+    model_comboBox->setCurrentIndex(modelIndex);
+    rise_lineEdit->setText(QString::number(sc::THERMAL_RATING_RISE_C));
+    ambient_lineEdit->setText(QString::number(ambient_C));
+    if (current_A > 0) current_lineEdit->setText(QString::number(current_A, 'g', 5));
+}
+
+void PulseDialog::setVia(double diameter_mm, double wallThick_mm, double boardThick_mm, int modelIndex,
+                         double current_A, double ambient_C)
+{
+    const QSignalBlocker block(kind_comboBox);
+    kind_comboBox->setCurrentIndex(VIA);
+    kindChanged();
+    if (diameter_mm > 0) sizeA_lineEdit->setText(QString::number(diameter_mm, 'g', 5));
+    if (wallThick_mm > 0) sizeB_lineEdit->setText(QString::number(wallThick_mm * 1000, 'g', 4));
+    if (boardThick_mm > 0) sizeC_lineEdit->setText(QString::number(boardThick_mm, 'g', 5));
+    model_comboBox->setCurrentIndex(modelIndex);
+    rise_lineEdit->setText(QString::number(sc::THERMAL_RATING_RISE_C));
+    ambient_lineEdit->setText(QString::number(ambient_C));
+    if (current_A > 0) current_lineEdit->setText(QString::number(current_A, 'g', 5));
+}
+
+void PulseDialog::kindChanged()
+{
+    const bool trace = kind_comboBox->currentIndex() == TRACE;
+    sizeA_label->setText(trace ? tr("線寬 (mm)") : tr("孔徑 (mm)"));
+    sizeB_label->setText(trace ? tr("銅厚 (um)") : tr("孔壁 (um)"));
+    sizeC_label->setText(trace ? tr("長度 (mm)") : tr("板厚 (mm)"));
+    internal_checkBox->setEnabled(trace);
+    solve();
+}
+
+void PulseDialog::loadWaveform()
+{
+    const QString path = QFileDialog::getOpenFileName(this, tr("開啟電流波形"), QString(),
+                                                      tr("波形 (*.csv *.txt);;所有檔案 (*)"));
+    if (path.isEmpty()) return;
+    sc::MappedFile file;
+    sc::PulseWaveform w;
+    std::string error;
+    if (!file.open(path.toStdString())) {
+        result_label->setText(QString::fromStdString(file.errorString()));
+        return;
+    }
+    if (!sc::parsePulseWaveform(file.view(), w, error)) {
+        result_label->setText(tr("%1：%2").arg(path, QString::fromStdString(error)));
+        return;
+    }
+    if (static_cast<int>(w.time_s.size()) > MAX_EDITABLE_POINTS) {
+        // 示波器的取樣檔可能有上百萬點，文字框只放重新取樣後的摘要會失真，改為提示
+        result_label->setText(tr("%1 有 %2 點，超過文字框上限 %3 點，請以 sc_cli pulse 計算")
+                                  .arg(path).arg(w.time_s.size()).arg(MAX_EDITABLE_POINTS));
+        return;
+    }
+    QString text;
+    for (std::size_t i = 0; i < w.time_s.size(); ++i)
+        text += QString("%1, %2\n").arg(w.time_s[i], 0, 'g', 9).arg(w.current_A[i], 0, 'g', 9);
+    points_edit->setPlainText(text);
+}
+
+bool PulseDialog::conductor(sc::PulseConductor &c, QString &error) const
+{
+    bool okA, okB, okC, okR, okT;
+    const double a = handler->parseValue(sizeA_lineEdit->text(), &okA);
+    const double b = handler->parseValue(sizeB_lineEdit->text(), &okB) / 1000;
+    const double len = handler->parseValue(sizeC_lineEdit->text(), &okC);
+    const double rise = handler->parseValue(rise_lineEdit->text(), &okR);
+    const double ambient = handler->parseValue(ambient_lineEdit->text(), &okT);
+    if (!okA || !okB || !okC || !okR || !okT || !(a > 0) || !(b > 0) || !(len > 0) || !(rise > 0) ||
+        !(ambient < sc::COPPER_MELT_C)) {
+        error = tr("請輸入正的尺寸與額定溫升");
+        return false;
+    }
+    const sc::TraceModel model = model_comboBox->currentIndex() == 1 ? sc::TraceModel::IPC2152
+                                                                      : sc::TraceModel::IPC2221;
+    c = (kind_comboBox->currentIndex() == TRACE)
+            ? sc::tracePulseConductor(a, b, len, internal_checkBox->isChecked(), model, sc::Ipc2152Options(), rise,
+                                      ambient)
+            : sc::viaPulseConductor(a, b, len, model, rise, ambient);
+    if (adiabatic_checkBox->isChecked()) c.theta_C_per_W = 0;
+    return true;
+}
+
+bool PulseDialog::waveform(sc::PulseWaveform &w, QString &error) const
+{
+    if (wave_comboBox->currentIndex() == PIECEWISE) {
+        std::string e;
+        if (!sc::parsePulseWaveform(points_edit->toPlainText().toStdString(), w, e)) {
+            error = QString::fromStdString(e);
+            return false;
+        }
+        return true;
+    }
+    bool okI, okW, okD;
+    const double current = handler->parseValue(current_lineEdit->text(), &okI);
+    const double width = handler->parseValue(width_lineEdit->text(), &okW);
+    const double duration = handler->parseValue(duration_lineEdit->text(), &okD);
+    if (!okI || !okW || !okD || !(width > 0) || !(duration > 0)) {
+        error = tr("請輸入電流、正的寬度 / 時間常數與模擬時間");
+        return false;
+    }
+    w = (wave_comboBox->currentIndex() == RECTANGULAR) ? sc::rectangularPulse(current, width, duration)
+                                                       : sc::exponentialPulse(current, width, duration);
+    return true;
+}
+
+void PulseDialog::solve()
+{
+    ++inputGeneration;
+    scalePending = false;
+    sc::PulseConductor c;
+    sc::PulseWaveform w;
+    QString error;
+    if (!conductor(c, error) || !waveform(w, error)) {
+        result_label->setText(error);
+        curve->clear();
+        return;
+    }
+
+    sc::PulseOptions opt;
+    opt.recordHistory = true;
+    sc::PulseResult r = sc::pulseSolve(w, c, opt);
+    if (!r.valid) {
+        result_label->setText(tr("無法計算"));
+        curve->clear();
+        return;
+    }
+
+    double peakCurrent = 0;
+    for (double I : w.current_A) peakCurrent = std::max(peakCurrent, std::abs(I));
+    const double tau = c.theta_C_per_W * sc::COPPER_HEAT_CAPACITY_J_PER_MM3K * c.area_mm2 * c.length_mm;
+
+    QString text = r.fused ? tr("<b><font color=red>%1 s 時熔斷</font></b>").arg(r.fuseTime_s, 0, 'g', 4)
+                           : tr("峰值 %1 °C (%2 s)，結束時 %3 °C").arg(r.peak_C, 0, 'f', 1)
+                                 .arg(r.peakTime_s, 0, 'g', 4).arg(r.final_C, 0, 'f', 1);
+    text += tr("<br>I²t %1 A²s，截面積 %2 mm²").arg(r.i2t_A2s, 0, 'g', 4).arg(c.area_mm2, 0, 'g', 4);
+    if (peakCurrent > 0) {
+        text += tr("<br>Onderdonk (絕熱) 在峰值電流下 %1 s 熔斷；Preece 長時間熔斷電流 %2 A")
+                    .arg(sc::onderdonkFusingTime(peakCurrent, c.area_mm2, c.ambient_C), 0, 'g', 4)
+                    .arg(sc::preeceFusingCurrent(c.area_mm2), 0, 'g', 4);
+    }
+    text += (c.theta_C_per_W > 0) ? tr("<br>熱阻 %1 °C/W，熱時間常數 %2 s").arg(c.theta_C_per_W, 0, 'g', 4)
+                                         .arg(tau, 0, 'g', 4)
+                                  : tr("<br>絕熱");
+    text += tr("，%1 步 (%2 次重算)").arg(r.steps).arg(r.rejected);
+    if (!r.completed) text += tr("<br>步數用完，結果不完整");
+    resultText = text;
+    result_label->setText(text + tr("<br>熔斷倍數計算中..."));
+    curve->setHistory(std::move(r.history), c.ambient_C);
+
+    scaleWave = std::move(w);
+    scaleConductor = c;
+    if (scaleThread) scalePending = true;
+    else startScale();
+}
+
+void PulseDialog::startScale()
+{
+    scalePending = false;
+    const unsigned generation = inputGeneration;
+    scaleThread = QThread::create([this, wave = scaleWave, c = scaleConductor, generation]() {
+        const double scale = sc::pulseFusingScale(wave, c);
+        QMetaObject::invokeMethod(this, [this, scale, generation]() {
+            if (generation != inputGeneration) return;
+            result_label->setText(std::isfinite(scale)
+                                      ? resultText + tr("<br>波形放大 %1 倍時熔斷").arg(scale, 0, 'g', 4)
+                                      : resultText);
+        }, Qt::QueuedConnection);
+    });
+    connect(scaleThread, &QThread::finished, this, [this]() {
+        scaleThread->deleteLater();
+        scaleThread = nullptr;
+        if (scalePending) startScale();
+    });
+    scaleThread->start();
+}
@@ -0,0 +1,99 @@
+#ifndef PULSEDIALOG_H
+#define PULSEDIALOG_H
+
+#include <QDialog>
+#include <QWidget>
+#include "UnitConverterHandler.h"
+#include "PulseFusing.h"
+
+#include <vector>
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPlainTextEdit;
+class QPushButton;
+class QThread;
+
+// 溫度 - 時間曲線，虛線為銅的熔點
+class PulseCurveWidget : public QWidget
+{
+public:
+    explicit PulseCurveWidget(QWidget *parent = nullptr);
+
+    void setHistory(std::vector<sc::PulseSample> history, double ambient_C);
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    std::vector<sc::PulseSample> history;
+    double ambient = 0;
+};
+
+// 脈衝 / 故障電流：走線或貫孔在湧浪、短路電流下的溫度與熔斷時間 (集總 RC + 自動步長 ODE)
+// 走線頁、貫孔頁開啟時帶入目前的導體；單次積分不到一毫秒，輸入時即時更新，
+// 熔斷倍數要數十次積分，在工作執行緒上算完再補上
+class PulseDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    PulseDialog(UnitConverterHandler *sharedHandler, QWidget *parent = nullptr);
+    ~PulseDialog();
+
+    // 額定溫升重設為 THERMAL_RATING_RISE_C、環境溫度取呼叫端頁面的，穩態才會與該頁的自洽溫升相同
+    void setTrace(double width_mm, double thickness_mm, double length_mm, bool internal, int modelIndex,
+                  double current_A, double ambient_C);
+    void setVia(double diameter_mm, double wallThick_mm, double boardThick_mm, int modelIndex, double current_A,
+                double ambient_C);
+
+private:
+    UnitConverterHandler *handler;
+
+    QComboBox *kind_comboBox = nullptr;
+    QLabel *sizeA_label = nullptr;
+    QLabel *sizeB_label = nullptr;
+    QLabel *sizeC_label = nullptr;
+    QLineEdit *sizeA_lineEdit = nullptr;        // 線寬 / 孔徑 (mm)
+    QLineEdit *sizeB_lineEdit = nullptr;        // 銅厚 / 孔壁 (um)
+    QLineEdit *sizeC_lineEdit = nullptr;        // 長度 / 板厚 (mm)
+    QCheckBox *internal_checkBox = nullptr;
+    QComboBox *model_comboBox = nullptr;
+    QLineEdit *rise_lineEdit = nullptr;
+    QLineEdit *ambient_lineEdit = nullptr;
+    QCheckBox *adiabatic_checkBox = nullptr;
+
+    QComboBox *wave_comboBox = nullptr;
+    QLineEdit *current_lineEdit = nullptr;
+    QLineEdit *width_lineEdit = nullptr;
+    QLineEdit *duration_lineEdit = nullptr;
+    QPlainTextEdit *points_edit = nullptr;
+    QPushButton *load_button = nullptr;
+
+    QLabel *result_label = nullptr;
+    PulseCurveWidget *curve = nullptr;
+
+    // 熔斷倍數 (pulseFusingScale) 的工作執行緒；計算期間輸入變更時記下 scalePending，結束後以最新的輸入重算
+    QThread *scaleThread = nullptr;
+    bool scalePending = false;
+    sc::PulseWaveform scaleWave;
+    sc::PulseConductor scaleConductor;
+    QString resultText;                         // 不含熔斷倍數的結果
+
+    // 輸入每變更一次加一；結果回來時與開始時不同就丟棄
+    unsigned inputGeneration = 0;
+
+    bool conductor(sc::PulseConductor &c, QString &error) const;
+    bool waveform(sc::PulseWaveform &w, QString &error) const;
+    void startScale();
+
+private slots:
+    void kindChanged();
+    void loadWaveform();
+    void solve();
+};
+
+#endif // PULSEDIALOG_H
@@ -1,6 +1,8 @@
 #include "ResCap_Conversion.h"
 #include "ui_ResCap_Conversion.h"
 
+#include "SmdCode.h"
+
 
 ResCap_Conversion::ResCap_Conversion(UnitConverterHandler *sharedHandler, QWidget *parent) :
     QWidget(parent),
@@ -36,10 +38,7 @@ void ResCap_Conversion::updateSMDResistor() {
 
 
     int unitIdx = ui->Resistor_output_comboBox->currentIndex();
-    double finalVal = baseValue;
-
-    if (unitIdx == 1) finalVal = baseValue / 1000.0;       // kΩ
-    else if (unitIdx == 2) finalVal = baseValue / 1000000.0; // MΩ
+    double finalVal = ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(baseValue), unitIdx);
 
     ui->Resistor_output_lineEdit->setText(QString::number(finalVal, 'g', 6));
 }
@@ -50,43 +49,15 @@ void ResCap_Conversion::updateSMDCapacitor() {
     double baseValue = decodeSMDCode(code); // 算出是多少 pF
 
     int unitIdx = ui->capacitor_output_comboBox->currentIndex();
-    double finalVal = baseValue;
-
-    if (unitIdx == 1) finalVal = baseValue / 1000.0;       // nF
-    else if (unitIdx == 2) finalVal = baseValue / 1000000.0; // μF
+    double finalVal = CapacitorUnitList::to(sc::units::quantity<sc::units::pF>(baseValue), unitIdx);
 
     ui->capacitor_output_lineEdit->setText(QString::number(finalVal, 'g', 6));
 }
 
 
 
-double ResCap_Conversion::decodeSMDCode(QString code) {
-    if (code.isEmpty()) return 0;
-
-    // 1. 處理帶有小數點代碼的情況
-    // 電阻常用 R (4R7), 電容常用 p (4p7) 或 n (1n2)
-    if (code.contains('R', Qt::CaseInsensitive) ||
-        code.contains('P', Qt::CaseInsensitive) ||
-        code.contains('N', Qt::CaseInsensitive)) {
-
-        QString temp = code;
-        temp.replace('R', '.', Qt::CaseInsensitive);
-        temp.replace('P', '.', Qt::CaseInsensitive);
-        temp.replace('N', '.', Qt::CaseInsensitive);
-        return temp.toDouble();
-    }
-
-    // 2. 處理標準三位數代碼 (如 103)
-    if (code.length() >= 3) {
-        // 使用 last(1) 取代 right(1)，避免 Clazy 警告
-        int exponent = code.last(1).toInt();
-
-        // 使用 chopped(1) 取得除了最後一碼以外的部分，取代 left()，效能更好
-        double prefix = code.chopped(1).toDouble();
-
-        // 核心演算法：前兩位 * 10的(第三位)次方
-        return prefix * std::pow(10, exponent);
-    }
-
-    return code.toDouble(); // 如果是兩位數，直接視為數值
+double ResCap_Conversion::decodeSMDCode(const QString &code) {
+    // 解析邏輯在 sc_core (SmdCode.cpp)，這裡只負責 QString -> UTF-8
+    const QByteArray utf8 = code.toUtf8();
+    return sc::decodeSmdCode(std::string_view(utf8.constData(), static_cast<size_t>(utf8.size())));
 }
@@ -26,7 +26,7 @@ private:
 
     void updateSMDCapacitor();
     void updateSMDResistor();
-    double decodeSMDCode(QString code);
+    double decodeSMDCode(const QString &code);
 
 };
 
@@ -0,0 +1,286 @@
+#include "ThermalViaDialog.h"
+
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace {
+
+enum Column { POWER, PAD_RISE, PEAK_RISE, THETA_BOTTOM, THETA_AMBIENT, VIA_MAX, VIA_MIN, BARREL, COLUMN_COUNT };
+
+enum Source { UNIFORM_PAD, CENTER_HOTSPOT };
+
+// 塞孔材料的熱傳導係數 (W/(m·K))
+struct FillMaterial {
+    const char *name;
+    double k;
+};
+constexpr FillMaterial FILLS[] = {
+    { QT_TRANSLATE_NOOP("ThermalViaDialog", "不塞孔 (空氣)"), 0 },
+    { QT_TRANSLATE_NOOP("ThermalViaDialog", "樹脂塞孔"), 0.25 },
+    { QT_TRANSLATE_NOOP("ThermalViaDialog", "導熱膠塞孔"), 5 },
+    { QT_TRANSLATE_NOOP("ThermalViaDialog", "填銅"), 385 },
+};
+
+// 陣列上限：節點 x 頻寬決定分解時間與記憶體
+constexpr int MAX_VIAS = 40000;
+
+} // namespace
+
+ThermalViaDialog::ThermalViaDialog(UnitConverterHandler *sharedHandler, QWidget *parent) :
+    QDialog(parent),
+    handler(sharedHandler)
+{
+    setWindowTitle(tr("散熱孔熱阻"));
+    resize(860, 600);
+
+    const sc::ThermalViaArray array;
+    const sc::ThermalViaBoundary boundary;
+    rows_lineEdit = new QLineEdit(QString::number(array.rows), this);
+    cols_lineEdit = new QLineEdit(QString::number(array.cols), this);
+    pitch_lineEdit = new QLineEdit(QString::number(array.pitch_mm), this);
+    drill_lineEdit = new QLineEdit(QString::number(array.drill_mm), this);
+    wall_lineEdit = new QLineEdit(QString::number(array.wall_mm * 1000), this);
+    fill_comboBox = new QComboBox(this);
+    for (const FillMaterial &f : FILLS) fill_comboBox->addItem(tr(f.name));
+    layers_lineEdit = new QLineEdit("4", this);
+    board_lineEdit = new QLineEdit("1.6", this);
+    outer_lineEdit = new QLineEdit("35", this);
+    inner_lineEdit = new QLineEdit("35", this);
+    coverage_lineEdit = new QLineEdit("1", this);
+    coverage_lineEdit->setToolTip(tr("內層銅在焊墊範圍內的覆蓋率 (0 ~ 1)，完整的電源 / 地平面為 1"));
+    solder_lineEdit = new QLineEdit(QString::number(boundary.solder_mm * 1000), this);
+    bottom_lineEdit = new QLineEdit(this);
+    bottom_lineEdit->setPlaceholderText(tr("理想散熱器"));
+    bottom_lineEdit->setToolTip(tr("底層銅到散熱器 / 環境的熱傳係數 (W/(m²·K))，空白 = 底層固定在參考溫度"));
+    powers_lineEdit = new QLineEdit("0.5, 1, 2, 5", this);
+    powers_lineEdit->setToolTip(tr("焊墊功率 (W)，以逗號分隔；只需要回代，輸入時即時更新"));
+    source_comboBox = new QComboBox(this);
+    source_comboBox->addItems({ tr("等溫焊墊"), tr("中央熱點") });
+    source_comboBox->setToolTip(tr("中央熱點：晶片比焊墊小，功率集中在陣列中央的單元，焊墊只負責橫向擴散"));
+    build_button = new QPushButton(tr("計算"), this);
+    result_label = new QLabel(this);
+    result_label->setWordWrap(true);
+    result_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    table = new QTableWidget(0, COLUMN_COUNT, this);
+    table->setHorizontalHeaderLabels({ tr("功率 (W)"), tr("焊墊溫升 (°C)"), tr("最高溫升 (°C)"),
+                                       tr("θ 熱源-底層 (°C/W)"), tr("θ 熱源-參考 (°C/W)"), tr("孔壁最大 (W)"),
+                                       tr("孔壁最小 (W)"), tr("孔壁 / 塞孔佔比") });
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    QFormLayout *left = new QFormLayout;
+    QHBoxLayout *grid = new QHBoxLayout;
+    grid->addWidget(rows_lineEdit);
+    grid->addWidget(new QLabel("x", this));
+    grid->addWidget(cols_lineEdit);
+    left->addRow(tr("孔數 (列 x 行)"), grid);
+    left->addRow(tr("中心距 (mm)"), pitch_lineEdit);
+    left->addRow(tr("孔徑 (mm)"), drill_lineEdit);
+    left->addRow(tr("孔壁 (um)"), wall_lineEdit);
+    left->addRow(tr("塞孔"), fill_comboBox);
+    left->addRow(tr("焊錫厚度 (um)"), solder_lineEdit);
+    QFormLayout *right = new QFormLayout;
+    right->addRow(tr("銅層數"), layers_lineEdit);
+    right->addRow(tr("板厚 (mm)"), board_lineEdit);
+    right->addRow(tr("外層銅厚 (um)"), outer_lineEdit);
+    right->addRow(tr("內層銅厚 (um)"), inner_lineEdit);
+    right->addRow(tr("內層覆蓋率"), coverage_lineEdit);
+    right->addRow(tr("底面 h (W/(m²·K))"), bottom_lineEdit);
+    QHBoxLayout *inputs = new QHBoxLayout;
+    inputs->addLayout(left);
+    inputs->addLayout(right);
+    QHBoxLayout *powers = new QHBoxLayout;
+    powers->addWidget(new QLabel(tr("功率 (W)"), this));
+    powers->addWidget(powers_lineEdit, 1);
+    powers->addWidget(source_comboBox);
+    powers->addWidget(build_button);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(inputs);
+    layout->addLayout(powers);
+    layout->addWidget(new QLabel(tr("只計陣列 (焊墊) 範圍內的疊構，陣列外的銅平面擴散不計，結果偏保守"), this));
+    layout->addWidget(result_label);
+    layout->addWidget(table, 1);
+
+    // 幾何或疊構改變時舊的分解 (以及正在進行的分解) 就不能用了
+    auto invalidate = [this]() {
+        ++inputGeneration;
+        if (!field && !buildThread) return;
+        field.reset();
+        table->setRowCount(0);
+        result_label->setText(tr("輸入已變更，請按「計算」"));
+    };
+    for (QLineEdit *e : { rows_lineEdit, cols_lineEdit, pitch_lineEdit, drill_lineEdit, wall_lineEdit,
+                          layers_lineEdit, board_lineEdit, outer_lineEdit, inner_lineEdit, coverage_lineEdit,
+                          solder_lineEdit, bottom_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, invalidate);
+    connect(fill_comboBox, &QComboBox::currentIndexChanged, this, invalidate);
+    connect(powers_lineEdit, &QLineEdit::textChanged, this, &ThermalViaDialog::updatePowers);
+    connect(source_comboBox, &QComboBox::currentIndexChanged, this, &ThermalViaDialog::updatePowers);
+    connect(build_button, &QPushButton::clicked, this, &ThermalViaDialog::build);
+
+    build();
+}
+
+ThermalViaDialog::~ThermalViaDialog()
+{
+    if (buildThread) buildThread->wait();
+}
+
+void ThermalViaDialog::setVia(double drill_mm, double wall_mm, double board_mm, double copper_mm)
+{
+    if (drill_mm > 0) drill_lineEdit->setText(QString::number(drill_mm, 'g', 5));
+    if (wall_mm > 0) wall_lineEdit->setText(QString::number(wall_mm * 1000, 'g', 4));
+    if (board_mm > 0) board_lineEdit->setText(QString::number(board_mm, 'g', 5));
+    if (copper_mm > 0) outer_lineEdit->setText(QString::number(copper_mm * 1000, 'g', 4));
+    if (!field && !buildThread) build();
+}
+
+void ThermalViaDialog::build()
+{
+    if (buildThread) return;
+
+    bool ok[12];
+    const double rows = handler->parseValue(rows_lineEdit->text(), &ok[0]);
+    const double cols = handler->parseValue(cols_lineEdit->text(), &ok[1]);
+    sc::ThermalViaArray array;
+    array.pitch_mm = handler->parseValue(pitch_lineEdit->text(), &ok[2]);
+    array.drill_mm = handler->parseValue(drill_lineEdit->text(), &ok[3]);
+    array.wall_mm = handler->parseValue(wall_lineEdit->text(), &ok[4]) / 1000;
+    array.kFill = FILLS[std::max(fill_comboBox->currentIndex(), 0)].k;
+    const double layers = handler->parseValue(layers_lineEdit->text(), &ok[5]);
+    const double board = handler->parseValue(board_lineEdit->text(), &ok[6]);
+    const double outer = handler->parseValue(outer_lineEdit->text(), &ok[7]) / 1000;
+    const double inner = handler->parseValue(inner_lineEdit->text(), &ok[8]) / 1000;
+    const double coverage = handler->parseValue(coverage_lineEdit->text(), &ok[9]);
+    sc::ThermalViaBoundary boundary;
+    boundary.solder_mm = handler->parseValue(solder_lineEdit->text(), &ok[10]) / 1000;
+    ok[11] = true;
+    if (!bottom_lineEdit->text().trimmed().isEmpty())
+        boundary.hBottom = handler->parseValue(bottom_lineEdit->text(), &ok[11]);
+
+    table->setRowCount(0);
+    if (std::find(std::begin(ok), std::end(ok), false) != std::end(ok)) {
+        result_label->setText(tr("請輸入所有欄位 (底面 h 可以空白)"));
+        return;
+    }
+    if (!(rows >= 1) || !(cols >= 1) || rows * cols > MAX_VIAS || !(layers >= 2) || layers > 64) {
+        result_label->setText(tr("孔數需為 1 ~ %1 顆，銅層數 2 ~ 64").arg(MAX_VIAS));
+        return;
+    }
+    array.rows = static_cast<int>(rows);
+    array.cols = static_cast<int>(cols);
+    const sc::ThermalViaStack stack = sc::evenThermalStack(static_cast<int>(layers), board, outer, inner, coverage);
+    if (!(stack.dielectric_mm.front() > 0)) {
+        result_label->setText(tr("板厚必須大於銅厚總和"));
+        return;
+    }
+
+    build_button->setEnabled(false);
+    build_button->setText(tr("分解中..."));
+
+    const unsigned generation = inputGeneration;
+    buildThread = QThread::create([this, stack, array, boundary, generation]() {
+        QElapsedTimer timer;
+        timer.start();
+        auto f = std::make_shared<const sc::ThermalViaField>(stack, array, boundary);
+        const double elapsed = timer.nsecsElapsed() / 1e6;
+        QMetaObject::invokeMethod(this, [this, f, array, elapsed, generation]() {
+            if (generation != inputGeneration) {
+                field.reset();
+                table->setRowCount(0);
+                result_label->setText(tr("輸入已變更，請按「計算」"));
+                return;
+            }
+            if (!f->valid()) {
+                field.reset();
+                result_label->setText(tr("無法建立熱阻網路：中心距必須大於孔外徑，各厚度必須是正數"));
+                return;
+            }
+            field = f;
+            fieldRows = array.rows;
+            fieldCols = array.cols;
+            fieldLayers = f->layers();
+            result_label->setText(tr("%1 x %2 顆，%3 層銅：%4 個節點，頻寬 %5，分解 %6 ms")
+                                      .arg(array.rows).arg(array.cols).arg(f->layers()).arg(f->nodes())
+                                      .arg(f->bandwidth()).arg(elapsed, 0, 'f', 1));
+            updatePowers();
+        }, Qt::QueuedConnection);
+    });
+    connect(buildThread, &QThread::finished, this, [this]() {
+        buildThread->deleteLater();
+        buildThread = nullptr;
+        build_button->setEnabled(true);
+        build_button->setText(tr("計算"));
+    });
+    buildThread->start();
+}
+
+void ThermalViaDialog::updatePowers()
+{
+    table->setRowCount(0);
+    if (!field) return;
+
+    QList<double> powers;
+    for (const QString &p : powers_lineEdit->text().split(',', Qt::SkipEmptyParts)) {
+        bool ok;
+        const double w = handler->parseValue(p.trimmed(), &ok);
+        if (ok && w > 0) powers.append(w);
+    }
+
+    // 中央熱點：奇數邊取中間一格，偶數邊取中間兩格
+    std::vector<double> share;
+    if (source_comboBox->currentIndex() == CENTER_HOTSPOT) {
+        share.assign(static_cast<std::size_t>(fieldRows) * fieldCols, 0.0);
+        const int r0 = (fieldRows - 1) / 2, r1 = fieldRows / 2;
+        const int c0 = (fieldCols - 1) / 2, c1 = fieldCols / 2;
+        const double part = 1.0 / ((r1 - r0 + 1) * (c1 - c0 + 1));
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) share[static_cast<std::size_t>(r) * fieldCols + c] = part;
+        }
+    }
+
+    table->setRowCount(static_cast<int>(powers.size()));
+    for (int row = 0; row < powers.size(); ++row) {
+        const double power = powers[row];
+        std::vector<double> heat(share.size());
+        for (std::size_t k = 0; k < share.size(); ++k) heat[k] = share[k] * power;
+        const sc::ThermalViaSolution s = heat.empty() ? field->solve(power) : field->solve(0, heat);
+
+        // 最高溫：焊墊或頂層任一單元 (中央熱點時在熱點下方)
+        double peak = s.padRise_C;
+        for (std::size_t k = 0; k < s.viaHeat_W.size(); ++k) peak = std::max(peak, s.rise_C[k * fieldLayers]);
+        const double offset = (peak - s.padRise_C) / s.totalPower_W;
+        const auto [lo, hi] = std::minmax_element(s.viaBarrelHeat_W.begin(), s.viaBarrelHeat_W.end());
+        double barrel = 0;
+        for (double q : s.viaBarrelHeat_W) barrel += q;
+        const QString cells[COLUMN_COUNT] = {
+            QString::number(power, 'g', 4),
+            QString::number(s.padRise_C, 'f', 2),
+            QString::number(peak, 'f', 2),
+            QString::number(s.thetaPadBottom + offset, 'f', 3),
+            QString::number(s.thetaPadAmbient + offset, 'f', 3),
+            QString::number(*hi, 'g', 4),
+            QString::number(*lo, 'g', 4),
+            QString::number(100 * barrel / s.totalPower_W, 'f', 1) + "%",
+        };
+        for (int c = 0; c < COLUMN_COUNT; ++c) {
+            QTableWidgetItem *item = new QTableWidgetItem(cells[c]);
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            table->setItem(row, c, item);
+        }
+    }
+}
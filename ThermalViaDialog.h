@@ -0,0 +1,68 @@
+#ifndef THERMALVIADIALOG_H
+#define THERMALVIADIALOG_H
+
+#include <QDialog>
+#include "UnitConverterHandler.h"
+#include "ThermalVia.h"
+
+#include <memory>
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QTableWidget;
+class QThread;
+
+// 散熱孔陣列的熱阻：焊墊下方 N x M 顆貫孔穿過疊構，求 θ(焊墊 -> 底層) 與各孔的熱流
+// 幾何 / 疊構變更時重新分解 (工作執行緒)；功率清單只做前代回代，輸入時即時更新
+class ThermalViaDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    ThermalViaDialog(UnitConverterHandler *sharedHandler, QWidget *parent = nullptr);
+    ~ThermalViaDialog();
+
+    void setVia(double drill_mm, double wall_mm, double board_mm, double copper_mm);
+
+private:
+    UnitConverterHandler *handler;
+
+    QLineEdit *rows_lineEdit = nullptr;
+    QLineEdit *cols_lineEdit = nullptr;
+    QLineEdit *pitch_lineEdit = nullptr;
+    QLineEdit *drill_lineEdit = nullptr;
+    QLineEdit *wall_lineEdit = nullptr;
+    QComboBox *fill_comboBox = nullptr;
+    QLineEdit *layers_lineEdit = nullptr;
+    QLineEdit *board_lineEdit = nullptr;
+    QLineEdit *outer_lineEdit = nullptr;
+    QLineEdit *inner_lineEdit = nullptr;
+    QLineEdit *coverage_lineEdit = nullptr;
+    QLineEdit *solder_lineEdit = nullptr;
+    QLineEdit *bottom_lineEdit = nullptr;
+    QLineEdit *powers_lineEdit = nullptr;
+    QComboBox *source_comboBox = nullptr;
+    QPushButton *build_button = nullptr;
+    QLabel *result_label = nullptr;
+    QTableWidget *table = nullptr;
+
+    // 分解後的網路，功率變更時共用
+    std::shared_ptr<const sc::ThermalViaField> field;
+    int fieldRows = 0;
+    int fieldCols = 0;
+    int fieldLayers = 0;
+
+    // 數千顆孔的分解要數百毫秒，在工作執行緒上做
+    QThread *buildThread = nullptr;
+
+    // 幾何 / 疊構每變更一次加一；分解完成時與開始時不同就丟棄結果 (分解期間輸入被改過)
+    unsigned inputGeneration = 0;
+
+private slots:
+    void build();
+    void updatePowers();
+};
+
+#endif // THERMALVIADIALOG_H
@@ -0,0 +1,266 @@
+#include "TraceThermalDialog.h"
+#include "TraceCalc.h"
+
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QFormLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPainter>
+#include <QPushButton>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 解析度：走線寬度方向格數、銅厚方向格數、走線外的放大倍率
+struct Resolution {
+    int cellsAcrossTrace;
+    int cellsPerCopper;
+    double grading;
+};
+constexpr Resolution RESOLUTIONS[] = { { 16, 2, 1.2 }, { 32, 4, 1.1 }, { 96, 8, 1.05 } };
+
+// 熱圖視窗：走線中心左右各 max(3 倍線寬, 1.5 倍板厚)
+constexpr double VIEW_TRACE_WIDTHS = 3;
+constexpr double VIEW_BOARD_THICKNESS = 1.5;
+
+// 以格子邊界找座標所在的格子
+int cellIndex(const std::vector<double> &edges, double v)
+{
+    const auto it = std::upper_bound(edges.begin(), edges.end(), v);
+    const int i = static_cast<int>(it - edges.begin()) - 1;
+    return std::clamp(i, 0, static_cast<int>(edges.size()) - 2);
+}
+
+} // namespace
+
+// --- HeatMapWidget ---
+
+HeatMapWidget::HeatMapWidget(QWidget *parent) : QWidget(parent)
+{
+    setMinimumHeight(220);
+}
+
+void HeatMapWidget::setResult(const sc::TraceThermalResult &r, const sc::TraceThermalGeometry &g)
+{
+    result = r;
+    geometry = g;
+    render();
+    update();
+}
+
+void HeatMapWidget::clear()
+{
+    result = sc::TraceThermalResult();
+    image = QImage();
+    update();
+}
+
+void HeatMapWidget::resizeEvent(QResizeEvent *)
+{
+    render();
+}
+
+void HeatMapWidget::render()
+{
+    image = QImage();
+    const std::vector<double> &xe = result.xEdges_mm;
+    const std::vector<double> &ye = result.yEdges_mm;
+    if (result.rise_C.empty() || xe.size() < 2 || ye.size() < 2 || !(result.maxRise_C > 0)) return;
+
+    const double halfView = std::min(std::max(VIEW_TRACE_WIDTHS * geometry.traceWidth_mm,
+                                              VIEW_BOARD_THICKNESS * geometry.boardThickness_mm),
+                                     -xe.front());
+    const double yTop = ye.back();
+    const QSize size = contentsRect().size();
+    if (size.width() <= 0 || size.height() <= 0) return;
+
+    // 等比例縮放 (x、y 同一個 mm/像素)
+    const double scale = std::min(size.width() / (2 * halfView), size.height() / yTop);
+    const int w = std::max(1, static_cast<int>(2 * halfView * scale));
+    const int h = std::max(1, static_cast<int>(yTop * scale));
+    std::vector<int> column(w), row(h);
+    for (int px = 0; px < w; ++px) column[px] = cellIndex(xe, -halfView + (px + 0.5) / scale);
+    for (int py = 0; py < h; ++py) row[py] = cellIndex(ye, yTop - (py + 0.5) / scale);
+
+    image = QImage(w, h, QImage::Format_RGB32);
+    for (int py = 0; py < h; ++py) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(py));
+        const double *rise = &result.rise_C[static_cast<std::size_t>(row[py]) * result.nx];
+        for (int px = 0; px < w; ++px) {
+            const double t = std::clamp(rise[column[px]] / result.maxRise_C, 0.0, 1.0);
+            line[px] = QColor::fromHsvF(0.66 * (1 - t), 0.85, 0.95).rgb();
+        }
+    }
+}
+
+void HeatMapWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), palette().base());
+    if (image.isNull()) return;
+
+    const QRect r = contentsRect();
+    const QPoint origin(r.left() + (r.width() - image.width()) / 2, r.top() + (r.height() - image.height()) / 2);
+    p.drawImage(origin, image);
+
+    // 走線輪廓
+    const double halfView = std::min(std::max(VIEW_TRACE_WIDTHS * geometry.traceWidth_mm,
+                                              VIEW_BOARD_THICKNESS * geometry.boardThickness_mm),
+                                     -result.xEdges_mm.front());
+    const double scale = image.width() / (2 * halfView);
+    const double yTop = result.yEdges_mm.back();
+    const double traceBottom = geometry.internal ? 0.5 * (geometry.boardThickness_mm - geometry.traceThickness_mm)
+                                                 : geometry.boardThickness_mm;
+    const QRectF trace(origin.x() + (halfView - 0.5 * geometry.traceWidth_mm) * scale,
+                       origin.y() + (yTop - traceBottom - geometry.traceThickness_mm) * scale,
+                       geometry.traceWidth_mm * scale, geometry.traceThickness_mm * scale);
+    p.setPen(QPen(Qt::black, 1));
+    p.drawRect(trace);
+
+    p.setPen(palette().text().color());
+    p.drawText(r.adjusted(4, 2, -4, 0), Qt::AlignLeft | Qt::AlignTop,
+               tr("最高溫升 %1 °C").arg(result.maxRise_C, 0, 'g', 4));
+}
+
+// --- TraceThermalDialog ---
+
+TraceThermalDialog::TraceThermalDialog(UnitConverterHandler *sharedHandler, QWidget *parent) :
+    QDialog(parent),
+    handler(sharedHandler)
+{
+    setWindowTitle(tr("走線截面熱分析 (2D)"));
+    resize(560, 640);
+
+    const sc::TraceThermalGeometry geometry;
+    const sc::TraceThermalMaterial material;
+    width_lineEdit = new QLineEdit(QString::number(geometry.traceWidth_mm), this);
+    thickness_lineEdit = new QLineEdit(QString::number(geometry.traceThickness_mm), this);
+    current_lineEdit = new QLineEdit("1", this);
+    layer_comboBox = new QComboBox(this);
+    layer_comboBox->addItems({ tr("外層"), tr("內層 (板厚中央)") });
+    board_lineEdit = new QLineEdit(QString::number(geometry.boardThickness_mm), this);
+    plane_lineEdit = new QLineEdit(this);
+    plane_lineEdit->setPlaceholderText(tr("無銅平面"));
+    plane_lineEdit->setToolTip(tr("走線下方銅平面的距離，空白表示沒有銅平面"));
+    h_lineEdit = new QLineEdit(QString::number(material.hTop), this);
+    h_lineEdit->setToolTip(tr("上下表面的對流 + 輻射係數，自然對流約 5 ~ 15，強制風冷 25 ~ 100"));
+    ambient_lineEdit = new QLineEdit(QString::number(material.ambient_C), this);
+    resolution_comboBox = new QComboBox(this);
+    resolution_comboBox->addItems({ tr("粗 (快)"), tr("標準"), tr("細") });
+    resolution_comboBox->setCurrentIndex(1);
+    solve_button = new QPushButton(tr("計算"), this);
+    result_label = new QLabel(this);
+    result_label->setWordWrap(true);
+    heatMap = new HeatMapWidget(this);
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("線寬 (mm)"), width_lineEdit);
+    form->addRow(tr("銅厚 (mm)"), thickness_lineEdit);
+    form->addRow(tr("電流 (A)"), current_lineEdit);
+    form->addRow(tr("層"), layer_comboBox);
+    form->addRow(tr("板厚 (mm)"), board_lineEdit);
+    form->addRow(tr("銅平面距離 (mm)"), plane_lineEdit);
+    form->addRow(tr("表面散熱係數 (W/m²K)"), h_lineEdit);
+    form->addRow(tr("環境溫度 (°C)"), ambient_lineEdit);
+    form->addRow(tr("網格"), resolution_comboBox);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addWidget(solve_button);
+    layout->addWidget(result_label);
+    layout->addWidget(heatMap, 1);
+
+    connect(solve_button, &QPushButton::clicked, this, &TraceThermalDialog::solve);
+}
+
+TraceThermalDialog::~TraceThermalDialog()
+{
+    if (solveThread) solveThread->wait();
+}
+
+void TraceThermalDialog::setTrace(double width_mm, double thickness_mm, double current_A, double board_mm,
+                                  double plane_mm)
+{
+    if (width_mm > 0) width_lineEdit->setText(QString::number(width_mm, 'g', 5));
+    if (thickness_mm > 0) thickness_lineEdit->setText(QString::number(thickness_mm, 'g', 5));
+    if (current_A > 0) current_lineEdit->setText(QString::number(current_A, 'g', 5));
+    if (board_mm > 0) board_lineEdit->setText(QString::number(board_mm, 'g', 5));
+    plane_lineEdit->setText(plane_mm > 0 ? QString::number(plane_mm, 'g', 5) : QString());
+}
+
+void TraceThermalDialog::solve()
+{
+    if (solveThread) return;
+
+    bool okW, okT, okI, okB, okH, okA;
+    sc::TraceThermalGeometry geometry;
+    sc::TraceThermalMaterial material;
+    geometry.traceWidth_mm = handler->parseValue(width_lineEdit->text(), &okW);
+    geometry.traceThickness_mm = handler->parseValue(thickness_lineEdit->text(), &okT);
+    const double current = handler->parseValue(current_lineEdit->text(), &okI);
+    geometry.boardThickness_mm = handler->parseValue(board_lineEdit->text(), &okB);
+    geometry.internal = layer_comboBox->currentIndex() == 1;
+    bool okP;
+    const double plane = handler->parseValue(plane_lineEdit->text(), &okP);
+    geometry.planeDistance_mm = (okP && plane > 0) ? plane : 0;
+    const double h = handler->parseValue(h_lineEdit->text(), &okH);
+    material.ambient_C = handler->parseValue(ambient_lineEdit->text(), &okA);
+    if (!okW || !okT || !okI || !okB || !okH || !okA || !(geometry.traceWidth_mm > 0) ||
+        !(geometry.traceThickness_mm > 0) || !(current > 0) || !(geometry.boardThickness_mm > 0) || !(h >= 0)) {
+        result_label->setText(tr("請輸入正的線寬、銅厚、電流與板厚"));
+        heatMap->clear();
+        return;
+    }
+    if (geometry.planeDistance_mm >= geometry.boardThickness_mm) {
+        result_label->setText(tr("銅平面距離必須小於板厚"));
+        heatMap->clear();
+        return;
+    }
+    material.hTop = material.hBottom = h;
+
+    const Resolution res = RESOLUTIONS[resolution_comboBox->currentIndex()];
+    sc::TraceThermalOptions options;
+    options.cellsAcrossTrace = res.cellsAcrossTrace;
+    options.cellsPerCopper = res.cellsPerCopper;
+    options.grading = res.grading;
+
+    solve_button->setEnabled(false);
+    solve_button->setText(tr("計算中..."));
+
+    solveThread = QThread::create([this, geometry, material, options, current]() {
+        QElapsedTimer timer;
+        timer.start();
+        sc::TraceThermalResult r = sc::traceThermalSolve(geometry, current, material, options);
+        const double elapsed = timer.nsecsElapsed() / 1e6;
+        QMetaObject::invokeMethod(this, [this, r, geometry, current, elapsed]() {
+            const double k = geometry.internal ? sc::IPC2221_K_INTERNAL : sc::IPC2221_K_EXTERNAL;
+            const double ipc = sc::traceTempRise(current, geometry.traceWidth_mm, geometry.traceThickness_mm, k);
+            if (r.runaway) {
+                result_label->setText(tr("熱失控：電阻隨溫度增加的功率超過散熱能力，沒有穩態 (IPC-2221 溫升 %1 °C)")
+                                          .arg(ipc, 0, 'g', 4));
+                heatMap->clear();
+                return;
+            }
+            QString text = tr("最高溫升 %1 °C，走線平均 %2 °C (IPC-2221：%3 °C)\n"
+                              "%4 W/m、%5 mΩ/mm，%6 x %7 格，%8 次迭代，%9 ms")
+                               .arg(r.maxRise_C, 0, 'g', 4).arg(r.traceRise_C, 0, 'g', 4).arg(ipc, 0, 'g', 4)
+                               .arg(r.power_W_per_m, 0, 'g', 4).arg(r.resistance_ohm_per_m, 0, 'g', 4)
+                               .arg(r.nx).arg(r.ny).arg(r.iterations).arg(elapsed, 0, 'f', 1);
+            if (!r.converged) text += tr("\n未收斂，結果僅供參考");
+            result_label->setText(text);
+            heatMap->setResult(r, geometry);
+        }, Qt::QueuedConnection);
+    });
+    connect(solveThread, &QThread::finished, this, [this]() {
+        solveThread->deleteLater();
+        solveThread = nullptr;
+        solve_button->setEnabled(true);
+        solve_button->setText(tr("計算"));
+    });
+    solveThread->start();
+}
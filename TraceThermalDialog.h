@@ -0,0 +1,70 @@
+#ifndef TRACETHERMALDIALOG_H
+#define TRACETHERMALDIALOG_H
+
+#include <QDialog>
+#include <QImage>
+#include <QWidget>
+#include "UnitConverterHandler.h"
+#include "TraceThermal2D.h"
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QThread;
+
+// 截面溫升分布：只畫走線附近的視窗 (截面本身寬達數十 mm)，顏色由環境溫度 (藍) 到最高溫 (紅)
+class HeatMapWidget : public QWidget
+{
+public:
+    explicit HeatMapWidget(QWidget *parent = nullptr);
+
+    void setResult(const sc::TraceThermalResult &result, const sc::TraceThermalGeometry &geometry);
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    sc::TraceThermalResult result;
+    sc::TraceThermalGeometry geometry;
+    QImage image;
+    void render();
+};
+
+// 走線截面 2D 熱傳導：與 IPC-2221 經驗公式的溫升比較 (走線頁開啟，預先帶入線寬、銅厚、電流)
+class TraceThermalDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    TraceThermalDialog(UnitConverterHandler *sharedHandler, QWidget *parent = nullptr);
+    ~TraceThermalDialog();
+
+    void setTrace(double width_mm, double thickness_mm, double current_A, double board_mm, double plane_mm);
+
+private:
+    UnitConverterHandler *handler;
+
+    QLineEdit *width_lineEdit = nullptr;
+    QLineEdit *thickness_lineEdit = nullptr;
+    QLineEdit *current_lineEdit = nullptr;
+    QComboBox *layer_comboBox = nullptr;
+    QLineEdit *board_lineEdit = nullptr;
+    QLineEdit *plane_lineEdit = nullptr;
+    QLineEdit *h_lineEdit = nullptr;
+    QLineEdit *ambient_lineEdit = nullptr;
+    QComboBox *resolution_comboBox = nullptr;
+    QPushButton *solve_button = nullptr;
+    QLabel *result_label = nullptr;
+    HeatMapWidget *heatMap = nullptr;
+
+    // 網格細時一次要數百毫秒以上，在工作執行緒上解
+    QThread *solveThread = nullptr;
+
+private slots:
+    void solve();
+};
+
+#endif // TRACETHERMALDIALOG_H
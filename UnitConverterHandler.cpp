@@ -17,7 +17,7 @@
  *            10 ^ (-3 - (-6)) = 10 ^ 3 = 1000
  *
  * 【 3. 計算方式與呈現邏輯 】
- * - 矩陣生成：利用雙重迴圈遍歷所有單位組合，計算其相互比值並填入 QTableWidget。
+ * - 矩陣生成：由 UnitMatrixModel 在 view 需要顯示時才計算該格比值 (見 UnitMatrixModel.cpp)。
  * - 數值格式化：
  *   a. 常規區間 (10⁻⁴ ~ 10⁶)：採用固定小數位數（Fixed-point），並移除結尾多餘的「0」，保持介面簡潔。
  *   b. 極端區間：當比值過大或過小時，自動切換至科學記號 (Scientific Notation, 'e')，確保表格寬度不溢出。
@@ -25,49 +25,65 @@
  *
  * 【 4. 換算執行 】
  * 最終換算結果 = 輸入數值 * 該單位組合的比值。
+ * 10 的次方由 sc_core (Units.h) 的編譯期查表取得，不在每次按鍵時呼叫 std::pow。
  */
 
 #include "UnitConverterHandler.h"
+#include "UnitMatrixModel.h"
+#include "Units.h"
+#include "ScaleKernels.h"
+#include "EngExpr.h"
 #include <cmath>
-#include <QTableWidgetItem>
-#include <QBrush>
-#include <QRegularExpression>
-
-
-void UnitConverterHandler::setupMatrixTable(QTableWidget* table) {
-    int size = units.size();
-    table->setRowCount(size);
-    table->setColumnCount(size);
-
-    // 1. 設定標題列 (Horizontal) 與 標題行 (Vertical)
-    table->setHorizontalHeaderLabels(units);
-    table->setVerticalHeaderLabels(units);
-
-    // 2. 雙重迴圈填寫矩陣
-    for (int r = 0; r < size; ++r) {
-        for (int c = 0; c < size; ++c) {
-            // 公式：10^(From指數 - To指數)
-            double ratio = std::pow(10, exponents[r] - exponents[c]);
-            QString display = (ratio >= 1e6 || ratio <= 1e-4)
-                                  ? QString::number(ratio, 'e', 2)
-                                  : QString::number(ratio, 'g', 6);
-
-            QTableWidgetItem* item = new QTableWidgetItem(display);
-
-            item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-
-            // 3. 對角線背景變色
-            if (r == c) {
-                item->setBackground(QBrush(Qt::lightGray));
-            }
-            table->setItem(r, c, item);
-        }
-    }
+#include <QHeaderView>
+
+
+UnitMatrixModel *UnitConverterHandler::setupMatrixTable(QTableView* table) {
+    // 比值改由 model 在 data() 中即時計算，不再為每一格配置 QTableWidgetItem
+    UnitMatrixModel *model = new UnitMatrixModel(table);
+    table->setModel(model);
+
+    // 固定列高/欄寬：view 不需要逐格量測內容，捲動成本與單位數無關
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table->horizontalHeader()->setDefaultSectionSize(80);
+    table->setSelectionMode(QAbstractItemView::ContiguousSelection);
+    return model;
 }
 
 double UnitConverterHandler::convert(double value, int sourceIdx, int targetIdx) {
-    double ratio = std::pow(10, exponents[sourceIdx] - exponents[targetIdx]);
-    return value * ratio;
+    return value * ratio(sourceIdx, targetIdx);
+}
+
+double UnitConverterHandler::ratio(int sourceIdx, int targetIdx) const {
+    return sc::units::pow10(exponents[sourceIdx] - exponents[targetIdx]);
+}
+
+void UnitConverterHandler::convertBatch(const double *in, double *out, std::size_t n,
+                                        int sourceIdx, int targetIdx) const {
+    sc::scaleArray(in, out, n, ratio(sourceIdx, targetIdx));
+}
+
+void UnitConverterHandler::convertBatch(const float *in, float *out, std::size_t n,
+                                        int sourceIdx, int targetIdx) const {
+    // 比值先以 double 算好再轉 float，避免 10 的次方累積誤差
+    sc::scaleArray(in, out, n, static_cast<float>(ratio(sourceIdx, targetIdx)));
+}
+
+void UnitConverterHandler::convertInPlace(double *data, std::size_t n, int sourceIdx, int targetIdx) const {
+    sc::scaleArray(data, data, n, ratio(sourceIdx, targetIdx));
+}
+
+void UnitConverterHandler::convertInPlace(float *data, std::size_t n, int sourceIdx, int targetIdx) const {
+    sc::scaleArray(data, data, n, static_cast<float>(ratio(sourceIdx, targetIdx)));
+}
+
+double UnitConverterHandler::parseValue(const QString &text, bool *ok) const {
+    // 編譯結果由 sc_core 的全域快取保存，重複輸入相同文字不會重新解析
+    const QByteArray utf8 = text.toUtf8();
+    double value = 0;
+    bool good = sc::evalEngExpr(std::string_view(utf8.constData(), static_cast<std::size_t>(utf8.size())), value);
+    if (ok) *ok = good;
+    return good ? value : 0.0;
 }
 
 /*
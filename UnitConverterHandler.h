@@ -1,17 +1,31 @@
 #ifndef UNITCONVERTERHANDLER_H
 #define UNITCONVERTERHANDLER_H
 
-#include <QTableWidget>
+#include <QTableView>
+#include <QString>
 #include <QStringList>
+#include <cstddef>
 #include <vector>
 
+#include "Units.h"
+
+class UnitMatrixModel;
+
+// 各分頁共用的編譯期單位表，index 與下拉選單順序一致
+using ResistorUnitList  = sc::units::UnitList<sc::units::Ohm, sc::units::kOhm, sc::units::MOhm>;
+using CapacitorUnitList = sc::units::UnitList<sc::units::pF, sc::units::nF, sc::units::uF>;
+using CurrentUnitList   = sc::units::UnitList<sc::units::A, sc::units::mA, sc::units::uA>;
+
+// 由單位表產生下拉選單文字，確保選單順序與換算表不會對不上
+template <class List>
+QStringList unitSymbols()
+{
+    QStringList out;
+    for (const char *symbol : List::symbols)
+        out << QString::fromUtf8(symbol);
+    return out;
+}
 
-// 定義一個簡單的結構來回傳計算結果
-struct LEDResult {
-    double resistance;
-    double wattage;
-    bool isVoltageOk;
-};
 
 class UnitConverterHandler {
 public:
@@ -19,23 +33,39 @@ public:
     const QStringList units = {"p (10⁻¹²)", "n (10⁻⁹)", "u (10⁻⁶)", "m (10⁻³)", "1 (Base)", "K (10³)", "M (10⁶)"};
     const std::vector<int> exponents = {-12, -9, -6, -3, 0, 3, 6};
 
-    // 專門負責填寫表格的函數
-    void setupMatrixTable(QTableWidget* table);
+    // 專門負責填寫表格的函數：建立 UnitMatrixModel 並掛到 view 上 (model 由 view 擁有)
+    UnitMatrixModel *setupMatrixTable(QTableView* table);
 
     // 專門負責計算結果的函數
     double convert(double value, int sourceIdx, int targetIdx);
 
+    // 兩個單位之間的比值 10^(From指數 - To指數)
+    double ratio(int sourceIdx, int targetIdx) const;
+
+    // 批次換算 (大量量測資料用)：比值只算一次，乘法交給 SIMD 核心
+    // in 與 out 為長度 n 的連續陣列，兩者不可部分重疊
+    void convertBatch(const double *in, double *out, std::size_t n, int sourceIdx, int targetIdx) const;
+    void convertBatch(const float *in, float *out, std::size_t n, int sourceIdx, int targetIdx) const;
+
+    // 原地換算，不需要第二塊緩衝區
+    void convertInPlace(double *data, std::size_t n, int sourceIdx, int targetIdx) const;
+    void convertInPlace(float *data, std::size_t n, int sourceIdx, int targetIdx) const;
+
+    // 解析輸入框文字：接受工程記號 (4k7、10u、2.2uF) 與簡單運算式 (2*0.035、1/(2*pi*1k*100n))
+    // 語法錯誤時 *ok = false 並回傳 0，行為與 QString::toDouble 一致
+    double parseValue(const QString &text, bool *ok = nullptr) const;
+
 
     // 在 public 加入：
     // 解析 SMD 代碼 (如 "103")，回傳基準單位數值 (電阻為 Ohm, 電容為 pF)
     //double decodeSMDCode(QString code);
 
     // 專為 Tab 2 設計的單位清單
-    const QStringList resistorUnits = {"Ω", "kΩ", "MΩ"};
-    const QStringList capacitorUnits = {"pF", "nF", "μF"};
+    const QStringList resistorUnits = unitSymbols<ResistorUnitList>();
+    const QStringList capacitorUnits = unitSymbols<CapacitorUnitList>();
 
     // 新增：電流單位清單宣告
-    const QStringList currentUnits = {"A", "mA", "uA"};
+    const QStringList currentUnits = unitSymbols<CurrentUnitList>();
 
 
 
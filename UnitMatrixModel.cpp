@@ -0,0 +1,177 @@
+/**
+ * @file UnitMatrixModel.cpp
+ * @brief 單位換算矩陣 (model/view 版)
+ *
+ * 原本的 setupMatrixTable 對每一格 new 一個 QTableWidgetItem 並格式化字串，
+ * 7x7 時沒問題，但完整 SI 前綴 (21x21) 加上多種維度時，成本會隨格數平方成長。
+ * 這裡改成：
+ *   - 只保存每個單位的係數 (或 10 的指數)，比值 = 係數[row] / 係數[col]
+ *   - data() 被 view 要求時才計算，字串放進 QCache，捲動回來不必再格式化
+ *   - 純 10 次方的維度直接查 sc_core 的 10^n 表
+ */
+
+#include "UnitMatrixModel.h"
+
+#include "SiPrefix.h"
+#include "Units.h"
+
+#include <QBrush>
+
+namespace {
+
+// 把指數轉成上標字串，例如 -12 -> "⁻¹²"
+QString superscript(int exponent)
+{
+    static const QChar digits[] = { QChar(0x2070), QChar(0x00B9), QChar(0x00B2), QChar(0x00B3), QChar(0x2074),
+                                    QChar(0x2075), QChar(0x2076), QChar(0x2077), QChar(0x2078), QChar(0x2079) };
+    QString out;
+    if (exponent < 0) out += QChar(0x207B);
+    const QString n = QString::number(qAbs(exponent));
+    for (QChar c : n) out += digits[c.digitValue()];
+    return out;
+}
+
+QString formatRatio(double ratio)
+{
+    // 與原本矩陣相同的格式規則
+    return (ratio >= 1e6 || ratio <= 1e-4) ? QString::number(ratio, 'e', 2)
+                                           : QString::number(ratio, 'g', 6);
+}
+
+constexpr int TEXT_CACHE_ENTRIES = 4096;
+
+} // namespace
+
+UnitMatrixModel::UnitMatrixModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_textCache(TEXT_CACHE_ENTRIES)
+{
+    setDimension(SiPrefix);
+}
+
+QStringList UnitMatrixModel::dimensionNames()
+{
+    return { tr("SI 前綴 (q ~ Q)"), tr("長度"), tr("電流"), tr("能量") };
+}
+
+void UnitMatrixModel::addDecimal(const QString &label, int exponent)
+{
+    m_labels << label;
+    m_exponents << exponent;
+    m_factors << sc::units::pow10(exponent);
+}
+
+void UnitMatrixModel::addFactor(const QString &label, double factor)
+{
+    m_labels << label;
+    m_exponents << 0;
+    m_factors << factor;
+    m_decimalOnly = false;
+}
+
+void UnitMatrixModel::setDimension(int dimension)
+{
+    namespace u = sc::units;
+
+    beginResetModel();
+    m_labels.clear();
+    m_factors.clear();
+    m_exponents.clear();
+    m_decimalOnly = true;
+    m_textCache.clear();
+
+    switch (dimension) {
+    case Length:
+        addFactor(u::um::symbol, u::um::factor);
+        addFactor(u::mil::symbol, u::mil::factor);
+        addFactor(u::mm::symbol, u::mm::factor);
+        addFactor(u::cm::symbol, u::cm::factor);
+        addFactor(u::inch::symbol, u::inch::factor);
+        addFactor(u::m::symbol, u::m::factor);
+        break;
+    case Current:
+        // pA ~ kA
+        for (std::size_t i = 0; i < sc::siPrefixCount(); ++i) {
+            const sc::SiPrefix &p = sc::siPrefixes()[i];
+            if (p.exponent >= -12 && p.exponent <= 3)
+                addDecimal(QString::fromUtf8(p.symbol) + "A", p.exponent);
+        }
+        break;
+    case Energy:
+        addFactor(u::mJ::symbol, u::mJ::factor);
+        addFactor(u::mWh::symbol, u::mWh::factor);
+        addFactor(u::J::symbol, u::J::factor);
+        addFactor(u::kJ::symbol, u::kJ::factor);
+        addFactor(u::Wh::symbol, u::Wh::factor);
+        addFactor(u::kWh::symbol, u::kWh::factor);
+        break;
+    case SiPrefix:
+    default:
+        for (std::size_t i = 0; i < sc::siPrefixCount(); ++i) {
+            const sc::SiPrefix &p = sc::siPrefixes()[i];
+            const QString symbol = p.exponent == 0 ? QStringLiteral("1") : QString::fromUtf8(p.symbol);
+            const QString label = p.exponent == 0
+                                      ? QStringLiteral("1 (Base)")
+                                      : QString("%1 (10%2)").arg(symbol, superscript(p.exponent));
+            addDecimal(label, p.exponent);
+        }
+        break;
+    }
+    endResetModel();
+}
+
+int UnitMatrixModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_labels.size();
+}
+
+int UnitMatrixModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_labels.size();
+}
+
+double UnitMatrixModel::ratio(int row, int col) const
+{
+    if (m_decimalOnly) return sc::units::pow10(m_exponents[row] - m_exponents[col]);
+    return m_factors[row] / m_factors[col];
+}
+
+QVariant UnitMatrixModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) return QVariant();
+    const int r = index.row();
+    const int c = index.column();
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        const quint64 key = (quint64(quint32(r)) << 32) | quint32(c);
+        if (const QString *cached = m_textCache.object(key)) return *cached;
+        const QString text = formatRatio(ratio(r, c));
+        m_textCache.insert(key, new QString(text));
+        return text;
+    }
+    case Qt::BackgroundRole:
+        // 對角線 (比值為 1) 灰底，作為換算基準點
+        if (r == c) return QBrush(Qt::lightGray);
+        return QVariant();
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    case Qt::ToolTipRole:
+        return QString("1 %1 = %2 %3").arg(m_labels[r], QString::number(ratio(r, c), 'g', 12), m_labels[c]);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant UnitMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    Q_UNUSED(orientation);
+    if (role != Qt::DisplayRole || section < 0 || section >= m_labels.size()) return QVariant();
+    return m_labels[section];
+}
+
+Qt::ItemFlags UnitMatrixModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
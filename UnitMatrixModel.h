@@ -0,0 +1,53 @@
+#ifndef UNITMATRIXMODEL_H
+#define UNITMATRIXMODEL_H
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QStringList>
+#include <QVector>
+
+// 單位換算矩陣的 model：不預先建立任何儲存格，
+// 比值在 data() 被呼叫時才由係數表算出，格式化後的字串放在小型 LRU 快取裡。
+// 因此開啟與捲動的成本只和畫面上看得到的格數有關，與單位數量無關。
+class UnitMatrixModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    // 可選的維度，順序與 dimensionNames() 相同
+    enum Dimension {
+        SiPrefix = 0,   // quecto ~ quetta
+        Length,         // um / mm / mil / inch / cm / m
+        Current,        // pA ~ kA
+        Energy          // mJ / J / kJ / mWh / Wh / kWh
+    };
+
+    explicit UnitMatrixModel(QObject *parent = nullptr);
+
+    static QStringList dimensionNames();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    // 1 個 row 單位 = ratio(row, col) 個 column 單位
+    double ratio(int row, int col) const;
+
+public slots:
+    void setDimension(int dimension);
+
+private:
+    void addDecimal(const QString &label, int exponent);
+    void addFactor(const QString &label, double factor);
+
+    QStringList m_labels;
+    QVector<double> m_factors;    // 相對基準單位的係數
+    QVector<int> m_exponents;     // 純 10 的次方時的指數
+    bool m_decimalOnly = true;    // 全部都是 10 的次方：比值直接查 10^n 表，不做除法
+
+    mutable QCache<quint64, QString> m_textCache;
+};
+
+#endif // UNITMATRIXMODEL_H
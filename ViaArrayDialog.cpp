@@ -0,0 +1,177 @@
+#include "ViaArrayDialog.h"
+
+#include <QComboBox>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+#include <cmath>
+
+namespace {
+
+enum Column { DRILL, WALL, COUNT, PITCH, FACTOR, VIA_CURRENT, CAPACITY, SIZE, AREA, RESISTANCE, DROP, COLUMN_COUNT };
+
+} // namespace
+
+ViaArrayDialog::ViaArrayDialog(UnitConverterHandler *sharedHandler, QWidget *parent) :
+    QDialog(parent),
+    handler(sharedHandler)
+{
+    setWindowTitle(tr("貫孔陣列"));
+    resize(900, 640);
+
+    const sc::ViaArrayOptions defaults;
+    current_lineEdit = new QLineEdit(QString::number(defaults.current_A), this);
+    deltaT_lineEdit = new QLineEdit(QString::number(defaults.deltaT), this);
+    board_lineEdit = new QLineEdit(QString::number(defaults.boardThick_mm), this);
+    walls_lineEdit = new QLineEdit("20, 25", this);
+    walls_lineEdit->setToolTip(tr("可選的孔壁電鍍厚度 (um)，以逗號分隔，每個都會和標準孔徑表組合"));
+    ring_lineEdit = new QLineEdit(QString::number(defaults.annularRing_mm), this);
+    spacing_lineEdit = new QLineEdit(QString::number(defaults.holeSpacing_mm), this);
+    spacing_lineEdit->setToolTip(tr("相鄰孔壁的最小距離 (板廠的孔到孔能力)"));
+    padWidth_lineEdit = new QLineEdit(this);
+    padWidth_lineEdit->setPlaceholderText(tr("不限"));
+    padHeight_lineEdit = new QLineEdit(this);
+    padHeight_lineEdit->setPlaceholderText(tr("不限"));
+    model_comboBox = new QComboBox(this);
+    model_comboBox->addItems({ tr("IPC-2221"), tr("IPC-2152") });
+    best_label = new QLabel(this);
+    best_label->setWordWrap(true);
+    best_label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    table = new QTableWidget(0, COLUMN_COUNT, this);
+    table->setHorizontalHeaderLabels({ tr("孔徑 (mm)"), tr("孔壁 (um)"), tr("孔數"), tr("中心距 (mm)"),
+                                       tr("群組係數"), tr("單孔 (A)"), tr("總載流 (A)"), tr("外框 (mm)"),
+                                       tr("面積 (mm²)"), tr("電阻 (mΩ)"), tr("壓降 (mV)") });
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    QFormLayout *left = new QFormLayout;
+    left->addRow(tr("總電流 (A)"), current_lineEdit);
+    left->addRow(tr("允許溫升 (°C)"), deltaT_lineEdit);
+    left->addRow(tr("板厚 (mm)"), board_lineEdit);
+    left->addRow(tr("模型"), model_comboBox);
+    QFormLayout *right = new QFormLayout;
+    right->addRow(tr("孔壁電鍍選項 (um)"), walls_lineEdit);
+    right->addRow(tr("孔環 (mm)"), ring_lineEdit);
+    right->addRow(tr("孔間距 (mm)"), spacing_lineEdit);
+    QHBoxLayout *pad = new QHBoxLayout;
+    pad->addWidget(padWidth_lineEdit);
+    pad->addWidget(new QLabel("x", this));
+    pad->addWidget(padHeight_lineEdit);
+    right->addRow(tr("焊墊範圍 (mm)"), pad);
+    QHBoxLayout *inputs = new QHBoxLayout;
+    inputs->addLayout(left);
+    inputs->addLayout(right);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(inputs);
+    layout->addWidget(new QLabel(tr("群組減額：中心距 >= 3 倍孔徑 100%，<= 2 倍孔徑 80%，之間線性內插"), this));
+    layout->addWidget(best_label);
+    layout->addWidget(table, 1);
+
+    for (QLineEdit *e : { current_lineEdit, deltaT_lineEdit, board_lineEdit, walls_lineEdit, ring_lineEdit,
+                          spacing_lineEdit, padWidth_lineEdit, padHeight_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &ViaArrayDialog::search);
+    connect(model_comboBox, &QComboBox::currentIndexChanged, this, &ViaArrayDialog::search);
+
+    search();
+}
+
+void ViaArrayDialog::setVia(double current_A, double deltaT, double boardThick_mm, double wallThick_mm,
+                            int modelIndex)
+{
+    if (current_A > 0) current_lineEdit->setText(QString::number(current_A, 'g', 5));
+    if (deltaT > 0) deltaT_lineEdit->setText(QString::number(deltaT, 'g', 5));
+    if (boardThick_mm > 0) board_lineEdit->setText(QString::number(boardThick_mm, 'g', 5));
+    if (wallThick_mm > 0) {
+        // 貫孔頁的孔壁厚放在第一個選項
+        const QString um = QString::number(wallThick_mm * 1000, 'g', 4);
+        QStringList walls = walls_lineEdit->text().split(',', Qt::SkipEmptyParts);
+        for (QString &w : walls) w = w.trimmed();
+        walls.removeAll(um);
+        walls.prepend(um);
+        walls_lineEdit->setText(walls.join(", "));
+    }
+    model_comboBox->setCurrentIndex(modelIndex);
+}
+
+void ViaArrayDialog::search()
+{
+    sc::ViaArrayOptions opt;
+    bool okI, okT, okB, okR, okS;
+    opt.current_A = handler->parseValue(current_lineEdit->text(), &okI);
+    opt.deltaT = handler->parseValue(deltaT_lineEdit->text(), &okT);
+    opt.boardThick_mm = handler->parseValue(board_lineEdit->text(), &okB);
+    opt.annularRing_mm = handler->parseValue(ring_lineEdit->text(), &okR);
+    opt.holeSpacing_mm = handler->parseValue(spacing_lineEdit->text(), &okS);
+    opt.model = model_comboBox->currentIndex() == 1 ? sc::TraceModel::IPC2152 : sc::TraceModel::IPC2221;
+    opt.wallThick_mm.clear();
+    for (const QString &w : walls_lineEdit->text().split(',', Qt::SkipEmptyParts)) {
+        bool ok;
+        const double um = handler->parseValue(w.trimmed(), &ok);
+        if (ok && um > 0) opt.wallThick_mm.push_back(um / 1000);
+    }
+    bool ok;
+    const double padW = handler->parseValue(padWidth_lineEdit->text(), &ok);
+    opt.maxWidth_mm = ok ? padW : 0;
+    const double padH = handler->parseValue(padHeight_lineEdit->text(), &ok);
+    opt.maxHeight_mm = ok ? padH : 0;
+
+    table->setRowCount(0);
+    if (!okI || !okT || !okB || !okR || !okS || !(opt.current_A > 0) || !(opt.deltaT > 0) ||
+        !(opt.boardThick_mm > 0) || opt.wallThick_mm.empty()) {
+        best_label->setText(tr("請輸入正的電流、溫升、板厚與至少一個孔壁厚"));
+        return;
+    }
+
+    const sc::ViaArrayResult r = sc::viaArraySearch(opt);
+    if (r.best >= 0) {
+        const sc::ViaArrayDesign &d = r.table[r.best];
+        best_label->setText(tr("最小面積：孔徑 %1 mm、孔壁 %2 um，%3 x %4 = %5 孔，中心距 %6 mm，"
+                               "外框 %7 x %8 mm (%9 mm²)")
+                                .arg(d.drill_mm).arg(d.wallThick_mm * 1000, 0, 'g', 4).arg(d.rows).arg(d.cols)
+                                .arg(d.count()).arg(d.pitch_mm, 0, 'g', 4).arg(d.width_mm, 0, 'g', 4)
+                                .arg(d.height_mm, 0, 'g', 4).arg(d.area_mm2, 0, 'g', 4));
+    } else {
+        best_label->setText(tr("沒有放得進焊墊範圍的排列"));
+    }
+
+    table->setRowCount(static_cast<int>(r.table.size()));
+    for (int row = 0; row < static_cast<int>(r.table.size()); ++row) {
+        const sc::ViaArrayDesign &d = r.table[row];
+        const bool none = d.count() == 0;
+        const QString cells[COLUMN_COUNT] = {
+            QString::number(d.drill_mm),
+            QString::number(d.wallThick_mm * 1000, 'g', 4),
+            none ? tr("超過上限") : tr("%1 x %2").arg(d.rows).arg(d.cols),
+            (none || d.count() == 1) ? QStringLiteral("-") : QString::number(d.pitch_mm, 'f', 3),
+            QString::number(d.groupFactor, 'f', 2),
+            QString::number(d.viaCurrent_A, 'f', 3),
+            none ? QStringLiteral("-") : QString::number(d.capacity_A, 'f', 2),
+            none ? QStringLiteral("-") : tr("%1 x %2").arg(d.width_mm, 0, 'f', 2).arg(d.height_mm, 0, 'f', 2),
+            none ? QStringLiteral("-") : QString::number(d.area_mm2, 'f', 2),
+            none ? QStringLiteral("-") : QString::number(d.resistance_ohm * 1e3, 'f', 3),
+            none ? QStringLiteral("-") : QString::number(d.voltageDrop_V * 1e3, 'f', 2),
+        };
+        for (int c = 0; c < COLUMN_COUNT; ++c) {
+            QTableWidgetItem *item = new QTableWidgetItem(cells[c]);
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            if (!d.feasible) item->setForeground(palette().color(QPalette::Disabled, QPalette::Text));
+            if (row == r.best) {
+                QFont f = item->font();
+                f.setBold(true);
+                item->setFont(f);
+            }
+            table->setItem(row, c, item);
+        }
+        if (!d.feasible) table->item(row, COUNT)->setToolTip(tr("放不進焊墊範圍 (或孔數超過上限)"));
+    }
+    if (r.best >= 0) table->scrollToItem(table->item(r.best, 0));
+}
@@ -0,0 +1,43 @@
+#ifndef VIAARRAYDIALOG_H
+#define VIAARRAYDIALOG_H
+
+#include <QDialog>
+#include "UnitConverterHandler.h"
+#include "ViaArray.h"
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QTableWidget;
+
+// 貫孔陣列：總電流分給多顆貫孔，列出每個標準孔徑 x 電鍍選項的最小面積排列 (含群組減額)
+// 貫孔頁開啟時帶入電流、溫升、板厚、孔壁厚與模型；搜尋不到一毫秒，輸入時即時更新
+class ViaArrayDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    ViaArrayDialog(UnitConverterHandler *sharedHandler, QWidget *parent = nullptr);
+
+    void setVia(double current_A, double deltaT, double boardThick_mm, double wallThick_mm, int modelIndex);
+
+private:
+    UnitConverterHandler *handler;
+
+    QLineEdit *current_lineEdit = nullptr;
+    QLineEdit *deltaT_lineEdit = nullptr;
+    QLineEdit *board_lineEdit = nullptr;
+    QLineEdit *walls_lineEdit = nullptr;
+    QLineEdit *ring_lineEdit = nullptr;
+    QLineEdit *spacing_lineEdit = nullptr;
+    QLineEdit *padWidth_lineEdit = nullptr;
+    QLineEdit *padHeight_lineEdit = nullptr;
+    QComboBox *model_comboBox = nullptr;
+    QLabel *best_label = nullptr;
+    QTableWidget *table = nullptr;
+
+private slots:
+    void search();
+};
+
+#endif // VIAARRAYDIALOG_H
@@ -1,5 +1,56 @@
 #include "Voltage_Divider.h"
 #include "ui_Voltage_Divider.h"
+#include "MonteCarloDialog.h"
+
+#include "DividerCalc.h"
+#include "DividerSearch.h"
+#include "FeedbackDesign.h"
+
+#include <QComboBox>
+#include <QDialog>
+#include <QFormLayout>
+#include <QGridLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QRegularExpression>
+#include <QTableWidget>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+// 下拉選單順序對應的 E 系列
+const sc::ESeries PAIR_SERIES[] = { sc::ESeries::E12, sc::ESeries::E24, sc::ESeries::E48,
+                                    sc::ESeries::E96, sc::ESeries::E192 };
+
+// 公差分析的輸入名稱與預設公差 (最差情況範圍共用)
+const char *const TOL_VI = "Vi (V)";
+const char *const TOL_R1 = "R1 (Ω)";
+const char *const TOL_R2 = "R2 (Ω)";
+constexpr double DEFAULT_VI_TOL = 0.02;
+constexpr double DEFAULT_R_TOL = 0.01;
+
+// 最差情況另外計入電阻溫度係數：±100 ppm/°C (一般厚膜電阻)，工業級溫度範圍
+constexpr double WORST_TCR_PPM = 100;
+constexpr double WORST_T_MIN_C = -40;
+constexpr double WORST_T_MAX_C = 85;
+
+// 以 SI 前綴顯示電阻 (4.99k、1.2M)
+QString formatOhm(double r)
+{
+    if (r >= 1e6) return QString::number(r / 1e6, 'g', 4) + "M";
+    if (r >= 1e3) return QString::number(r / 1e3, 'g', 4) + "k";
+    return QString::number(r, 'g', 4);
+}
+
+} // namespace
 
 
 
@@ -37,12 +88,412 @@ Voltage_Divider::Voltage_Divider(UnitConverterHandler *sharedHandler, QWidget *p
     connect(ui->calcMode_comboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(onVoltageModeChanged()));
     connect(ui->calcMode_comboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(updateVoltageDivider()));*/
 
+    // 標準值組合：R1/R2 反算出來的值通常買不到，列出最接近的 E 系列組合
+    setupStandardPairSearch();
+
+    // 公差分析：實際的 Vo 分布與良率
+    QPushButton *toleranceButton = new QPushButton(tr("公差分析..."), this);
+    toleranceButton->setGeometry(610, 180, 111, 31);
+    toleranceDialog = new MonteCarloDialog(handler, tr("分壓公差分析"), this);
+    connect(toleranceButton, &QPushButton::clicked, this, &Voltage_Divider::openToleranceAnalysis);
+
+    worstCase_label = new QLabel(this);
+    worstCase_label->setGeometry(70, 485, 421, 31);
+    worstCase_label->setToolTip(tr("公差 + 電阻溫度係數 ±%1 ppm/°C (%2 ~ %3 °C) 的最差情況")
+                                    .arg(WORST_TCR_PPM).arg(WORST_T_MIN_C).arg(WORST_T_MAX_C));
+    connect(toleranceDialog, &MonteCarloDialog::tolerancesChanged, this, &Voltage_Divider::updateWorstCase);
+
     // 【新增】程式啟動時先執行一次，確保 UI 鎖定狀態正確
     onVoltageModeChanged();
 }
 
+void Voltage_Divider::setupStandardPairSearch() {
+    QGroupBox *box = new QGroupBox(tr("標準值組合"), this);
+    box->setAlignment(Qt::AlignCenter);
+    box->setGeometry(510, 40, 211, 131);
+    QGridLayout *boxLayout = new QGridLayout(box);
+
+    seriesCombo = new QComboBox(box);
+    seriesCombo->addItems({"E12", "E24", "E48", "E96", "E192"});
+    seriesCombo->setCurrentIndex(3);
+    QPushButton *listButton = new QPushButton(tr("最佳組合..."), box);
+    QPushButton *chainButton = new QPushButton(tr("多段分壓..."), box);
+    QPushButton *feedbackButton = new QPushButton(tr("回授電阻..."), box);
+    boxLayout->addWidget(seriesCombo, 0, 0, 1, 2);
+    boxLayout->addWidget(listButton, 1, 0);
+    boxLayout->addWidget(chainButton, 1, 1);
+    boxLayout->addWidget(feedbackButton, 2, 0, 1, 2);
+
+    // 非模態視窗：輸入 Vi/Vo 時即時更新
+    pairDialog = new QDialog(this);
+    pairDialog->setWindowTitle(tr("分壓電阻標準值組合"));
+    pairDialog->resize(520, 380);
+
+    pairMinR_lineEdit = new QLineEdit("100", pairDialog);
+    pairMaxR_lineEdit = new QLineEdit("1M", pairDialog);
+    pairMaxI_lineEdit = new QLineEdit(pairDialog);
+    pairMaxI_lineEdit->setPlaceholderText(tr("不限制"));
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("最小電阻 (Ω)"), pairMinR_lineEdit);
+    form->addRow(tr("最大電阻 (Ω)"), pairMaxR_lineEdit);
+    form->addRow(tr("最大分壓電流 (mA)"), pairMaxI_lineEdit);
+
+    pairTable = new QTableWidget(0, 5, pairDialog);
+    pairTable->setHorizontalHeaderLabels({"R1", "R2", "Vo (V)", tr("誤差 (%)"), tr("電流 (mA)")});
+    pairTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    pairTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    pairTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    pairTable->setToolTip(tr("雙擊套用到 R1 / R2"));
+
+    QVBoxLayout *dialogLayout = new QVBoxLayout(pairDialog);
+    dialogLayout->addLayout(form);
+    dialogLayout->addWidget(pairTable);
+
+    connect(listButton, &QPushButton::clicked, this, [this]() {
+        pairDialog->show();
+        pairDialog->raise();
+        updateStandardPairs();
+    });
+    connect(seriesCombo, &QComboBox::currentIndexChanged, this, &Voltage_Divider::updateStandardPairs);
+    for (QLineEdit *e : { ui->VI_Input_lineEdit, ui->Vo_Input_lineEdit,
+                          pairMinR_lineEdit, pairMaxR_lineEdit, pairMaxI_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &Voltage_Divider::updateStandardPairs);
+    connect(pairTable, &QTableWidget::cellDoubleClicked, this, &Voltage_Divider::applyStandardPair);
+
+    setupChainSearch(chainButton);
+    setupFeedbackDesign(feedbackButton);
+}
+
+void Voltage_Divider::setupChainSearch(QPushButton *openButton) {
+    chainDialog = new QDialog(this);
+    chainDialog->setWindowTitle(tr("多段分壓電阻串"));
+    chainDialog->resize(560, 420);
+
+    chainVin_lineEdit = new QLineEdit(chainDialog);
+    chainTaps_lineEdit = new QLineEdit("3.3, 2.5, 1.2", chainDialog);
+    chainTaps_lineEdit->setToolTip(tr("以逗號分隔的分接電壓 (V)"));
+    chainMaxI_lineEdit = new QLineEdit("1", chainDialog);
+    chainBudget_lineEdit = new QLineEdit("500", chainDialog);
+    chainRun_button = new QPushButton(tr("計算"), chainDialog);
+    chainStatus_label = new QLabel(chainDialog);
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("輸入電壓 Vin (V)"), chainVin_lineEdit);
+    form->addRow(tr("分接電壓 (V)"), chainTaps_lineEdit);
+    form->addRow(tr("最大電流 (mA)"), chainMaxI_lineEdit);
+    form->addRow(tr("時間上限 (ms)"), chainBudget_lineEdit);
+    form->addRow(chainRun_button, chainStatus_label);
+
+    chainTable = new QTableWidget(0, 4, chainDialog);
+    chainTable->setHorizontalHeaderLabels({tr("電阻"), tr("下方分接 (V)"), tr("目標 (V)"), tr("誤差 (%)")});
+    chainTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    chainTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    QVBoxLayout *dialogLayout = new QVBoxLayout(chainDialog);
+    dialogLayout->addLayout(form);
+    dialogLayout->addWidget(chainTable);
+
+    connect(openButton, &QPushButton::clicked, this, [this]() {
+        if (chainVin_lineEdit->text().isEmpty())
+            chainVin_lineEdit->setText(ui->VI_Input_lineEdit->text());
+        chainDialog->show();
+        chainDialog->raise();
+    });
+    connect(chainRun_button, &QPushButton::clicked, this, &Voltage_Divider::runChainSearch);
+}
+
+void Voltage_Divider::runChainSearch() {
+    // 搜尋中再按一次 = 取消，保留目前最佳解
+    if (chainThread) {
+        chainCancel = true;
+        return;
+    }
+
+    bool okVin, okI, okBudget;
+    const double Vin = handler->parseValue(chainVin_lineEdit->text(), &okVin);
+    const double maxI_mA = handler->parseValue(chainMaxI_lineEdit->text(), &okI);
+    const double budget = handler->parseValue(chainBudget_lineEdit->text(), &okBudget);
+
+    std::vector<double> taps;
+    const QStringList parts = chainTaps_lineEdit->text().split(QRegularExpression("[,;]"), Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        bool ok;
+        double v = handler->parseValue(part, &ok);
+        if (!ok || !(v > 0 && v < Vin)) {
+            chainStatus_label->setText(tr("分接電壓需介於 0 與 Vin 之間"));
+            return;
+        }
+        taps.push_back(v);
+    }
+    if (!okVin || taps.empty()) {
+        chainStatus_label->setText(tr("請輸入 Vin 與分接電壓"));
+        return;
+    }
+
+    sc::ChainSearchOptions opt;
+    opt.series = PAIR_SERIES[qBound(0, seriesCombo->currentIndex(), 4)];
+    opt.minResistor_ohm = 10;
+    opt.maxResistor_ohm = 10e6;
+    if (okI && maxI_mA > 0) opt.maxCurrent_A = maxI_mA * 1e-3;
+    opt.timeBudget_ms = (okBudget && budget >= 0) ? budget : 500;
+    opt.cancel = &chainCancel;
+
+    std::sort(taps.begin(), taps.end(), std::greater<double>());
+    chainTargets = taps;
+    chainTable->setRowCount(0);
+    chainStatus_label->setText(tr("搜尋中..."));
+    chainRun_button->setText(tr("停止"));
+    chainCancel = false;
+
+    // 進度回呼在工作執行緒上，透過 queued 呼叫轉回 GUI 執行緒
+    chainThread = QThread::create([this, Vin, taps, opt]() {
+        sc::ChainSearchResult r = sc::solveDividerChain(Vin, taps, opt, [this](const sc::ChainSolution &s) {
+            QMetaObject::invokeMethod(chainDialog, [this, s]() { showChainSolution(s); }, Qt::QueuedConnection);
+        });
+        QMetaObject::invokeMethod(chainDialog, [this, r]() {
+            if (r.found) showChainSolution(r.best);
+            chainStatus_label->setText(r.found
+                ? tr("%1，%2 ms").arg(r.complete ? tr("已是最佳解") : tr("時間到，目前最佳解"))
+                                  .arg(r.elapsed_ms, 0, 'f', 1)
+                : tr("找不到符合限制的組合"));
+        }, Qt::QueuedConnection);
+    });
+    connect(chainThread, &QThread::finished, this, [this]() {
+        chainThread->deleteLater();
+        chainThread = nullptr;
+        chainRun_button->setText(tr("計算"));
+    });
+    chainThread->start();
+}
+
+void Voltage_Divider::showChainSolution(const sc::ChainSolution &solution) {
+    const int n = static_cast<int>(solution.resistors_ohm.size());
+    chainTable->setRowCount(n);
+    for (int i = 0; i < n; ++i) {
+        chainTable->setItem(i, 0, new QTableWidgetItem(formatOhm(solution.resistors_ohm[static_cast<size_t>(i)])));
+        // 最後一顆電阻接 GND，下方沒有分接點
+        if (i < static_cast<int>(solution.tapVoltages.size()) && i < static_cast<int>(chainTargets.size())) {
+            const double v = solution.tapVoltages[static_cast<size_t>(i)];
+            const double target = chainTargets[static_cast<size_t>(i)];
+            chainTable->setItem(i, 1, new QTableWidgetItem(QString::number(v, 'g', 6)));
+            chainTable->setItem(i, 2, new QTableWidgetItem(QString::number(target, 'g', 6)));
+            chainTable->setItem(i, 3, new QTableWidgetItem(QString::number((v / target - 1) * 100, 'g', 3)));
+        } else {
+            chainTable->setItem(i, 1, new QTableWidgetItem("GND"));
+            chainTable->setItem(i, 2, new QTableWidgetItem());
+            chainTable->setItem(i, 3, new QTableWidgetItem());
+        }
+    }
+    chainStatus_label->setText(tr("最大誤差 %1 %，電流 %2 mA")
+                                   .arg(solution.maxError * 100, 0, 'g', 3)
+                                   .arg(solution.current_A * 1e3, 0, 'g', 4));
+}
+
+void Voltage_Divider::openToleranceAnalysis() {
+    // 以畫面上目前的 Vi、R1、R2 當標稱值 (反算模式下 R1/R2 是計算結果)
+    bool okVi, okR1, okR2;
+    const double Vi = handler->parseValue(ui->VI_Input_lineEdit->text(), &okVi);
+    const double R1 = ResistorUnitList::from(handler->parseValue(ui->R1_Input_lineEdit->text(), &okR1),
+                                             ui->R1_input_comboBox->currentIndex()).in<sc::units::Ohm>();
+    const double R2 = ResistorUnitList::from(handler->parseValue(ui->R2_Input_lineEdit->text(), &okR2),
+                                             ui->R2_input_comboBox->currentIndex()).in<sc::units::Ohm>();
+    if (okVi && okR1 && okR2 && R1 > 0 && R2 > 0) {
+        toleranceDialog->setModel({ { TOL_VI, Vi, DEFAULT_VI_TOL, sc::Distribution::Normal },
+                                    { TOL_R1, R1, DEFAULT_R_TOL, sc::Distribution::TruncatedNormal },
+                                    { TOL_R2, R2, DEFAULT_R_TOL, sc::Distribution::TruncatedNormal } },
+                                  "Vo (V)", sc::dividerVoModel(), sc::dividerVo(Vi, R1, R2));
+    }
+    toleranceDialog->show();
+    toleranceDialog->raise();
+}
+
+void Voltage_Divider::updateStandardPairs() {
+    if (!pairDialog || !pairDialog->isVisible()) return;
+
+    // 只有在反算 R1/R2 時才重新搜尋；套用組合後會切到「求 Vo」，清單保持不動方便比較
+    const int mode = ui->calcMode_comboBox->currentIndex();
+    if (mode != static_cast<int>(sc::DividerSolve::R1) && mode != static_cast<int>(sc::DividerSolve::R2)
+        && pairTable->rowCount() > 0)
+        return;
+
+    bool okVi, okVo, okMin, okMax, okI;
+    double Vi = handler->parseValue(ui->VI_Input_lineEdit->text(), &okVi);
+    double Vo = handler->parseValue(ui->Vo_Input_lineEdit->text(), &okVo);
+
+    sc::DividerSearchOptions opt;
+    opt.series = PAIR_SERIES[qBound(0, seriesCombo->currentIndex(), 4)];
+    opt.minResistor_ohm = handler->parseValue(pairMinR_lineEdit->text(), &okMin);
+    opt.maxResistor_ohm = handler->parseValue(pairMaxR_lineEdit->text(), &okMax);
+    double maxI_mA = handler->parseValue(pairMaxI_lineEdit->text(), &okI);
+
+    pairTable->setRowCount(0);
+    if (!okVi || !okVo || !okMin || !okMax) return;
+
+    // 搜尋本身在 1 ms 以內 (E192、7 個 decade)，可以跟著按鍵即時更新
+    const std::vector<sc::DividerPair> pairs = sc::dividerBestPairs(
+        Vi, Vo, opt, (okI && maxI_mA > 0) ? maxI_mA * 1e-3 : HUGE_VAL);
+
+    pairTable->setRowCount(static_cast<int>(pairs.size()));
+    for (int row = 0; row < static_cast<int>(pairs.size()); ++row) {
+        const sc::DividerPair &p = pairs[static_cast<size_t>(row)];
+        const double total = p.R1_ohm + p.R2_ohm;
+        QTableWidgetItem *r1 = new QTableWidgetItem(formatOhm(p.R1_ohm));
+        r1->setData(Qt::UserRole, p.R1_ohm);
+        QTableWidgetItem *r2 = new QTableWidgetItem(formatOhm(p.R2_ohm));
+        r2->setData(Qt::UserRole, p.R2_ohm);
+        pairTable->setItem(row, 0, r1);
+        pairTable->setItem(row, 1, r2);
+        pairTable->setItem(row, 2, new QTableWidgetItem(QString::number(Vi * p.ratio, 'g', 6)));
+        pairTable->setItem(row, 3, new QTableWidgetItem(QString::number(p.error * 100, 'g', 3)));
+        pairTable->setItem(row, 4, new QTableWidgetItem(QString::number(Vi / total * 1e3, 'g', 4)));
+    }
+}
+
+void Voltage_Divider::applyStandardPair(int row) {
+    QTableWidgetItem *r1 = pairTable->item(row, 0);
+    QTableWidgetItem *r2 = pairTable->item(row, 1);
+    if (!r1 || !r2) return;
+
+    // 套用兩顆電阻後改成「求 Vo」，直接看到實際輸出電壓
+    ui->calcMode_comboBox->setCurrentIndex(static_cast<int>(sc::DividerSolve::Vo));
+    const double r1Ohm = r1->data(Qt::UserRole).toDouble();
+    const double r2Ohm = r2->data(Qt::UserRole).toDouble();
+    ui->R1_Input_lineEdit->setText(QString::number(
+        ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(r1Ohm), ui->R1_input_comboBox->currentIndex()), 'g', 6));
+    ui->R2_Input_lineEdit->setText(QString::number(
+        ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(r2Ohm), ui->R2_input_comboBox->currentIndex()), 'g', 6));
+}
+
+void Voltage_Divider::setupFeedbackDesign(QPushButton *openButton) {
+    feedbackDialog = new QDialog(this);
+    feedbackDialog->setWindowTitle(tr("穩壓器回授電阻"));
+    feedbackDialog->resize(720, 440);
+
+    feedbackVref_lineEdit = new QLineEdit("0.8", feedbackDialog);
+    feedbackVouts_lineEdit = new QLineEdit("3.3, 5, 1.8", feedbackDialog);
+    feedbackVouts_lineEdit->setToolTip(tr("以逗號分隔的輸出電壓 (V)，每個電壓各列出最佳組合"));
+    feedbackMaxI_lineEdit = new QLineEdit("100", feedbackDialog);
+    feedbackMaxI_lineEdit->setPlaceholderText(tr("不限制"));
+    feedbackVrefTol_lineEdit = new QLineEdit("1", feedbackDialog);
+    feedbackRTol_lineEdit = new QLineEdit("1", feedbackDialog);
+    feedbackMinR_lineEdit = new QLineEdit("1k", feedbackDialog);
+    feedbackMaxR_lineEdit = new QLineEdit("1M", feedbackDialog);
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("回授參考電壓 Vref (V)"), feedbackVref_lineEdit);
+    form->addRow(tr("輸出電壓 (V)"), feedbackVouts_lineEdit);
+    form->addRow(tr("最大分壓電流 (µA)"), feedbackMaxI_lineEdit);
+    form->addRow(tr("Vref 精度 (±%)"), feedbackVrefTol_lineEdit);
+    form->addRow(tr("電阻公差 (±%)"), feedbackRTol_lineEdit);
+    form->addRow(tr("最小電阻 (Ω)"), feedbackMinR_lineEdit);
+    form->addRow(tr("最大電阻 (Ω)"), feedbackMaxR_lineEdit);
+
+    feedbackTable = new QTableWidget(0, 8, feedbackDialog);
+    feedbackTable->setHorizontalHeaderLabels({tr("目標 (V)"), "R1", "R2", "Vout (V)", tr("誤差 (%)"),
+                                              tr("最差範圍 (V)"), tr("最差誤差 (%)"), tr("電流 (µA)")});
+    feedbackTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    feedbackTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    feedbackTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    feedbackTable->setToolTip(tr("R1 接 Vout 到 FB，R2 接 FB 到 GND；雙擊套用到分壓計算"));
+
+    QVBoxLayout *dialogLayout = new QVBoxLayout(feedbackDialog);
+    dialogLayout->addLayout(form);
+    dialogLayout->addWidget(feedbackTable);
+
+    connect(openButton, &QPushButton::clicked, this, [this]() {
+        feedbackDialog->show();
+        feedbackDialog->raise();
+        updateFeedbackPairs();
+    });
+    connect(seriesCombo, &QComboBox::currentIndexChanged, this, &Voltage_Divider::updateFeedbackPairs);
+    for (QLineEdit *e : { feedbackVref_lineEdit, feedbackVouts_lineEdit, feedbackMaxI_lineEdit,
+                          feedbackVrefTol_lineEdit, feedbackRTol_lineEdit, feedbackMinR_lineEdit,
+                          feedbackMaxR_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &Voltage_Divider::updateFeedbackPairs);
+    connect(feedbackTable, &QTableWidget::cellDoubleClicked, this, &Voltage_Divider::applyFeedbackPair);
+}
+
+void Voltage_Divider::updateFeedbackPairs() {
+    if (!feedbackDialog || !feedbackDialog->isVisible()) return;
+    feedbackTable->setRowCount(0);
+
+    bool okVref, okI, okVrefTol, okRTol, okMin, okMax;
+    const double Vref = handler->parseValue(feedbackVref_lineEdit->text(), &okVref);
+    const double maxI_uA = handler->parseValue(feedbackMaxI_lineEdit->text(), &okI);
+    const double vrefTol = handler->parseValue(feedbackVrefTol_lineEdit->text(), &okVrefTol);
+    const double rTol = handler->parseValue(feedbackRTol_lineEdit->text(), &okRTol);
+
+    sc::FeedbackOptions opt;
+    opt.series = PAIR_SERIES[qBound(0, seriesCombo->currentIndex(), 4)];
+    opt.minResistor_ohm = handler->parseValue(feedbackMinR_lineEdit->text(), &okMin);
+    opt.maxResistor_ohm = handler->parseValue(feedbackMaxR_lineEdit->text(), &okMax);
+    if (okI && maxI_uA > 0) opt.maxCurrent_A = maxI_uA * 1e-6;
+    if (okVrefTol && vrefTol >= 0) opt.vrefTolerance = vrefTol / 100;
+    if (okRTol && rTol >= 0) opt.resistorTolerance = rTol / 100;
+    opt.topK = 5;
+    if (!okVref || !okMin || !okMax) return;
+
+    std::vector<double> vouts;
+    const QStringList parts = feedbackVouts_lineEdit->text().split(QRegularExpression("[,;]"), Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        bool ok;
+        const double v = handler->parseValue(part, &ok);
+        if (ok) vouts.push_back(v);
+    }
+
+    // 比值索引在第一次使用時建立 (E192 約 10 ms)，之後每個目標只是一次二分搜尋
+    const std::vector<std::vector<sc::FeedbackPair>> results = sc::feedbackBestPairs(Vref, vouts, opt);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        for (const sc::FeedbackPair &p : results[i]) {
+            const int row = feedbackTable->rowCount();
+            feedbackTable->insertRow(row);
+            QTableWidgetItem *target = new QTableWidgetItem(QString::number(vouts[i], 'g', 6));
+            target->setData(Qt::UserRole, p.Vout_V);
+            QTableWidgetItem *r1 = new QTableWidgetItem(formatOhm(p.R1_ohm));
+            r1->setData(Qt::UserRole, p.R1_ohm);
+            QTableWidgetItem *r2 = new QTableWidgetItem(formatOhm(p.R2_ohm));
+            r2->setData(Qt::UserRole, p.R2_ohm);
+            feedbackTable->setItem(row, 0, target);
+            feedbackTable->setItem(row, 1, r1);
+            feedbackTable->setItem(row, 2, r2);
+            feedbackTable->setItem(row, 3, new QTableWidgetItem(QString::number(p.Vout_V, 'g', 6)));
+            feedbackTable->setItem(row, 4, new QTableWidgetItem(QString::number(p.error * 100, 'g', 3)));
+            feedbackTable->setItem(row, 5, new QTableWidgetItem(QString("%1 ~ %2")
+                                                                    .arg(p.worstMin_V, 0, 'g', 5)
+                                                                    .arg(p.worstMax_V, 0, 'g', 5)));
+            feedbackTable->setItem(row, 6, new QTableWidgetItem(QString::number(p.worstError * 100, 'g', 3)));
+            feedbackTable->setItem(row, 7, new QTableWidgetItem(QString::number(p.current_A * 1e6, 'g', 4)));
+        }
+    }
+}
+
+void Voltage_Divider::applyFeedbackPair(int row) {
+    QTableWidgetItem *target = feedbackTable->item(row, 0);
+    QTableWidgetItem *r1 = feedbackTable->item(row, 1);
+    QTableWidgetItem *r2 = feedbackTable->item(row, 2);
+    if (!target || !r1 || !r2) return;
+
+    // 回授網路就是 Vi = Vout 的分壓：套用後「求 Vo」顯示的就是 FB 電壓，應等於 Vref
+    ui->calcMode_comboBox->setCurrentIndex(static_cast<int>(sc::DividerSolve::Vo));
+    ui->VI_Input_lineEdit->setText(QString::number(target->data(Qt::UserRole).toDouble(), 'g', 6));
+    ui->R1_Input_lineEdit->setText(QString::number(
+        ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(r1->data(Qt::UserRole).toDouble()),
+                             ui->R1_input_comboBox->currentIndex()), 'g', 6));
+    ui->R2_Input_lineEdit->setText(QString::number(
+        ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(r2->data(Qt::UserRole).toDouble()),
+                             ui->R2_input_comboBox->currentIndex()), 'g', 6));
+}
+
 Voltage_Divider::~Voltage_Divider()
 {
+    // 背景搜尋還在跑的話先取消並等它結束
+    if (chainThread) {
+        chainCancel = true;
+        chainThread->wait();
+        delete chainThread;
+    }
     delete ui;
 }
 
@@ -94,42 +545,48 @@ void Voltage_Divider::updateVoltageDivider() {
     bool okVi, okVo, okR1, okR2;
 
     // 取得所有數值
-    double Vi = ui->VI_Input_lineEdit->text().toDouble(&okVi);
-    double Vo = ui->Vo_Input_lineEdit->text().toDouble(&okVo);
-    double R1_val = ui->R1_Input_lineEdit->text().toDouble(&okR1);
-    double R2_val = ui->R2_Input_lineEdit->text().toDouble(&okR2);
+    double Vi = handler->parseValue(ui->VI_Input_lineEdit->text(), &okVi);
+    double Vo = handler->parseValue(ui->Vo_Input_lineEdit->text(), &okVo);
+    double R1_val = handler->parseValue(ui->R1_Input_lineEdit->text(), &okR1);
+    double R2_val = handler->parseValue(ui->R2_Input_lineEdit->text(), &okR2);
 
     // 換算電阻基準值 (Ohm)
-    double R1_ohm = R1_val * std::pow(10, (ui->R1_input_comboBox->currentIndex() * 3));
-    double R2_ohm = R2_val * std::pow(10, (ui->R2_input_comboBox->currentIndex() * 3));
+    double R1_ohm = ResistorUnitList::from(R1_val, ui->R1_input_comboBox->currentIndex()).base();
+    double R2_ohm = ResistorUnitList::from(R2_val, ui->R2_input_comboBox->currentIndex()).base();
 
     switch (mode) {
     case 0: // 求 Vo = Vi * (R2 / (R1 + R2))
-        if (okVi && okR1 && okR2 && (R1_ohm + R2_ohm) != 0) {
-            double res = Vi * (R2_ohm / (R1_ohm + R2_ohm));
-            ui->Vo_Input_lineEdit->setText(QString::number(res, 'g', 6));
+        if (okVi && okR1 && okR2) {
+            double res = sc::dividerVo(Vi, R1_ohm, R2_ohm);
+            if (std::isfinite(res))
+                ui->Vo_Input_lineEdit->setText(QString::number(res, 'g', 6));
         }
         break;
 
     case 1: // 求 Vi = Vo * (R1 + R2) / R2
-        if (okVo && okR1 && okR2 && R2_ohm != 0) {
-            double res = Vo * (R1_ohm + R2_ohm) / R2_ohm;
-            ui->VI_Input_lineEdit->setText(QString::number(res, 'g', 6));
+        if (okVo && okR1 && okR2) {
+            double res = sc::dividerVi(Vo, R1_ohm, R2_ohm);
+            if (std::isfinite(res))
+                ui->VI_Input_lineEdit->setText(QString::number(res, 'g', 6));
         }
         break;
 
     case 2: // 求 R1 = R2 * (Vi - Vo) / Vo
-        if (okVi && okVo && okR2 && Vo != 0) {
-            double res_ohm = R2_ohm * (Vi - Vo) / Vo;
-            double display = res_ohm / std::pow(10, (ui->R1_input_comboBox->currentIndex() * 3));
+        if (okVi && okVo && okR2) {
+            double res_ohm = sc::dividerR1(Vi, Vo, R2_ohm);
+            if (!std::isfinite(res_ohm)) break;
+            double display = ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(res_ohm),
+                                                  ui->R1_input_comboBox->currentIndex());
             ui->R1_Input_lineEdit->setText(QString::number(display, 'g', 6));
         }
         break;
 
     case 3: // 求 R2 = R1 * Vo / (Vi - Vo)
-        if (okVi && okVo && okR1 && (Vi - Vo) != 0) {
-            double res_ohm = R1_ohm * Vo / (Vi - Vo);
-            double display = res_ohm / std::pow(10, (ui->R2_input_comboBox->currentIndex() * 3));
+        if (okVi && okVo && okR1) {
+            double res_ohm = sc::dividerR2(Vi, Vo, R1_ohm);
+            if (!std::isfinite(res_ohm)) break;
+            double display = ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(res_ohm),
+                                                  ui->R2_input_comboBox->currentIndex());
             ui->R2_Input_lineEdit->setText(QString::number(display, 'g', 6));
         }
         break;
@@ -138,6 +595,44 @@ void Voltage_Divider::updateVoltageDivider() {
         break;
     }
 
+    updateWorstCase();
     isCalculating = false; // 計算結束，解鎖
 }
 
+void Voltage_Divider::updateWorstCase() {
+    if (!worstCase_label) return;
+
+    // 計算完成後畫面上的四個值都是標稱值
+    bool okVi, okVo, okR1, okR2;
+    const double Vi = handler->parseValue(ui->VI_Input_lineEdit->text(), &okVi);
+    const double Vo = handler->parseValue(ui->Vo_Input_lineEdit->text(), &okVo);
+    const double R1 = ResistorUnitList::from(handler->parseValue(ui->R1_Input_lineEdit->text(), &okR1),
+                                             ui->R1_input_comboBox->currentIndex()).base();
+    const double R2 = ResistorUnitList::from(handler->parseValue(ui->R2_Input_lineEdit->text(), &okR2),
+                                             ui->R2_input_comboBox->currentIndex()).base();
+    if (!okVi || !okVo || !okR1 || !okR2 || !(R1 > 0) || !(R2 > 0)) {
+        worstCase_label->clear();
+        return;
+    }
+
+    const sc::Interval r1 = sc::resistorInterval(R1, toleranceDialog->toleranceFor(TOL_R1, DEFAULT_R_TOL),
+                                                 WORST_TCR_PPM, WORST_T_MIN_C, WORST_T_MAX_C);
+    const sc::Interval r2 = sc::resistorInterval(R2, toleranceDialog->toleranceFor(TOL_R2, DEFAULT_R_TOL),
+                                                 WORST_TCR_PPM, WORST_T_MIN_C, WORST_T_MAX_C);
+
+    // 求 Vi 時顯示所需 Vi 的範圍；其他模式顯示電路實際輸出 Vo 的範圍 (R1/R2 以算出的值為標稱值)
+    const auto mode = static_cast<sc::DividerSolve>(ui->calcMode_comboBox->currentIndex());
+    sc::Interval range;
+    QString name;
+    if (mode == sc::DividerSolve::Vi) {
+        range = sc::dividerSolveInterval(mode, sc::point(0), sc::point(Vo), r1, r2);
+        name = "Vi";
+    } else {
+        const sc::Interval vi = sc::tolerance(Vi, toleranceDialog->toleranceFor(TOL_VI, DEFAULT_VI_TOL));
+        range = sc::dividerSolveInterval(sc::DividerSolve::Vo, vi, sc::point(0), r1, r2);
+        name = "Vo";
+    }
+    worstCase_label->setText(tr("%1 最差情況：%2 ~ %3 V")
+                                 .arg(name).arg(range.lower(), 0, 'g', 5).arg(range.upper(), 0, 'g', 5));
+}
+
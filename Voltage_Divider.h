@@ -3,6 +3,19 @@
 
 #include <QWidget>
 #include "UnitConverterHandler.h"
+#include "DividerChain.h"
+
+#include <atomic>
+#include <vector>
+
+class MonteCarloDialog;
+class QComboBox;
+class QDialog;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QTableWidget;
+class QThread;
 
 namespace Ui {
 class Voltage_Divider;
@@ -24,10 +37,59 @@ private:
     UnitConverterHandler *handler; // <--- 在這裡宣告它！
     bool isCalculating = false;
 
+    // 標準值組合搜尋 (程式建立的元件)
+    void setupStandardPairSearch();
+    QComboBox *seriesCombo = nullptr;
+    QDialog *pairDialog = nullptr;
+    QLineEdit *pairMinR_lineEdit = nullptr;
+    QLineEdit *pairMaxR_lineEdit = nullptr;
+    QLineEdit *pairMaxI_lineEdit = nullptr;
+    QTableWidget *pairTable = nullptr;
+
+    // 多段分壓 (電阻串) 搜尋：在背景執行緒進行，找到更好的解就更新表格
+    void setupChainSearch(QPushButton *openButton);
+    void showChainSolution(const sc::ChainSolution &solution);
+    QDialog *chainDialog = nullptr;
+    QLineEdit *chainVin_lineEdit = nullptr;
+    QLineEdit *chainTaps_lineEdit = nullptr;
+    QLineEdit *chainMaxI_lineEdit = nullptr;
+    QLineEdit *chainBudget_lineEdit = nullptr;
+    QPushButton *chainRun_button = nullptr;
+    QLabel *chainStatus_label = nullptr;
+    QTableWidget *chainTable = nullptr;
+    QThread *chainThread = nullptr;
+    std::atomic<bool> chainCancel{false};
+    std::vector<double> chainTargets;       // 目前顯示結果對應的目標分接電壓 (由高到低)
+
+    // 穩壓器回授電阻：Vref + 多個目標 Vout，依誤差列出標準值組合
+    void setupFeedbackDesign(QPushButton *openButton);
+    QDialog *feedbackDialog = nullptr;
+    QLineEdit *feedbackVref_lineEdit = nullptr;
+    QLineEdit *feedbackVouts_lineEdit = nullptr;
+    QLineEdit *feedbackMaxI_lineEdit = nullptr;
+    QLineEdit *feedbackVrefTol_lineEdit = nullptr;
+    QLineEdit *feedbackRTol_lineEdit = nullptr;
+    QLineEdit *feedbackMinR_lineEdit = nullptr;
+    QLineEdit *feedbackMaxR_lineEdit = nullptr;
+    QTableWidget *feedbackTable = nullptr;
+
+    // 公差分析 (Monte Carlo)：Vi、R1、R2 的公差對 Vo 的影響
+    MonteCarloDialog *toleranceDialog = nullptr;
+
+    // 最差情況範圍 (區間運算)，公差與公差分析視窗共用
+    QLabel *worstCase_label = nullptr;
+    void updateWorstCase();
+
 
 public slots:
     void updateVoltageDivider();
     void onVoltageModeChanged();
+    void updateStandardPairs();
+    void applyStandardPair(int row);
+    void runChainSearch();
+    void updateFeedbackPairs();
+    void applyFeedbackPair(int row);
+    void openToleranceAnalysis();
 
 };
 
@@ -1,7 +1,53 @@
 #include "ledcurrentlimit.h"
 #include "ui_ledcurrentlimit.h"
+
+#include "LedCalc.h"
+#include "LedArray.h"
+#include "LedModel.h"
+#include "LedModelDialog.h"
+#include "LedThermal.h"
+#include "MonteCarloDialog.h"
 //#include "UnitConverterHandler.h"
 
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDialog>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// 下拉選單順序對應的限流電阻系列
+const sc::ESeries ARRAY_SERIES[] = { sc::ESeries::E12, sc::ESeries::E24, sc::ESeries::E48, sc::ESeries::E96 };
+
+// 以數值排序的表格欄位：顯示文字取有效位數，排序用 UserRole 中的原始數值
+class NumberItem : public QTableWidgetItem
+{
+public:
+    NumberItem(double value, int precision) : QTableWidgetItem(QString::number(value, 'g', precision))
+    {
+        setData(Qt::UserRole, value);
+    }
+
+    bool operator<(const QTableWidgetItem &other) const override
+    {
+        return data(Qt::UserRole).toDouble() < other.data(Qt::UserRole).toDouble();
+    }
+};
+
+} // namespace
+
 
 LED_current_limit::LED_current_limit(UnitConverterHandler *sharedHandler, QWidget *parent) :
     QWidget(parent),
@@ -34,6 +80,28 @@ LED_current_limit::LED_current_limit(UnitConverterHandler *sharedHandler, QWidge
     connect(ui->Series_Input_lineEdit, &QLineEdit::textChanged, this, &LED_current_limit::updateLEDCalculator);
     connect(ui->Parallel_Input_lineEdit, &QLineEdit::textChanged, this, &LED_current_limit::updateLEDCalculator);
 
+    // 公差分析：用算出來的電阻看實際 LED 電流的分布
+    QPushButton *toleranceButton = new QPushButton(tr("公差分析..."), this);
+    toleranceButton->setGeometry(260, 370, 211, 31);
+    toleranceDialog = new MonteCarloDialog(handler, tr("LED 電流公差分析"), this);
+    connect(toleranceButton, &QPushButton::clicked, this, &LED_current_limit::openToleranceAnalysis);
+
+    // LED 模型：小電流時固定 Vd 誤差很大，改用 I-V 曲線
+    QPushButton *modelButton = new QPushButton(tr("LED 模型..."), this);
+    modelButton->setGeometry(260, 450, 211, 31);
+    modelDialog = new LedModelDialog(handler, this);
+    connect(modelButton, &QPushButton::clicked, this, [this]() {
+        modelDialog->show();
+        modelDialog->raise();
+        updateLEDCalculator();
+    });
+    connect(modelDialog, &LedModelDialog::modelChanged, this, &LED_current_limit::updateLEDCalculator);
+
+    // 電熱耦合：原本只在電阻功耗 > 0.25 W 時標紅，這裡把溫度對 Vf、電流與電阻額定的影響一起算進來
+    setupThermalAnalysis();
+
+    // 陣列組態：給定 LED 數量與電源範圍，找出適合的串並聯方式與電阻
+    setupArraySearch();
 }
 
 LED_current_limit ::~LED_current_limit ()
@@ -47,9 +115,18 @@ void LED_current_limit::updateLEDCalculator() {
     if (!handler) return;
 
     bool okVcc, okVd, okI,okS, okP;
-    double vcc = ui->VCCIO_Input_lineEdit->text().toDouble(&okVcc);
-    double vd = ui->VD_Input_lineEdit->text().toDouble(&okVd);
-    double current = ui->D1_Input_lineEdit->text().toDouble(&okI);
+    double vcc = handler->parseValue(ui->VCCIO_Input_lineEdit->text(), &okVcc);
+    double current = handler->parseValue(ui->D1_Input_lineEdit->text(), &okI);
+
+    // 模型模式：Vd 欄位改為唯讀，顯示模型在目前電流下的 Vf
+    const bool useModel = modelDialog && modelDialog->modelEnabled();
+    ui->VD_Input_lineEdit->setReadOnly(useModel);
+    if (useModel && okI) {
+        const double currentA = CurrentUnitList::from(current, ui->D1_input_comboBox->currentIndex()).in<sc::units::A>();
+        const QSignalBlocker blocker(ui->VD_Input_lineEdit);
+        ui->VD_Input_lineEdit->setText(QString::number(sc::ledForwardVoltage(modelDialog->model(), currentA), 'g', 5));
+    }
+    double vd = handler->parseValue(ui->VD_Input_lineEdit->text(), &okVd);
 
     // 讀取串並聯數量，如果沒填或填錯，預設為 1
     int series = ui->Series_Input_lineEdit->text().toInt(&okS);
@@ -65,7 +142,7 @@ void LED_current_limit::updateLEDCalculator() {
 
         // 2. 呼叫邏輯層計算基準電阻 (Ohm)
 
-        LEDResult result = calculateLEDComplex(vcc, vd, current, iUnitIdx, series, parallel);
+        sc::LEDResult result = calculateLEDComplex(vcc, vd, current, iUnitIdx, series, parallel);
 
         if (!result.isVoltageOk) {
             ui->limit_Input_lineEdit->setText("Vcc < 總Vd!");
@@ -75,11 +152,13 @@ void LED_current_limit::updateLEDCalculator() {
 
         // 顯示電阻結果
         int rUnitIdx = ui->limit_Input_comboBox->currentIndex();
-        double displayR = result.resistance;
-        if (rUnitIdx == 1) displayR /= 1000.0;
-        else if (rUnitIdx == 2) displayR /= 1000000.0;
+        double displayR = ResistorUnitList::to(sc::units::quantity<sc::units::Ohm>(result.resistance), rUnitIdx);
 
         ui->limit_Input_lineEdit->setText(QString::number(displayR, 'g', 6));
+        // 計算頁是整組共用一顆電阻，換成模型的「每串一顆」是 parallel 倍
+        if (modelDialog && modelDialog->isVisible())
+            modelDialog->setCircuit(result.resistance * parallel, series, parallel);
+        updateThermalAnalysis();
 
         // 顯示功耗結果 (W)
         ui->W_Input_lineEdit->setText(QString::number(result.wattage, 'g', 4));
@@ -99,46 +178,340 @@ void LED_current_limit::updateLEDCalculator() {
 
 double LED_current_limit::calculateLEDResistor(double vcc, double vd, double current, int currentUnitIdx) {
 
-    if (current <= 0) return 0;
+    // 將電流換算為標準單位 A (Ampere)
+    double currentA = CurrentUnitList::from(current, currentUnitIdx).in<sc::units::A>();
 
-    // 1. 將電流換算為標準單位 A (Ampere)
-    double currentA = current;
-    if (currentUnitIdx == 1) currentA = current / 1000.0;      // mA -> A
-    else if (currentUnitIdx == 2) currentA = current / 1000000.0; // uA -> A
+    // R = (Vcc - Vd) / I，電壓不足時回傳 -1
+    return sc::ledResistor(vcc, vd, currentA);
+}
+
+sc::LEDResult LED_current_limit::calculateLEDComplex(double vcc, double vd, double current, int iUnitIdx, int series, int parallel) {
+
+    // 處理電流單位換算 (換算為 A)，串並聯的計算交給 sc_core
+    double branchCurrentA = CurrentUnitList::from(current, iUnitIdx).in<sc::units::A>();
+
+    return sc::ledSolve(vcc, vd, branchCurrentA, series, parallel);
+}
+
+void LED_current_limit::openToleranceAnalysis() {
+    bool okVcc, okVd, okR, okS, okP;
+    const double vcc = handler->parseValue(ui->VCCIO_Input_lineEdit->text(), &okVcc);
+    const double vd = handler->parseValue(ui->VD_Input_lineEdit->text(), &okVd);
+    const double r = ResistorUnitList::from(handler->parseValue(ui->limit_Input_lineEdit->text(), &okR),
+                                            ui->limit_Input_comboBox->currentIndex()).in<sc::units::Ohm>();
+    int series = ui->Series_Input_lineEdit->text().toInt(&okS);
+    if (!okS || series < 1) series = 1;
+    int parallel = ui->Parallel_Input_lineEdit->text().toInt(&okP);
+    if (!okP || parallel < 1) parallel = 1;
 
-    // 2. 檢查壓差是否合理 (Vcc 必須大於 Vd)
-    if (vcc <= vd) return -1; // 回傳 -1 代表電壓不足以驅動 LED
+    if (okVcc && okVd && okR && r > 0) {
+        const double nominal_A = std::max(vcc - vd * series, 0.0) / (r * parallel);
+        toleranceDialog->setModel({ { "Vcc (V)", vcc, 0.05, sc::Distribution::Normal },
+                                    { "Vd (V)", vd, 0.05, sc::Distribution::Uniform },
+                                    { "R (Ω)", r, 0.05, sc::Distribution::TruncatedNormal } },
+                                  tr("每串電流 (mA)"), sc::ledBranchCurrentModel(series, parallel),
+                                  nominal_A, 1e3);
+    }
+    toleranceDialog->show();
+    toleranceDialog->raise();
+}
 
-    // 3. 歐姆定律：R = (Vcc - Vd) / I
-    return (vcc - vd) / currentA;
+void LED_current_limit::setupArraySearch() {
+    QPushButton *arrayButton = new QPushButton(tr("陣列組態..."), this);
+    arrayButton->setGeometry(260, 410, 211, 31);
+
+    arrayDialog = new QDialog(this);
+    arrayDialog->setWindowTitle(tr("LED 陣列組態"));
+    arrayDialog->resize(760, 480);
+
+    arrayCount_lineEdit = new QLineEdit("12", arrayDialog);
+    arrayVccMin_lineEdit = new QLineEdit("11.4", arrayDialog);
+    arrayVccMax_lineEdit = new QLineEdit("12.6", arrayDialog);
+    arrayVdMin_lineEdit = new QLineEdit("2.9", arrayDialog);
+    arrayVdMax_lineEdit = new QLineEdit("3.2", arrayDialog);
+    arrayIMin_lineEdit = new QLineEdit("15", arrayDialog);
+    arrayIMax_lineEdit = new QLineEdit("25", arrayDialog);
+    arrayPower_lineEdit = new QLineEdit(arrayDialog);
+    arrayPower_lineEdit->setPlaceholderText(tr("不限制"));
+    arraySeries_comboBox = new QComboBox(arrayDialog);
+    arraySeries_comboBox->addItems({"E12", "E24", "E48", "E96"});
+    arraySeries_comboBox->setCurrentIndex(1);
+    arrayParetoOnly_checkBox = new QCheckBox(tr("只顯示 Pareto 前緣"), arrayDialog);
+    arrayParetoOnly_checkBox->setChecked(true);
+    arrayStatus_label = new QLabel(arrayDialog);
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("LED 數量"), arrayCount_lineEdit);
+    form->addRow(tr("Vcc 最低 (V)"), arrayVccMin_lineEdit);
+    form->addRow(tr("Vcc 最高 (V)"), arrayVccMax_lineEdit);
+    form->addRow(tr("Vd 最低 (V)"), arrayVdMin_lineEdit);
+    form->addRow(tr("Vd 最高 (V)"), arrayVdMax_lineEdit);
+    form->addRow(tr("每串電流下限 (mA)"), arrayIMin_lineEdit);
+    form->addRow(tr("每串電流上限 (mA)"), arrayIMax_lineEdit);
+    form->addRow(tr("電阻額定功率 (W)"), arrayPower_lineEdit);
+    form->addRow(tr("電阻系列"), arraySeries_comboBox);
+    form->addRow(arrayParetoOnly_checkBox, arrayStatus_label);
+
+    arrayTable = new QTableWidget(0, 9, arrayDialog);
+    arrayTable->setHorizontalHeaderLabels({tr("串"), tr("並"), tr("電阻 (Ω)"), tr("最低電流 (mA)"),
+                                           tr("標稱電流 (mA)"), tr("最高電流 (mA)"), tr("電阻功耗 (W)"),
+                                           tr("效率 (%)"), tr("電流變動 (%)")});
+    arrayTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    arrayTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    arrayTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    arrayTable->setSortingEnabled(true);
+    arrayTable->setToolTip(tr("點欄位標題排序；雙擊套用到計算頁"));
+
+    QVBoxLayout *dialogLayout = new QVBoxLayout(arrayDialog);
+    dialogLayout->addLayout(form);
+    dialogLayout->addWidget(arrayTable);
+
+    connect(arrayButton, &QPushButton::clicked, this, [this]() {
+        arrayDialog->show();
+        arrayDialog->raise();
+        updateArraySearch();
+    });
+    for (QLineEdit *e : { arrayCount_lineEdit, arrayVccMin_lineEdit, arrayVccMax_lineEdit, arrayVdMin_lineEdit,
+                          arrayVdMax_lineEdit, arrayIMin_lineEdit, arrayIMax_lineEdit, arrayPower_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &LED_current_limit::updateArraySearch);
+    connect(arraySeries_comboBox, &QComboBox::currentIndexChanged, this, &LED_current_limit::updateArraySearch);
+    connect(arrayParetoOnly_checkBox, &QCheckBox::toggled, this, &LED_current_limit::updateArraySearch);
+    connect(arrayTable, &QTableWidget::cellDoubleClicked, this, &LED_current_limit::applyArrayConfig);
 }
 
-LEDResult LED_current_limit::calculateLEDComplex(double vcc, double vd, double current, int iUnitIdx, int series, int parallel) {
+void LED_current_limit::updateArraySearch() {
+    if (!arrayDialog || !arrayDialog->isVisible()) return;
+
+    bool okN, okVccMin, okVccMax, okVdMin, okVdMax, okIMin, okIMax, okP;
+    sc::LedArrayOptions opt;
+    opt.ledCount = arrayCount_lineEdit->text().toInt(&okN);
+    opt.vccMin_V = handler->parseValue(arrayVccMin_lineEdit->text(), &okVccMin);
+    opt.vccMax_V = handler->parseValue(arrayVccMax_lineEdit->text(), &okVccMax);
+    opt.vdMin_V = handler->parseValue(arrayVdMin_lineEdit->text(), &okVdMin);
+    opt.vdMax_V = handler->parseValue(arrayVdMax_lineEdit->text(), &okVdMax);
+    opt.minCurrent_A = handler->parseValue(arrayIMin_lineEdit->text(), &okIMin) * 1e-3;
+    opt.maxCurrent_A = handler->parseValue(arrayIMax_lineEdit->text(), &okIMax) * 1e-3;
+    const double power = handler->parseValue(arrayPower_lineEdit->text(), &okP);
+    if (okP && power > 0) opt.maxResistorPower_W = power;
+    opt.series = ARRAY_SERIES[qBound(0, arraySeries_comboBox->currentIndex(), 3)];
+
+    // 重新填表時先關掉排序，否則每插入一格就重排一次
+    arrayTable->setSortingEnabled(false);
+    arrayTable->setRowCount(0);
+    if (!okN || !okVccMin || !okVccMax || !okVdMin || !okVdMax || !okIMin || !okIMax) {
+        arrayStatus_label->clear();
+        arrayTable->setSortingEnabled(true);
+        return;
+    }
 
-    LEDResult res = {0, 0, true};
+    // 可行電阻範圍是解析算出來的，整個搜尋在 1 ms 以內，可以跟著按鍵即時更新
+    const sc::LedArrayResult r = sc::ledArraySearch(opt);
+    const bool paretoOnly = arrayParetoOnly_checkBox->isChecked();
+    for (const sc::LedArrayConfig &c : r.configs) {
+        if (paretoOnly && !c.pareto) continue;
+        const int row = arrayTable->rowCount();
+        arrayTable->insertRow(row);
+        arrayTable->setItem(row, 0, new NumberItem(c.series, 4));
+        arrayTable->setItem(row, 1, new NumberItem(c.parallel, 4));
+        arrayTable->setItem(row, 2, new NumberItem(c.R_ohm, 4));
+        arrayTable->setItem(row, 3, new NumberItem(c.currentMin_A * 1e3, 4));
+        arrayTable->setItem(row, 4, new NumberItem(c.currentNominal_A * 1e3, 4));
+        arrayTable->setItem(row, 5, new NumberItem(c.currentMax_A * 1e3, 4));
+        arrayTable->setItem(row, 6, new NumberItem(c.resistorPower_W, 4));
+        arrayTable->setItem(row, 7, new NumberItem(c.efficiency * 100, 3));
+        arrayTable->setItem(row, 8, new NumberItem(c.regulation * 100, 3));
+        // 電阻最差功耗超過 1/4 W 時標紅 (與計算頁相同的提醒)
+        if (c.resistorPowerMax_W > 0.25) arrayTable->item(row, 2)->setForeground(Qt::red);
+        arrayTable->item(row, 2)->setToolTip(tr("最差情況功耗 %1 W").arg(c.resistorPowerMax_W, 0, 'g', 3));
+    }
+    arrayTable->setSortingEnabled(true);
 
-    // 1. 處理電流單位換算 (換算為 A)
-    double branchCurrentA = current;
-    if (iUnitIdx == 1) branchCurrentA = current / 1000.0;
-    else if (iUnitIdx == 2) branchCurrentA = current / 1000000.0;
+    arrayStatus_label->setText(r.configs.empty()
+        ? tr("沒有可行的組態 (放寬電流規格或電源範圍)")
+        : tr("可行 %1 組，%2 ms").arg(r.configs.size()).arg(r.elapsed_ms, 0, 'f', 2));
+}
 
-    // 2. 串聯計算：總電壓需求
-    double totalVd = vd * (series > 0 ? series : 1);
+void LED_current_limit::applyArrayConfig(int row) {
+    QTableWidgetItem *s = arrayTable->item(row, 0);
+    QTableWidgetItem *p = arrayTable->item(row, 1);
+    QTableWidgetItem *i = arrayTable->item(row, 4);
+    if (!s || !p || !i) return;
+
+    // 以標稱 Vcc、中間壓降與標稱電流回填，計算頁算出的電阻就是表中的標準值 (兩邊都是整組共用一顆電阻)
+    bool okMin, okMax, okVdMin, okVdMax;
+    const double vccMin = handler->parseValue(arrayVccMin_lineEdit->text(), &okMin);
+    const double vccMax = handler->parseValue(arrayVccMax_lineEdit->text(), &okMax);
+    const double vdMin = handler->parseValue(arrayVdMin_lineEdit->text(), &okVdMin);
+    const double vdMax = handler->parseValue(arrayVdMax_lineEdit->text(), &okVdMax);
+    if (!okMin || !okMax || !okVdMin || !okVdMax) return;
+
+    ui->VCCIO_Input_lineEdit->setText(QString::number(0.5 * (vccMin + vccMax), 'g', 6));
+    ui->VD_Input_lineEdit->setText(QString::number(0.5 * (vdMin + vdMax), 'g', 6));
+    ui->Series_Input_lineEdit->setText(QString::number(s->data(Qt::UserRole).toInt()));
+    ui->Parallel_Input_lineEdit->setText(QString::number(p->data(Qt::UserRole).toInt()));
+    ui->D1_input_comboBox->setCurrentIndex(1);   // mA
+    ui->D1_Input_lineEdit->setText(QString::number(i->data(Qt::UserRole).toDouble(), 'g', 6));
+}
 
-    // 3. 並聯計算：總電流需求
-    double totalCurrentA = branchCurrentA * (parallel > 0 ? parallel : 1);
+void LED_current_limit::setupThermalAnalysis() {
+    QPushButton *thermalButton = new QPushButton(tr("電熱耦合..."), this);
+    thermalButton->setGeometry(20, 480, 211, 31);
+
+    thermalDialog = new QDialog(this);
+    thermalDialog->setWindowTitle(tr("LED 電熱耦合"));
+    thermalDialog->resize(760, 520);
+
+    const sc::LedThermalParams defaults;
+    auto field = [this](double v) { return new QLineEdit(QString::number(v, 'g', 6), thermalDialog); };
+    thermalRthJb_lineEdit = field(defaults.rthJunctionBoard);
+    thermalRthBa_lineEdit = field(defaults.rthBoardAmbient);
+    thermalRthR_lineEdit = field(defaults.rthResistor);
+    thermalTempco_lineEdit = field(defaults.vfTempco_V_per_C * 1e3);
+    thermalTcr_lineEdit = field(defaults.resistorTcr_ppm);
+    thermalRating_lineEdit = field(defaults.resistorRating_W);
+    thermalTjMax_lineEdit = field(defaults.tjMax_C);
+    thermalTaMin_lineEdit = field(-40);
+    thermalTaMax_lineEdit = field(85);
+    thermalTaStep_lineEdit = field(5);
+    thermalStatus_label = new QLabel(thermalDialog);
+    thermalStatus_label->setWordWrap(true);
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow(tr("LED 接面到板 Rθjb (°C/W，每顆)"), thermalRthJb_lineEdit);
+    form->addRow(tr("板到環境 Rθba (°C/W，整片)"), thermalRthBa_lineEdit);
+    form->addRow(tr("限流電阻到板 (°C/W)"), thermalRthR_lineEdit);
+    form->addRow(tr("Vf 溫度係數 (mV/°C，每顆)"), thermalTempco_lineEdit);
+    form->addRow(tr("電阻 TCR (ppm/°C)"), thermalTcr_lineEdit);
+    form->addRow(tr("電阻額定功率 (W，70 °C 以下)"), thermalRating_lineEdit);
+    form->addRow(tr("Tj 上限 (°C)"), thermalTjMax_lineEdit);
+    QHBoxLayout *range = new QHBoxLayout;
+    range->addWidget(thermalTaMin_lineEdit);
+    range->addWidget(new QLabel("~", thermalDialog));
+    range->addWidget(thermalTaMax_lineEdit);
+    range->addWidget(new QLabel(tr("間隔"), thermalDialog));
+    range->addWidget(thermalTaStep_lineEdit);
+    form->addRow(tr("環境溫度 (°C)"), range);
+    form->addRow(thermalStatus_label);
+
+    thermalTable = new QTableWidget(0, 8, thermalDialog);
+    thermalTable->setHorizontalHeaderLabels({tr("環境 (°C)"), tr("每串電流 (mA)"), "Vf (V)", "Tj (°C)",
+                                             tr("電阻溫度 (°C)"), tr("電阻功耗 (W)"), tr("降額後允許 (W)"),
+                                             tr("狀態")});
+    thermalTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    thermalTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    thermalTable->verticalHeader()->setVisible(false);
+
+    QVBoxLayout *dialogLayout = new QVBoxLayout(thermalDialog);
+    dialogLayout->addLayout(form);
+    dialogLayout->addWidget(thermalTable);
+
+    connect(thermalButton, &QPushButton::clicked, this, [this]() {
+        thermalDialog->show();
+        thermalDialog->raise();
+        updateThermalAnalysis();
+    });
+    for (QLineEdit *e : { thermalRthJb_lineEdit, thermalRthBa_lineEdit, thermalRthR_lineEdit, thermalTempco_lineEdit,
+                          thermalTcr_lineEdit, thermalRating_lineEdit, thermalTjMax_lineEdit,
+                          thermalTaMin_lineEdit, thermalTaMax_lineEdit, thermalTaStep_lineEdit })
+        connect(e, &QLineEdit::textChanged, this, &LED_current_limit::updateThermalAnalysis);
+}
 
-    // 4. 安全檢查：Vcc 必須大於總 LED 壓降
-    if (vcc <= totalVd) {
-        res.isVoltageOk = false;
-        return res;
+void LED_current_limit::updateThermalAnalysis() {
+    if (!thermalDialog || !thermalDialog->isVisible()) return;
+    thermalTable->setRowCount(0);
+
+    // 計算頁目前的電路：Vcc、選定的電阻 (整組共用一顆)、串並數與設計電流
+    bool okVcc, okVd, okR, okI, okS, okP;
+    const double vcc = handler->parseValue(ui->VCCIO_Input_lineEdit->text(), &okVcc);
+    const double vd = handler->parseValue(ui->VD_Input_lineEdit->text(), &okVd);
+    const double r = ResistorUnitList::from(handler->parseValue(ui->limit_Input_lineEdit->text(), &okR),
+                                            ui->limit_Input_comboBox->currentIndex()).in<sc::units::Ohm>();
+    const double current = CurrentUnitList::from(handler->parseValue(ui->D1_Input_lineEdit->text(), &okI),
+                                                 ui->D1_input_comboBox->currentIndex()).in<sc::units::A>();
+    int series = ui->Series_Input_lineEdit->text().toInt(&okS);
+    if (!okS || series < 1) series = 1;
+    int parallel = ui->Parallel_Input_lineEdit->text().toInt(&okP);
+    if (!okP || parallel < 1) parallel = 1;
+    if (!okVcc || !okVd || !okR || !okI || !(r > 0) || !(current > 0)) {
+        thermalStatus_label->setText(tr("請先在計算頁算出限流電阻"));
+        return;
     }
 
-    // 5. 計算電阻 R = V / I
-    res.resistance = (vcc - totalVd) / totalCurrentA;
+    sc::LedThermalParams params;
+    params.sharedResistor = true;
+    params.model = modelDialog->model();
+    // 沒有使用 LED 模型時，調整 Is 讓曲線通過計算頁的 (設計電流, Vd)，曲線形狀沿用模型視窗的 n、Rs
+    if (!modelDialog->modelEnabled()) {
+        const double nVt = sc::ledThermalVoltage(params.model);
+        const double x = (vd - current * params.model.Rs_ohm) / nVt;
+        if (x > 0) params.model.Is_A = current / std::expm1(x);
+    }
 
-    // 6. 計算功耗 P = V * I (或是 I^2 * R)
-    res.wattage = (vcc - totalVd) * totalCurrentA;
+    bool ok[10];
+    const double v[10] = {
+        handler->parseValue(thermalRthJb_lineEdit->text(), &ok[0]),
+        handler->parseValue(thermalRthBa_lineEdit->text(), &ok[1]),
+        handler->parseValue(thermalRthR_lineEdit->text(), &ok[2]),
+        handler->parseValue(thermalTempco_lineEdit->text(), &ok[3]),
+        handler->parseValue(thermalTcr_lineEdit->text(), &ok[4]),
+        handler->parseValue(thermalRating_lineEdit->text(), &ok[5]),
+        handler->parseValue(thermalTjMax_lineEdit->text(), &ok[6]),
+        handler->parseValue(thermalTaMin_lineEdit->text(), &ok[7]),
+        handler->parseValue(thermalTaMax_lineEdit->text(), &ok[8]),
+        handler->parseValue(thermalTaStep_lineEdit->text(), &ok[9]),
+    };
+    if (!std::all_of(ok, ok + 10, [](bool b) { return b; }) || !(v[9] > 0) || !(v[8] >= v[7])) {
+        thermalStatus_label->setText(tr("請確認熱參數與溫度範圍"));
+        return;
+    }
+    params.rthJunctionBoard = v[0];
+    params.rthBoardAmbient = v[1];
+    params.rthResistor = v[2];
+    params.vfTempco_V_per_C = v[3] * 1e-3;
+    params.resistorTcr_ppm = v[4];
+    params.resistorRating_W = v[5];
+    params.tjMax_C = v[6];
+
+    // 環境溫度掃描一次批次呼叫 (表格最多 1000 列)
+    std::vector<double> ambient;
+    for (double t = v[7]; t <= v[8] + 1e-9 && ambient.size() < 1000; t += v[9]) ambient.push_back(t);
+    const std::size_t n = ambient.size();
+    std::vector<double> current_A(n), vf(n), tj(n), tr(n), pr(n), allowed(n);
+    std::vector<int> iterations(n);
+    std::unique_ptr<bool[]> converged(new bool[n]);
+    sc::LedThermalBatchIn in{ nullptr, nullptr, ambient.data(), vcc, r, 0 };
+    sc::LedThermalBatchOut out{ current_A.data(), vf.data(), tj.data(), tr.data(), pr.data(), allowed.data(),
+                                iterations.data(), converged.get() };
+    sc::ledThermalSolveBatch(params, series, parallel, in, out, n);
+
+    thermalTable->setRowCount(static_cast<int>(n));
+    double maxSafeAmbient = -HUGE_VAL;
+    bool allSafe = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        const bool safe = converged[i] && tj[i] <= params.tjMax_C && pr[i] <= allowed[i];
+        QString state = tr("OK");
+        if (!converged[i]) state = tr("熱失控");
+        else if (tj[i] > params.tjMax_C) state = tr("Tj 過高");
+        else if (pr[i] > allowed[i]) state = tr("電阻超過降額");
+        if (safe && allSafe) maxSafeAmbient = ambient[i];
+        allSafe = allSafe && safe;
+
+        const int row = static_cast<int>(i);
+        thermalTable->setItem(row, 0, new QTableWidgetItem(QString::number(ambient[i], 'g', 4)));
+        thermalTable->setItem(row, 1, new QTableWidgetItem(QString::number(current_A[i] * 1e3, 'g', 4)));
+        thermalTable->setItem(row, 2, new QTableWidgetItem(QString::number(vf[i], 'g', 4)));
+        thermalTable->setItem(row, 3, new QTableWidgetItem(QString::number(tj[i], 'f', 1)));
+        thermalTable->setItem(row, 4, new QTableWidgetItem(QString::number(tr[i], 'f', 1)));
+        thermalTable->setItem(row, 5, new QTableWidgetItem(QString::number(pr[i], 'g', 3)));
+        thermalTable->setItem(row, 6, new QTableWidgetItem(QString::number(allowed[i], 'g', 3)));
+        QTableWidgetItem *stateItem = new QTableWidgetItem(state);
+        if (!safe) stateItem->setForeground(Qt::red);
+        thermalTable->setItem(row, 7, stateItem);
+    }
 
-    return res;
+    thermalStatus_label->setText(maxSafeAmbient > -HUGE_VAL
+        ? tr("從 %1 °C 起到 %2 °C 都在規格內 (設計電流 %3 mA，%4)")
+              .arg(v[7]).arg(maxSafeAmbient).arg(current * 1e3, 0, 'g', 4)
+              .arg(modelDialog->modelEnabled() ? tr("使用 LED 模型") : tr("I-V 曲線通過計算頁的 Vd"))
+        : tr("最低環境溫度就已超出規格"));
 }
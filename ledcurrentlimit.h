@@ -3,6 +3,16 @@
 
 #include <QWidget>
 #include "UnitConverterHandler.h"
+#include "LedCalc.h"
+
+class LedModelDialog;
+class MonteCarloDialog;
+class QCheckBox;
+class QComboBox;
+class QDialog;
+class QLabel;
+class QLineEdit;
+class QTableWidget;
 
 namespace Ui {
 class LED_current_limit ;
@@ -28,7 +38,49 @@ private:
     double calculateLEDResistor(double vSource, double vLed, double current, int currentUnitIdx);
 
     // 新增：處理串並聯的 LED 計算
-    LEDResult calculateLEDComplex(double vcc, double vd, double current, int iUnitIdx, int series, int parallel);
+    sc::LEDResult calculateLEDComplex(double vcc, double vd, double current, int iUnitIdx, int series, int parallel);
+
+    // 公差分析 (Monte Carlo)：選定電阻後，Vcc、Vd、R 的公差對 LED 電流的影響
+    MonteCarloDialog *toleranceDialog = nullptr;
+    void openToleranceAnalysis();
+
+    // LED 模型 (Shockley)：勾選後 Vd 由模型在目前電流下算出，並可對 Vcc 掃描工作點
+    LedModelDialog *modelDialog = nullptr;
+
+    // 電熱耦合：Tj、Vf、電流與電阻降額的固定點，對環境溫度掃描
+    void setupThermalAnalysis();
+    void updateThermalAnalysis();
+    QDialog *thermalDialog = nullptr;
+    QLineEdit *thermalRthJb_lineEdit = nullptr;
+    QLineEdit *thermalRthBa_lineEdit = nullptr;
+    QLineEdit *thermalRthR_lineEdit = nullptr;
+    QLineEdit *thermalTempco_lineEdit = nullptr;
+    QLineEdit *thermalTcr_lineEdit = nullptr;
+    QLineEdit *thermalRating_lineEdit = nullptr;
+    QLineEdit *thermalTjMax_lineEdit = nullptr;
+    QLineEdit *thermalTaMin_lineEdit = nullptr;
+    QLineEdit *thermalTaMax_lineEdit = nullptr;
+    QLineEdit *thermalTaStep_lineEdit = nullptr;
+    QLabel *thermalStatus_label = nullptr;
+    QTableWidget *thermalTable = nullptr;
+
+    // 陣列組態搜尋：N 顆 LED 的所有串並聯方式 x 限流電阻標準值，列出功耗與電流穩定度的 Pareto 前緣
+    void setupArraySearch();
+    void updateArraySearch();
+    void applyArrayConfig(int row);
+    QDialog *arrayDialog = nullptr;
+    QLineEdit *arrayCount_lineEdit = nullptr;
+    QLineEdit *arrayVccMin_lineEdit = nullptr;
+    QLineEdit *arrayVccMax_lineEdit = nullptr;
+    QLineEdit *arrayVdMin_lineEdit = nullptr;
+    QLineEdit *arrayVdMax_lineEdit = nullptr;
+    QLineEdit *arrayIMin_lineEdit = nullptr;
+    QLineEdit *arrayIMax_lineEdit = nullptr;
+    QLineEdit *arrayPower_lineEdit = nullptr;
+    QComboBox *arraySeries_comboBox = nullptr;
+    QCheckBox *arrayParetoOnly_checkBox = nullptr;
+    QLabel *arrayStatus_label = nullptr;
+    QTableWidget *arrayTable = nullptr;
 };
 
 #endif // LEDCURRENTLIMIT_H
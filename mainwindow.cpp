@@ -1,11 +1,13 @@
 #include "mainwindow.h"
 #include "./ui_mainwindow.h"
 #include "UnitConverterHandler.h"
+#include "UnitMatrixModel.h"
 #include "ledcurrentlimit.h"
 #include "Voltage_Divider.h"
 #include "ResCap_Conversion.h"
 #include "Line_Width.h"
 #include "via_current_cal.h"
+#include "Impedance_Calc.h"
 
 #include <QVBoxLayout>
 #include <QMessageBox> // 記得在檔案最上方 include
@@ -22,8 +24,11 @@ MainWindow::MainWindow(QWidget *parent)
     // 建立處理器
     UnitConverterHandler *handler = new UnitConverterHandler();
 
-    // 1. 填寫表格
-    handler->setupMatrixTable(ui->matrixTable);
+    // 1. 填寫表格 (可切換維度的換算矩陣)
+    UnitMatrixModel *matrixModel = handler->setupMatrixTable(ui->matrixTable);
+    ui->matrixDimension_comboBox->addItems(UnitMatrixModel::dimensionNames());
+    connect(ui->matrixDimension_comboBox, &QComboBox::currentIndexChanged,
+            matrixModel, &UnitMatrixModel::setDimension);
 
     // 2. 填寫下拉選單 (ComboBox)
     ui->Input_comboBox->addItems(handler->units);
@@ -107,6 +112,11 @@ MainWindow::MainWindow(QWidget *parent)
     //--- Tab 5 End ---
 
 
+    // --- 控制阻抗 (放在走線電流分頁後面) ---
+    Impedance_Calc *Impedance_Page = new Impedance_Calc(handler, ui->tabWidget);
+    ui->tabWidget->insertTab(ui->tabWidget->indexOf(ui->tab_5) + 1, Impedance_Page, tr("控制阻抗計算"));
+
+
     // --- Tab 6 (貫孔電流設計) ---
     // 建立一個垂直佈局，放在 MainWindow UI 的 tab_5 裡面
     QVBoxLayout *Viacurrent_layout = new QVBoxLayout(ui->tab_6);
@@ -140,7 +150,7 @@ void MainWindow::updateResult() {
 
     bool ok;
     // 取得輸入的數值
-    double inputVal = ui->Input_lineEdit->text().toDouble(&ok);
+    double inputVal = handler->parseValue(ui->Input_lineEdit->text(), &ok);
 
     if (!ok) {
         ui->Outputput_lineEdit->clear(); // 如果輸入不是數字，清空輸出
@@ -171,7 +181,8 @@ void MainWindow::on_actionAbout_triggered()
                           "3. 電阻分壓計算<br/>"
                           "4. LED限流電阻計算<br/>"
                           "5. PCB 走線電流計算及單位換算功能。<br/>"
-                          "6. PCB貫孔電流計算</p>"
+                          "6. PCB貫孔電流計算<br/>"
+                          "7. 控制阻抗計算 (微帶線、帶狀線、差動對)</p>"
                           "<p>公式參考：IPC-2221 標準。</p>"
                           "有興趣討論的話,請發郵件給我"
                           "<a href='mailto:markscat@gmail.com'>markscat@gmail.com</a></p>"
@@ -0,0 +1,102 @@
+#include "BufferedWriter.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace sc {
+
+BufferedWriter::BufferedWriter(std::size_t bufferSize)
+    : m_buffer(bufferSize > 0 ? bufferSize : 1)
+{
+}
+
+BufferedWriter::~BufferedWriter()
+{
+    close();
+}
+
+bool BufferedWriter::open(const std::string &path)
+{
+    close();
+    m_error.clear();
+    m_written = 0;
+
+    if (path == "-") {
+        m_file = stdout;
+        m_ownsFile = false;
+    } else {
+#ifdef _WIN32
+        int wlen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+        std::wstring wpath(wlen > 0 ? wlen : 0, L'\0');
+        if (wlen > 0) MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wpath[0], wlen);
+        m_file = _wfopen(wpath.c_str(), L"wb");
+#else
+        m_file = std::fopen(path.c_str(), "wb");
+#endif
+        m_ownsFile = true;
+    }
+
+    if (!m_file) {
+        m_error = "cannot create " + path;
+        m_ok = false;
+        return false;
+    }
+    // 我們自己做緩衝，關掉 stdio 的緩衝避免多一次複製
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+    m_ok = true;
+    return true;
+}
+
+bool BufferedWriter::close()
+{
+    if (!m_file) return m_ok;
+    flush();
+    if (m_ownsFile && std::fclose(m_file) != 0 && m_ok) {
+        m_ok = false;
+        m_error = "close failed";
+    }
+    m_file = nullptr;
+    return m_ok;
+}
+
+void BufferedWriter::write(const char *data, std::size_t size)
+{
+    if (!m_ok) return;
+
+    if (m_used + size > m_buffer.size()) {
+        flush();
+        // 比緩衝區還大的資料直接寫出
+        if (size >= m_buffer.size()) {
+            if (std::fwrite(data, 1, size, m_file) != size) {
+                m_ok = false;
+                m_error = "write failed";
+                return;
+            }
+            m_written += size;
+            return;
+        }
+    }
+    std::memcpy(m_buffer.data() + m_used, data, size);
+    m_used += size;
+}
+
+bool BufferedWriter::flush()
+{
+    if (!m_ok || !m_file) return m_ok;
+    if (m_used > 0) {
+        if (std::fwrite(m_buffer.data(), 1, m_used, m_file) != m_used) {
+            m_ok = false;
+            m_error = "write failed";
+        } else {
+            m_written += m_used;
+        }
+        m_used = 0;
+    }
+    std::fflush(m_file);
+    return m_ok;
+}
+
+} // namespace sc
@@ -0,0 +1,46 @@
+#ifndef SC_BUFFEREDWRITER_H
+#define SC_BUFFEREDWRITER_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+// 大區塊緩衝的檔案輸出：累積到 bufferSize 才呼叫一次 fwrite
+class BufferedWriter
+{
+public:
+    explicit BufferedWriter(std::size_t bufferSize = std::size_t(4) << 20);
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    // path 為 "-" 時寫到標準輸出
+    bool open(const std::string &path);
+    bool close();
+
+    void write(const char *data, std::size_t size);
+    void write(std::string_view text) { write(text.data(), text.size()); }
+    bool flush();
+
+    bool ok() const { return m_ok; }
+    std::size_t bytesWritten() const { return m_written; }
+    const std::string &errorString() const { return m_error; }
+
+private:
+    std::FILE *m_file = nullptr;
+    bool m_ownsFile = false;
+    bool m_ok = false;
+    std::vector<char> m_buffer;
+    std::size_t m_used = 0;
+    std::size_t m_written = 0;
+    std::string m_error;
+};
+
+} // namespace sc
+
+#endif // SC_BUFFEREDWRITER_H
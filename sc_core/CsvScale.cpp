@@ -0,0 +1,215 @@
+/**
+ * @file CsvScale.cpp
+ * @brief 大型 CSV 的欄位單位換算 (串流、多執行緒、保持列順序)
+ *
+ * 【 流程 】
+ * 1. 輸入 (記憶體映射) 以「視窗」為單位處理，每個視窗 = 執行緒數 * chunkBytes。
+ * 2. 視窗內切成數個區塊，切點往後對齊到下一個 '\n'，確保每列完整落在單一區塊。
+ * 3. 各執行緒把自己的區塊換算到獨立的輸出字串，全部完成後依區塊順序寫出，
+ *    因此列的順序與輸入完全相同，記憶體用量只和視窗大小有關，與檔案大小無關。
+ */
+
+#include "CsvScale.h"
+#include "BufferedWriter.h"
+#include "NumParse.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sc {
+
+namespace {
+
+struct LineScaler {
+    char delimiter;
+    double factor;
+    std::vector<char> selected;     // selected[col] != 0 代表要換算
+
+    bool isSelected(std::size_t col) const { return col < selected.size() && selected[col]; }
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+// 找出從 p 開始的欄位結尾 (指向分隔符號或列尾)
+const char *fieldEnd(const char *p, const char *end, char delimiter)
+{
+    if (p != end && *p == '"') {
+        ++p;
+        while (p != end) {
+            if (*p == '"') {
+                if (p + 1 != end && p[1] == '"') { p += 2; continue; }
+                ++p;
+                break;
+            }
+            ++p;
+        }
+    }
+    const void *d = std::memchr(p, delimiter, static_cast<std::size_t>(end - p));
+    return d ? static_cast<const char *>(d) : end;
+}
+
+// 換算一個區塊 [begin, end)，結果附加到 out
+void scaleBlock(const LineScaler &ls, const char *begin, const char *end,
+                std::string &out, CsvScaleStats &stats)
+{
+    char num[FORMAT_BUFFER_SIZE];
+    const char *line = begin;
+    while (line < end) {
+        const char *nl = static_cast<const char *>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+        const char *lineEnd = nl ? nl : end;
+        const char *content = lineEnd;
+        if (content > line && content[-1] == '\r') --content;   // 保留 CRLF
+
+        ++stats.rows;
+        std::size_t col = 0;
+        const char *f = line;
+        for (;;) {
+            const char *fe = fieldEnd(f, content, ls.delimiter);
+            if (ls.isSelected(col)) {
+                const char *a = f, *b = fe;
+                while (a < b && isBlank(*a)) ++a;
+                while (b > a && isBlank(b[-1])) --b;
+                double v = 0;
+                const char *stop = (a < b) ? parseDouble(a, b, v) : a;
+                if (a < b && stop == b) {
+                    out.append(num, formatDouble(num, v * ls.factor));
+                    ++stats.converted;
+                } else {
+                    out.append(f, fe);
+                    if (a < b) ++stats.skipped;
+                }
+            } else {
+                out.append(f, fe);
+            }
+            if (fe == content) break;
+            out.push_back(ls.delimiter);
+            f = fe + 1;
+            ++col;
+        }
+        out.append(content, nl ? nl + 1 : end);   // '\r' 與 '\n'
+        line = nl ? nl + 1 : end;
+    }
+}
+
+// 從 p 往後找到下一列的開頭
+const char *nextLineStart(const char *p, const char *end)
+{
+    if (p >= end) return end;
+    const void *nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+    return nl ? static_cast<const char *>(nl) + 1 : end;
+}
+
+} // namespace
+
+std::vector<std::string> splitCsvLine(std::string_view line, char delimiter)
+{
+    std::vector<std::string> fields;
+    const char *p = line.data();
+    const char *end = p + line.size();
+    if (end > p && end[-1] == '\n') --end;
+    if (end > p && end[-1] == '\r') --end;
+
+    for (;;) {
+        const char *fe = fieldEnd(p, end, delimiter);
+        std::string field(p, fe);
+        // 去掉包住欄位的雙引號並還原 "" -> "
+        if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+            std::string unq;
+            for (std::size_t i = 1; i + 1 < field.size(); ++i) {
+                unq.push_back(field[i]);
+                if (field[i] == '"' && field[i + 1] == '"') ++i;
+            }
+            field.swap(unq);
+        }
+        fields.push_back(std::move(field));
+        if (fe == end) break;
+        p = fe + 1;
+    }
+    return fields;
+}
+
+std::string_view csvFieldView(std::string_view line, char delimiter, std::size_t column)
+{
+    const char *p = line.data();
+    const char *end = p + line.size();
+    if (end > p && end[-1] == '\n') --end;
+    if (end > p && end[-1] == '\r') --end;
+
+    for (std::size_t col = 0;; ++col) {
+        const char *fe = fieldEnd(p, end, delimiter);
+        if (col == column) {
+            const char *a = p, *b = fe;
+            while (a < b && isBlank(*a)) ++a;
+            while (b > a && isBlank(b[-1])) --b;
+            if (b - a >= 2 && *a == '"' && b[-1] == '"') { ++a; --b; }
+            return std::string_view(a, static_cast<std::size_t>(b - a));
+        }
+        if (fe == end) return std::string_view();
+        p = fe + 1;
+    }
+}
+
+bool scaleCsvColumns(std::string_view input, BufferedWriter &out,
+                     const CsvScaleOptions &options, CsvScaleStats *stats)
+{
+    LineScaler ls;
+    ls.delimiter = options.delimiter;
+    ls.factor = options.factor;
+    for (std::size_t c : options.columns) {
+        if (c >= ls.selected.size()) ls.selected.resize(c + 1, 0);
+        ls.selected[c] = 1;
+    }
+
+    CsvScaleStats total;
+    const char *p = input.data();
+    const char *end = p + input.size();
+
+    if (options.hasHeader && p != end) {
+        const char *headerEnd = nextLineStart(p, end);
+        out.write(p, static_cast<std::size_t>(headerEnd - p));
+        p = headerEnd;
+    }
+
+    const unsigned threads = options.threads ? options.threads : hardwareThreads();
+    const std::size_t chunk = std::max<std::size_t>(options.chunkBytes, 4096);
+
+    std::vector<const char *> bounds;
+    std::vector<std::string> outputs(threads);
+    std::vector<CsvScaleStats> partial(threads);
+
+    while (p < end && out.ok()) {
+        // 1. 切出本視窗的區塊邊界 (對齊列尾)
+        bounds.clear();
+        bounds.push_back(p);
+        for (unsigned t = 0; t < threads && bounds.back() < end; ++t) {
+            const char *from = bounds.back();
+            const char *target = (static_cast<std::size_t>(end - from) > chunk) ? from + chunk : end;
+            bounds.push_back(target == end ? end : nextLineStart(target, end));
+        }
+        const std::size_t blocks = bounds.size() - 1;
+
+        // 2. 平行換算
+        parallelFor(blocks, threads, [&](std::size_t i) {
+            std::string &o = outputs[i];
+            o.clear();
+            o.reserve(static_cast<std::size_t>(bounds[i + 1] - bounds[i]) * 5 / 4 + 64);
+            partial[i] = CsvScaleStats();
+            scaleBlock(ls, bounds[i], bounds[i + 1], o, partial[i]);
+        });
+
+        // 3. 依原順序寫出
+        for (std::size_t i = 0; i < blocks; ++i) {
+            out.write(outputs[i]);
+            total.rows += partial[i].rows;
+            total.converted += partial[i].converted;
+            total.skipped += partial[i].skipped;
+        }
+        p = bounds.back();
+    }
+
+    if (stats) *stats = total;
+    return out.ok();
+}
+
+} // namespace sc
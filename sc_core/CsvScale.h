@@ -0,0 +1,43 @@
+#ifndef SC_CSVSCALE_H
+#define SC_CSVSCALE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+class BufferedWriter;
+
+// 把 CSV 中指定欄位的數值乘上同一個比值 (例如 u -> m 為 1e-3)，其餘內容原樣輸出
+struct CsvScaleOptions {
+    char delimiter = ',';
+    bool hasHeader = false;                  // 第一列原樣輸出，不換算
+    std::vector<std::size_t> columns;        // 要換算的欄位 (0 起算)
+    double factor = 1.0;
+    unsigned threads = 0;                    // 0 = 全部硬體執行緒
+    std::size_t chunkBytes = std::size_t(8) << 20;   // 每個工作區塊大小
+};
+
+struct CsvScaleStats {
+    std::size_t rows = 0;            // 資料列數 (不含標題列)
+    std::size_t converted = 0;       // 成功換算的儲存格
+    std::size_t skipped = 0;         // 指定欄位中不是數字的儲存格 (原樣輸出)
+};
+
+// 拆開一列 CSV 的欄位 (支援以雙引號包住的欄位，不支援欄位內換行)
+std::vector<std::string> splitCsvLine(std::string_view line, char delimiter);
+
+// 取出一列中第 column 個欄位 (0 起算) 而不複製：去掉前後空白與包住欄位的雙引號
+// (不還原欄位內的 "")。欄位不存在時回傳空字串
+std::string_view csvFieldView(std::string_view line, char delimiter, std::size_t column);
+
+// input 通常是 MappedFile::view()。輸入依列邊界切成區塊，多執行緒換算後依原順序寫出。
+// 回傳 false 代表寫入失敗
+bool scaleCsvColumns(std::string_view input, BufferedWriter &out,
+                     const CsvScaleOptions &options, CsvScaleStats *stats = nullptr);
+
+} // namespace sc
+
+#endif // SC_CSVSCALE_H
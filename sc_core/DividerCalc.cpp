@@ -0,0 +1,117 @@
+/**
+ * @file DividerCalc.cpp
+ * @brief 電阻分壓計算 - 不依賴 Qt 的核心實現
+ *
+ *    Vo = Vi * R2 / (R1 + R2)
+ *
+ * 由上式可解出 Vi、R1、R2 任一未知量。
+ *
+ * 區間版本改寫成每個變數只出現一次的形式 (Vo = Vi / (1 + R1 / R2) 等)，
+ * 式子對每個變數都是單調的，所以區間結果等於列舉所有公差角落的最小/最大值。
+ */
+
+#include "DividerCalc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sc {
+
+namespace {
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+}
+
+double dividerVo(double Vi, double R1, double R2)
+{
+    if ((R1 + R2) == 0) return NaN;
+    return Vi * (R2 / (R1 + R2));
+}
+
+double dividerVi(double Vo, double R1, double R2)
+{
+    if (R2 == 0) return NaN;
+    return Vo * (R1 + R2) / R2;
+}
+
+double dividerR1(double Vi, double Vo, double R2)
+{
+    if (Vo == 0) return NaN;
+    return R2 * (Vi - Vo) / Vo;
+}
+
+double dividerR2(double Vi, double Vo, double R1)
+{
+    if ((Vi - Vo) == 0) return NaN;
+    return R1 * Vo / (Vi - Vo);
+}
+
+double dividerSolve(DividerSolve mode, double Vi, double Vo, double R1, double R2)
+{
+    switch (mode) {
+    case DividerSolve::Vo: return dividerVo(Vi, R1, R2);
+    case DividerSolve::Vi: return dividerVi(Vo, R1, R2);
+    case DividerSolve::R1: return dividerR1(Vi, Vo, R2);
+    case DividerSolve::R2: return dividerR2(Vi, Vo, R1);
+    }
+    return NaN;
+}
+
+void dividerSolveBatch(DividerSolve mode, const DividerBatchIn &in, double *out, std::size_t n)
+{
+    // 模式判斷提到迴圈外，每個分支都是單純的陣列運算
+    switch (mode) {
+    case DividerSolve::Vo:
+        for (std::size_t i = 0; i < n; ++i) out[i] = dividerVo(in.Vi[i], in.R1[i], in.R2[i]);
+        break;
+    case DividerSolve::Vi:
+        for (std::size_t i = 0; i < n; ++i) out[i] = dividerVi(in.Vo[i], in.R1[i], in.R2[i]);
+        break;
+    case DividerSolve::R1:
+        for (std::size_t i = 0; i < n; ++i) out[i] = dividerR1(in.Vi[i], in.Vo[i], in.R2[i]);
+        break;
+    case DividerSolve::R2:
+        for (std::size_t i = 0; i < n; ++i) out[i] = dividerR2(in.Vi[i], in.Vo[i], in.R1[i]);
+        break;
+    }
+}
+
+Interval resistorInterval(double nominal_ohm, double relTol, double tcr_ppm, double tMin_C, double tMax_C)
+{
+    const double tcr = std::fabs(tcr_ppm) * 1e-6;
+    const Interval drift = interval(-tcr, tcr) * interval(std::min(tMin_C, tMax_C) - 25.0,
+                                                          std::max(tMin_C, tMax_C) - 25.0);
+    return tolerance(nominal_ohm, relTol) * (drift + 1.0);
+}
+
+Interval dividerSolveInterval(DividerSolve mode, const Interval &Vi, const Interval &Vo,
+                              const Interval &R1, const Interval &R2)
+{
+    switch (mode) {
+    case DividerSolve::Vo: return Vi / (R1 / R2 + 1.0);
+    case DividerSolve::Vi: return Vo * (R1 / R2 + 1.0);
+    case DividerSolve::R1: return R2 * (Vi / Vo - 1.0);
+    case DividerSolve::R2: return R1 / (Vi / Vo - 1.0);
+    }
+    return point(NaN);
+}
+
+void dividerSolveIntervalBatch(DividerSolve mode, const DividerIntervalBatchIn &in, Interval *out, std::size_t n)
+{
+    switch (mode) {
+    case DividerSolve::Vo:
+        for (std::size_t i = 0; i < n; ++i) out[i] = in.Vi[i] / (in.R1[i] / in.R2[i] + 1.0);
+        break;
+    case DividerSolve::Vi:
+        for (std::size_t i = 0; i < n; ++i) out[i] = in.Vo[i] * (in.R1[i] / in.R2[i] + 1.0);
+        break;
+    case DividerSolve::R1:
+        for (std::size_t i = 0; i < n; ++i) out[i] = in.R2[i] * (in.Vi[i] / in.Vo[i] - 1.0);
+        break;
+    case DividerSolve::R2:
+        for (std::size_t i = 0; i < n; ++i) out[i] = in.R1[i] / (in.Vi[i] / in.Vo[i] - 1.0);
+        break;
+    }
+}
+
+} // namespace sc
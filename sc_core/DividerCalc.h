@@ -0,0 +1,58 @@
+#ifndef SC_DIVIDERCALC_H
+#define SC_DIVIDERCALC_H
+
+#include "Interval.h"
+
+#include <cstddef>
+
+namespace sc {
+
+// 求解目標，順序與 Voltage_Divider 的 calcMode_comboBox 相同
+enum class DividerSolve {
+    Vo = 0,   // 求輸出電壓
+    Vi = 1,   // 求輸入電壓
+    R1 = 2,   // 求上拉電阻
+    R2 = 3    // 求下拉電阻
+};
+
+// 以下函數在分母為 0 時回傳 NaN，電阻皆為 Ohm
+double dividerVo(double Vi, double R1, double R2);   // Vo = Vi * R2 / (R1 + R2)
+double dividerVi(double Vo, double R1, double R2);   // Vi = Vo * (R1 + R2) / R2
+double dividerR1(double Vi, double Vo, double R2);   // R1 = R2 * (Vi - Vo) / Vo
+double dividerR2(double Vi, double Vo, double R1);   // R2 = R1 * Vo / (Vi - Vo)
+
+// 依 mode 求未知量，未知量本身的輸入值會被忽略
+double dividerSolve(DividerSolve mode, double Vi, double Vo, double R1, double R2);
+
+// 批次計算 (struct-of-arrays)：未知量對應的輸入陣列可為 nullptr
+struct DividerBatchIn {
+    const double *Vi;
+    const double *Vo;
+    const double *R1;
+    const double *R2;
+};
+
+void dividerSolveBatch(DividerSolve mode, const DividerBatchIn &in, double *out, std::size_t n);
+
+// --- 最差情況 (區間運算) ---
+
+// 電阻在公差與溫度係數下的範圍：R = Rnom * (1 ± tol) * (1 + TCR * (T - 25°C))，
+// TCR 為 ± tcr_ppm (ppm/°C)，T 為 tMin_C ~ tMax_C
+Interval resistorInterval(double nominal_ohm, double relTol, double tcr_ppm, double tMin_C, double tMax_C);
+
+// 依 mode 求未知量的範圍；式子改寫成每個變數只出現一次，結果就是所有角落的精確包絡
+Interval dividerSolveInterval(DividerSolve mode, const Interval &Vi, const Interval &Vo,
+                              const Interval &R1, const Interval &R2);
+
+struct DividerIntervalBatchIn {
+    const Interval *Vi;
+    const Interval *Vo;
+    const Interval *R1;
+    const Interval *R2;
+};
+
+void dividerSolveIntervalBatch(DividerSolve mode, const DividerIntervalBatchIn &in, Interval *out, std::size_t n);
+
+} // namespace sc
+
+#endif // SC_DIVIDERCALC_H
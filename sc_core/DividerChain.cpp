@@ -0,0 +1,419 @@
+/**
+ * @file DividerChain.cpp
+ * @brief 多段分壓電阻串的分支定界搜尋
+ *
+ * 【 1. 模型 】
+ * 電阻串由 GND 往上依序為 B0, B1, ..., Bm (共 m + 1 顆)，第 j 個分接點下方的電阻和為 S_j，
+ * 總電阻為 T，分接比 = S_j / T。對每個分接點，令 T_j* = S_j / r_j (r_j 為目標分接比)，
+ * 分接誤差 = |T_j* / T - 1|。所以整串的最大誤差只取決於
+ *    a = min T_j*、b = max T_j*、T
+ * 且在 T = (a + b) / 2 時最小，值為 (b - a) / (b + a)。
+ *
+ * 【 2. 分支定界 】
+ * 由 GND 往上逐顆選電阻。已決定的分接點給出 a、b，不論上方怎麼選，
+ * 誤差至少是 (b - a) / (b + a) (再以總電阻/電流限制夾住 T)，這就是下界。
+ * 下界不比目前最佳解好就剪枝；而且可以反推下一顆電阻必須落在哪個區間，
+ * 用二分搜尋直接跳到該區間，從最接近理想值的候選開始往外試。
+ * 最上面一顆電阻只需檢查理想值兩側的兩個候選 (誤差對 T 是單峰的)。
+ *
+ * 【 3. 平行與時間預算 】
+ * 先用貪婪法 (各電阻取最接近理想值的標準值) 建立初始解，再把前兩層展開成工作清單。
+ * 每個執行緒持有清單中的一段區間，做完自己的區間後從剩餘最多的執行緒偷走後半段
+ * (work stealing)。目前最佳誤差以 atomic 共享，各執行緒立刻用來剪枝。
+ * 超過時間預算或被取消時停止，回傳目前最佳解。
+ */
+
+#include "DividerChain.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+
+namespace sc {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 每展開這麼多節點檢查一次時間與取消旗標
+constexpr std::uint64_t CHECK_INTERVAL = 1024;
+// 初始貪婪解在總電阻範圍內嘗試的點數 (對數等分)
+constexpr int GREEDY_SAMPLES = 64;
+
+struct Task {
+    std::uint32_t index[2];     // 前兩層 (B0、B1) 在數值表中的位置
+};
+
+// 一段可被偷走的工作區間 [begin, end)
+struct WorkRange {
+    std::mutex mutex;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+class ChainSearch
+{
+public:
+    ChainSearch(double Vin, const std::vector<double> &taps, const ChainSearchOptions &opt,
+                const ChainProgress &progress)
+        : m_vin(Vin), m_opt(opt), m_progress(progress)
+    {
+        m_values = standardValuesInRange(opt.series, opt.minResistor_ohm, opt.maxResistor_ohm);
+        m_taps = taps.size();
+        // m_ratio[k]：由下往上第 k 個分接點 (B0..Bk 之上) 的目標分接比
+        for (std::size_t k = 0; k < m_taps; ++k) m_ratio.push_back(taps[m_taps - 1 - k] / Vin);
+
+        const double count = static_cast<double>(m_taps + 1);
+        m_tLo = (opt.maxCurrent_A > 0 && std::isfinite(opt.maxCurrent_A)) ? Vin / opt.maxCurrent_A : 0.0;
+        m_tHi = (opt.minCurrent_A > 0) ? Vin / opt.minCurrent_A : std::numeric_limits<double>::infinity();
+        if (!m_values.empty()) {
+            m_tLo = std::max(m_tLo, count * m_values.front());
+            m_tHi = std::min(m_tHi, count * m_values.back());
+        }
+        m_bestErr.store(std::numeric_limits<double>::infinity());
+        m_start = Clock::now();
+        if (opt.timeBudget_ms > 0)
+            m_deadline = m_start + std::chrono::duration_cast<Clock::duration>(
+                                       std::chrono::duration<double, std::milli>(opt.timeBudget_ms));
+    }
+
+    ChainSearchResult run()
+    {
+        ChainSearchResult result;
+        if (m_values.empty() || m_taps == 0 || !(m_tLo <= m_tHi)) {
+            result.complete = true;
+            return result;
+        }
+
+        greedy();
+        buildTasks();
+
+        const unsigned threads = m_opt.threads ? m_opt.threads : hardwareThreads();
+        m_ranges = std::vector<WorkRange>(threads);
+        for (unsigned w = 0; w < threads; ++w) {
+            m_ranges[w].begin = m_tasks.size() * w / threads;
+            m_ranges[w].end = m_tasks.size() * (w + 1) / threads;
+        }
+        parallelFor(threads, threads, [&](std::size_t w) { worker(w); });
+
+        result.found = std::isfinite(m_bestErr.load());
+        result.best = m_best;
+        result.complete = !m_stop.load();
+        result.nodes = m_nodes.load();
+        result.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+        return result;
+    }
+
+private:
+    // --- 誤差與下界 ---
+
+    // 在 T 的可行範圍 [tMin, tMax] 內，a、b 對應的最小可能誤差
+    static double bound(double a, double b, double tMin, double tMax)
+    {
+        const double t = std::clamp((a + b) * 0.5, tMin, tMax);
+        return std::max(b / t - 1.0, 1.0 - a / t);
+    }
+
+    // 剩下 remaining 顆 (含最上面一顆) 尚未決定時，T 的可行範圍
+    void totalRange(double S, std::size_t remaining, double &tMin, double &tMax) const
+    {
+        tMin = std::max(m_tLo, S + remaining * m_values.front());
+        tMax = std::min(m_tHi, S + remaining * m_values.back());
+    }
+
+    // 下一顆電阻使新分接點的 T* = x 時，x 必須落在的區間 (否則不可能優於 e)
+    void admissibleX(double a, double b, double e, double &xLo, double &xHi) const
+    {
+        xLo = 0;
+        xHi = std::numeric_limits<double>::infinity();
+        if (!(e < 1)) return;
+        xLo = std::max(m_tLo * (1 - e), b * (1 - e) / (1 + e));
+        xHi = std::min(m_tHi * (1 + e), a * (1 + e) / (1 - e));
+    }
+
+    // --- 記錄解 ---
+
+    // chosen：由下往上 m + 1 顆電阻在數值表中的位置
+    void offer(const std::uint32_t *chosen, double err)
+    {
+        if (!(err < m_bestErr.load(std::memory_order_relaxed))) return;
+        std::lock_guard<std::mutex> lock(m_bestMutex);
+        if (!(err < m_bestErr.load(std::memory_order_relaxed))) return;
+        m_bestErr.store(err);
+
+        ChainSolution s;
+        double T = 0;
+        for (std::size_t k = 0; k <= m_taps; ++k) T += m_values[chosen[k]];
+        s.resistors_ohm.resize(m_taps + 1);
+        s.tapVoltages.resize(m_taps);
+        double S = 0;
+        for (std::size_t k = 0; k <= m_taps; ++k) {
+            s.resistors_ohm[m_taps - k] = m_values[chosen[k]];
+            S += m_values[chosen[k]];
+            if (k < m_taps) s.tapVoltages[m_taps - 1 - k] = m_vin * S / T;
+        }
+        s.maxError = err;
+        s.current_A = m_vin / T;
+        m_best = s;
+        if (m_progress) m_progress(m_best);
+    }
+
+    // --- 初始解 ---
+
+    std::size_t nearestIndex(double v) const
+    {
+        const auto it = std::lower_bound(m_values.begin(), m_values.end(), v);
+        if (it == m_values.begin()) return 0;
+        if (it == m_values.end()) return m_values.size() - 1;
+        const std::size_t i = static_cast<std::size_t>(it - m_values.begin());
+        return (*it / v < v / m_values[i - 1]) ? i : i - 1;
+    }
+
+    void greedy()
+    {
+        std::vector<std::uint32_t> chosen(m_taps + 1);
+        const double tLo = m_tLo, tHi = m_tHi;
+        for (int s = 0; s < GREEDY_SAMPLES; ++s) {
+            const double f = (GREEDY_SAMPLES > 1) ? double(s) / (GREEDY_SAMPLES - 1) : 0.0;
+            const double T = tLo * std::pow(tHi / tLo, f);
+            double prev = 0, S = 0, a = HUGE_VAL, b = 0;
+            for (std::size_t k = 0; k <= m_taps; ++k) {
+                const double upper = (k < m_taps) ? m_ratio[k] : 1.0;
+                chosen[k] = static_cast<std::uint32_t>(nearestIndex(T * (upper - prev)));
+                prev = upper;
+                S += m_values[chosen[k]];
+                if (k < m_taps) {
+                    a = std::min(a, S / m_ratio[k]);
+                    b = std::max(b, S / m_ratio[k]);
+                }
+            }
+            if (S < m_tLo || S > m_tHi) continue;
+            offer(chosen.data(), std::max(b / S - 1.0, 1.0 - a / S));
+        }
+    }
+
+    // --- 工作清單 ---
+
+    // 在 [lo, hi) 內，從 ideal 最近的位置開始往兩側交錯列出
+    template <class Fn>
+    bool forEachOutward(std::size_t lo, std::size_t hi, double ideal, Fn &&fn)
+    {
+        if (lo >= hi) return true;
+        std::size_t right = static_cast<std::size_t>(
+            std::lower_bound(m_values.begin() + static_cast<std::ptrdiff_t>(lo),
+                             m_values.begin() + static_cast<std::ptrdiff_t>(hi), ideal) - m_values.begin());
+        std::size_t left = right;
+        while (left > lo || right < hi) {
+            if (right < hi && !fn(right++)) return false;
+            if (left > lo && !fn(--left)) return false;
+        }
+        return true;
+    }
+
+    // 下一顆電阻的索引區間 [lo, hi)
+    void candidateRange(std::size_t k, double S, double a, double b, std::size_t &lo, std::size_t &hi) const
+    {
+        double xLo, xHi;
+        admissibleX(a, b, m_bestErr.load(std::memory_order_relaxed), xLo, xHi);
+        const double r = m_ratio[k];
+        lo = static_cast<std::size_t>(std::lower_bound(m_values.begin(), m_values.end(), xLo * r - S) - m_values.begin());
+        hi = static_cast<std::size_t>(std::upper_bound(m_values.begin(), m_values.end(), xHi * r - S) - m_values.begin());
+    }
+
+    void buildTasks()
+    {
+        const std::size_t n = m_values.size();
+        for (std::uint32_t i0 = 0; i0 < n; ++i0) {
+            const double S0 = m_values[i0];
+            const double x0 = S0 / m_ratio[0];
+            double tMin, tMax;
+            totalRange(S0, m_taps, tMin, tMax);
+            if (tMin > tMax || bound(x0, x0, tMin, tMax) >= m_bestErr.load()) continue;
+            if (m_taps == 1) {
+                m_tasks.push_back({{i0, 0}});
+                continue;
+            }
+            std::size_t lo, hi;
+            candidateRange(1, S0, x0, x0, lo, hi);
+            for (std::size_t i1 = lo; i1 < hi; ++i1) {
+                const double S1 = S0 + m_values[i1];
+                const double x1 = S1 / m_ratio[1];
+                totalRange(S1, m_taps - 1, tMin, tMax);
+                if (tMin > tMax || bound(std::min(x0, x1), std::max(x0, x1), tMin, tMax) >= m_bestErr.load()) continue;
+                m_tasks.push_back({{i0, static_cast<std::uint32_t>(i1)}});
+            }
+        }
+        // 先做兩層總和接近理想比例的工作，較早找到好解以加強剪枝
+        const double target = (m_taps == 1) ? 0.0 : m_ratio[0] / m_ratio[1];
+        if (m_taps > 1) {
+            std::sort(m_tasks.begin(), m_tasks.end(), [&](const Task &p, const Task &q) {
+                auto score = [&](const Task &t) {
+                    const double ratio = m_values[t.index[0]] / (m_values[t.index[0]] + m_values[t.index[1]]);
+                    return std::fabs(ratio / target - 1.0);
+                };
+                return score(p) < score(q);
+            });
+        }
+    }
+
+    // --- 執行緒 ---
+
+    bool nextTask(std::size_t w, Task &task)
+    {
+        {
+            WorkRange &mine = m_ranges[w];
+            std::lock_guard<std::mutex> lock(mine.mutex);
+            if (mine.begin < mine.end) {
+                task = m_tasks[mine.begin++];
+                return true;
+            }
+        }
+        // 自己的區間做完：找剩餘最多的執行緒，偷走它的後半段
+        for (;;) {
+            std::size_t victim = m_ranges.size(), most = 0;
+            for (std::size_t v = 0; v < m_ranges.size(); ++v) {
+                if (v == w) continue;
+                std::lock_guard<std::mutex> lock(m_ranges[v].mutex);
+                const std::size_t left = m_ranges[v].end - m_ranges[v].begin;
+                if (left > most) { most = left; victim = v; }
+            }
+            if (victim == m_ranges.size()) return false;
+
+            std::size_t from, to;
+            {
+                WorkRange &vr = m_ranges[victim];
+                std::lock_guard<std::mutex> lock(vr.mutex);
+                if (vr.begin >= vr.end) continue;               // 被別人搶先了，重找
+                const std::size_t mid = vr.begin + (vr.end - vr.begin) / 2;
+                from = (mid == vr.begin) ? vr.begin : mid;
+                to = vr.end;
+                vr.end = from;
+            }
+            WorkRange &mine = m_ranges[w];
+            std::lock_guard<std::mutex> lock(mine.mutex);
+            task = m_tasks[from];
+            mine.begin = from + 1;
+            mine.end = to;
+            return true;
+        }
+    }
+
+    bool shouldStop(std::uint64_t &localNodes)
+    {
+        if (++localNodes % CHECK_INTERVAL != 0) return m_stop.load(std::memory_order_relaxed);
+        m_nodes.fetch_add(CHECK_INTERVAL, std::memory_order_relaxed);
+        if ((m_opt.timeBudget_ms > 0 && Clock::now() >= m_deadline) ||
+            (m_opt.cancel && m_opt.cancel->load(std::memory_order_relaxed)))
+            m_stop.store(true);
+        return m_stop.load(std::memory_order_relaxed);
+    }
+
+    void worker(std::size_t w)
+    {
+        std::vector<std::uint32_t> chosen(m_taps + 1);
+        std::uint64_t localNodes = 0;
+        Task task;
+        while (!m_stop.load(std::memory_order_relaxed) && nextTask(w, task)) {
+            const std::size_t depth = (m_taps == 1) ? 1 : 2;
+            double S = 0, a = HUGE_VAL, b = 0;
+            for (std::size_t k = 0; k < depth; ++k) {
+                chosen[k] = task.index[k];
+                S += m_values[chosen[k]];
+                a = std::min(a, S / m_ratio[k]);
+                b = std::max(b, S / m_ratio[k]);
+            }
+            descend(depth, S, a, b, chosen.data(), localNodes);
+        }
+        m_nodes.fetch_add(localNodes % CHECK_INTERVAL, std::memory_order_relaxed);
+    }
+
+    // 已決定 B0..B(k-1)，下方電阻和 S，已決定分接點的 a、b
+    bool descend(std::size_t k, double S, double a, double b, std::uint32_t *chosen, std::uint64_t &localNodes)
+    {
+        if (shouldStop(localNodes)) return false;
+
+        if (k == m_taps) {
+            // 最上面一顆：T 的理想值為 (a + b) / 2，只需檢查兩側最近的候選
+            double tMin, tMax;
+            totalRange(S, 1, tMin, tMax);
+            if (tMin > tMax) return true;
+            const std::size_t lo = static_cast<std::size_t>(
+                std::lower_bound(m_values.begin(), m_values.end(), tMin - S) - m_values.begin());
+            const std::size_t hi = static_cast<std::size_t>(
+                std::upper_bound(m_values.begin(), m_values.end(), tMax - S) - m_values.begin());
+            if (lo >= hi) return true;
+            const double ideal = std::clamp((a + b) * 0.5, tMin, tMax) - S;
+            std::size_t i = static_cast<std::size_t>(
+                std::lower_bound(m_values.begin() + static_cast<std::ptrdiff_t>(lo),
+                                 m_values.begin() + static_cast<std::ptrdiff_t>(hi), ideal) - m_values.begin());
+            for (std::size_t c : { i, i - 1 }) {
+                if (c < lo || c >= hi) continue;
+                const double T = S + m_values[c];
+                const double err = std::max(b / T - 1.0, 1.0 - a / T);
+                if (err < m_bestErr.load(std::memory_order_relaxed)) {
+                    chosen[k] = static_cast<std::uint32_t>(c);
+                    offer(chosen, err);
+                }
+            }
+            return true;
+        }
+
+        std::size_t lo, hi;
+        candidateRange(k, S, a, b, lo, hi);
+        const double r = m_ratio[k];
+        const double ideal = (a + b) * 0.5 * r - S;
+        return forEachOutward(lo, hi, ideal, [&](std::size_t i) {
+            const double S2 = S + m_values[i];
+            const double x = S2 / r;
+            const double a2 = std::min(a, x), b2 = std::max(b, x);
+            double tMin, tMax;
+            totalRange(S2, m_taps - k, tMin, tMax);
+            if (tMin <= tMax && bound(a2, b2, tMin, tMax) < m_bestErr.load(std::memory_order_relaxed)) {
+                chosen[k] = static_cast<std::uint32_t>(i);
+                if (!descend(k + 1, S2, a2, b2, chosen, localNodes)) return false;
+            }
+            return true;
+        });
+    }
+
+    double m_vin;
+    const ChainSearchOptions &m_opt;
+    const ChainProgress &m_progress;
+
+    std::vector<double> m_values;
+    std::vector<double> m_ratio;
+    std::size_t m_taps = 0;
+    double m_tLo = 0, m_tHi = 0;
+
+    std::vector<Task> m_tasks;
+    std::vector<WorkRange> m_ranges;
+
+    std::atomic<double> m_bestErr{0};
+    std::mutex m_bestMutex;
+    ChainSolution m_best;
+
+    std::atomic<bool> m_stop{false};
+    std::atomic<std::uint64_t> m_nodes{0};
+    Clock::time_point m_start;
+    Clock::time_point m_deadline;
+};
+
+} // namespace
+
+ChainSearchResult solveDividerChain(double Vin, std::vector<double> taps,
+                                    const ChainSearchOptions &options, const ChainProgress &progress)
+{
+    std::sort(taps.begin(), taps.end(), [](double x, double y) { return x > y; });
+    for (double t : taps) {
+        if (!(t > 0 && t < Vin)) return ChainSearchResult();
+    }
+    for (std::size_t i = 1; i < taps.size(); ++i) {
+        if (taps[i] == taps[i - 1]) return ChainSearchResult();
+    }
+    ChainSearch search(Vin, taps, options, progress);
+    return search.run();
+}
+
+} // namespace sc
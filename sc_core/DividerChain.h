@@ -0,0 +1,54 @@
+#ifndef SC_DIVIDERCHAIN_H
+#define SC_DIVIDERCHAIN_H
+
+#include "ESeries.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace sc {
+
+// 多段分壓 (電阻串) 的搜尋條件
+struct ChainSearchOptions {
+    ESeries series = ESeries::E96;
+    double minResistor_ohm = 100;           // 單顆電阻允許範圍
+    double maxResistor_ohm = 1e6;
+    double minCurrent_A = 0;                // 電阻串電流範圍 (換算成總電阻範圍)
+    double maxCurrent_A = std::numeric_limits<double>::infinity();
+    unsigned threads = 0;                   // 0 = 全部硬體執行緒
+    double timeBudget_ms = 500;             // 0 = 不限時間 (搜到證明最佳為止)
+    const std::atomic<bool> *cancel = nullptr;   // 外部取消 (可為 nullptr)
+};
+
+struct ChainSolution {
+    std::vector<double> resistors_ohm;      // 由 Vin 往 GND 排列，共 taps + 1 顆
+    std::vector<double> tapVoltages;        // 實際的分接電壓，順序同 taps (由高到低)
+    double maxError = std::numeric_limits<double>::infinity();   // 最大相對誤差
+    double current_A = 0;
+};
+
+struct ChainSearchResult {
+    ChainSolution best;
+    bool found = false;         // 至少找到一組符合限制的解
+    bool complete = false;      // 搜尋完整結束，best 已證明是最佳解 (未逾時、未取消)
+    std::uint64_t nodes = 0;    // 展開的節點數
+    double elapsed_ms = 0;
+};
+
+// 找到更好的解時呼叫 (在工作執行緒上，呼叫端需自行轉回 GUI 執行緒)
+using ChainProgress = std::function<void(const ChainSolution &)>;
+
+// 以 Vin 供電、taps 為目標分接電壓 (0 < tap < Vin，會依由高到低排序)，
+// 選出 taps.size() + 1 顆標準值電阻，使各分接點的最大相對誤差最小。
+// 超過時間預算時回傳目前最佳解 (complete = false)。
+ChainSearchResult solveDividerChain(double Vin, std::vector<double> taps,
+                                    const ChainSearchOptions &options,
+                                    const ChainProgress &progress = ChainProgress());
+
+} // namespace sc
+
+#endif // SC_DIVIDERCHAIN_H
@@ -0,0 +1,177 @@
+/**
+ * @file DividerSearch.cpp
+ * @brief 分壓電阻的標準值組合搜尋
+ *
+ * 【 演算法 】
+ * 1. 把允許範圍內的標準值展開成一個遞增陣列 V (E192、7 個 decade 約 1300 個值，
+ *    組合數約 180 萬)。
+ * 2. 對每個 R2，理想的 R1* = R2 * (1 - k) / k。在 V 中二分搜尋 R1* 的位置，
+ *    再以兩個指標向左右擴展：分壓比隨 R1 單調變化，所以越往外誤差越大，
+ *    一旦兩邊都比目前第 k 名差就停止，不必檢查其他 R1。
+ * 3. R2 依區塊分給多個執行緒，每個區塊維護自己的 top-k heap，最後合併。
+ * 每個 R2 只需 O(log n + k)，整體與組合數無關。
+ */
+
+#include "DividerSearch.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace sc {
+
+namespace {
+
+// 每個執行緒分到的區塊數，讓動態分配可以平衡負載
+constexpr unsigned BLOCKS_PER_THREAD = 4;
+
+// 排名：|error| 小者優先，相同時總電阻小者優先 (heap 頂端是目前最差的一組)
+bool better(const DividerPair &a, const DividerPair &b)
+{
+    const double ea = std::fabs(a.error), eb = std::fabs(b.error);
+    if (ea != eb) return ea < eb;
+    return (a.R1_ohm + a.R2_ohm) < (b.R1_ohm + b.R2_ohm);
+}
+
+struct WorseOnTop {
+    bool operator()(const DividerPair &a, const DividerPair &b) const { return better(a, b); }
+};
+
+using TopKHeap = std::priority_queue<DividerPair, std::vector<DividerPair>, WorseOnTop>;
+
+class TopK
+{
+public:
+    explicit TopK(std::size_t k) : m_k(k) {}
+
+    // 候選值的 |error| 是否還有機會進榜
+    bool admits(double absError) const
+    {
+        return m_heap.size() < m_k || absError <= std::fabs(m_heap.top().error);
+    }
+
+    void push(const DividerPair &p)
+    {
+        if (m_heap.size() < m_k) {
+            m_heap.push(p);
+        } else if (better(p, m_heap.top())) {
+            m_heap.pop();
+            m_heap.push(p);
+        }
+    }
+
+    std::vector<DividerPair> take()
+    {
+        std::vector<DividerPair> out;
+        out.reserve(m_heap.size());
+        while (!m_heap.empty()) {
+            out.push_back(m_heap.top());
+            m_heap.pop();
+        }
+        return out;
+    }
+
+private:
+    std::size_t m_k;
+    TopKHeap m_heap;
+};
+
+} // namespace
+
+std::vector<DividerPair> dividerBestPairs(double targetRatio, const DividerSearchOptions &options)
+{
+    std::vector<DividerPair> result;
+    if (!(targetRatio > 0 && targetRatio < 1) || options.topK == 0) return result;
+
+    const std::vector<double> values =
+        standardValuesInRange(options.series, options.minResistor_ohm, options.maxResistor_ohm);
+    if (values.empty()) return result;
+
+    const double k = targetRatio;
+    const std::size_t n = values.size();
+    const unsigned threads = options.threads ? options.threads : hardwareThreads();
+    const std::size_t blocks = std::min<std::size_t>(n, std::size_t(threads) * BLOCKS_PER_THREAD);
+
+    std::vector<std::vector<DividerPair>> partial(blocks);
+    parallelFor(blocks, threads, [&](std::size_t b) {
+        TopK top(options.topK);
+        const std::size_t begin = n * b / blocks;
+        const std::size_t end = n * (b + 1) / blocks;
+
+        for (std::size_t j = begin; j < end; ++j) {
+            const double r2 = values[j];
+
+            // R1 的可用範圍 (總電阻限制)，轉成 V 中的索引區間 [lo, hi)
+            const double r1Min = options.minTotal_ohm - r2;
+            const double r1Max = options.maxTotal_ohm - r2;
+            const std::size_t lo = static_cast<std::size_t>(
+                std::lower_bound(values.begin(), values.end(), r1Min) - values.begin());
+            const std::size_t hi = static_cast<std::size_t>(
+                std::upper_bound(values.begin(), values.end(), r1Max) - values.begin());
+            if (lo >= hi) continue;
+
+            const double ideal = r2 * (1 - k) / k;
+            std::size_t mid = static_cast<std::size_t>(
+                std::lower_bound(values.begin() + static_cast<std::ptrdiff_t>(lo),
+                                 values.begin() + static_cast<std::ptrdiff_t>(hi), ideal) - values.begin());
+
+            auto make = [&](std::size_t i) {
+                DividerPair p;
+                p.R1_ohm = values[i];
+                p.R2_ohm = r2;
+                p.ratio = r2 / (values[i] + r2);
+                p.error = (p.ratio - k) / k;
+                return p;
+            };
+
+            // 向右 (R1 變大、分壓比變小) 與向左擴展，直到兩邊都進不了榜
+            std::size_t right = mid;          // 下一個要檢查的右側索引
+            std::size_t left = mid;           // 左側索引 + 1
+            bool moreRight = right < hi, moreLeft = left > lo;
+            while (moreRight || moreLeft) {
+                if (moreRight) {
+                    DividerPair p = make(right);
+                    if (top.admits(std::fabs(p.error))) {
+                        top.push(p);
+                        moreRight = ++right < hi;
+                    } else {
+                        moreRight = false;
+                    }
+                }
+                if (moreLeft) {
+                    DividerPair p = make(left - 1);
+                    if (top.admits(std::fabs(p.error))) {
+                        top.push(p);
+                        moreLeft = --left > lo;
+                    } else {
+                        moreLeft = false;
+                    }
+                }
+            }
+        }
+        partial[b] = top.take();
+    });
+
+    // 合併各區塊的 top-k
+    for (const std::vector<DividerPair> &p : partial) result.insert(result.end(), p.begin(), p.end());
+    std::sort(result.begin(), result.end(), better);
+    if (result.size() > options.topK) result.resize(options.topK);
+    return result;
+}
+
+std::vector<DividerPair> dividerBestPairs(double Vi, double Vo, const DividerSearchOptions &options,
+                                          double maxCurrent_A, double minCurrent_A)
+{
+    if (!(Vi > 0) || !(Vo > 0) || !(Vo < Vi)) return {};
+
+    DividerSearchOptions opt = options;
+    // I = Vi / (R1 + R2)：電流上限 -> 總電阻下限，電流下限 -> 總電阻上限
+    if (maxCurrent_A > 0 && std::isfinite(maxCurrent_A))
+        opt.minTotal_ohm = std::max(opt.minTotal_ohm, Vi / maxCurrent_A);
+    if (minCurrent_A > 0)
+        opt.maxTotal_ohm = std::min(opt.maxTotal_ohm, Vi / minCurrent_A);
+    return dividerBestPairs(Vo / Vi, opt);
+}
+
+} // namespace sc
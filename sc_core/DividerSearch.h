@@ -0,0 +1,41 @@
+#ifndef SC_DIVIDERSEARCH_H
+#define SC_DIVIDERSEARCH_H
+
+#include "ESeries.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace sc {
+
+// 以標準值組成分壓電阻 R1 (上) / R2 (下) 的搜尋條件
+struct DividerSearchOptions {
+    ESeries series = ESeries::E96;
+    double minResistor_ohm = 100;           // 單顆電阻允許範圍 (可用來限制 decade)
+    double maxResistor_ohm = 1e6;
+    double minTotal_ohm = 0;                // R1 + R2 的範圍 (限制分壓電流)
+    double maxTotal_ohm = std::numeric_limits<double>::infinity();
+    std::size_t topK = 10;
+    unsigned threads = 0;                   // 0 = 全部硬體執行緒
+};
+
+struct DividerPair {
+    double R1_ohm;
+    double R2_ohm;
+    double ratio;              // R2 / (R1 + R2)
+    double error;              // 相對誤差 (ratio - 目標) / 目標
+};
+
+// 找出分壓比 R2 / (R1 + R2) 最接近 targetRatio (0 < targetRatio < 1) 的前 topK 組，
+// 依 |error| 由小到大排序 (誤差相同時總電阻小的在前)
+std::vector<DividerPair> dividerBestPairs(double targetRatio, const DividerSearchOptions &options);
+
+// 給定 Vi 與目標 Vo；maxCurrent_A / minCurrent_A 換算成總電阻範圍後與 options 的範圍取交集
+std::vector<DividerPair> dividerBestPairs(double Vi, double Vo, const DividerSearchOptions &options,
+                                          double maxCurrent_A = std::numeric_limits<double>::infinity(),
+                                          double minCurrent_A = 0);
+
+} // namespace sc
+
+#endif // SC_DIVIDERSEARCH_H
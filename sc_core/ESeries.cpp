@@ -0,0 +1,174 @@
+/**
+ * @file ESeries.cpp
+ * @brief 最接近標準值的反查與 SMD 標示代碼
+ *
+ * 1. 數值先正規化到 [100, 1000) 的三位有效數字 (mantissa * 10^exponent)。
+ * 2. 在排序好的 constexpr 系列表中二分搜尋，比較上下兩個候選值的比值 (對數距離)，
+ *    因為 E 系列是依公差等比分布的，用差值判斷會偏向較小的那一個。
+ * 3. 上方候選超出 decade 時換成下一個 decade 的 100。
+ */
+
+#include "ESeries.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace sc {
+
+namespace {
+
+double scalePow10(double mant, int exp)
+{
+    if (exp < units::POW10_MIN || exp > units::POW10_MAX) return mant * std::pow(10.0, exp);
+    return (exp >= 0) ? mant * units::pow10(exp) : mant / units::pow10(-exp);
+}
+
+// EIA-96 的指數 -> 倍率字母 (同義字母取常用的那一個)
+char eia96Letter(int exponent)
+{
+    static const char LETTERS[] = { 'Z', 'Y', 'X', 'A', 'B', 'C', 'D', 'E', 'F' };   // -3 ~ 5
+    if (exponent < -3 || exponent > 5) return 0;
+    return LETTERS[exponent + 3];
+}
+
+// 以 R 當小數點輸出 digits 位有效數字 (sig)，小數點前有 intDigits 位 (可為 0)
+void writeRkm(char *out, int sig, int digits, int intDigits)
+{
+    char d[8];
+    for (int i = digits - 1; i >= 0; --i) {
+        d[i] = static_cast<char>('0' + sig % 10);
+        sig /= 10;
+    }
+    int k = 0;
+    for (int i = 0; i < digits; ++i) {
+        if (i == intDigits) out[k++] = 'R';
+        out[k++] = d[i];
+    }
+    out[k] = '\0';
+}
+
+} // namespace
+
+std::vector<double> standardValuesInRange(ESeries series, double minValue, double maxValue)
+{
+    std::vector<double> out;
+    if (!(minValue > 0) || !(maxValue >= minValue) || !std::isfinite(maxValue)) return out;
+
+    const ESeriesTable t = eSeriesTable(series);
+    const int first = static_cast<int>(std::floor(std::log10(minValue))) - 3;
+    const int last = static_cast<int>(std::floor(std::log10(maxValue))) - 2;
+    out.reserve(static_cast<std::size_t>(last - first + 1) * t.size);
+    for (int e = first; e <= last; ++e) {
+        for (std::size_t i = 0; i < t.size; ++i) {
+            const double v = scalePow10(t.values[i], e);
+            if (v >= minValue && v <= maxValue) out.push_back(v);
+        }
+    }
+    return out;
+}
+
+StandardValue nearestStandardValue(double value, ESeries series)
+{
+    StandardValue r{0, 0, 0, 0};
+    if (!(value > 0) || !std::isfinite(value)) return r;
+
+    // 1. 正規化到 [100, 1000)
+    int e = static_cast<int>(std::floor(std::log10(value))) - 2;
+    double m = value / scalePow10(1.0, e);
+    if (m >= 1000) { m /= 10; ++e; }
+    else if (m < 100) { m *= 10; --e; }
+
+    // 2. 二分搜尋上下兩個候選值
+    const ESeriesTable t = eSeriesTable(series);
+    const std::uint16_t *hiIt = std::lower_bound(t.values, t.values + t.size, m);
+    std::size_t hi = static_cast<std::size_t>(hiIt - t.values);
+    if (hi < t.size && t.values[hi] == m) {
+        r.mantissa = t.values[hi];
+        r.index = static_cast<std::uint16_t>(hi);
+    } else {
+        // 表的第一個值是 100，m >= 100，所以 hi >= 1
+        const double loVal = t.values[hi - 1];
+        const double hiVal = (hi < t.size) ? t.values[hi] : 1000.0;
+        if (hiVal / m < m / loVal) {
+            if (hi < t.size) {
+                r.mantissa = t.values[hi];
+                r.index = static_cast<std::uint16_t>(hi);
+            } else {
+                r.mantissa = t.values[0];      // 下一個 decade 的 100
+                r.index = 0;
+                ++e;
+            }
+        } else {
+            r.mantissa = t.values[hi - 1];
+            r.index = static_cast<std::uint16_t>(hi - 1);
+        }
+    }
+    r.exponent = e;
+    r.value = scalePow10(r.mantissa, e);
+    return r;
+}
+
+bool smdMarking(const StandardValue &v, ESeries series, SmdMarking &out)
+{
+    out.text[0] = '\0';
+    if (v.mantissa < 100 || v.mantissa > 999) return false;
+
+    switch (series) {
+    case ESeries::E6:
+    case ESeries::E12:
+    case ESeries::E24: {
+        // 三位數：兩位有效數字 + 10 的次方
+        const int sig = v.mantissa / 10;
+        const int e = v.exponent + 1;
+        if (v.mantissa % 10 != 0) return false;
+        if (e >= 0 && e <= 9) {
+            // sig 為 10 ~ 99、e 為 0 ~ 9，以小型別傳入讓編譯器看得出不會截斷
+            std::snprintf(out.text, SMD_MARKING_SIZE, "%02u%u", static_cast<unsigned char>(sig),
+                          static_cast<unsigned char>(e));
+            return true;
+        }
+        if (e == -1 || e == -2) {           // 4R7、R47
+            writeRkm(out.text, sig, 2, e + 2);
+            return true;
+        }
+        return false;
+    }
+    case ESeries::E48:
+    case ESeries::E96: {
+        // EIA-96：E96 中的位置 + 倍率字母
+        const std::uint16_t *it = std::lower_bound(E96_VALUES.begin(), E96_VALUES.end(), v.mantissa);
+        const char letter = eia96Letter(v.exponent);
+        if (it == E96_VALUES.end() || *it != v.mantissa || !letter) return false;
+        // 代碼 01 ~ 96
+        const unsigned char code = static_cast<unsigned char>(it - E96_VALUES.begin() + 1);
+        std::snprintf(out.text, SMD_MARKING_SIZE, "%02u%c", static_cast<unsigned>(code), letter);
+        return true;
+    }
+    default: {
+        // 四位數：三位有效數字 + 10 的次方
+        const int e = v.exponent;
+        if (e >= 0 && e <= 9) {
+            std::snprintf(out.text, SMD_MARKING_SIZE, "%03d%d", v.mantissa, e);
+            return true;
+        }
+        if (e >= -3 && e < 0) {            // 47R0、4R70、R470
+            writeRkm(out.text, v.mantissa, 3, e + 3);
+            return true;
+        }
+        return false;
+    }
+    }
+}
+
+void nearestStandardValueBatch(const double *values, std::size_t n, ESeries series,
+                               double *nearest, SmdMarking *markings)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        const StandardValue v = nearestStandardValue(values[i], series);
+        nearest[i] = v.value;
+        if (markings) smdMarking(v, series, markings[i]);
+    }
+}
+
+} // namespace sc
@@ -0,0 +1,182 @@
+#ifndef SC_ESERIES_H
+#define SC_ESERIES_H
+
+/**
+ * @file ESeries.h
+ * @brief 標準值系列 (E6 ~ E192) 與 EIA-96 代碼表
+ *
+ * 【 1. 系列表 】
+ * 每個系列以一個 decade 內的三位有效數字 (100 ~ 999) 表示，例如 E12 的 4.7 存成 470。
+ * E6/E12/E24 是歷史沿用的數值 (與公式不完全一致)，直接列出；
+ * E48/E96/E192 由公式 10^(i/N) 取三位有效數字在編譯期產生，只有 E192 的 920 是例外。
+ *
+ * 【 2. EIA-96 代碼 】
+ * 代碼 = 兩位數索引 (01 ~ 96，對應 E96 的第幾個值) + 倍率字母。
+ * key = 索引 * 12 + 字母序號 是一個沒有碰撞的完美雜湊，數值表在編譯期建好，
+ * 解析只需一次查表，程式啟動時也不需要初始化。
+ */
+
+#include "Units.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+enum class ESeries : std::uint8_t { E6, E12, E24, E48, E96, E192 };
+
+namespace detail {
+
+// x^n (n >= 0)
+constexpr double ipow(double x, int n)
+{
+    double r = 1.0;
+    for (int i = 0; i < n; ++i) r *= x;
+    return r;
+}
+
+// 10 的 N 次方根 (牛頓法)
+constexpr double rootOf10(int n)
+{
+    double x = 1.0 + 2.3 / n;
+    for (int k = 0; k < 50; ++k) x -= (ipow(x, n) - 10.0) / (n * ipow(x, n - 1));
+    return x;
+}
+
+// E48/E96/E192：第 i 個值 = round(100 * 10^(i/N))
+template <int N>
+constexpr std::array<std::uint16_t, N> makeESeries()
+{
+    std::array<std::uint16_t, N> t{};
+    const double step = rootOf10(N);
+    double v = 100.0;
+    for (int i = 0; i < N; ++i) {
+        t[static_cast<std::size_t>(i)] = static_cast<std::uint16_t>(v + 0.5);
+        v *= step;
+    }
+    if (N == 192) t[185] = 920;      // IEC 60063 的唯一例外 (公式為 919)
+    return t;
+}
+
+} // namespace detail
+
+inline constexpr std::array<std::uint16_t, 6> E6_VALUES = {
+    100, 150, 220, 330, 470, 680 };
+inline constexpr std::array<std::uint16_t, 12> E12_VALUES = {
+    100, 120, 150, 180, 220, 270, 330, 390, 470, 560, 680, 820 };
+inline constexpr std::array<std::uint16_t, 24> E24_VALUES = {
+    100, 110, 120, 130, 150, 160, 180, 200, 220, 240, 270, 300,
+    330, 360, 390, 430, 470, 510, 560, 620, 680, 750, 820, 910 };
+inline constexpr std::array<std::uint16_t, 48> E48_VALUES = detail::makeESeries<48>();
+inline constexpr std::array<std::uint16_t, 96> E96_VALUES = detail::makeESeries<96>();
+inline constexpr std::array<std::uint16_t, 192> E192_VALUES = detail::makeESeries<192>();
+
+static_assert(E96_VALUES[0] == 100 && E96_VALUES[29] == 200 && E96_VALUES[67] == 499 && E96_VALUES[95] == 976,
+              "E96 table generation is off");
+static_assert(E192_VALUES[185] == 920 && E192_VALUES[191] == 988, "E192 table generation is off");
+
+// 不同系列共用的檢視 (指向上面的 constexpr 表)
+struct ESeriesTable {
+    const std::uint16_t *values;
+    std::size_t size;
+};
+
+constexpr ESeriesTable eSeriesTable(ESeries s)
+{
+    switch (s) {
+    case ESeries::E6: return { E6_VALUES.data(), E6_VALUES.size() };
+    case ESeries::E12: return { E12_VALUES.data(), E12_VALUES.size() };
+    case ESeries::E24: return { E24_VALUES.data(), E24_VALUES.size() };
+    case ESeries::E48: return { E48_VALUES.data(), E48_VALUES.size() };
+    case ESeries::E96: return { E96_VALUES.data(), E96_VALUES.size() };
+    default: return { E192_VALUES.data(), E192_VALUES.size() };
+    }
+}
+
+// --- EIA-96 ---
+namespace detail {
+
+// 倍率字母的序號與 10 的指數 (R 與 Y、S 與 X、H 與 B 同義)
+inline constexpr char EIA96_LETTERS[] = { 'Z', 'Y', 'R', 'X', 'S', 'A', 'B', 'H', 'C', 'D', 'E', 'F' };
+inline constexpr int EIA96_EXPONENTS[] = { -3, -2, -2, -1, -1, 0, 1, 1, 2, 3, 4, 5 };
+constexpr int EIA96_LETTER_COUNT = 12;
+
+constexpr std::array<std::int8_t, 128> makeEia96LetterSlots()
+{
+    std::array<std::int8_t, 128> t{};
+    for (auto &s : t) s = -1;
+    for (int i = 0; i < EIA96_LETTER_COUNT; ++i)
+        t[static_cast<std::size_t>(EIA96_LETTERS[i])] = static_cast<std::int8_t>(i);
+    return t;
+}
+
+// key = 兩位數索引 (00 ~ 99) * 12 + 字母序號；無效的索引 (00、97 ~ 99) 存 0
+constexpr std::array<double, 100 * EIA96_LETTER_COUNT> makeEia96Values()
+{
+    std::array<double, 100 * EIA96_LETTER_COUNT> t{};
+    for (int idx = 1; idx <= 96; ++idx) {
+        for (int l = 0; l < EIA96_LETTER_COUNT; ++l) {
+            const double mant = E96_VALUES[static_cast<std::size_t>(idx - 1)];
+            const int e = EIA96_EXPONENTS[l];
+            t[static_cast<std::size_t>(idx * EIA96_LETTER_COUNT + l)] =
+                (e >= 0) ? mant * units::pow10(e) : mant / units::pow10(-e);
+        }
+    }
+    return t;
+}
+
+inline constexpr std::array<std::int8_t, 128> EIA96_LETTER_SLOT = makeEia96LetterSlots();
+inline constexpr std::array<double, 100 * EIA96_LETTER_COUNT> EIA96_TABLE = makeEia96Values();
+
+} // namespace detail
+
+// 解析 EIA-96 代碼 (例如 01C = 10 kOhm、68X = 49.9 Ohm)，格式不符回傳 false
+constexpr bool eia96Decode(std::string_view code, double &value)
+{
+    if (code.size() != 3) return false;
+    const char d0 = code[0], d1 = code[1];
+    const unsigned char letter = static_cast<unsigned char>(code[2]);
+    if (d0 < '0' || d0 > '9' || d1 < '0' || d1 > '9' || letter >= 128) return false;
+    const int slot = detail::EIA96_LETTER_SLOT[letter];
+    if (slot < 0) return false;
+    const double v = detail::EIA96_TABLE[static_cast<std::size_t>(((d0 - '0') * 10 + (d1 - '0')) * detail::EIA96_LETTER_COUNT + slot)];
+    if (v <= 0) return false;
+    value = v;
+    return true;
+}
+
+// 列出 [minValue, maxValue] 之間的所有標準值 (遞增排序)，例如 E96 的 10 Ohm ~ 1 MOhm
+std::vector<double> standardValuesInRange(ESeries series, double minValue, double maxValue);
+
+// --- 反查：數值 -> 最接近的標準值與標示代碼 ---
+
+struct StandardValue {
+    double value;            // 標準值 (與輸入同單位)
+    std::uint16_t mantissa;  // 三位有效數字 (100 ~ 999)
+    int exponent;            // value = mantissa * 10^exponent
+    std::uint16_t index;     // 在系列表中的位置 (0 起算)
+};
+
+// 以比值 (對數距離) 取最接近的標準值；value 必須為正，否則回傳 value = 0
+StandardValue nearestStandardValue(double value, ESeries series);
+
+// 標示代碼，例如 "472"、"4R7"、"1002"、"01C"；緩衝區至少 SMD_MARKING_SIZE 個字元 (含結尾 '\0')
+constexpr std::size_t SMD_MARKING_SIZE = 8;
+struct SmdMarking {
+    char text[SMD_MARKING_SIZE];
+};
+
+// 依系列慣用的標示法產生代碼：E6 ~ E24 用三位數、E48/E96 用 EIA-96、E192 用四位數；
+// 小於 10 (三位數) 或 100 (四位數) 的數值以 R 當小數點。超出可表示範圍時回傳 false (text 為空字串)
+bool smdMarking(const StandardValue &v, ESeries series, SmdMarking &out);
+
+// 批次：每個輸入找出最接近的標準值 (nearest 不可為 nullptr) 與標示代碼 (markings 可為 nullptr)
+void nearestStandardValueBatch(const double *values, std::size_t n, ESeries series,
+                               double *nearest, SmdMarking *markings);
+
+} // namespace sc
+
+#endif // SC_ESERIES_H
@@ -0,0 +1,544 @@
+/**
+ * @file EngExpr.cpp
+ * @brief 工程記號運算式的編譯器與直譯器
+ *
+ * 【 1. 編譯 】
+ * 遞迴下降解析，直接輸出堆疊式 bytecode：
+ *    expr  := term (('+' | '-') term)*
+ *    term  := unary (('*' | '/') unary)*
+ *    unary := ('+' | '-') unary | power
+ *    power := primary ('^' unary)?          (右結合)
+ *    primary := number | 常數 | 變數 | func '(' expr ')' | '(' expr ')'
+ * 輸出指令時順便做常數摺疊：運算元都是常數就直接算出結果，
+ * 所以不含變數的輸入框最後只剩一個 Push。
+ *
+ * 【 2. 數字後綴 】
+ * 數字後面緊接的字母串 (word) 依序判斷：
+ *   a. 純整數 + 倍率字母 + 數字 → RKM (4k7 = 4.7k、4R7 = 4.7)
+ *   b. 倍率字母 + (空 / 已知單位) → 乘上倍率 (10u、2.2uF、1MΩ)
+ *   c. 已知單位 → 忽略 (3.3V、100R)
+ *   d. 其他 → 語法錯誤，寧可報錯也不要猜錯 (例如 10mil 不會被當成 10m)
+ *
+ * 【 3. 快取 】
+ * EngExprCache 以原始文字為 key 保存編譯結果，同一段文字只編譯一次。
+ */
+
+#include "EngExpr.h"
+#include "NumParse.h"
+#include "Units.h"
+
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace sc {
+
+namespace {
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+constexpr int MAX_STACK = 64;
+constexpr std::size_t BATCH_BLOCK = 256;
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+inline bool isAsciiAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+// UTF-8 的多位元組字元 (Ω、µ、π ...) 一律當成字母
+inline bool isWordChar(char c) { return isAsciiAlpha(c) || static_cast<unsigned char>(c) >= 0x80; }
+
+// 倍率字母 -> 10 的指數；R/r 只在 RKM 中當小數點使用 (倍率 1)
+bool multiplierExponent(std::string_view s, int &exp, bool allowR)
+{
+    if (s == "f") { exp = -15; return true; }
+    if (s == "p") { exp = -12; return true; }
+    if (s == "n") { exp = -9; return true; }
+    if (s == "u" || s == "\xC2\xB5" || s == "\xCE\xBC") { exp = -6; return true; }   // u µ μ
+    if (s == "m") { exp = -3; return true; }
+    if (s == "k" || s == "K") { exp = 3; return true; }
+    if (s == "M") { exp = 6; return true; }
+    if (s == "G") { exp = 9; return true; }
+    if (s == "T") { exp = 12; return true; }
+    if (allowR && (s == "R" || s == "r")) { exp = 0; return true; }
+    return false;
+}
+
+// 倍率字母的位元組長度 (µ/μ 為 2)，不是倍率字母回傳 0
+std::size_t multiplierLength(std::string_view word, bool allowR)
+{
+    int exp = 0;
+    if (word.size() >= 2 && multiplierExponent(word.substr(0, 2), exp, allowR)) return 2;
+    if (!word.empty() && multiplierExponent(word.substr(0, 1), exp, allowR)) return 1;
+    return 0;
+}
+
+bool isUnitWord(std::string_view w)
+{
+    static const char *const UNITS[] = {
+        "V", "A", "F", "H", "W", "J", "s", "Hz", "R", "ohm", "Ohm", "Wh",
+        "\xCE\xA9",     // Ω (U+03A9)
+        "\xE2\x84\xA6"  // Ω (U+2126)
+    };
+    for (const char *u : UNITS) {
+        if (w == u) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+class EngCompiler
+{
+public:
+    explicit EngCompiler(std::string_view text) : m_p(text.data()), m_end(text.data() + text.size()) {}
+
+    EngProgram run()
+    {
+        skipSpace();
+        if (m_p == m_end) fail("empty expression");
+        else {
+            parseExpr();
+            skipSpace();
+            if (ok() && m_p != m_end) fail("unexpected character");
+        }
+        if (!ok()) {
+            m_prog.m_code.clear();
+            m_prog.m_variables.clear();
+        }
+        m_prog.m_maxStack = m_maxDepth;
+        return std::move(m_prog);
+    }
+
+private:
+    using Op = EngProgram::Op;
+    using Instr = EngProgram::Instr;
+
+    bool ok() const { return m_prog.m_error.empty(); }
+    void fail(const char *msg) { if (ok()) m_prog.m_error = msg; }
+
+    void skipSpace()
+    {
+        while (m_p != m_end && (*m_p == ' ' || *m_p == '\t')) ++m_p;
+    }
+
+    void adjustDepth(int delta)
+    {
+        m_depth += delta;
+        if (m_depth > m_maxDepth) m_maxDepth = m_depth;
+        if (m_depth > MAX_STACK) fail("expression too deep");
+    }
+
+    void emitPush(double v)
+    {
+        m_prog.m_code.push_back({Op::Push, 0, v});
+        adjustDepth(+1);
+    }
+
+    void emitVar(std::uint32_t index)
+    {
+        m_prog.m_code.push_back({Op::Var, index, 0});
+        adjustDepth(+1);
+    }
+
+    static double apply1(Op op, double a)
+    {
+        switch (op) {
+        case Op::Neg: return -a;
+        case Op::Sqrt: return std::sqrt(a);
+        case Op::Ln: return std::log(a);
+        case Op::Log10: return std::log10(a);
+        case Op::Exp: return std::exp(a);
+        case Op::Abs: return std::fabs(a);
+        default: return NaN;
+        }
+    }
+
+    static double apply2(Op op, double a, double b)
+    {
+        switch (op) {
+        case Op::Add: return a + b;
+        case Op::Sub: return a - b;
+        case Op::Mul: return a * b;
+        case Op::Div: return a / b;
+        case Op::Pow: return std::pow(a, b);
+        default: return NaN;
+        }
+    }
+
+    // 一元運算：運算元是常數就直接摺疊
+    void emitUnary(Op op)
+    {
+        std::vector<Instr> &code = m_prog.m_code;
+        if (!code.empty() && code.back().op == Op::Push) {
+            code.back().value = apply1(op, code.back().value);
+            return;
+        }
+        code.push_back({op, 0, 0});
+    }
+
+    // 二元運算：兩個運算元都是常數就直接摺疊
+    void emitBinary(Op op)
+    {
+        std::vector<Instr> &code = m_prog.m_code;
+        std::size_t n = code.size();
+        if (n >= 2 && code[n - 1].op == Op::Push && code[n - 2].op == Op::Push) {
+            code[n - 2].value = apply2(op, code[n - 2].value, code[n - 1].value);
+            code.pop_back();
+        } else {
+            code.push_back({op, 0, 0});
+        }
+        adjustDepth(-1);
+    }
+
+    void parseExpr()
+    {
+        parseTerm();
+        for (;;) {
+            skipSpace();
+            if (!ok() || m_p == m_end) return;
+            char c = *m_p;
+            if (c != '+' && c != '-') return;
+            ++m_p;
+            parseTerm();
+            emitBinary(c == '+' ? Op::Add : Op::Sub);
+        }
+    }
+
+    void parseTerm()
+    {
+        parseUnary();
+        for (;;) {
+            skipSpace();
+            if (!ok() || m_p == m_end) return;
+            char c = *m_p;
+            if (c != '*' && c != '/') return;
+            ++m_p;
+            parseUnary();
+            emitBinary(c == '*' ? Op::Mul : Op::Div);
+        }
+    }
+
+    void parseUnary()
+    {
+        skipSpace();
+        if (m_p != m_end && (*m_p == '+' || *m_p == '-')) {
+            bool neg = (*m_p == '-');
+            ++m_p;
+            parseUnary();
+            if (neg) emitUnary(Op::Neg);
+            return;
+        }
+        parsePower();
+    }
+
+    void parsePower()
+    {
+        parsePrimary();
+        skipSpace();
+        if (ok() && m_p != m_end && *m_p == '^') {
+            ++m_p;
+            parseUnary();
+            emitBinary(Op::Pow);
+        }
+    }
+
+    void parsePrimary()
+    {
+        if (!ok()) return;
+        skipSpace();
+        if (m_p == m_end) { fail("unexpected end"); return; }
+
+        char c = *m_p;
+        if (c == '(') {
+            ++m_p;
+            parseExpr();
+            skipSpace();
+            if (m_p == m_end || *m_p != ')') { fail("missing ')'"); return; }
+            ++m_p;
+            return;
+        }
+        if (isDigit(c) || c == '.') {
+            parseNumber();
+            return;
+        }
+        if (isWordChar(c)) {
+            parseIdentifier();
+            return;
+        }
+        fail("unexpected character");
+    }
+
+    std::string_view readWord()
+    {
+        const char *b = m_p;
+        while (m_p != m_end && (isWordChar(*m_p) || (m_p != b && isDigit(*m_p)))) ++m_p;
+        return std::string_view(b, static_cast<std::size_t>(m_p - b));
+    }
+
+    void parseNumber()
+    {
+        const char *start = m_p;
+        double value = 0;
+        const char *stop = parseDouble(m_p, m_end, value);
+        if (stop == m_p) { fail("bad number"); return; }
+        bool plainInteger = true;
+        for (const char *q = m_p; q != stop; ++q) {
+            if (!isDigit(*q)) { plainInteger = false; break; }
+        }
+        m_p = stop;
+
+        // a. RKM：整數 + 倍率字母 + 數字 (4k7、4R7、1n2)
+        if (plainInteger && m_p != m_end) {
+            std::string_view rest(m_p, static_cast<std::size_t>(m_end - m_p));
+            std::size_t len = multiplierLength(rest, true);
+            if (len > 0 && len < rest.size() && isDigit(rest[len])) {
+                int exp = 0;
+                multiplierExponent(rest.substr(0, len), exp, true);
+                // 以「整數.小數」重新解析，避免二進位捨入誤差
+                std::string digits(start, stop);
+                digits.push_back('.');
+                const char *f = m_p + len;
+                while (f != m_end && isDigit(*f)) digits.push_back(*f++);
+                double mant = 0;
+                parseDouble(digits.data(), digits.data() + digits.size(), mant);
+                m_p = f;
+                value = mant * units::pow10(exp);
+                // RKM 之後仍可接單位：4k7Ω
+                std::string_view unit = readWord();
+                if (!unit.empty() && !isUnitWord(unit)) { fail("unknown unit suffix"); return; }
+                emitPush(value);
+                return;
+            }
+        }
+
+        std::string_view word = readWord();
+        if (!word.empty()) {
+            std::size_t len = multiplierLength(word, false);
+            std::string_view tail = word.substr(len);
+            if (len > 0 && (tail.empty() || isUnitWord(tail))) {
+                int exp = 0;
+                multiplierExponent(word.substr(0, len), exp, false);
+                value *= units::pow10(exp);
+            } else if (!isUnitWord(word)) {
+                fail("unknown unit suffix");
+                return;
+            }
+        }
+        emitPush(value);
+    }
+
+    void parseIdentifier()
+    {
+        std::string_view name = readWord();
+        skipSpace();
+
+        if (m_p != m_end && *m_p == '(') {
+            Op op;
+            if (name == "sqrt") op = Op::Sqrt;
+            else if (name == "ln") op = Op::Ln;
+            else if (name == "log") op = Op::Log10;
+            else if (name == "exp") op = Op::Exp;
+            else if (name == "abs") op = Op::Abs;
+            else { fail("unknown function"); return; }
+            ++m_p;
+            parseExpr();
+            skipSpace();
+            if (m_p == m_end || *m_p != ')') { fail("missing ')'"); return; }
+            ++m_p;
+            emitUnary(op);
+            return;
+        }
+
+        if (name == "pi" || name == "PI" || name == "\xCF\x80") { emitPush(3.14159265358979323846); return; }
+        if (name == "e") { emitPush(2.71828182845904523536); return; }
+
+        // 變數
+        std::vector<std::string> &vars = m_prog.m_variables;
+        std::uint32_t index = 0;
+        while (index < vars.size() && vars[index] != name) ++index;
+        if (index == vars.size()) vars.emplace_back(name);
+        emitVar(index);
+    }
+
+    const char *m_p;
+    const char *m_end;
+    int m_depth = 0;
+    int m_maxDepth = 0;
+    EngProgram m_prog;
+};
+
+EngProgram compileEngExpr(std::string_view text)
+{
+    return EngCompiler(text).run();
+}
+
+double EngProgram::evaluate(const double *vars, std::size_t varCount) const
+{
+    if (!valid() || m_code.empty()) return NaN;
+    if (varCount < m_variables.size()) return NaN;
+
+    double stack[MAX_STACK];
+    int sp = 0;
+    for (const Instr &in : m_code) {
+        switch (in.op) {
+        case Op::Push: stack[sp++] = in.value; break;
+        case Op::Var: stack[sp++] = vars[in.index]; break;
+        case Op::Add: --sp; stack[sp - 1] += stack[sp]; break;
+        case Op::Sub: --sp; stack[sp - 1] -= stack[sp]; break;
+        case Op::Mul: --sp; stack[sp - 1] *= stack[sp]; break;
+        case Op::Div: --sp; stack[sp - 1] /= stack[sp]; break;
+        case Op::Pow: --sp; stack[sp - 1] = std::pow(stack[sp - 1], stack[sp]); break;
+        case Op::Neg: stack[sp - 1] = -stack[sp - 1]; break;
+        case Op::Sqrt: stack[sp - 1] = std::sqrt(stack[sp - 1]); break;
+        case Op::Ln: stack[sp - 1] = std::log(stack[sp - 1]); break;
+        case Op::Log10: stack[sp - 1] = std::log10(stack[sp - 1]); break;
+        case Op::Exp: stack[sp - 1] = std::exp(stack[sp - 1]); break;
+        case Op::Abs: stack[sp - 1] = std::fabs(stack[sp - 1]); break;
+        }
+    }
+    return stack[0];
+}
+
+void EngProgram::evaluateBatch(const double *const *varColumns, std::size_t varCount,
+                               double *out, std::size_t n) const
+{
+    if (!valid() || m_code.empty() || varCount < m_variables.size()) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = NaN;
+        return;
+    }
+    if (isConstant()) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = m_code[0].value;
+        return;
+    }
+
+    // 堆疊的每一層是一個區塊長度的陣列，每個指令對整個區塊做同一件事
+    std::vector<double> stackMem(static_cast<std::size_t>(m_maxStack) * BATCH_BLOCK);
+    for (std::size_t base = 0; base < n; base += BATCH_BLOCK) {
+        const std::size_t len = (n - base < BATCH_BLOCK) ? n - base : BATCH_BLOCK;
+        int sp = 0;
+        auto slot = [&](int level) { return stackMem.data() + static_cast<std::size_t>(level) * BATCH_BLOCK; };
+
+        for (const Instr &in : m_code) {
+            switch (in.op) {
+            case Op::Push: {
+                double *d = slot(sp++);
+                for (std::size_t i = 0; i < len; ++i) d[i] = in.value;
+                break;
+            }
+            case Op::Var: {
+                double *d = slot(sp++);
+                const double *s = varColumns[in.index] + base;
+                for (std::size_t i = 0; i < len; ++i) d[i] = s[i];
+                break;
+            }
+            case Op::Add: case Op::Sub: case Op::Mul: case Op::Div: case Op::Pow: {
+                --sp;
+                double *a = slot(sp - 1);
+                const double *b = slot(sp);
+                switch (in.op) {
+                case Op::Add: for (std::size_t i = 0; i < len; ++i) a[i] += b[i]; break;
+                case Op::Sub: for (std::size_t i = 0; i < len; ++i) a[i] -= b[i]; break;
+                case Op::Mul: for (std::size_t i = 0; i < len; ++i) a[i] *= b[i]; break;
+                case Op::Div: for (std::size_t i = 0; i < len; ++i) a[i] /= b[i]; break;
+                default: for (std::size_t i = 0; i < len; ++i) a[i] = std::pow(a[i], b[i]); break;
+                }
+                break;
+            }
+            case Op::Neg: {
+                double *a = slot(sp - 1);
+                for (std::size_t i = 0; i < len; ++i) a[i] = -a[i];
+                break;
+            }
+            case Op::Sqrt: {
+                double *a = slot(sp - 1);
+                for (std::size_t i = 0; i < len; ++i) a[i] = std::sqrt(a[i]);
+                break;
+            }
+            case Op::Ln: {
+                double *a = slot(sp - 1);
+                for (std::size_t i = 0; i < len; ++i) a[i] = std::log(a[i]);
+                break;
+            }
+            case Op::Log10: {
+                double *a = slot(sp - 1);
+                for (std::size_t i = 0; i < len; ++i) a[i] = std::log10(a[i]);
+                break;
+            }
+            case Op::Exp: {
+                double *a = slot(sp - 1);
+                for (std::size_t i = 0; i < len; ++i) a[i] = std::exp(a[i]);
+                break;
+            }
+            case Op::Abs: {
+                double *a = slot(sp - 1);
+                for (std::size_t i = 0; i < len; ++i) a[i] = std::fabs(a[i]);
+                break;
+            }
+            }
+        }
+        const double *r = slot(0);
+        for (std::size_t i = 0; i < len; ++i) out[base + i] = r[i];
+    }
+}
+
+// --- 快取 ---
+
+struct EngExprCache::Impl {
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const EngProgram>> map;
+};
+
+EngExprCache::EngExprCache(std::size_t capacity) : d(new Impl)
+{
+    d->capacity = capacity > 0 ? capacity : 1;
+}
+
+EngExprCache::~EngExprCache() = default;
+
+std::shared_ptr<const EngProgram> EngExprCache::get(std::string_view text)
+{
+    std::string key(text);
+    {
+        std::lock_guard<std::mutex> lock(d->mutex);
+        auto it = d->map.find(key);
+        if (it != d->map.end()) return it->second;
+    }
+
+    // 編譯在鎖外進行，兩個執行緒同時編譯同一段文字也只是多做一次
+    auto prog = std::make_shared<const EngProgram>(compileEngExpr(text));
+
+    std::lock_guard<std::mutex> lock(d->mutex);
+    if (d->map.size() >= d->capacity) d->map.clear();
+    d->map.emplace(std::move(key), prog);
+    return prog;
+}
+
+std::size_t EngExprCache::size() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->map.size();
+}
+
+void EngExprCache::clear()
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->map.clear();
+}
+
+EngExprCache &EngExprCache::global()
+{
+    static EngExprCache cache;
+    return cache;
+}
+
+bool evalEngExpr(std::string_view text, double &out)
+{
+    std::shared_ptr<const EngProgram> prog = EngExprCache::global().get(text);
+    if (!prog->valid() || !prog->variables().empty()) return false;
+    // 1/0、sqrt(-1)、超出 double 範圍等結果不是有限數，與數字解析一樣視為失敗
+    const double v = prog->evaluate();
+    if (!std::isfinite(v)) return false;
+    out = v;
+    return true;
+}
+
+} // namespace sc
@@ -0,0 +1,89 @@
+#ifndef SC_ENGEXPR_H
+#define SC_ENGEXPR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+/**
+ * 工程記號運算式：把輸入框的文字編譯成小型 bytecode，重複計算時只需執行 bytecode。
+ *
+ * 支援：
+ *  - 工程後綴：10u、4.7k、2.2uF、3.3V、100nF、1MΩ (單位字母會被忽略)
+ *  - RKM 代碼：4k7、4R7、2M2、4p7、1n2 (字母同時是小數點與倍率)
+ *  - 四則運算、次方 ^、括號、正負號
+ *  - 常數 pi (π)、e；函數 sqrt ln log exp abs
+ *  - 其他識別字視為變數，計算時再給值 (掃描/批次用)
+ */
+class EngProgram
+{
+public:
+    bool valid() const { return m_error.empty(); }
+    const std::string &error() const { return m_error; }
+
+    // 運算式用到的變數名稱，evaluate 時依此順序給值
+    const std::vector<std::string> &variables() const { return m_variables; }
+
+    // 沒有變數，結果在編譯時期就已算好
+    bool isConstant() const { return m_code.size() == 1 && m_code[0].op == Op::Push; }
+
+    // 執行 bytecode；無效的程式或變數數量不足時回傳 NaN
+    double evaluate(const double *vars = nullptr, std::size_t varCount = 0) const;
+
+    // 批次執行：varColumns[k] 是第 k 個變數長度 n 的連續陣列，結果寫入 out
+    // 以欄為單位直譯，每個指令的分派成本由整個區塊分攤
+    void evaluateBatch(const double *const *varColumns, std::size_t varCount,
+                       double *out, std::size_t n) const;
+
+private:
+    friend EngProgram compileEngExpr(std::string_view text);
+
+    enum class Op : std::uint8_t {
+        Push, Var, Add, Sub, Mul, Div, Pow, Neg, Sqrt, Ln, Log10, Exp, Abs
+    };
+    struct Instr {
+        Op op;
+        std::uint32_t index;   // Var 的變數編號
+        double value;          // Push 的常數
+    };
+
+    std::vector<Instr> m_code;
+    std::vector<std::string> m_variables;
+    int m_maxStack = 0;
+    std::string m_error;
+
+    friend class EngCompiler;
+};
+
+EngProgram compileEngExpr(std::string_view text);
+
+// 以文字為 key 的編譯結果快取 (執行緒安全)；超過容量時整個清空重建
+class EngExprCache
+{
+public:
+    explicit EngExprCache(std::size_t capacity = 1024);
+    ~EngExprCache();
+
+    std::shared_ptr<const EngProgram> get(std::string_view text);
+    std::size_t size() const;
+    void clear();
+
+    // 整個程式共用的快取 (GUI 輸入框用)
+    static EngExprCache &global();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> d;
+};
+
+// 計算不含變數的運算式 (經過全域快取)，語法錯誤、含變數或結果不是有限數 (例如 1/0) 時回傳 false
+bool evalEngExpr(std::string_view text, double &out);
+
+} // namespace sc
+
+#endif // SC_ENGEXPR_H
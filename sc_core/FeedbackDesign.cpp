@@ -0,0 +1,197 @@
+/**
+ * @file FeedbackDesign.cpp
+ * @brief 回授電阻設計：排序的分壓比索引 + 二分搜尋
+ *
+ * 【 1. 索引 】
+ * 分壓比 R2 / (R1 + R2) = m2 / (m1 * 10^d + m2)，只由兩個有效數字 (m1, m2) 與 decade 差 d 決定。
+ * 列出所有 (m1, m2, d) 並依比值排序：E96 約 12 萬筆、E192 約 48 萬筆，
+ * 每個系列只在第一次使用時建立一次 (std::call_once)。
+ *
+ * 【 2. 查詢 】
+ * 目標比值 k = Vref / Vout。二分搜尋 k 在索引中的位置，再以兩個指標往左右擴展，
+ * 每次取 Vout 誤差 |Vref / ratio - Vout| 較小的一邊 (每一邊的誤差都隨距離單調增加)，
+ * 所以候選是依輸出誤差由小到大出現的。比值相同 (在 1e-12 內) 的一串組合只是同一個分壓比的不同縮放，
+ * 整串一起取出，替每個挑一個符合電阻範圍與電流限制的 decade，只留總電阻最小的一組；
+ * 收滿 topK 個不同的比值就結束。
+ *
+ * 【 3. 最差情況 】
+ * Vout = Vref * (1 + R1 / R2) 以區間運算 (Interval.h) 計算 Vref 與電阻公差下的範圍。
+ */
+
+#include "FeedbackDesign.h"
+#include "Interval.h"
+#include "Units.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+
+namespace sc {
+
+namespace {
+
+constexpr std::size_t SERIES_COUNT = 6;
+// 比值相對差在這以內視為同一個分壓比 (等比例縮放的組合，捨入只差幾個 ulp)
+constexpr double RATIO_EPSILON = 1e-12;
+
+double scalePow10(double mant, int exp)
+{
+    if (exp < units::POW10_MIN || exp > units::POW10_MAX) return mant * std::pow(10.0, exp);
+    return (exp >= 0) ? mant * units::pow10(exp) : mant / units::pow10(-exp);
+}
+
+std::vector<RatioEntry> buildRatioIndex(ESeries series)
+{
+    const ESeriesTable t = eSeriesTable(series);
+    std::vector<RatioEntry> index;
+    index.reserve(t.size * t.size * (2 * RATIO_INDEX_DECADES + 1));
+    for (int d = -RATIO_INDEX_DECADES; d <= RATIO_INDEX_DECADES; ++d) {
+        for (std::size_t i1 = 0; i1 < t.size; ++i1) {
+            const double r1 = scalePow10(t.values[i1], d);
+            for (std::size_t i2 = 0; i2 < t.size; ++i2) {
+                RatioEntry e;
+                e.ratio = t.values[i2] / (r1 + t.values[i2]);
+                e.index1 = static_cast<std::uint16_t>(i1);
+                e.index2 = static_cast<std::uint16_t>(i2);
+                e.decades = static_cast<std::int8_t>(d);
+                index.push_back(e);
+            }
+        }
+    }
+    // 比值相同的組合 (例如 5.11 / 5.11 與 4.12 / 4.12) 以 (d, m1, m2) 排定先後，結果與排序實作無關
+    std::sort(index.begin(), index.end(), [](const RatioEntry &a, const RatioEntry &b) {
+        if (a.ratio != b.ratio) return a.ratio < b.ratio;
+        if (a.decades != b.decades) return a.decades < b.decades;
+        if (a.index1 != b.index1) return a.index1 < b.index1;
+        return a.index2 < b.index2;
+    });
+    return index;
+}
+
+// 把比值索引的一筆放到實際的 decade：R2 = m2 * 10^e、R1 = m1 * 10^(e + d)，
+// 取滿足所有下限的最小 e，再檢查上限。找不到回傳 false
+struct Placement {
+    double minR, maxR, minTotal, maxTotal;
+};
+
+bool place(const ESeriesTable &t, const RatioEntry &entry, const Placement &lim, double &R1, double &R2)
+{
+    const double m1 = scalePow10(t.values[entry.index1], entry.decades);   // 以 R2 的 decade 為基準
+    const double m2 = t.values[entry.index2];
+
+    // 下限 -> e 的最小值 (log10 只用來估計，之後以實際數值修正)
+    double need = std::max(lim.minR / std::min(m1, m2), lim.minTotal / (m1 + m2));
+    int e = need > 0 ? static_cast<int>(std::ceil(std::log10(need))) - 1 : -3;
+    for (;; ++e) {
+        R1 = scalePow10(m1, e);
+        R2 = scalePow10(m2, e);
+        if (R1 >= lim.minR && R2 >= lim.minR && R1 + R2 >= lim.minTotal) break;
+        if (e > 12) return false;
+    }
+    return R1 <= lim.maxR && R2 <= lim.maxR && R1 + R2 <= lim.maxTotal;
+}
+
+FeedbackPair makePair(double Vref, double Vout, double R1, double R2, const FeedbackOptions &opt)
+{
+    FeedbackPair p;
+    p.R1_ohm = R1;
+    p.R2_ohm = R2;
+    p.Vout_V = Vref * (1.0 + R1 / R2);
+    p.error = (p.Vout_V - Vout) / Vout;
+    const Interval v = tolerance(Vref, opt.vrefTolerance)
+                       * (tolerance(R1, opt.resistorTolerance) / tolerance(R2, opt.resistorTolerance) + 1.0);
+    p.worstMin_V = v.lower();
+    p.worstMax_V = v.upper();
+    p.worstError = std::max(std::fabs(v.lower() / Vout - 1.0), std::fabs(v.upper() / Vout - 1.0));
+    p.current_A = p.Vout_V / (R1 + R2);
+    return p;
+}
+
+} // namespace
+
+const std::vector<RatioEntry> &ratioIndex(ESeries series)
+{
+    static std::array<std::once_flag, SERIES_COUNT> once;
+    static std::array<std::vector<RatioEntry>, SERIES_COUNT> indexes;
+    const std::size_t s = std::min<std::size_t>(static_cast<std::size_t>(series), SERIES_COUNT - 1);
+    std::call_once(once[s], [&] { indexes[s] = buildRatioIndex(series); });
+    return indexes[s];
+}
+
+std::vector<FeedbackPair> feedbackBestPairs(double Vref, double Vout, const FeedbackOptions &options)
+{
+    std::vector<FeedbackPair> result;
+    if (!(Vref > 0) || !(Vout > Vref) || options.topK == 0) return result;
+    if (!(options.minResistor_ohm > 0) || !(options.maxResistor_ohm >= options.minResistor_ohm)) return result;
+
+    // I = Vout / (R1 + R2)：電流上限 -> 總電阻下限，電流下限 -> 總電阻上限
+    Placement lim;
+    lim.minR = options.minResistor_ohm;
+    lim.maxR = options.maxResistor_ohm;
+    lim.minTotal = (options.maxCurrent_A > 0 && std::isfinite(options.maxCurrent_A)) ? Vout / options.maxCurrent_A : 0;
+    lim.maxTotal = options.minCurrent_A > 0 ? Vout / options.minCurrent_A : std::numeric_limits<double>::infinity();
+    if (lim.minTotal > lim.maxTotal) return result;
+
+    // 電阻範圍只有幾個 decade 時，decade 差太大的比值不可能放得進去
+    const int maxDecades = static_cast<int>(std::ceil(std::log10(lim.maxR / lim.minR))) + 1;
+
+    const ESeriesTable t = eSeriesTable(options.series);
+    const std::vector<RatioEntry> &index = ratioIndex(options.series);
+    const double k = Vref / Vout;
+    const auto mid = std::lower_bound(index.begin(), index.end(), k,
+                                      [](const RatioEntry &e, double v) { return e.ratio < v; });
+
+    auto sameRatio = [](double a, double b) { return std::fabs(a - b) <= RATIO_EPSILON * b; };
+    auto voutError = [&](double ratio) { return std::fabs(Vref / ratio - Vout); };
+
+    // 兩個指標往外擴展，每次取輸出誤差較小的一邊；誤差相同時先取右邊 (Vout 偏低)
+    std::size_t right = static_cast<std::size_t>(mid - index.begin());
+    std::size_t left = right;
+    std::vector<double> ratios;                 // 已輸出的比值
+    while (result.size() < options.topK && (left > 0 || right < index.size())) {
+        std::size_t first, last;                // 這一串相同比值的範圍 [first, last)
+        if (right < index.size() && (left == 0 || voutError(index[right].ratio) <= voutError(index[left - 1].ratio))) {
+            first = right;
+            for (last = first + 1; last < index.size() && sameRatio(index[last].ratio, index[first].ratio); ++last) {}
+            right = last;
+        } else {
+            last = left;
+            for (first = last - 1; first > 0 && sameRatio(index[first - 1].ratio, index[last - 1].ratio); --first) {}
+            left = first;
+        }
+
+        // 同一串只留總電阻最小的放置 (相同時取 R2 較小者，順序固定)
+        bool found = false;
+        double bestR1 = 0, bestR2 = 0;
+        for (std::size_t i = first; i < last; ++i) {
+            if (std::abs(index[i].decades) > maxDecades) continue;
+            double R1, R2;
+            if (!place(t, index[i], lim, R1, R2)) continue;
+            if (!found || R1 + R2 < bestR1 + bestR2 || (R1 + R2 == bestR1 + bestR2 && R2 < bestR2)) {
+                bestR1 = R1;
+                bestR2 = R2;
+                found = true;
+            }
+        }
+        if (!found) continue;
+
+        // 中間兩側恰好相同的比值 (1e-12 內) 可能被拆成兩串，第二串略過
+        const double ratio = bestR2 / (bestR1 + bestR2);
+        if (std::any_of(ratios.begin(), ratios.end(), [&](double r) { return sameRatio(ratio, r); })) continue;
+        ratios.push_back(ratio);
+        result.push_back(makePair(Vref, Vout, bestR1, bestR2, options));
+    }
+    return result;
+}
+
+std::vector<std::vector<FeedbackPair>> feedbackBestPairs(double Vref, const std::vector<double> &vouts,
+                                                         const FeedbackOptions &options)
+{
+    std::vector<std::vector<FeedbackPair>> out;
+    out.reserve(vouts.size());
+    for (double v : vouts) out.push_back(feedbackBestPairs(Vref, v, options));
+    return out;
+}
+
+} // namespace sc
@@ -0,0 +1,72 @@
+#ifndef SC_FEEDBACKDESIGN_H
+#define SC_FEEDBACKDESIGN_H
+
+/**
+ * @file FeedbackDesign.h
+ * @brief 穩壓器 (Buck / LDO) 回授電阻設計
+ *
+ *    Vout ── R1 ──┬── FB (= Vref)
+ *                 R2
+ *                 └── GND          Vout = Vref * (1 + R1 / R2)
+ *
+ * 所有標準值組合的分壓比 R2 / (R1 + R2) 只跟兩個有效數字與 decade 差有關，
+ * 第一次使用某個系列時把這些比值排序建成索引 (之後共用)，每次查詢只要一次二分搜尋。
+ */
+
+#include "ESeries.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sc {
+
+struct FeedbackOptions {
+    ESeries series = ESeries::E96;
+    double minResistor_ohm = 1e3;           // 單顆電阻允許範圍
+    double maxResistor_ohm = 1e6;
+    double maxCurrent_A = std::numeric_limits<double>::infinity();   // 分壓電流上限 -> 總電阻下限
+    double minCurrent_A = 0;                // 分壓電流下限 (抗雜訊) -> 總電阻上限
+    double vrefTolerance = 0.01;            // Vref 精度 (±1%)
+    double resistorTolerance = 0.01;        // 電阻公差
+    std::size_t topK = 10;
+};
+
+struct FeedbackPair {
+    double R1_ohm;             // 上方 (Vout -> FB)
+    double R2_ohm;             // 下方 (FB -> GND)
+    double Vout_V;             // 標稱輸出電壓
+    double error;              // 標稱誤差 (Vout - 目標) / 目標
+    double worstMin_V;         // Vref 與電阻公差下的輸出範圍
+    double worstMax_V;
+    double worstError;         // 最差情況的最大相對誤差
+    double current_A;          // 分壓電流 Vout / (R1 + R2)
+};
+
+// 依 |Vout - 目標| 由小到大回傳前 topK 組，每個分壓比只出現一次。同一個比值有多種組合
+// (等比例的有效數字、不同 decade) 可選時，取符合限制的最小總電阻 (電流最接近 maxCurrent_A，回授節點最不怕雜訊)
+std::vector<FeedbackPair> feedbackBestPairs(double Vref, double Vout, const FeedbackOptions &options);
+
+// 多個目標電壓共用同一個索引
+std::vector<std::vector<FeedbackPair>> feedbackBestPairs(double Vref, const std::vector<double> &vouts,
+                                                         const FeedbackOptions &options);
+
+// --- 比值索引 ---
+
+struct RatioEntry {
+    double ratio;              // R2 / (R1 + R2)
+    std::uint16_t index1;      // R1 在系列表中的位置
+    std::uint16_t index2;      // R2 在系列表中的位置
+    std::int8_t decades;       // R1 / R2 的 decade 差 (R1 = m1 * 10^(e + decades)、R2 = m2 * 10^e)
+};
+
+// R1 / R2 的 decade 差範圍 (±)，涵蓋 1 Ohm ~ 1 MOhm 的任意組合
+constexpr int RATIO_INDEX_DECADES = 6;
+
+// 依 ratio 遞增排序的索引；第一次呼叫時建立 (執行緒安全)，之後回傳同一份
+const std::vector<RatioEntry> &ratioIndex(ESeries series);
+
+} // namespace sc
+
+#endif // SC_FEEDBACKDESIGN_H
@@ -0,0 +1,544 @@
+/**
+ * @file GridSolver.cpp
+ * @brief 張量積網格五點格式：聚合多重網格預條件的共軛梯度法
+ *
+ * 【 1. 多重網格 】
+ * 每一層把 2 x 2 格聚合成一格，粗網格的耦合是跨過兩個聚合之間的細網格耦合總和
+ * (分段常數延拓的 Galerkin 算子 PᵀAP)，所以係數跳躍 (銅 / FR-4、導體 / 介質) 自動反映在粗網格上，
+ * 粗網格仍是五點格式。最粗一層 (數十格) 以 Cholesky 直接解。
+ * 分段常數延拓的 V-cycle 收斂率會隨層數變差，所以粗網格誤差方程式做兩次循環 (W-cycle)，
+ * 迭代次數與網格大小無關，而粗網格只有 1/4 的格數，多出的工作量不到一倍。
+ *
+ * 【 2. 平滑 】
+ * 交替方向的斑馬線鬆弛：隔列整列 (x 線) 再隔欄整欄 (y 線) 以三對角直接解。
+ * 漸變網格的格子長寬比很大，點 Gauss-Seidel 在這種格子上幾乎不收斂，線鬆弛則不受影響。
+ * 後平滑的順序與前平滑完全相反，整體是對稱的，可以當作 CG 的預條件。
+ *
+ * 【 3. 平行與向量化 】
+ * 格子以列為單位連續存放 (x 方向連續)，係數也是 struct-of-arrays：gE (往東)、gN (往北)、diag。
+ * 算子與殘差的內層迴圈沒有分支，可由編譯器向量化；x 線鬆弛同一種顏色各列互不相依，
+ * 大網格時以列區塊分給多個執行緒；y 線鬆弛逐列推進同色各欄 (存取仍是連續的)，以欄區塊分給多個執行緒。
+ * 內積以區塊部分和依序相加 (結果與執行緒數無關)。三對角的消去係數每層預先算好，平滑時沒有除法。
+ */
+
+#include "GridSolver.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sc {
+
+// 以 grading 倍率從 h0 放大，填滿長度 length (最後一格吸收餘數)，回傳各格寬度
+std::vector<double> gradedCells(double length, double h0, double grading)
+{
+    std::vector<double> cells;
+    double x = 0, h = h0;
+    while (length - x > 1.5 * h) {
+        cells.push_back(h);
+        x += h;
+        h *= grading;
+    }
+    cells.push_back(length - x);
+    return cells;
+}
+
+// 兩側都從 h0 開始放大、在中間相接的格子
+std::vector<double> gradedBothEnds(double length, double h0, double grading)
+{
+    std::vector<double> half = gradedCells(0.5 * length, h0, grading);
+    std::vector<double> cells(half.begin(), half.end());
+    cells.insert(cells.end(), half.rbegin(), half.rend());
+    return cells;
+}
+
+void appendEdges(std::vector<double> &edges, const std::vector<double> &cells)
+{
+    for (double h : cells) edges.push_back(edges.back() + h);
+}
+
+namespace {
+
+// 超過這個格數才分給多個執行緒 (小網格開執行緒的成本比計算還高)
+constexpr std::size_t PARALLEL_MIN_CELLS = std::size_t(1) << 16;
+// 每個執行緒工作區塊的列數下限
+constexpr int ROWS_PER_BLOCK_MIN = 16;
+// 每個執行緒工作區塊的欄數下限 (y 線鬆弛)
+constexpr int COLUMNS_PER_BLOCK_MIN = 64;
+// 最粗一層的格數上限 (直接解)
+constexpr std::size_t COARSEST_CELLS = 64;
+// 每次循環的前 / 後平滑次數
+constexpr int SMOOTHING_SWEEPS = 1;
+// 粗網格循環次數 (1 = V-cycle、2 = W-cycle)
+constexpr int COARSE_CYCLES = 2;
+
+// ---------------- 多重網格的一層 ----------------
+
+struct Level {
+    int nx = 0;
+    int ny = 0;
+    std::vector<double> gE;     // 到東邊鄰格的耦合 (最後一欄為 0)
+    std::vector<double> gN;     // 到北邊鄰格的耦合 (最後一列為 0)
+    std::vector<double> diag;   // 對角線 (所有耦合 + 邊界項)
+    std::vector<double> x, b, r;
+    std::vector<double> rowC, rowM, colC, colM;     // 線鬆弛的消去係數 (factorLines)
+    std::vector<double> dp;         // 線鬆弛的暫存
+    std::vector<double> cholesky;   // 最粗一層：下三角 Cholesky 因子 (n x n)
+
+    std::size_t cells() const { return static_cast<std::size_t>(nx) * ny; }
+};
+
+// 以列區塊執行 fn(j0, j1)，大網格時分給多個執行緒
+template <typename Fn>
+void forRows(const Level &L, unsigned threads, Fn fn)
+{
+    if (L.cells() < PARALLEL_MIN_CELLS || threads <= 1) {
+        fn(0, L.ny);
+        return;
+    }
+    const int rows = std::max(ROWS_PER_BLOCK_MIN, L.ny / static_cast<int>(threads * 4) + 1);
+    const std::size_t blocks = static_cast<std::size_t>((L.ny + rows - 1) / rows);
+    parallelFor(blocks, threads, [&](std::size_t k) {
+        const int j0 = static_cast<int>(k) * rows;
+        fn(j0, std::min(L.ny, j0 + rows));
+    });
+}
+
+// 以欄區塊執行 fn(i0, i1)，大網格時分給多個執行緒
+template <typename Fn>
+void forColumns(const Level &L, unsigned threads, Fn fn)
+{
+    if (L.cells() < PARALLEL_MIN_CELLS || threads <= 1) {
+        fn(0, L.nx);
+        return;
+    }
+    const int cols = std::max(COLUMNS_PER_BLOCK_MIN, L.nx / static_cast<int>(threads * 4) + 1);
+    const std::size_t blocks = static_cast<std::size_t>((L.nx + cols - 1) / cols);
+    parallelFor(blocks, threads, [&](std::size_t k) {
+        const int i0 = static_cast<int>(k) * cols;
+        fn(i0, std::min(L.nx, i0 + cols));
+    });
+}
+
+// 以列區塊計算部分和再依序相加 (與執行緒數無關)
+template <typename Fn>
+double sumRows(const Level &L, unsigned threads, Fn rowSum)
+{
+    if (L.cells() < PARALLEL_MIN_CELLS || threads <= 1) {
+        double s = 0;
+        for (int j = 0; j < L.ny; ++j) s += rowSum(j);
+        return s;
+    }
+    const int rows = std::max(ROWS_PER_BLOCK_MIN, L.ny / static_cast<int>(threads * 4) + 1);
+    const std::size_t blocks = static_cast<std::size_t>((L.ny + rows - 1) / rows);
+    std::vector<double> partial(blocks, 0.0);
+    parallelFor(blocks, threads, [&](std::size_t k) {
+        const int j0 = static_cast<int>(k) * rows;
+        const int j1 = std::min(L.ny, j0 + rows);
+        double s = 0;
+        for (int j = j0; j < j1; ++j) s += rowSum(j);
+        partial[k] = s;
+    });
+    double s = 0;
+    for (double v : partial) s += v;
+    return s;
+}
+
+// out = A * v 的第 j 列
+inline void applyRow(const Level &L, const double *v, double *out, int j)
+{
+    const int nx = L.nx;
+    const std::size_t row = static_cast<std::size_t>(j) * nx;
+    const double *gE = &L.gE[row];
+    const double *gN = &L.gN[row];
+    const double *gS = (j > 0) ? &L.gN[row - nx] : nullptr;
+    const double *d = &L.diag[row];
+    const double *c = v + row;
+    double *o = out + row;
+
+    for (int i = 0; i < nx; ++i) o[i] = d[i] * c[i];
+    for (int i = 0; i + 1 < nx; ++i) {
+        o[i] -= gE[i] * c[i + 1];
+        o[i + 1] -= gE[i] * c[i];
+    }
+    if (j + 1 < L.ny) {
+        const double *n = c + nx;
+        for (int i = 0; i < nx; ++i) o[i] -= gN[i] * n[i];
+    }
+    if (gS) {
+        const double *s = c - nx;
+        for (int i = 0; i < nx; ++i) o[i] -= gS[i] * s[i];
+    }
+}
+
+// 線鬆弛的三對角矩陣只和耦合係數有關，Thomas 法的消去係數每層預先算好一次：
+// rowC / rowM：x 線 (沿 i 消去) 的上對角係數與 1 / 主元；colC / colM：y 線 (沿 j 消去)
+void factorLines(Level &L)
+{
+    const int nx = L.nx;
+    const int ny = L.ny;
+    const std::size_t n = L.cells();
+    L.rowC.assign(n, 0.0);
+    L.rowM.assign(n, 0.0);
+    L.colC.assign(n, 0.0);
+    L.colM.assign(n, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * nx + i;
+            // 不在系統內的格子 (diag = 0) 沒有耦合，主元為 0：該格的解固定為 0
+            double pivot = L.diag[k] - ((i > 0) ? L.gE[k - 1] * L.rowC[k - 1] : 0.0);
+            L.rowM[k] = (pivot > 0) ? 1.0 / pivot : 0.0;
+            L.rowC[k] = L.gE[k] * L.rowM[k];
+            pivot = L.diag[k] - ((j > 0) ? L.gN[k - nx] * L.colC[k - nx] : 0.0);
+            L.colM[k] = (pivot > 0) ? 1.0 / pivot : 0.0;
+            L.colC[k] = L.gN[k] * L.colM[k];
+        }
+    }
+}
+
+// x 方向線鬆弛：同時解 j % 2 == color 的整列 (三對角)，上下兩列的值當作已知
+void smoothRows(Level &L, int color, unsigned threads)
+{
+    const int nx = L.nx;
+    forRows(L, threads, [&](int j0, int j1) {
+        for (int j = j0 + ((j0 + color) & 1); j < j1; j += 2) {
+            const std::size_t row = static_cast<std::size_t>(j) * nx;
+            const double *gE = &L.gE[row];
+            const double *gN = &L.gN[row];
+            const double *b = &L.b[row];
+            const double *c = &L.rowC[row];
+            const double *m = &L.rowM[row];
+            double *x = &L.x[row];
+            double *dp = &L.dp[row];
+            for (int i = 0; i < nx; ++i) dp[i] = b[i];
+            if (j + 1 < L.ny) {
+                const double *xn = x + nx;
+                for (int i = 0; i < nx; ++i) dp[i] += gN[i] * xn[i];
+            }
+            if (j > 0) {
+                const double *gS = gN - nx;
+                const double *xs = x - nx;
+                for (int i = 0; i < nx; ++i) dp[i] += gS[i] * xs[i];
+            }
+            dp[0] *= m[0];
+            for (int i = 1; i < nx; ++i) dp[i] = (dp[i] + gE[i - 1] * dp[i - 1]) * m[i];
+            x[nx - 1] = dp[nx - 1];
+            for (int i = nx - 2; i >= 0; --i) x[i] = dp[i] + c[i] * x[i + 1];
+        }
+    });
+}
+
+// y 方向線鬆弛：同時解 i % 2 == color 的所有欄，逐列往上消去再往下回代，
+// 記憶體仍是沿列連續存取；各欄互不相依，大網格時以欄區塊分給多個執行緒
+void smoothColumns(Level &L, int color, unsigned threads)
+{
+    const int nx = L.nx;
+    const int ny = L.ny;
+    forColumns(L, threads, [&](int i0, int i1) {
+        const int first = i0 + ((i0 + color) & 1);
+        for (int j = 0; j < ny; ++j) {
+            const std::size_t row = static_cast<std::size_t>(j) * nx;
+            const double *gE = &L.gE[row];
+            const double *b = &L.b[row];
+            const double *m = &L.colM[row];
+            const double *x = &L.x[row];
+            double *dp = &L.dp[row];
+            for (int i = first; i < i1; i += 2) {
+                double rhs = b[i];
+                if (i > 0) rhs += gE[i - 1] * x[i - 1];
+                if (i + 1 < nx) rhs += gE[i] * x[i + 1];
+                dp[i] = rhs;
+            }
+            if (j > 0) {
+                const double *gS = &L.gN[row - nx];
+                const double *dps = dp - nx;
+                for (int i = first; i < i1; i += 2) dp[i] += gS[i] * dps[i];
+            }
+            for (int i = first; i < i1; i += 2) dp[i] *= m[i];
+        }
+        for (int j = ny - 1; j >= 0; --j) {
+            const std::size_t row = static_cast<std::size_t>(j) * nx;
+            double *x = &L.x[row];
+            const double *dp = &L.dp[row];
+            if (j + 1 < ny) {
+                const double *c = &L.colC[row];
+                const double *xn = x + nx;
+                for (int i = first; i < i1; i += 2) x[i] = dp[i] + c[i] * xn[i];
+            } else {
+                for (int i = first; i < i1; i += 2) x[i] = dp[i];
+            }
+        }
+    });
+}
+
+// 前平滑：x 線 (紅、黑) 再 y 線 (紅、黑)；後平滑順序完全相反，前後互為鏡像，
+// 不論 COARSE_CYCLES 幾次，循環 (預條件子) 都是對稱的
+void presmooth(Level &L, unsigned threads)
+{
+    smoothRows(L, 0, threads);
+    smoothRows(L, 1, threads);
+    smoothColumns(L, 0, threads);
+    smoothColumns(L, 1, threads);
+}
+
+void postsmooth(Level &L, unsigned threads)
+{
+    smoothColumns(L, 1, threads);
+    smoothColumns(L, 0, threads);
+    smoothRows(L, 1, threads);
+    smoothRows(L, 0, threads);
+}
+
+Level coarsen(const Level &f)
+{
+    Level c;
+    c.nx = (f.nx + 1) / 2;
+    c.ny = (f.ny + 1) / 2;
+    c.gE.assign(c.cells(), 0.0);
+    c.gN.assign(c.cells(), 0.0);
+    c.diag.assign(c.cells(), 0.0);
+    for (int j = 0; j < f.ny; ++j) {
+        for (int i = 0; i < f.nx; ++i) {
+            const std::size_t fi = static_cast<std::size_t>(j) * f.nx + i;
+            const std::size_t ci = static_cast<std::size_t>(j / 2) * c.nx + i / 2;
+            c.diag[ci] += f.diag[fi];
+            // 聚合內部的耦合從對角線扣掉 (兩端各一次)，跨聚合的累加到粗網格耦合
+            if (i + 1 < f.nx) {
+                if ((i & 1) == 0) c.diag[ci] -= 2 * f.gE[fi];
+                else c.gE[ci] += f.gE[fi];
+            }
+            if (j + 1 < f.ny) {
+                if ((j & 1) == 0) c.diag[ci] -= 2 * f.gN[fi];
+                else c.gN[ci] += f.gN[fi];
+            }
+        }
+    }
+    return c;
+}
+
+void factorCoarsest(Level &L)
+{
+    const std::size_t n = L.cells();
+    std::vector<double> a(n * n, 0.0);
+    for (int j = 0; j < L.ny; ++j) {
+        for (int i = 0; i < L.nx; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * L.nx + i;
+            a[k * n + k] = (L.diag[k] > 0) ? L.diag[k] : 1.0;     // 不在系統內的格子當作單位列
+            if (i + 1 < L.nx) a[(k + 1) * n + k] = a[k * n + k + 1] = -L.gE[k];
+            if (j + 1 < L.ny) a[(k + L.nx) * n + k] = a[k * n + k + L.nx] = -L.gN[k];
+        }
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        double d = a[k * n + k];
+        for (std::size_t m = 0; m < k; ++m) d -= a[k * n + m] * a[k * n + m];
+        d = std::sqrt(std::max(d, 1e-300));
+        a[k * n + k] = d;
+        for (std::size_t r = k + 1; r < n; ++r) {
+            double s = a[r * n + k];
+            for (std::size_t m = 0; m < k; ++m) s -= a[r * n + m] * a[k * n + m];
+            a[r * n + k] = s / d;
+        }
+    }
+    L.cholesky.swap(a);
+}
+
+void solveCoarsest(Level &L)
+{
+    const std::size_t n = L.cells();
+    const std::vector<double> &a = L.cholesky;
+    for (std::size_t k = 0; k < n; ++k) {
+        double s = L.b[k];
+        for (std::size_t m = 0; m < k; ++m) s -= a[k * n + m] * L.x[m];
+        L.x[k] = s / a[k * n + k];
+    }
+    for (std::size_t k = n; k-- > 0;) {
+        double s = L.x[k];
+        for (std::size_t m = k + 1; m < n; ++m) s -= a[m * n + k] * L.x[m];
+        L.x[k] = s / a[k * n + k];
+    }
+}
+
+class Multigrid
+{
+public:
+    Multigrid(Level fine, unsigned threads) : threads(threads)
+    {
+        levels.push_back(std::move(fine));
+        while (levels.back().cells() > COARSEST_CELLS && (levels.back().nx > 1 || levels.back().ny > 1))
+            levels.push_back(coarsen(levels.back()));
+        for (Level &L : levels) {
+            L.x.assign(L.cells(), 0.0);
+            L.b.assign(L.cells(), 0.0);
+            L.r.assign(L.cells(), 0.0);
+            L.dp.assign(L.cells(), 0.0);
+            if (&L != &levels.back()) factorLines(L);
+        }
+        factorCoarsest(levels.back());
+    }
+
+    Level &fine() { return levels.front(); }
+
+    // z = M^-1 r (一次 W-cycle，初值 0)
+    void precondition(const std::vector<double> &r, std::vector<double> &z)
+    {
+        Level &f = levels.front();
+        f.b = r;
+        std::fill(f.x.begin(), f.x.end(), 0.0);
+        cycle(0);
+        z = f.x;
+    }
+
+    void apply(const Level &L, const double *v, double *out)
+    {
+        forRows(L, threads, [&](int j0, int j1) {
+            for (int j = j0; j < j1; ++j) applyRow(L, v, out, j);
+        });
+    }
+
+    unsigned threads;
+
+private:
+    std::vector<Level> levels;
+
+    // 從目前的 L.x 出發做一次循環；粗網格誤差方程式再做 COARSE_CYCLES 次 (W-cycle)
+    void cycle(std::size_t l)
+    {
+        Level &L = levels[l];
+        if (l + 1 == levels.size()) {
+            solveCoarsest(L);
+            return;
+        }
+        for (int s = 0; s < SMOOTHING_SWEEPS; ++s) presmooth(L, threads);
+
+        // 殘差限制到粗網格 (聚合內加總)
+        apply(L, L.x.data(), L.r.data());
+        Level &C = levels[l + 1];
+        std::fill(C.b.begin(), C.b.end(), 0.0);
+        for (int j = 0; j < L.ny; ++j) {
+            const std::size_t row = static_cast<std::size_t>(j) * L.nx;
+            double *cb = &C.b[static_cast<std::size_t>(j / 2) * C.nx];
+            for (int i = 0; i < L.nx; ++i) cb[i / 2] += L.b[row + i] - L.r[row + i];
+        }
+        std::fill(C.x.begin(), C.x.end(), 0.0);
+        const int visits = (l + 2 == levels.size()) ? 1 : COARSE_CYCLES;
+        for (int v = 0; v < visits; ++v) cycle(l + 1);
+
+        // 粗網格修正延拓回來 (分段常數)
+        forRows(L, threads, [&](int j0, int j1) {
+            for (int j = j0; j < j1; ++j) {
+                const double *cx = &C.x[static_cast<std::size_t>(j / 2) * C.nx];
+                double *x = &L.x[static_cast<std::size_t>(j) * L.nx];
+                for (int i = 0; i < L.nx; ++i) x[i] += cx[i / 2];
+            }
+        });
+
+        for (int s = 0; s < SMOOTHING_SWEEPS; ++s) postsmooth(L, threads);
+    }
+};
+
+// 預條件共軛梯度：x 為初值，回傳迭代次數
+int pcg(Multigrid &mg, const std::vector<double> &b, std::vector<double> &x, double tolerance, int maxIterations,
+        bool &converged)
+{
+    Level &L = mg.fine();
+    const std::size_t n = L.cells();
+    const int nx = L.nx;
+    std::vector<double> r(n), z(n), p(n), q(n);
+
+    auto dot = [&](const std::vector<double> &u, const std::vector<double> &v) {
+        return sumRows(L, mg.threads, [&](int j) {
+            const std::size_t row = static_cast<std::size_t>(j) * nx;
+            double s = 0;
+            for (int i = 0; i < nx; ++i) s += u[row + i] * v[row + i];
+            return s;
+        });
+    };
+
+    mg.apply(L, x.data(), q.data());
+    for (std::size_t k = 0; k < n; ++k) r[k] = b[k] - q[k];
+    const double bNorm = std::sqrt(dot(b, b));
+    converged = false;
+    if (!(bNorm > 0)) {
+        std::fill(x.begin(), x.end(), 0.0);
+        converged = true;
+        return 0;
+    }
+
+    mg.precondition(r, z);
+    p = z;
+    double rz = dot(r, z);
+    int it = 0;
+    while (it < maxIterations) {
+        if (std::sqrt(dot(r, r)) <= tolerance * bNorm) {
+            converged = true;
+            break;
+        }
+        ++it;
+        mg.apply(L, p.data(), q.data());
+        const double alpha = rz / dot(p, q);
+        forRows(L, mg.threads, [&](int j0, int j1) {
+            for (std::size_t k = static_cast<std::size_t>(j0) * nx; k < static_cast<std::size_t>(j1) * nx; ++k) {
+                x[k] += alpha * p[k];
+                r[k] -= alpha * q[k];
+            }
+        });
+        mg.precondition(r, z);
+        const double rzNew = dot(r, z);
+        const double beta = rzNew / rz;
+        rz = rzNew;
+        forRows(L, mg.threads, [&](int j0, int j1) {
+            for (std::size_t k = static_cast<std::size_t>(j0) * nx; k < static_cast<std::size_t>(j1) * nx; ++k)
+                p[k] = z[k] + beta * p[k];
+        });
+    }
+    if (!converged) converged = std::sqrt(dot(r, r)) <= tolerance * bNorm;
+    return it;
+}
+
+} // namespace
+
+struct GridSolver::Impl {
+    Multigrid mg;
+
+    Impl(Level fine, unsigned threads) : mg(std::move(fine), threads) {}
+};
+
+GridSolver::GridSolver(GridSystem system, unsigned threads)
+{
+    Level fine;
+    fine.nx = system.nx;
+    fine.ny = system.ny;
+    fine.gE = std::move(system.gE);
+    fine.gN = std::move(system.gN);
+    fine.diag = std::move(system.diag);
+    d = std::make_unique<Impl>(std::move(fine), threads ? threads : hardwareThreads());
+}
+
+GridSolver::~GridSolver() = default;
+
+int GridSolver::nx() const
+{
+    return d->mg.fine().nx;
+}
+
+int GridSolver::ny() const
+{
+    return d->mg.fine().ny;
+}
+
+void GridSolver::apply(const double *v, double *out) const
+{
+    d->mg.apply(d->mg.fine(), v, out);
+}
+
+int GridSolver::solve(const std::vector<double> &b, std::vector<double> &x, double tolerance, int maxIterations,
+                      bool *converged)
+{
+    if (x.size() != b.size()) x.assign(b.size(), 0.0);
+    bool ok = false;
+    const int it = pcg(d->mg, b, x, tolerance, maxIterations, ok);
+    if (converged) *converged = ok;
+    return it;
+}
+
+} // namespace sc
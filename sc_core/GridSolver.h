@@ -0,0 +1,68 @@
+#ifndef SC_GRIDSOLVER_H
+#define SC_GRIDSOLVER_H
+
+/**
+ * @file GridSolver.h
+ * @brief 張量積網格上五點格式的對稱正定系統 A x = b (多重網格預條件共軛梯度法)
+ *
+ * 有限體積離散的熱傳導 (TraceThermal2D)、靜電場 (Impedance) 都是這個形式：
+ * 每格一個未知數，只和東西南北四個鄰格耦合，
+ *   (A x)_k = diag_k x_k - Σ g_kl x_l
+ * 耦合 g 為正且對稱，diag >= 所有耦合的和 (邊界項、固定值的鄰格加在 diag)，
+ * diag = 0 (且沒有耦合) 的格子不屬於系統 (例如區域外、挖空的部分)，解固定為 0，
+ * 這些格子的 b 必須是 0；其餘每個連通區域至少要有一格接到固定值 (diag 大於耦合的和)，否則矩陣是奇異的。
+ * 建構時建立多重網格階層，之後同一個系統可以對不同的 b 重複求解。
+ */
+
+#include <memory>
+#include <vector>
+
+namespace sc {
+
+// 五點格式的係數，列 j、欄 i 的格子索引為 j * nx + i (x 方向連續)
+struct GridSystem {
+    int nx = 0;
+    int ny = 0;
+    std::vector<double> gE;     // 到東邊鄰格 (i + 1) 的耦合，最後一欄為 0
+    std::vector<double> gN;     // 到北邊鄰格 (j + 1) 的耦合，最後一列為 0
+    std::vector<double> diag;   // 對角線
+};
+
+class GridSolver
+{
+public:
+    explicit GridSolver(GridSystem system, unsigned threads = 0);     // threads 0 = 全部硬體執行緒
+    ~GridSolver();
+    GridSolver(const GridSolver &) = delete;
+    GridSolver &operator=(const GridSolver &) = delete;
+
+    int nx() const;
+    int ny() const;
+
+    // out = A v
+    void apply(const double *v, double *out) const;
+
+    // 預條件共軛梯度，x 為初值 (大小不符時從 0 開始)，相對殘差 |b - Ax| / |b| <= tolerance 為收斂。
+    // 回傳迭代次數
+    int solve(const std::vector<double> &b, std::vector<double> &x, double tolerance, int maxIterations,
+              bool *converged = nullptr);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> d;
+};
+
+// ---- 漸變網格 ----
+
+// 以 grading 倍率從 h0 放大，填滿長度 length (最後一格吸收餘數)，回傳各格寬度
+std::vector<double> gradedCells(double length, double h0, double grading);
+
+// 兩側都從 h0 開始放大、在中間相接的格子
+std::vector<double> gradedBothEnds(double length, double h0, double grading);
+
+// 把各格寬度接在 edges 最後一個邊界之後
+void appendEdges(std::vector<double> &edges, const std::vector<double> &cells);
+
+} // namespace sc
+
+#endif // SC_GRIDSOLVER_H
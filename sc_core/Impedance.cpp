@@ -0,0 +1,440 @@
+/**
+ * @file Impedance.cpp
+ * @brief 控制阻抗的封閉公式與 2D Laplace 場解
+ *
+ * 【 1. 封閉公式 】
+ * 微帶線：Hammerstad-Jensen (1980) 的 Z0(u)、εeff(u)，銅厚以等效線寬修正 (空氣中 Δu1、介質中 Δur)，
+ *   0.01 <= w/h <= 100 誤差約 0.2 % (不含銅厚修正本身的誤差)。
+ * 帶狀線：Wheeler (1978)，走線在兩平面正中央，銅厚以等效線寬 w' 修正，誤差約 0.5 %。
+ * 差動對：IPC-2141 的耦合修正
+ *   微帶線 Zdiff = 2 Z0 (1 - 0.48 e^(-0.96 s / h))、帶狀線 Zdiff = 2 Z0 (1 - 0.347 e^(-2.9 s / b))，
+ *   間距很小時誤差可達數 %，需要準確值時用場解。
+ *
+ * 【 2. 場解 】
+ * 截面左右對稱，只解 x >= 0 的一半：單端線與偶模在對稱面是 Neumann 邊界，奇模是 0 V。
+ * 漸變張量網格 (導體邊緣最細)，每格一個電位 (格心)，相鄰兩格的耦合是兩個半格 Δ/ε 的串聯，
+ * 導體內部是等電位的，導體那一側的半格不計，所以導體表面正好在格子邊界上。
+ * 導體格子 (1 V) 從方程式中消去：鄰格的耦合移到右邊 (b += g)，方程式仍是對稱正定的五點格式，
+ * 以 GridSolver 求解。參考平面 (下方、帶狀線上方) 與微帶線上方遠處的遮蔽是 0 V 的邊界。
+ * 導體電荷 Q = Σ g (1 - V_鄰格)，C = ε0 Q；Z0 = η0 / sqrt(Q Q0) (Q0 為全部換成空氣時的電荷)。
+ *
+ * 【 3. 反算線寬 】
+ * 封閉公式在線寬上單調遞減，二分法在數微秒內完成。場解以封閉公式的線寬為起點，
+ * 第一步用場解 / 封閉公式的比值修正目標阻抗再反算 (兩者的誤差在線寬附近幾乎是常數)，
+ * 之後在 log Z 對 log w 上做割線法。網格隨線寬改變，上一次的電位場以格心查表內插到新網格當初值。
+ */
+
+#include "Impedance.h"
+#include "GridSolver.h"
+#include "ScConstants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sc {
+
+namespace {
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// 場解的截面範圍：微帶線上方與側邊留 20 倍介質厚度 (遠處的 0 V 遮蔽對 C 的影響 < 0.3 %)，
+// 帶狀線的場在平面間以指數衰減，側邊 5 倍平面間距即可；兩者都至少 3 倍線寬
+constexpr double MICROSTRIP_MARGIN_HEIGHTS = 20;
+constexpr double STRIPLINE_MARGIN_SPACINGS = 5;
+constexpr double MARGIN_TRACE_WIDTHS = 3;
+
+// 反算線寬的二分範圍 (相對於介質厚度) 與次數
+constexpr double WIDTH_MIN_RATIO = 1e-4;
+constexpr double WIDTH_MAX_RATIO = 1e3;
+constexpr int WIDTH_BISECTIONS = 80;
+
+// ---------------- 封閉公式 ----------------
+
+// Hammerstad-Jensen：零厚度微帶線在空氣中的阻抗
+double microstripZ01(double u)
+{
+    const double f = 6 + (2 * PI - 6) * std::exp(-std::pow(30.666 / u, 0.7528));
+    return FREE_SPACE_IMPEDANCE_OHM / (2 * PI) * std::log(f / u + std::sqrt(1 + 4 / (u * u)));
+}
+
+double microstripEeff(double u, double er)
+{
+    const double u4 = u * u * u * u;
+    const double a = 1 + std::log((u4 + (u / 52) * (u / 52)) / (u4 + 0.432)) / 49 +
+                     std::log(1 + std::pow(u / 18.1, 3)) / 18.7;
+    const double b = 0.564 * std::pow((er - 0.9) / (er + 3), 0.053);
+    return (er + 1) / 2 + (er - 1) / 2 * std::pow(1 + 10 / u, -a * b);
+}
+
+void microstrip(double w, double t, double h, double er, double &z0, double &eEff)
+{
+    const double u = w / h;
+    double u1 = u, ur = u;
+    if (t > 0) {
+        const double T = t / h;
+        const double c = 1 / std::tanh(std::sqrt(6.517 * u));
+        const double du1 = T / PI * std::log(1 + 4 * std::exp(1.0) / (T * c * c));
+        const double dur = 0.5 * (1 + 1 / std::cosh(std::sqrt(er - 1))) * du1;
+        u1 = u + du1;
+        ur = u + dur;
+    }
+    const double zr = microstripZ01(ur);
+    const double z1 = microstripZ01(u1);
+    const double er_r = microstripEeff(ur, er);
+    z0 = zr / std::sqrt(er_r);
+    eEff = er_r * (z1 / zr) * (z1 / zr);
+}
+
+// Wheeler：b 為平面間距，走線在正中央
+double stripline(double w, double t, double b, double er)
+{
+    if (!(t < b)) return NaN;
+    const double x = t / b;
+    double W = w / (b - t);
+    if (x > 0) {
+        const double m = 2 / (1 + 2.0 / 3.0 * x / (1 - x));
+        const double r = x / (2 - x);
+        const double dW = x / (PI * (1 - x)) *
+                          (1 - 0.5 * std::log(r * r + std::pow(0.0796 * x / (w / b + 1.1 * x), m)));
+        W += dW;
+    }
+    const double q = 8 / (PI * W);
+    return 30 / std::sqrt(er) * std::log(1 + 4 / (PI * W) * (q + std::sqrt(q * q + 6.27)));
+}
+
+bool validGeometry(const LineGeometry &g)
+{
+    if (!(g.width_mm > 0) || !(g.thickness_mm >= 0) || !(g.height_mm > 0) || !(g.er >= 1)) return false;
+    if (isDifferential(g.type) && !(g.spacing_mm > 0)) return false;
+    if (isStripline(g.type) && !(g.thickness_mm < g.height_mm)) return false;
+    return true;
+}
+
+// 反算用的目標量：單端為 Z0、差動對為 Zdiff
+double targetOf(const LineGeometry &g, const ImpedanceResult &r)
+{
+    return isDifferential(g.type) ? r.zDiff_ohm : r.z0_ohm;
+}
+
+// ---------------- 場解 ----------------
+
+struct Mesh {
+    std::vector<double> xe, ye;         // 格子邊界 (mm)
+    int nx = 0;
+    int ny = 0;
+    std::vector<char> conductor;
+    std::vector<double> er;             // 每格的相對介電常數
+    bool homogeneous = false;           // 介質均勻 (帶狀線)：C = εr C0
+};
+
+// 上一次場解的電位 (反算線寬時當下一次的初值)
+struct FieldState {
+    std::vector<double> xe, ye;
+    std::vector<double> potential[2];   // [0] 單端 / 奇模、[1] 偶模 (都是空氣中的解)
+};
+
+int cellIndex(const std::vector<double> &edges, double v)
+{
+    const auto it = std::upper_bound(edges.begin(), edges.end(), v);
+    const int i = static_cast<int>(it - edges.begin()) - 1;
+    return std::clamp(i, 0, static_cast<int>(edges.size()) - 2);
+}
+
+Mesh buildMesh(const LineGeometry &g, const FieldSolverOptions &opt)
+{
+    Mesh m;
+    const double w = g.width_mm;
+    const double t = g.thickness_mm;
+    const double h = g.height_mm;
+    const int across = std::max(opt.cellsAcrossTrace, 2);
+    const int perCopper = std::max(opt.cellsPerCopper, 1);
+    const double grading = std::max(opt.grading, 1.0);
+    const bool strip = isStripline(g.type);
+    const double hx0 = w / across;
+    const double hy0 = t / perCopper;
+
+    // ---- x：對稱面 (0) -> 走線 -> 遠處 ----
+    const double x0 = isDifferential(g.type) ? 0.5 * g.spacing_mm : 0.0;
+    const double x1 = x0 + (isDifferential(g.type) ? w : 0.5 * w);
+    const double margin = std::max(strip ? STRIPLINE_MARGIN_SPACINGS * h : MICROSTRIP_MARGIN_HEIGHTS * h,
+                                   MARGIN_TRACE_WIDTHS * w);
+    m.xe.push_back(0.0);
+    if (x0 > 0) appendEdges(m.xe, gradedBothEnds(x0, hx0, grading));
+    const int i0 = static_cast<int>(m.xe.size()) - 1;
+    m.xe.back() = x0;
+    appendEdges(m.xe, gradedBothEnds(x1 - x0, hx0, grading));
+    const int i1 = static_cast<int>(m.xe.size()) - 1;
+    m.xe.back() = x1;
+    appendEdges(m.xe, gradedCells(margin, hx0, grading));
+
+    // ---- y：參考平面 (0) -> 介質 -> 走線 -> 介質 (帶狀線) 或空氣 (微帶線) ----
+    const double below = strip ? 0.5 * (h - t) : h;
+    m.ye.push_back(0.0);
+    appendEdges(m.ye, gradedBothEnds(below, hy0, grading));
+    const int j0 = static_cast<int>(m.ye.size()) - 1;
+    m.ye.back() = below;
+    appendEdges(m.ye, std::vector<double>(static_cast<std::size_t>(perCopper), hy0));
+    const int j1 = static_cast<int>(m.ye.size()) - 1;
+    m.ye.back() = below + t;
+    if (strip) appendEdges(m.ye, gradedBothEnds(h - below - t, hy0, grading));
+    else appendEdges(m.ye, gradedCells(MICROSTRIP_MARGIN_HEIGHTS * h, hy0, grading));
+
+    m.nx = static_cast<int>(m.xe.size()) - 1;
+    m.ny = static_cast<int>(m.ye.size()) - 1;
+    const std::size_t n = static_cast<std::size_t>(m.nx) * m.ny;
+    m.conductor.assign(n, 0);
+    m.er.assign(n, g.er);
+    m.homogeneous = strip;
+    for (int j = 0; j < m.ny; ++j) {
+        for (int i = 0; i < m.nx; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * m.nx + i;
+            m.conductor[k] = (i >= i0 && i < i1 && j >= j0 && j < j1);
+            if (!strip && j >= j0) m.er[k] = 1;
+        }
+    }
+    return m;
+}
+
+// 導體 1 V 時導體上的電荷 / ε0 (半個截面)。dielectric = false 時全部換成空氣；
+// oddMode 時對稱面為 0 V。x 為初值，回傳時為電位
+double conductorCharge(const Mesh &m, bool dielectric, bool oddMode, std::vector<double> &x,
+                       const FieldSolverOptions &opt, ImpedanceResult &result)
+{
+    const int nx = m.nx;
+    const int ny = m.ny;
+    const std::size_t n = static_cast<std::size_t>(nx) * ny;
+    std::vector<double> dx(nx), dy(ny);
+    for (int i = 0; i < nx; ++i) dx[i] = m.xe[i + 1] - m.xe[i];
+    for (int j = 0; j < ny; ++j) dy[j] = m.ye[j + 1] - m.ye[j];
+    auto eps = [&](std::size_t k) { return dielectric ? m.er[k] : 1.0; };
+
+    GridSystem sys;
+    sys.nx = nx;
+    sys.ny = ny;
+    sys.gE.assign(n, 0.0);
+    sys.gN.assign(n, 0.0);
+    sys.diag.assign(n, 0.0);
+    std::vector<double> b(n, 0.0);
+    struct Face {
+        std::size_t free;
+        double g;
+    };
+    std::vector<Face> faces;
+
+    // 兩格之間的耦合：r1、r2 為兩個半格的 Δ/ε (導體那一側為 0)
+    auto couple = [&](std::size_t k, std::size_t l, double r1, double r2, double area, double &gOut) {
+        const bool ck = m.conductor[k], cl = m.conductor[l];
+        if (ck && cl) return;
+        const double g = area / ((ck ? 0.0 : r1) + (cl ? 0.0 : r2));
+        if (ck || cl) {
+            const std::size_t f = ck ? l : k;
+            sys.diag[f] += g;
+            b[f] += g;
+            faces.push_back({ f, g });
+        } else {
+            gOut = g;
+            sys.diag[k] += g;
+            sys.diag[l] += g;
+        }
+    };
+
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * nx + i;
+            if (i + 1 < nx)
+                couple(k, k + 1, 0.5 * dx[i] / eps(k), 0.5 * dx[i + 1] / eps(k + 1), dy[j], sys.gE[k]);
+            if (j + 1 < ny)
+                couple(k, k + nx, 0.5 * dy[j] / eps(k), 0.5 * dy[j + 1] / eps(k + nx), dx[i], sys.gN[k]);
+            if (m.conductor[k]) continue;
+            // 0 V 邊界：下方參考平面、上方平面 (或遠處遮蔽)、奇模的對稱面
+            if (j == 0) sys.diag[k] += eps(k) * dx[i] / (0.5 * dy[j]);
+            if (j == ny - 1) sys.diag[k] += eps(k) * dx[i] / (0.5 * dy[j]);
+            if (i == 0 && oddMode) sys.diag[k] += eps(k) * dy[j] / (0.5 * dx[i]);
+        }
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        if (m.conductor[k]) {
+            sys.diag[k] = 1;
+            b[k] = 1;
+        }
+    }
+
+    GridSolver solver(std::move(sys), opt.threads);
+    bool ok = false;
+    result.iterations += solver.solve(b, x, opt.tolerance, opt.maxIterations, &ok);
+    result.converged = result.converged && ok;
+
+    double q = 0;
+    for (const Face &f : faces) q += f.g * (1 - x[f.free]);
+    return q;
+}
+
+// 上一次的電位以格心查表內插到新網格
+std::vector<double> interpolate(const FieldState &state, int mode, const Mesh &m)
+{
+    const std::vector<double> &old = state.potential[mode];
+    const std::size_t n = static_cast<std::size_t>(m.nx) * m.ny;
+    if (old.empty()) return std::vector<double>(n, 0.0);
+    const int oldNx = static_cast<int>(state.xe.size()) - 1;
+    std::vector<int> col(m.nx);
+    for (int i = 0; i < m.nx; ++i) col[i] = cellIndex(state.xe, 0.5 * (m.xe[i] + m.xe[i + 1]));
+    std::vector<double> x(n);
+    for (int j = 0; j < m.ny; ++j) {
+        const int row = cellIndex(state.ye, 0.5 * (m.ye[j] + m.ye[j + 1]));
+        const double *src = &old[static_cast<std::size_t>(row) * oldNx];
+        double *dst = &x[static_cast<std::size_t>(j) * m.nx];
+        for (int i = 0; i < m.nx; ++i) dst[i] = src[col[i]];
+    }
+    return x;
+}
+
+ImpedanceResult fieldSolve(const LineGeometry &g, const FieldSolverOptions &opt, FieldState &state)
+{
+    ImpedanceResult r;
+    if (!validGeometry(g) || !(g.thickness_mm > 0)) return r;
+
+    const Mesh m = buildMesh(g, opt);
+    r.cells = m.nx * m.ny;
+    r.converged = true;
+    const bool diff = isDifferential(g.type);
+
+    // 每個模態：空氣中解一次 (Q0)，再以它為初值解有介質的 (Q)；介質均勻時 Q = εr Q0
+    auto charges = [&](int mode, double &q, double &q0) {
+        std::vector<double> x = interpolate(state, mode, m);
+        q0 = conductorCharge(m, false, diff && mode == 0, x, opt, r);
+        state.potential[mode] = x;
+        if (m.homogeneous) {
+            q = g.er * q0;
+        } else {
+            q = conductorCharge(m, true, diff && mode == 0, x, opt, r);
+        }
+    };
+
+    double q, q0;
+    charges(0, q, q0);
+    if (!diff) {
+        // 導體橫跨對稱面，整條線的電荷是半個截面的兩倍
+        r.z0_ohm = FREE_SPACE_IMPEDANCE_OHM / (2 * std::sqrt(q * q0));
+        r.eEff = q / q0;
+    } else {
+        r.zDiff_ohm = 2 * FREE_SPACE_IMPEDANCE_OHM / std::sqrt(q * q0);
+        r.eEff = q / q0;
+        double qe, qe0;
+        charges(1, qe, qe0);
+        r.zCommon_ohm = 0.5 * FREE_SPACE_IMPEDANCE_OHM / std::sqrt(qe * qe0);
+    }
+    state.xe = m.xe;
+    state.ye = m.ye;
+    return r;
+}
+
+} // namespace
+
+bool isDifferential(LineType type)
+{
+    return type == LineType::DiffMicrostrip || type == LineType::DiffStripline;
+}
+
+bool isStripline(LineType type)
+{
+    return type == LineType::Stripline || type == LineType::DiffStripline;
+}
+
+ImpedanceResult impedanceClosedForm(const LineGeometry &g)
+{
+    ImpedanceResult r;
+    if (!validGeometry(g)) return r;
+
+    if (isStripline(g.type)) {
+        r.z0_ohm = stripline(g.width_mm, g.thickness_mm, g.height_mm, g.er);
+        r.eEff = g.er;
+    } else {
+        microstrip(g.width_mm, g.thickness_mm, g.height_mm, g.er, r.z0_ohm, r.eEff);
+    }
+    if (g.type == LineType::DiffMicrostrip)
+        r.zDiff_ohm = 2 * r.z0_ohm * (1 - 0.48 * std::exp(-0.96 * g.spacing_mm / g.height_mm));
+    else if (g.type == LineType::DiffStripline)
+        r.zDiff_ohm = 2 * r.z0_ohm * (1 - 0.347 * std::exp(-2.9 * g.spacing_mm / g.height_mm));
+    r.converged = std::isfinite(targetOf(g, r));
+    return r;
+}
+
+ImpedanceResult impedanceFieldSolve(const LineGeometry &geometry, const FieldSolverOptions &options)
+{
+    FieldState state;
+    return fieldSolve(geometry, options, state);
+}
+
+double impedanceWidthClosedForm(const LineGeometry &geometry, double target_ohm)
+{
+    LineGeometry g = geometry;
+    auto z = [&](double w) {
+        g.width_mm = w;
+        return targetOf(g, impedanceClosedForm(g));
+    };
+    double lo = std::log(WIDTH_MIN_RATIO * geometry.height_mm);
+    double hi = std::log(WIDTH_MAX_RATIO * geometry.height_mm);
+    const double zLo = z(std::exp(lo)), zHi = z(std::exp(hi));
+    if (!(target_ohm > 0) || !(zLo >= target_ohm) || !(zHi <= target_ohm)) return NaN;
+    for (int k = 0; k < WIDTH_BISECTIONS; ++k) {
+        const double mid = 0.5 * (lo + hi);
+        if (z(std::exp(mid)) > target_ohm) lo = mid;
+        else hi = mid;
+    }
+    return std::exp(0.5 * (lo + hi));
+}
+
+ImpedanceWidthResult impedanceWidthFieldSolve(const LineGeometry &geometry, double target_ohm,
+                                              const FieldSolverOptions &options, double relTolerance,
+                                              int maxFieldSolves)
+{
+    ImpedanceWidthResult out;
+    LineGeometry g = geometry;
+    FieldState state;
+    if (!(geometry.thickness_mm > 0)) return out;
+
+    double w = impedanceWidthClosedForm(geometry, target_ohm);
+    if (!std::isfinite(w)) return out;
+
+    auto evaluate = [&](double width) {
+        g.width_mm = width;
+        out.impedance = fieldSolve(g, options, state);
+        out.width_mm = width;
+        ++out.fieldSolves;
+        return targetOf(g, out.impedance);
+    };
+    auto done = [&](double z) { return std::fabs(z - target_ohm) <= relTolerance * target_ohm; };
+
+    double z = evaluate(w);
+    if (!std::isfinite(z)) return out;
+    if (done(z)) {
+        out.converged = true;
+        return out;
+    }
+
+    // 第一步：封閉公式的誤差比例在附近幾乎不變，修正目標後再以封閉公式反算
+    g.width_mm = w;
+    const double ratio = z / targetOf(g, impedanceClosedForm(g));
+    double wPrev = w, zPrev = z;
+    w = impedanceWidthClosedForm(geometry, target_ohm / ratio);
+    if (!std::isfinite(w)) return out;
+
+    while (out.fieldSolves < maxFieldSolves) {
+        z = evaluate(w);
+        if (!std::isfinite(z)) return out;
+        if (done(z)) {
+            out.converged = true;
+            return out;
+        }
+        // 割線法：log Z 對 log w 幾乎是直線
+        const double slope = (std::log(z) - std::log(zPrev)) / (std::log(w) - std::log(wPrev));
+        if (!(slope < 0)) break;
+        wPrev = w;
+        zPrev = z;
+        w = std::exp(std::log(w) + (std::log(target_ohm) - std::log(z)) / slope);
+    }
+    return out;
+}
+
+} // namespace sc
@@ -0,0 +1,83 @@
+#ifndef SC_IMPEDANCE_H
+#define SC_IMPEDANCE_H
+
+/**
+ * @file Impedance.h
+ * @brief 控制阻抗：微帶線、帶狀線與差動對的特性阻抗
+ *
+ * 兩條路徑：
+ *   封閉公式 (impedanceClosedForm)：Hammerstad-Jensen 微帶線、Wheeler 帶狀線 (含銅厚修正)，
+ *     差動對以 IPC-2141 的耦合修正，每次不到一微秒，給輸入框即時更新用。
+ *   場解 (impedanceFieldSolve)：截面 2D Laplace 方程式的有限差分解，算出有介質與無介質 (空氣) 時
+ *     導體每單位長度的電容 C、C0，Z0 = 1 / (c sqrt(C C0))、εeff = C / C0。
+ * 反算線寬 (目標阻抗 -> 線寬) 兩條路徑都有，場解以封閉公式的結果為起點。
+ *
+ * 尺寸：height_mm 對微帶線是走線底面到參考平面的介質厚度；
+ * 對帶狀線是上下兩個參考平面的間距 b (走線在正中央)。差動對的 spacing_mm 是兩條線的邊到邊間距。
+ * 阻抗目標：單端線為 Z0，差動對為差動阻抗 Zdiff。
+ */
+
+#include <limits>
+
+namespace sc {
+
+enum class LineType { Microstrip, Stripline, DiffMicrostrip, DiffStripline };
+
+bool isDifferential(LineType type);
+bool isStripline(LineType type);
+
+struct LineGeometry {
+    LineType type = LineType::Microstrip;
+    double width_mm = 0.3;
+    double thickness_mm = 0.035;
+    double height_mm = 0.2;             // 微帶線：介質厚度；帶狀線：兩平面間距 b
+    double spacing_mm = 0.2;            // 差動對邊到邊間距
+    double er = 4.3;                    // 介質的相對介電常數
+};
+
+struct ImpedanceResult {
+    double z0_ohm = std::numeric_limits<double>::quiet_NaN();         // 單端特性阻抗 (差動對：封閉公式為單線、場解為 NaN)
+    double eEff = std::numeric_limits<double>::quiet_NaN();           // 有效介電常數 (差動對為奇模)
+    double zDiff_ohm = std::numeric_limits<double>::quiet_NaN();      // 差動阻抗 2 Zodd
+    double zCommon_ohm = std::numeric_limits<double>::quiet_NaN();    // 共模阻抗 Zeven / 2 (只有場解)
+    int cells = 0;                      // 場解的格數 (半個截面)
+    int iterations = 0;                 // 場解所有 Laplace 求解加總的共軛梯度迭代數
+    bool converged = false;
+};
+
+// 封閉公式；尺寸無效時各欄為 NaN
+ImpedanceResult impedanceClosedForm(const LineGeometry &geometry);
+
+struct FieldSolverOptions {
+    int cellsAcrossTrace = 48;          // 走線寬度方向的格數
+    int cellsPerCopper = 8;             // 銅厚方向的格數
+    double grading = 1.1;               // 離開導體邊緣的網格放大倍率
+    double tolerance = 1e-8;            // 共軛梯度的相對殘差
+    int maxIterations = 500;
+    unsigned threads = 0;               // 0 = 全部硬體執行緒
+};
+
+// 截面場解 (只解對稱面的一半)：單端 2 次 Laplace 求解 (有 / 無介質)，差動對奇模、偶模各 2 次；
+// 帶狀線的介質是均勻的，C = εr C0，每個模態只解 1 次。銅厚必須大於 0
+ImpedanceResult impedanceFieldSolve(const LineGeometry &geometry, const FieldSolverOptions &options = {});
+
+// 反算線寬 (mm)：封閉公式在線寬上單調遞減，以二分法求解；目標超出可達範圍時回傳 NaN
+double impedanceWidthClosedForm(const LineGeometry &geometry, double target_ohm);
+
+struct ImpedanceWidthResult {
+    double width_mm = std::numeric_limits<double>::quiet_NaN();
+    ImpedanceResult impedance;          // 最後一次場解的結果
+    int fieldSolves = 0;
+    bool converged = false;
+};
+
+// 場解反算線寬：以封閉公式的線寬為起點，場解 / 封閉公式的比值修正目標後再反算一次，
+// 之後在 log(線寬) 上做割線法；每次場解以上一次的電位場 (內插到新網格) 為初值。
+// |Z - 目標| <= relTolerance * 目標 為收斂，通常 2 ~ 4 次場解
+ImpedanceWidthResult impedanceWidthFieldSolve(const LineGeometry &geometry, double target_ohm,
+                                              const FieldSolverOptions &options = {},
+                                              double relTolerance = 1e-3, int maxFieldSolves = 8);
+
+} // namespace sc
+
+#endif // SC_IMPEDANCE_H
@@ -0,0 +1,190 @@
+#ifndef SC_INTERVAL_H
+#define SC_INTERVAL_H
+
+/**
+ * @file Interval.h
+ * @brief 向外捨入的區間運算 (最差情況分析用)
+ *
+ * 【 1. 表示法 】
+ * 區間 [lo, hi] 存成 (-lo, hi)：兩個分量都是「上界」，
+ * 所以加法就是一個向量加法，向外捨入就是兩個分量一起往 +inf 移一個 ulp。
+ * x86 上整個區間放在一個 SSE2 暫存器裡運算 (lo/hi 同時計算)，其他平台用純量版本，結果相同。
+ *
+ * 【 2. 向外捨入 】
+ * 不切換 FPU 捨入模式 (fesetround 很慢，且編譯器不保證遵守)，
+ * 而是在預設的就近捨入之後把邊界再往外推一個 ulp：就近捨入的誤差不超過半個 ulp，
+ * 推一個 ulp 一定涵蓋真值。std::pow 不保證正確捨入，多推一個 ulp。
+ *
+ * 【 3. 使用注意 】
+ * 同一個變數在式子中出現兩次會讓區間變寬 (dependency problem)，
+ * 例如分壓要寫成 Vi / (1 + R1 / R2) 而不是 Vi * R2 / (R1 + R2)，
+ * 每個變數只出現一次且式子對各變數單調時，結果就是精確的最差情況範圍，不需要列舉 2^N 個角落。
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SC_INTERVAL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace sc {
+
+struct alignas(16) Interval {
+    double nlo = 0;     // -下界
+    double hi = 0;      // 上界
+
+    double lower() const { return -nlo; }
+    double upper() const { return hi; }
+    double mid() const { return 0.5 * (hi - nlo); }
+    bool contains(double x) const { return -nlo <= x && x <= hi; }
+    bool isValid() const { return -nlo <= hi; }       // NaN 時為 false
+};
+
+namespace detail {
+
+#ifdef SC_INTERVAL_SSE2
+
+inline __m128d intervalLoad(const Interval &a) { return _mm_load_pd(&a.nlo); }
+
+inline Interval intervalStore(__m128d v)
+{
+    Interval r;
+    _mm_store_pd(&r.nlo, v);
+    return r;
+}
+
+// 兩個分量都往 +inf 移一個 ulp：正數 (含 +0) 位元 +1，負數位元 -1，+inf 與 NaN 不變
+inline __m128d nextUp(__m128d x)
+{
+    const __m128d zero = _mm_setzero_pd();
+    x = _mm_add_pd(x, zero);                                    // -0 -> +0
+    const __m128i neg = _mm_castpd_si128(_mm_cmplt_pd(x, zero));
+    const __m128i step = _mm_or_si128(neg, _mm_set1_epi64x(1)); // 負數 -1，其餘 +1
+    const __m128d up = _mm_castsi128_pd(_mm_add_epi64(_mm_castpd_si128(x), step));
+    const __m128d keep = _mm_or_pd(_mm_cmpeq_pd(x, _mm_set1_pd(std::numeric_limits<double>::infinity())),
+                                   _mm_cmpunord_pd(x, x));
+    return _mm_or_pd(_mm_and_pd(keep, x), _mm_andnot_pd(keep, up));
+}
+
+inline Interval roundOut(__m128d v) { return intervalStore(nextUp(v)); }
+
+#endif
+
+inline double nextUp(double x) { return std::nextafter(x, std::numeric_limits<double>::infinity()); }
+
+inline Interval roundOut(double nlo, double hi)
+{
+#ifdef SC_INTERVAL_SSE2
+    return roundOut(_mm_set_pd(hi, nlo));
+#else
+    return { nextUp(nlo), nextUp(hi) };
+#endif
+}
+
+} // namespace detail
+
+// --- 建立區間 ---
+
+inline Interval interval(double lo, double hi) { return { -lo, hi }; }
+
+inline Interval point(double x) { return { -x, x }; }
+
+// 標稱值 ± 相對公差 (0.01 = ±1%)，乘法誤差向外捨入
+inline Interval tolerance(double nominal, double relTol)
+{
+    const double a = nominal * (1.0 - relTol);
+    const double b = nominal * (1.0 + relTol);
+    return detail::roundOut(-std::min(a, b), std::max(a, b));
+}
+
+// 兩個區間的聯集 (包含兩者的最小區間)
+inline Interval hull(const Interval &a, const Interval &b)
+{
+    return { std::max(a.nlo, b.nlo), std::max(a.hi, b.hi) };
+}
+
+// --- 四則運算 ---
+
+inline Interval operator-(const Interval &a) { return { a.hi, a.nlo }; }
+
+inline Interval operator+(const Interval &a, const Interval &b)
+{
+#ifdef SC_INTERVAL_SSE2
+    return detail::roundOut(_mm_add_pd(detail::intervalLoad(a), detail::intervalLoad(b)));
+#else
+    return detail::roundOut(a.nlo + b.nlo, a.hi + b.hi);
+#endif
+}
+
+inline Interval operator-(const Interval &a, const Interval &b) { return a + (-b); }
+
+inline Interval operator*(const Interval &a, const Interval &b)
+{
+    // 四個端點乘積的最小/最大值；(-lo, hi) 表示法下兩者都是取 max
+#ifdef SC_INTERVAL_SSE2
+    const __m128d av = detail::intervalLoad(a);                   // (-alo, ahi)
+    const __m128d blo = _mm_set1_pd(-b.nlo);
+    const __m128d bhi = _mm_set1_pd(b.hi);
+    const __m128d sign = _mm_set_pd(0.0, -0.0);
+    const __m128d aReal = _mm_xor_pd(av, sign);                   // (alo, ahi)
+    const __m128d p = _mm_mul_pd(aReal, blo);                     // (alo*blo, ahi*blo)
+    const __m128d q = _mm_mul_pd(aReal, bhi);                     // (alo*bhi, ahi*bhi)
+    const __m128d mx = _mm_max_pd(p, q);
+    const __m128d mn = _mm_min_pd(p, q);
+    const double hi = std::max(_mm_cvtsd_f64(mx), _mm_cvtsd_f64(_mm_unpackhi_pd(mx, mx)));
+    const double lo = std::min(_mm_cvtsd_f64(mn), _mm_cvtsd_f64(_mm_unpackhi_pd(mn, mn)));
+    return detail::roundOut(-lo, hi);
+#else
+    const double alo = -a.nlo, blo = -b.nlo;
+    const double p0 = alo * blo, p1 = alo * b.hi, p2 = a.hi * blo, p3 = a.hi * b.hi;
+    return detail::roundOut(-std::min(std::min(p0, p1), std::min(p2, p3)),
+                            std::max(std::max(p0, p1), std::max(p2, p3)));
+#endif
+}
+
+// 1 / b；b 含 0 時結果為整條實數線
+inline Interval reciprocal(const Interval &b)
+{
+    if (b.contains(0.0)) {
+        const double inf = std::numeric_limits<double>::infinity();
+        return { inf, inf };
+    }
+    // 單調遞減：[1/hi, 1/lo]，存成 (-1/hi, 1/lo)
+    return detail::roundOut(-1.0 / b.hi, 1.0 / -b.nlo);
+}
+
+inline Interval operator/(const Interval &a, const Interval &b) { return a * reciprocal(b); }
+
+inline Interval operator+(const Interval &a, double b) { return a + point(b); }
+inline Interval operator-(const Interval &a, double b) { return a + point(-b); }
+inline Interval operator*(const Interval &a, double b) { return a * point(b); }
+inline Interval operator*(double a, const Interval &b) { return point(a) * b; }
+inline Interval operator/(const Interval &a, double b) { return a * reciprocal(point(b)); }
+inline Interval operator/(double a, const Interval &b) { return point(a) * reciprocal(b); }
+
+// --- 單調函數 ---
+
+// 下界小於 0 的部分截掉 (物理量不可能為負時使用)
+inline Interval sqrt(const Interval &a)
+{
+    const double lo = std::sqrt(std::max(-a.nlo, 0.0));
+    return detail::roundOut(-lo, std::sqrt(a.hi));
+}
+
+// x^p，x 必須為正 (下界夾在 0)；p > 0 遞增、p < 0 遞減。pow 不保證正確捨入，多擴一個 ulp
+inline Interval pow(const Interval &x, double p)
+{
+    const double lo = std::max(-x.nlo, 0.0);
+    double a = std::pow(lo, p), b = std::pow(x.hi, p);
+    if (p < 0) std::swap(a, b);
+    Interval r = detail::roundOut(-a, b);
+    return detail::roundOut(r.nlo, r.hi);
+}
+
+} // namespace sc
+
+#endif // SC_INTERVAL_H
@@ -0,0 +1,252 @@
+/**
+ * @file Ipc2152.cpp
+ * @brief IPC-2152 走線載流模型：對數座標的內插網格
+ *
+ * 【 1. 擬合式 】
+ * 圖表 (截面積 Ab mil²、電流 I A、溫升 ΔT °C)：
+ *   Ab = (117.555 * ΔT^-0.913 + 1.15) * I^(0.84 * ΔT^-0.108 + 1.159)
+ * 修正係數 (乘在 Ab 上)：
+ *   - 銅重 Cf = 1 + β ln(Ab) + γ，β、γ 取自 1、2、3 oz 三條曲線，銅重之間以 ln(面積) 線性內插
+ *   - 板厚 Bf = 24.929 * t^-0.755 (t 為 mil，限制在圖表的 20 ~ 120 mil)
+ *   - 銅平面 Pf = 0.0031 * d + 0.4054 (d 為 mil，最大 1)
+ * Bf、Pf 與電流無關，查表後直接相乘；Cf 與 Ab 有關，放進網格。
+ *
+ * 【 2. 網格 】
+ * 正向網格 ln(Ab * Cf)：銅重層 x ln ΔT x ln I，在對數座標上幾乎是平面，三線性內插的誤差 < 0.1%。
+ * 反向網格 ln I：銅重層 x ln ΔT x ln(Ab * Cf)，每一列 (固定銅重與 ΔT) 由正向網格的同一列反轉：
+ * 正向的列對 ln I 嚴格遞增，以兩個指標一起往前走，在每個等間距的 ln 面積節點上做線性反內插。
+ * 兩個網格都是連續陣列，每次查詢只讀 8 個相鄰的值；第一次使用時建立 (函數內的 static)。
+ * 銅重層之間：正向對 ln 面積線性內插；反向以兩層的斜率加權，與正向互為反函數 (見 lookupInverse)。
+ * 軸外的查詢沿邊界的格子線性外插。
+ */
+
+#include "Ipc2152.h"
+#include "ScConstants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sc {
+
+namespace {
+
+// 圖表擬合式的係數
+constexpr double CHART_A_SCALE = 117.555;
+constexpr double CHART_A_EXP = -0.913;
+constexpr double CHART_A_OFFSET = 1.15;
+constexpr double CHART_B_SCALE = 0.84;
+constexpr double CHART_B_EXP = -0.108;
+constexpr double CHART_B_OFFSET = 1.159;
+
+// 銅重修正：1、2、3 oz 的 β、γ (1 oz 為基準)
+constexpr int OZ_LAYERS = 3;
+constexpr double OZ_BETA[OZ_LAYERS] = { 0.0, -0.0185, -0.0318 };
+constexpr double OZ_GAMMA[OZ_LAYERS] = { 0.0, -0.0139, -0.0002 };
+
+// 板厚修正的有效範圍 (mil)
+constexpr double BOARD_MIN_MIL = 20;
+constexpr double BOARD_MAX_MIL = 120;
+
+// 等間距的對數軸
+struct Axis {
+    double min;
+    double max;
+    int points;
+
+    double step() const { return (max - min) / (points - 1); }
+    double at(int i) const { return min + i * step(); }
+
+    // 左端點索引 (限制在 [0, points - 2]) 與格內位置 t；軸外 t < 0 或 t > 1，即線性外插
+    int locate(double x, double &t) const
+    {
+        const double f = (x - min) / step();
+        int i = 0;
+        if (f >= points - 2) i = points - 2;
+        else if (f >= 0) i = static_cast<int>(f);
+        t = f - i;
+        return i;
+    }
+};
+
+const Axis DT_AXIS{ 0.0, std::log(100.0), 48 };            // 1 ~ 100 °C
+const Axis CURRENT_AXIS{ std::log(1e-3), std::log(500.0), 64 }; // 1 mA ~ 500 A
+const Axis AREA_AXIS{ -12.0, 18.0, 128 };                  // ln(Ab * Cf)，涵蓋上面兩軸的所有組合
+
+double chartLnArea(double lnCurrent, double lnDeltaT)
+{
+    const double a = CHART_A_SCALE * std::exp(CHART_A_EXP * lnDeltaT) + CHART_A_OFFSET;
+    const double b = CHART_B_SCALE * std::exp(CHART_B_EXP * lnDeltaT) + CHART_B_OFFSET;
+    return std::log(a) + b * lnCurrent;
+}
+
+// ln(Ab * Cf)，layer = 0 ~ 2 對應 1 ~ 3 oz
+double layerLnArea(int layer, double lnAb)
+{
+    const double cf = 1.0 + OZ_BETA[layer] * lnAb + OZ_GAMMA[layer];
+    return lnAb + std::log(std::max(cf, 0.25));
+}
+
+// 銅重換算成層的位置：layer (0 或 1) 與層間位置 t (0 ~ 1)
+int locateOz(double copperOz, double &t)
+{
+    const double f = std::clamp(copperOz, 1.0, static_cast<double>(OZ_LAYERS)) - 1.0;
+    const int layer = std::min(static_cast<int>(f), OZ_LAYERS - 2);
+    t = f - layer;
+    return layer;
+}
+
+struct Grids {
+    std::vector<double> forward;   // [layer][ΔT][I]
+    std::vector<double> inverse;   // [layer][ΔT][面積]
+};
+
+Grids buildGrids()
+{
+    Grids g;
+    g.forward.resize(static_cast<std::size_t>(OZ_LAYERS) * DT_AXIS.points * CURRENT_AXIS.points);
+    g.inverse.resize(static_cast<std::size_t>(OZ_LAYERS) * DT_AXIS.points * AREA_AXIS.points);
+
+    for (int layer = 0; layer < OZ_LAYERS; ++layer) {
+        for (int d = 0; d < DT_AXIS.points; ++d) {
+            const std::size_t row = static_cast<std::size_t>(layer) * DT_AXIS.points + d;
+            double *y = &g.forward[row * CURRENT_AXIS.points];
+            for (int i = 0; i < CURRENT_AXIS.points; ++i)
+                y[i] = layerLnArea(layer, chartLnArea(CURRENT_AXIS.at(i), DT_AXIS.at(d)));
+
+            // 單調反轉：j 是目前包含 u 的正向格子 (兩端外插)
+            double *x = &g.inverse[row * AREA_AXIS.points];
+            int j = 0;
+            for (int k = 0; k < AREA_AXIS.points; ++k) {
+                const double u = AREA_AXIS.at(k);
+                while (j < CURRENT_AXIS.points - 2 && y[j + 1] < u) ++j;
+                const double slope = CURRENT_AXIS.step() / (y[j + 1] - y[j]);
+                x[k] = CURRENT_AXIS.at(j) + (u - y[j]) * slope;
+            }
+        }
+    }
+    return g;
+}
+
+const Grids &grids()
+{
+    static const Grids g = buildGrids();
+    return g;
+}
+
+// 一層網格在 (ΔT, inner) 上的雙線性內插，slope 回傳沿 inner 軸的斜率
+struct LayerValue {
+    double value;
+    double slope;
+};
+
+LayerValue bilinear(const std::vector<double> &grid, const Axis &inner, int layer, int d, double tDt, int i,
+                    double tX)
+{
+    const double *r0 = &grid[(static_cast<std::size_t>(layer) * DT_AXIS.points + d) * inner.points + i];
+    const double *r1 = r0 + inner.points;
+    const double s0 = r0[1] - r0[0];
+    const double s1 = r1[1] - r1[0];
+    const double v0 = r0[0] + tX * s0;
+    const double v1 = r1[0] + tX * s1;
+    return { v0 + tDt * (v1 - v0), (s0 + tDt * (s1 - s0)) / inner.step() };
+}
+
+// 正向：銅重層之間對 ln 面積線性內插 (與 ipc2152AreaFromCurrentExact 的定義相同)
+double lookupForward(double copperOz, double lnDeltaT, double lnCurrent)
+{
+    const std::vector<double> &grid = grids().forward;
+    double tOz, tDt, tX;
+    const int layer = locateOz(copperOz, tOz);
+    const int d = DT_AXIS.locate(lnDeltaT, tDt);
+    const int i = CURRENT_AXIS.locate(lnCurrent, tX);
+    const double a = bilinear(grid, CURRENT_AXIS, layer, d, tDt, i, tX).value;
+    return (tOz > 0) ? a + tOz * (bilinear(grid, CURRENT_AXIS, layer + 1, d, tDt, i, tX).value - a) : a;
+}
+
+// 反向：正向在層間內插的是 ln 面積，所以 ln I 不能直接線性內插。
+// 兩層各自反查得到 x0、x1，在解附近把兩層的正向曲線視為直線 (斜率 = 1 / 反向網格的斜率)，
+// (1 - t) k0 (x - x0) + t k1 (x - x1) = 0 直接解出 x
+double lookupInverse(double copperOz, double lnDeltaT, double lnArea)
+{
+    const std::vector<double> &grid = grids().inverse;
+    double tOz, tDt, tX;
+    const int layer = locateOz(copperOz, tOz);
+    const int d = DT_AXIS.locate(lnDeltaT, tDt);
+    const int i = AREA_AXIS.locate(lnArea, tX);
+    const LayerValue a = bilinear(grid, AREA_AXIS, layer, d, tDt, i, tX);
+    if (!(tOz > 0)) return a.value;
+    const LayerValue b = bilinear(grid, AREA_AXIS, layer + 1, d, tDt, i, tX);
+    const double wa = (1.0 - tOz) / a.slope;
+    const double wb = tOz / b.slope;
+    return (wa * a.value + wb * b.value) / (wa + wb);
+}
+
+double ozFromThickness(double thickness_mm)
+{
+    return thickness_mm / COPPER_MM_PER_OZ;
+}
+
+} // namespace
+
+double ipc2152BoardFactor(double boardThickness_mm)
+{
+    if (!(boardThickness_mm > 0)) return 1.0;
+    const double t_mil = std::clamp(boardThickness_mm / MM_PER_MIL, BOARD_MIN_MIL, BOARD_MAX_MIL);
+    return 24.929 * std::pow(t_mil, -0.755);
+}
+
+double ipc2152PlaneFactor(double planeDistance_mm)
+{
+    if (!(planeDistance_mm > 0)) return 1.0;
+    return std::min(0.0031 * (planeDistance_mm / MM_PER_MIL) + 0.4054, 1.0);
+}
+
+double ipc2152AreaFromCurrent(double current_A, double deltaT, double copperOz, const Ipc2152Options &opt)
+{
+    if (!(current_A > 0)) return 0.0;
+    const double lnArea = lookupForward(copperOz, std::log(deltaT), std::log(current_A));
+    return std::exp(lnArea) * ipc2152BoardFactor(opt.boardThickness_mm) * ipc2152PlaneFactor(opt.planeDistance_mm);
+}
+
+double ipc2152CurrentFromArea(double area_mil2, double deltaT, double copperOz, const Ipc2152Options &opt)
+{
+    if (!(area_mil2 > 0)) return 0.0;
+    const double chartArea =
+        area_mil2 / (ipc2152BoardFactor(opt.boardThickness_mm) * ipc2152PlaneFactor(opt.planeDistance_mm));
+    return std::exp(lookupInverse(copperOz, std::log(deltaT), std::log(chartArea)));
+}
+
+double ipc2152AreaFromCurrentExact(double current_A, double deltaT, double copperOz, const Ipc2152Options &opt)
+{
+    if (!(current_A > 0)) return 0.0;
+    double tOz;
+    const int layer = locateOz(copperOz, tOz);
+    const double lnAb = chartLnArea(std::log(current_A), std::log(deltaT));
+    const double a = layerLnArea(layer, lnAb);
+    const double lnArea = (tOz > 0) ? a + tOz * (layerLnArea(layer + 1, lnAb) - a) : a;
+    return std::exp(lnArea) * ipc2152BoardFactor(opt.boardThickness_mm) * ipc2152PlaneFactor(opt.planeDistance_mm);
+}
+
+double ipc2152WidthFromCurrent(double current_A, double thickness_mm, double deltaT, const Ipc2152Options &opt)
+{
+    const double thickness_mil = thickness_mm / MM_PER_MIL;
+    return ipc2152AreaFromCurrent(current_A, deltaT, ozFromThickness(thickness_mm), opt) / thickness_mil * MM_PER_MIL;
+}
+
+double ipc2152CurrentFromWidth(double width_mm, double thickness_mm, double deltaT, const Ipc2152Options &opt)
+{
+    const double area_mil2 = (width_mm / MM_PER_MIL) * (thickness_mm / MM_PER_MIL);
+    return ipc2152CurrentFromArea(area_mil2, deltaT, ozFromThickness(thickness_mm), opt);
+}
+
+Interval ipc2152CurrentInterval(const Interval &width_mm, const Interval &thickness_mm, const Interval &deltaT,
+                                const Ipc2152Options &opt)
+{
+    // 兩端點各算一次 (電流對三個變數都遞增)，與其他區間函數一樣向外捨入
+    const double lo = ipc2152CurrentFromWidth(width_mm.lower(), thickness_mm.lower(), deltaT.lower(), opt);
+    const double hi = ipc2152CurrentFromWidth(width_mm.upper(), thickness_mm.upper(), deltaT.upper(), opt);
+    return detail::roundOut(-lo, hi);
+}
+
+} // namespace sc
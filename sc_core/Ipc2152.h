@@ -0,0 +1,51 @@
+#ifndef SC_IPC2152_H
+#define SC_IPC2152_H
+
+/**
+ * @file Ipc2152.h
+ * @brief IPC-2152 走線載流模型 (查表版本)
+ *
+ * IPC-2152 是圖表 (截面積 - 電流 - 溫升)，再以板厚、相鄰銅平面距離、銅重修正。
+ * 這裡用常見的圖表擬合式 (不是標準本身的數據，誤差約數個百分比，設計時請保留餘量)，
+ * 並預先算成對數座標的內插網格：正向 (電流 -> 面積) 與反向 (面積 -> 電流) 各是一次三線性內插，
+ * 反向網格由正向網格做單調反轉建立，不需要疊代求根。
+ * IPC-2152 不分內外層 (圖表是內層條件，用在外層偏保守)。
+ */
+
+#include "Interval.h"
+
+namespace sc {
+
+// 走線 / 貫孔載流能力的公式選擇
+enum class TraceModel { IPC2221, IPC2152 };
+
+struct Ipc2152Options {
+    double boardThickness_mm = 1.6;   // 板厚 (圖表基準為 70 mil ≈ 1.78 mm)
+    double planeDistance_mm = 0;      // 與相鄰銅平面的距離，<= 0 表示沒有銅平面
+};
+
+// 修正係數 (乘在圖表面積上，< 1 表示散熱較好、需要的面積較小)
+double ipc2152BoardFactor(double boardThickness_mm);
+double ipc2152PlaneFactor(double planeDistance_mm);
+
+// 由電流求需要的截面積 (mil²)；copperOz 為銅重 (1 oz ≈ 35 um)，1 ~ 3 oz 之外取端點
+double ipc2152AreaFromCurrent(double current_A, double deltaT, double copperOz, const Ipc2152Options &opt = {});
+
+// 由截面積 (mil²) 求載流能力 (A)
+double ipc2152CurrentFromArea(double area_mil2, double deltaT, double copperOz, const Ipc2152Options &opt = {});
+
+// 直接以擬合式計算 (不查表)，網格的參考值
+double ipc2152AreaFromCurrentExact(double current_A, double deltaT, double copperOz,
+                                   const Ipc2152Options &opt = {});
+
+// 與 TraceCalc.h 相同的線寬介面 (銅重由銅厚換算)
+double ipc2152WidthFromCurrent(double current_A, double thickness_mm, double deltaT, const Ipc2152Options &opt = {});
+double ipc2152CurrentFromWidth(double width_mm, double thickness_mm, double deltaT, const Ipc2152Options &opt = {});
+
+// 載流能力的範圍 (A)：對線寬、銅厚、溫升都是遞增，取兩端即為精確範圍
+Interval ipc2152CurrentInterval(const Interval &width_mm, const Interval &thickness_mm, const Interval &deltaT,
+                                const Ipc2152Options &opt = {});
+
+} // namespace sc
+
+#endif // SC_IPC2152_H
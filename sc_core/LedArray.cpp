@@ -0,0 +1,127 @@
+/**
+ * @file LedArray.cpp
+ * @brief LED 陣列組態搜尋
+ *
+ * 【 1. 每個串數的可行電阻範圍 】
+ * 整組共用一顆電阻 (與 ledSolve 相同)，每串電流 I = (Vcc - series * Vd) / (R * parallel)。
+ * 電流規格在兩個極端都要成立：
+ *   低點 (vccMin、vdMax)：I >= minCurrent  ->  R <= (vccMin - series * vdMax) / (minCurrent * parallel)
+ *   高點 (vccMax、vdMin)：I <= maxCurrent  ->  R >= (vccMax - series * vdMin) / (maxCurrent * parallel)
+ * 電阻額定再加一個下限 R >= (vccMax - series * vdMin)^2 / maxResistorPower。
+ * 所以不用逐一試電阻值：先以低點電壓是否足夠整個剔除串數，再只列出範圍內的標準值。
+ *
+ * 【 2. 平行搜尋 】
+ * 每個串數 (N 的因數) 是一個獨立的工作，交給 parallelFor；結果依串數順序合併，與執行緒數無關。
+ *
+ * 【 3. Pareto 前緣 】
+ * 目標：標稱條件下的電阻總功耗 (越小越好) 與電流變動 (越小越好)。
+ * 依功耗排序後掃過一次，電流變動比之前所有點都小的才在前緣上。
+ */
+
+#include "LedArray.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace sc {
+
+namespace {
+
+struct SeriesTask {
+    int series;
+    std::vector<LedArrayConfig> configs;
+    bool rejected = false;
+};
+
+void searchSeries(SeriesTask &task, const LedArrayOptions &opt, double vccNominal)
+{
+    const int s = task.series;
+    const double vdMid = 0.5 * (opt.vdMin_V + opt.vdMax_V);
+    const double headLow = opt.vccMin_V - s * opt.vdMax_V;
+    const double headHigh = opt.vccMax_V - s * opt.vdMin_V;
+    const double headNominal = vccNominal - s * vdMid;
+
+    // 最差低點點不亮：這個串數 (以及更多串) 都不可能
+    if (!(headLow > 0) || !(headNominal > 0)) {
+        task.rejected = true;
+        return;
+    }
+
+    const int p = opt.ledCount / s;
+    double rMin = headHigh / (opt.maxCurrent_A * p);
+    const double rMax = headLow / (opt.minCurrent_A * p);
+    if (opt.maxResistorPower_W > 0) rMin = std::max(rMin, headHigh * headHigh / opt.maxResistorPower_W);
+    if (!(rMin <= rMax)) return;
+
+    const double regulation = (headHigh - headLow) / headNominal;
+    const double efficiency = s * vdMid / vccNominal;
+
+    for (double R : standardValuesInRange(opt.series, rMin, rMax)) {
+        LedArrayConfig c;
+        c.series = s;
+        c.parallel = p;
+        c.R_ohm = R;
+        c.currentMin_A = headLow / (R * p);
+        c.currentNominal_A = headNominal / (R * p);
+        c.currentMax_A = headHigh / (R * p);
+        c.resistorPower_W = headNominal * headNominal / R;
+        c.resistorPowerMax_W = headHigh * headHigh / R;
+        c.efficiency = efficiency;
+        c.regulation = regulation;
+        c.pareto = false;
+        task.configs.push_back(c);
+    }
+}
+
+void markPareto(std::vector<LedArrayConfig> &configs)
+{
+    std::vector<std::size_t> order(configs.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (configs[a].resistorPower_W != configs[b].resistorPower_W)
+            return configs[a].resistorPower_W < configs[b].resistorPower_W;
+        return configs[a].regulation < configs[b].regulation;
+    });
+
+    double bestRegulation = std::numeric_limits<double>::infinity();
+    for (std::size_t i : order) {
+        if (configs[i].regulation < bestRegulation) {
+            configs[i].pareto = true;
+            bestRegulation = configs[i].regulation;
+        }
+    }
+}
+
+} // namespace
+
+LedArrayResult ledArraySearch(const LedArrayOptions &options)
+{
+    const auto start = std::chrono::steady_clock::now();
+    LedArrayResult result;
+    if (options.ledCount < 1 || !(options.vccMin_V > 0) || !(options.vccMax_V >= options.vccMin_V)
+        || !(options.vdMin_V > 0) || !(options.vdMax_V >= options.vdMin_V)
+        || !(options.minCurrent_A > 0) || !(options.maxCurrent_A >= options.minCurrent_A))
+        return result;
+
+    const double vccNominal = (options.vccNominal_V > 0) ? options.vccNominal_V
+                                                         : 0.5 * (options.vccMin_V + options.vccMax_V);
+
+    // series * parallel = N：每個因數是一個串數
+    std::vector<SeriesTask> tasks;
+    for (int s = 1; s <= options.ledCount; ++s)
+        if (options.ledCount % s == 0) tasks.push_back({ s, {} });
+
+    parallelFor(tasks.size(), options.threads, [&](std::size_t i) { searchSeries(tasks[i], options, vccNominal); });
+
+    for (SeriesTask &task : tasks) {
+        if (task.rejected) ++result.rejectedSeries;
+        result.configs.insert(result.configs.end(), task.configs.begin(), task.configs.end());
+    }
+    markPareto(result.configs);
+
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace sc
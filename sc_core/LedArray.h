@@ -0,0 +1,61 @@
+#ifndef SC_LEDARRAY_H
+#define SC_LEDARRAY_H
+
+/**
+ * @file LedArray.h
+ * @brief LED 陣列組態搜尋 (串數 x 並數 x 限流電阻標準值)
+ *
+ * N 顆 LED 排成 series 串 x parallel 並 (series * parallel = N)，與 LED 頁的計算相同，整組共用一顆限流電阻
+ * (各串電流相同，為總電流的 1 / parallel)。
+ * 電源在 vccMin ~ vccMax 之間變動、LED 壓降在 vdMin ~ vdMax 之間時，每串電流都要落在規格內；
+ * 在可行的組態中找出「電阻功耗」與「電流穩定度」的 Pareto 前緣。
+ */
+
+#include "ESeries.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace sc {
+
+struct LedArrayOptions {
+    int ledCount = 12;
+    double vccMin_V = 11.4;                 // 電源範圍
+    double vccMax_V = 12.6;
+    double vccNominal_V = 0;                // 0 = (vccMin + vccMax) / 2
+    double vdMin_V = 2.9;                   // 單顆 LED 順向壓降範圍 (批次差異、溫度)
+    double vdMax_V = 3.2;
+    double minCurrent_A = 0.015;            // 每串電流規格：最差低點 (vccMin、vdMax) 不低於 minCurrent，
+    double maxCurrent_A = 0.025;            // 最差高點 (vccMax、vdMin) 不高於 maxCurrent
+    double maxResistorPower_W = std::numeric_limits<double>::infinity();   // 電阻額定 (vccMax 下檢查)
+    ESeries series = ESeries::E24;          // 限流電阻系列
+    unsigned threads = 0;                   // 0 = 全部硬體執行緒
+};
+
+struct LedArrayConfig {
+    int series;                // 每串 LED 數
+    int parallel;              // 並聯串數
+    double R_ohm;              // 整組共用的限流電阻 (標準值)
+    double currentMin_A;       // 每串電流：vccMin、vdMax
+    double currentNominal_A;   // vccNominal、壓降取中間值
+    double currentMax_A;       // vccMax、vdMin
+    double resistorPower_W;    // 標稱條件下電阻的功耗
+    double resistorPowerMax_W; // 最差情況下電阻的功耗 (選額定用)
+    double efficiency;         // 標稱條件下 LED 功率 / 總功率
+    double regulation;         // 電流變動 (currentMax - currentMin) / currentNominal
+    bool pareto;               // 是否在 Pareto 前緣 (功耗與電流變動都不被其他組態同時勝過)
+};
+
+struct LedArrayResult {
+    std::vector<LedArrayConfig> configs;    // 所有可行組態，依 (series, R) 排序
+    std::size_t rejectedSeries = 0;         // 因 vccMin 不足以點亮而整個跳過的串數
+    double elapsed_ms = 0;
+};
+
+// 搜尋所有可行組態；同一個串數下電流變動與電阻值無關，所以 Pareto 點是每個串數中功耗最小的電阻
+LedArrayResult ledArraySearch(const LedArrayOptions &options);
+
+} // namespace sc
+
+#endif // SC_LEDARRAY_H
@@ -0,0 +1,52 @@
+/**
+ * @file LedCalc.cpp
+ * @brief LED 限流電阻計算 - 不依賴 Qt 的核心實現
+ *
+ * 串聯：總壓降 = Vd * 串數
+ * 並聯：總電流 = 每串電流 * 並數
+ * 電阻：R = (Vcc - 總壓降) / 總電流，功耗 P = (Vcc - 總壓降) * 總電流
+ */
+
+#include "LedCalc.h"
+
+namespace sc {
+
+double ledResistor(double vcc, double vd, double current_A)
+{
+    if (current_A <= 0) return 0;
+
+    // Vcc 必須大於 Vd，否則回傳 -1 代表電壓不足以驅動 LED
+    if (vcc <= vd) return -1;
+
+    return (vcc - vd) / current_A;
+}
+
+LEDResult ledSolve(double vcc, double vd, double branchCurrent_A, int series, int parallel)
+{
+    LEDResult res = {0, 0, true};
+
+    double totalVd = vd * (series > 0 ? series : 1);
+    double totalCurrentA = branchCurrent_A * (parallel > 0 ? parallel : 1);
+
+    if (vcc <= totalVd) {
+        res.isVoltageOk = false;
+        return res;
+    }
+
+    res.resistance = (vcc - totalVd) / totalCurrentA;
+    res.wattage = (vcc - totalVd) * totalCurrentA;
+    return res;
+}
+
+void ledSolveBatch(const LEDBatchIn &in, const LEDBatchOut &out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        LEDResult r = ledSolve(in.vcc[i], in.vd[i], in.branchCurrent_A[i],
+                               in.series[i], in.parallel[i]);
+        out.resistance[i] = r.resistance;
+        out.wattage[i] = r.wattage;
+        out.isVoltageOk[i] = r.isVoltageOk;
+    }
+}
+
+} // namespace sc
@@ -0,0 +1,41 @@
+#ifndef SC_LEDCALC_H
+#define SC_LEDCALC_H
+
+#include <cstddef>
+
+namespace sc {
+
+// LED 限流電阻計算結果
+struct LEDResult {
+    double resistance;   // Ohm
+    double wattage;      // 電阻功耗 (W)
+    bool isVoltageOk;    // Vcc 是否大於總 LED 壓降
+};
+
+// 單顆 LED：R = (Vcc - Vd) / I，電流單位為 A
+// current <= 0 回傳 0，Vcc <= Vd 回傳 -1
+double ledResistor(double vcc, double vd, double current_A);
+
+// 串並聯 LED：series 串 x parallel 並，branchCurrent_A 為每一串的電流
+LEDResult ledSolve(double vcc, double vd, double branchCurrent_A, int series, int parallel);
+
+// 批次計算 (struct-of-arrays)
+struct LEDBatchIn {
+    const double *vcc;
+    const double *vd;
+    const double *branchCurrent_A;
+    const int *series;
+    const int *parallel;
+};
+
+struct LEDBatchOut {
+    double *resistance;
+    double *wattage;
+    bool *isVoltageOk;
+};
+
+void ledSolveBatch(const LEDBatchIn &in, const LEDBatchOut &out, std::size_t n);
+
+} // namespace sc
+
+#endif // SC_LEDCALC_H
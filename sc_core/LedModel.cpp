@@ -0,0 +1,198 @@
+/**
+ * @file LedModel.cpp
+ * @brief Shockley 模型 LED 工作點的求解
+ *
+ * 【 1. 變數代換 】
+ * 每一串：Vcc = series * (n Vt ln(1 + I / Is) + I Rs) + I R。
+ * 直接對 I 做 Newton 在小電流時很難收斂 (ln 在 0 附近太陡)，改以 u = ln(1 + I / Is) 為未知數：
+ *   g(u) = a u + Is Rt (e^u - 1) - Vcc，   a = series * n Vt，Rt = series * Rs + R
+ * g 遞增且為凸函數，而且 u = min(Vcc / a, ln(1 + Vcc / (Is Rt))) 一定在根的右側 (各自忽略另一項)，
+ * 從這裡出發的 Newton / Halley 單調收斂，不需要阻尼或括號法。
+ *
+ * 【 2. 批次 】
+ * 每個區塊 (BLOCK_LANES 個工作點) 一起迭代：每一輪對整個區塊做一次 Halley 更新 (無分支)，
+ * 所有工作點都收斂才結束；已收斂的工作點再多做一輪也只是原地不動。
+ */
+
+#include "LedModel.h"
+#include "Parallel.h"
+#include "ScConstants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sc {
+
+namespace {
+
+constexpr std::size_t BLOCK_LANES = 256;
+constexpr int MAX_ITERATIONS = 40;
+constexpr double U_TOLERANCE = 1e-13;       // u 約 20 ~ 60，相對誤差約 1e-15
+
+// 超過這個數量才分給多個執行緒 (執行緒啟動成本比小批次的計算還高)
+constexpr std::size_t PARALLEL_MIN = 16 * BLOCK_LANES;
+
+void solveBlock(const LedModel &model, int series, int parallel, const LedSweepIn &in, const LedSweepOut &out,
+                std::size_t offset, std::size_t n, int *iterations)
+{
+    const double nVt = ledThermalVoltage(model);
+    const double a = series * nVt;
+    double u[BLOCK_LANES], vcc[BLOCK_LANES], IsRt[BLOCK_LANES];
+    int iters[BLOCK_LANES];
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double v = in.vcc ? in.vcc[offset + i] : in.vccScalar;
+        const double R = in.R_ohm ? in.R_ohm[offset + i] : in.RScalar;
+        vcc[i] = std::max(v, 0.0);
+        IsRt[i] = model.Is_A * (series * model.Rs_ohm + std::max(R, 0.0));
+        // 兩個起點都在根的右側，取比較近的一個；Rt = 0 時第二項為 +inf
+        const double uDiode = vcc[i] / a;
+        const double uResistor = IsRt[i] > 0 ? std::log1p(vcc[i] / IsRt[i]) : std::numeric_limits<double>::infinity();
+        u[i] = std::min(uDiode, uResistor);
+        iters[i] = 0;
+    }
+
+    for (int k = 0; k < MAX_ITERATIONS; ++k) {
+        double maxStep = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double e = std::exp(u[i]);
+            const double g = a * u[i] + IsRt[i] * (e - 1.0) - vcc[i];
+            const double g1 = a + IsRt[i] * e;
+            const double g2 = IsRt[i] * e;
+            // Halley：du = 2 g g' / (2 g'^2 - g g'')；g >= 0 且 g'' >= 0 時分母不小於 g'^2
+            const double denom = 2.0 * g1 * g1 - g * g2;
+            const double du = (denom > 0) ? 2.0 * g * g1 / denom : g / g1;
+            u[i] = std::max(u[i] - du, 0.0);
+            const double step = std::fabs(du);
+            iters[i] += (step > U_TOLERANCE * std::max(u[i], 1.0)) ? 1 : 0;
+            maxStep = std::max(maxStep, step / std::max(u[i], 1.0));
+        }
+        if (maxStep <= U_TOLERANCE) break;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double I = model.Is_A * std::expm1(u[i]);
+        const double R = in.R_ohm ? std::max(in.R_ohm[offset + i], 0.0) : std::max(in.RScalar, 0.0);
+        const double vf = nVt * u[i] + I * model.Rs_ohm;
+        out.current_A[offset + i] = I;
+        out.vf_V[offset + i] = vf;
+        if (out.ledPower_W) out.ledPower_W[offset + i] = series * vf * I * parallel;
+        if (out.resistorPower_W) out.resistorPower_W[offset + i] = I * I * R * parallel;
+        if (iterations) iterations[i] = iters[i] + 1;
+    }
+}
+
+// 3x3 線性方程組 (部分主元高斯消去)，奇異時回傳 false
+bool solve3(double A[3][3], double b[3], double x[3])
+{
+    for (int c = 0; c < 3; ++c) {
+        int p = c;
+        for (int r = c + 1; r < 3; ++r)
+            if (std::fabs(A[r][c]) > std::fabs(A[p][c])) p = r;
+        if (!(std::fabs(A[p][c]) > 1e-300)) return false;
+        std::swap(A[p], A[c]);
+        std::swap(b[p], b[c]);
+        for (int r = c + 1; r < 3; ++r) {
+            const double f = A[r][c] / A[c][c];
+            for (int k = c; k < 3; ++k) A[r][k] -= f * A[c][k];
+            b[r] -= f * b[c];
+        }
+    }
+    for (int r = 2; r >= 0; --r) {
+        double s = b[r];
+        for (int k = r + 1; k < 3; ++k) s -= A[r][k] * x[k];
+        x[r] = s / A[r][r];
+    }
+    return true;
+}
+
+} // namespace
+
+double ledThermalVoltage(const LedModel &model)
+{
+    return model.n * BOLTZMANN_OVER_Q * (model.temperature_C + KELVIN_OFFSET);
+}
+
+double ledForwardVoltage(const LedModel &model, double current_A)
+{
+    if (current_A <= 0) return 0;
+    return ledThermalVoltage(model) * std::log1p(current_A / model.Is_A) + current_A * model.Rs_ohm;
+}
+
+bool ledModelFit(const double *current_A, const double *voltage_V, std::size_t count, LedModel &model)
+{
+    if (count < 3) return false;
+
+    // 基底 (ln I, 1, I)；I 以 mA 計算讓三欄的數量級接近，解完再換回 Ohm
+    double A[3][3] = {}, b[3] = {};
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!(current_A[i] > 0) || !std::isfinite(voltage_V[i])) return false;
+        const double row[3] = { std::log(current_A[i]), 1.0, current_A[i] * 1e3 };
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) A[r][c] += row[r] * row[c];
+            b[r] += row[r] * voltage_V[i];
+        }
+    }
+
+    double x[3];
+    if (!solve3(A, b, x)) return false;
+    double nVt = x[0], offset = x[1];
+    double Rs = x[2] * 1e3;
+
+    // Rs 擬合成負值 (點太少或量測雜訊) 時固定 Rs = 0，只擬合 (a, b)
+    if (Rs < 0) {
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const double lx = std::log(current_A[i]);
+            sx += lx;
+            sy += voltage_V[i];
+            sxx += lx * lx;
+            sxy += lx * voltage_V[i];
+        }
+        const double det = count * sxx - sx * sx;
+        if (!(std::fabs(det) > 1e-300)) return false;
+        nVt = (count * sxy - sx * sy) / det;
+        offset = (sy - nVt * sx) / count;
+        Rs = 0;
+    }
+    if (!(nVt > 0)) return false;
+
+    // Vf = nVt ln(I) - nVt ln(Is) + Rs I  ->  Is = exp(-offset / nVt)
+    const double Is = std::exp(-offset / nVt);
+    if (!(Is > 0) || !std::isfinite(Is)) return false;
+    model.Is_A = Is;
+    model.n = nVt / (BOLTZMANN_OVER_Q * (model.temperature_C + KELVIN_OFFSET));
+    model.Rs_ohm = Rs;
+    return true;
+}
+
+LedOperatingPoint ledOperatingPoint(const LedModel &model, double vcc, double R_ohm, int series, int parallel)
+{
+    series = std::max(series, 1);
+    parallel = std::max(parallel, 1);
+    LedOperatingPoint p;
+    LedSweepIn in{ nullptr, nullptr, vcc, R_ohm };
+    LedSweepOut out{ &p.current_A, &p.vf_V, &p.ledPower_W, &p.resistorPower_W };
+    solveBlock(model, series, parallel, in, out, 0, 1, &p.iterations);
+    return p;
+}
+
+void ledOperatingPointBatch(const LedModel &model, int series, int parallel, const LedSweepIn &in,
+                            const LedSweepOut &out, std::size_t n, unsigned threads)
+{
+    series = std::max(series, 1);
+    parallel = std::max(parallel, 1);
+    const std::size_t blocks = (n + BLOCK_LANES - 1) / BLOCK_LANES;
+    auto block = [&](std::size_t b) {
+        const std::size_t offset = b * BLOCK_LANES;
+        solveBlock(model, series, parallel, in, out, offset, std::min(BLOCK_LANES, n - offset), nullptr);
+    };
+    if (n < PARALLEL_MIN) {
+        for (std::size_t b = 0; b < blocks; ++b) block(b);
+    } else {
+        parallelFor(blocks, threads, block);
+    }
+}
+
+} // namespace sc
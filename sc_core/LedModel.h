@@ -0,0 +1,73 @@
+#ifndef SC_LEDMODEL_H
+#define SC_LEDMODEL_H
+
+/**
+ * @file LedModel.h
+ * @brief Shockley 二極體模型的 LED 工作點
+ *
+ *   I = Is * (exp((Vf - I * Rs) / (n * Vt)) - 1)
+ *
+ * 固定 Vf 在小電流時誤差很大 (例如 1 mA 時紅光 LED 只有 1.8 V 左右)，
+ * 這裡用 (Is, n, Rs) 描述 I-V 曲線，可由規格書上的幾個 I-V 點擬合。
+ * 串 series 顆 LED 與限流電阻 R 的工作點以 Halley 法求解，批次版本一次解整段 Vcc / R 掃描。
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace sc {
+
+struct LedModel {
+    double Is_A = 1e-18;            // 飽和電流
+    double n = 2.0;                 // 理想因子
+    double Rs_ohm = 2.0;            // 串聯電阻
+    double temperature_C = 25;      // 接面溫度 (決定 Vt)
+};
+
+// 熱電壓 n * Vt (V)
+double ledThermalVoltage(const LedModel &model);
+
+// 給定電流時的順向電壓 (封閉解)：Vf = n Vt ln(1 + I / Is) + I Rs
+double ledForwardVoltage(const LedModel &model, double current_A);
+
+// 以規格書的 I-V 點擬合 (Is, n, Rs)：Vf ≈ a ln(I) + b + Rs I 對 (a, b, Rs) 是線性的，
+// 用最小平方法一次解出。至少 3 個點且電流各不相同；失敗 (或擬合出非物理的參數) 回傳 false，model 不變
+bool ledModelFit(const double *current_A, const double *voltage_V, std::size_t count, LedModel &model);
+
+// 串並聯工作點 (每一串：Vcc = series * Vf(I) + I * R，R 是每串各自的限流電阻；
+// 整組共用一顆電阻 R0 時等效於每串 R = parallel * R0)
+struct LedOperatingPoint {
+    double current_A;          // 每串電流
+    double vf_V;               // 單顆 LED 的順向電壓
+    double ledPower_W;         // 所有 LED 的總功耗
+    double resistorPower_W;    // 所有限流電阻的總功耗
+    int iterations;            // Halley 迭代次數
+};
+
+// Vcc <= 0 時電流為 0
+LedOperatingPoint ledOperatingPoint(const LedModel &model, double vcc, double R_ohm, int series, int parallel);
+
+// 批次計算 (struct-of-arrays)：vcc、R 任一個可為 nullptr，改用 vccScalar / RScalar
+// (常見的用法是固定 R 掃 Vcc，或固定 Vcc 掃 R)
+struct LedSweepIn {
+    const double *vcc;
+    const double *R_ohm;
+    double vccScalar = 0;
+    double RScalar = 0;
+};
+
+struct LedSweepOut {
+    double *current_A;
+    double *vf_V;
+    double *ledPower_W;         // 可為 nullptr
+    double *resistorPower_W;    // 可為 nullptr
+};
+
+// 以區塊為單位同時迭代所有工作點 (區塊內沒有分支，迴圈可向量化)，
+// 大批次時區塊分給多個執行緒。threads 為 0 時使用全部硬體執行緒
+void ledOperatingPointBatch(const LedModel &model, int series, int parallel, const LedSweepIn &in,
+                            const LedSweepOut &out, std::size_t n, unsigned threads = 0);
+
+} // namespace sc
+
+#endif // SC_LEDMODEL_H
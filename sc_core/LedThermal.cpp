@@ -0,0 +1,168 @@
+/**
+ * @file LedThermal.cpp
+ * @brief LED 電熱耦合的固定點迭代
+ *
+ * 【 1. 一輪迭代 】
+ * 給定目前的 Tj 與 Tr：
+ *   Vf 的溫度漂移當作電源少了 series * tempco * (Tj - Tref)，電阻換成 R * (1 + TCR * (Tr - 25))，
+ *   以 LedModel 的 Halley 解出電流，再由功耗算出新的 Tb、Tj、Tr。
+ * 整組共用一顆電阻時，每串等效於 parallel 倍的電阻，那一顆的功耗是總電流的 I^2 R。
+ * 溫度變化小於 toleranceC 就收斂；電流隨溫度上升太快時迭代會發散 (熱失控)，
+ * 以迭代上限或溫度超過 RUNAWAY_C 判定。
+ *
+ * 【 2. 批次 】
+ * 每個區塊維護「還沒收斂」的工作點清單，每一輪把它們壓緊成連續陣列交給
+ * ledOperatingPointBatch (同樣是區塊內無分支的向量化迴圈)，收斂的工作點寫出結果後移出清單，
+ * 所以收斂快的工作點不會陪著慢的一直算。
+ */
+
+#include "LedThermal.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sc {
+
+namespace {
+
+// 每個執行緒一次處理的工作點數
+constexpr std::size_t CHUNK = 1024;
+
+// 超過這個溫度視為熱失控 (LED 與電阻早已損壞，繼續迭代沒有意義)
+constexpr double RUNAWAY_C = 1000;
+
+// 電阻 TCR 的參考溫度
+constexpr double TCR_REFERENCE_C = 25;
+
+struct ChunkState {
+    std::vector<double> vcc, R, ambient;        // 輸入
+    std::vector<double> tj, tr;                 // 目前的溫度估計
+    std::vector<std::size_t> active;            // 尚未收斂的工作點 (區塊內索引)
+    std::vector<double> vccEff, Reff, current, vfModel;
+};
+
+void solveChunk(const LedThermalParams &p, int series, int parallel, const LedThermalBatchIn &in,
+                const LedThermalBatchOut &out, std::size_t offset, std::size_t n)
+{
+    ChunkState s;
+    s.vcc.resize(n);
+    s.R.resize(n);
+    s.ambient.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        s.vcc[i] = in.vcc ? in.vcc[offset + i] : in.vccScalar;
+        s.R[i] = in.R_ohm ? in.R_ohm[offset + i] : in.RScalar;
+        s.ambient[i] = in.ambient_C ? in.ambient_C[offset + i] : in.ambientScalar;
+    }
+    s.tj = s.ambient;
+    s.tr = s.ambient;
+    s.active.resize(n);
+    for (std::size_t i = 0; i < n; ++i) s.active[i] = i;
+
+    const double tref = p.model.temperature_C;
+    const double tcr = p.resistorTcr_ppm * 1e-6;
+    const double leds = static_cast<double>(series) * parallel;
+    // 每串看到的等效電阻倍率與電阻顆數
+    const double branchFactor = p.sharedResistor ? parallel : 1.0;
+    const double resistors = p.sharedResistor ? 1.0 : parallel;
+
+    auto finish = [&](std::size_t i, double I, double vf, double pr, int iterations, bool converged) {
+        const std::size_t o = offset + i;
+        const double allowed = p.resistorRating_W * resistorDerating(p, s.tr[i]);
+        out.current_A[o] = I;
+        out.vf_V[o] = vf;
+        out.tj_C[o] = s.tj[i];
+        if (out.tResistor_C) out.tResistor_C[o] = s.tr[i];
+        if (out.resistorPower_W) out.resistorPower_W[o] = pr;
+        if (out.resistorAllowed_W) out.resistorAllowed_W[o] = allowed;
+        if (out.iterations) out.iterations[o] = iterations;
+        if (out.converged) out.converged[o] = converged;
+    };
+
+    for (int k = 1; k <= p.maxIterations && !s.active.empty(); ++k) {
+        const std::size_t m = s.active.size();
+        s.vccEff.resize(m);
+        s.Reff.resize(m);
+        s.current.resize(m);
+        s.vfModel.resize(m);
+        for (std::size_t j = 0; j < m; ++j) {
+            const std::size_t i = s.active[j];
+            s.vccEff[j] = s.vcc[i] - series * p.vfTempco_V_per_C * (s.tj[i] - tref);
+            s.Reff[j] = branchFactor * s.R[i] * (1.0 + tcr * (s.tr[i] - TCR_REFERENCE_C));
+        }
+
+        LedSweepIn opIn{ s.vccEff.data(), s.Reff.data(), 0, 0 };
+        LedSweepOut opOut{ s.current.data(), s.vfModel.data(), nullptr, nullptr };
+        ledOperatingPointBatch(p.model, series, parallel, opIn, opOut, m, 1);
+
+        std::size_t keep = 0;
+        for (std::size_t j = 0; j < m; ++j) {
+            const std::size_t i = s.active[j];
+            const double I = s.current[j];
+            const double vf = s.vfModel[j] + p.vfTempco_V_per_C * (s.tj[i] - tref);
+            const double pLed = vf * I;
+            const double pRes = I * I * s.Reff[j] * branchFactor;
+            const double tb = s.ambient[i] + (leds * pLed + resistors * pRes) * p.rthBoardAmbient;
+            const double tj = tb + pLed * p.rthJunctionBoard;
+            const double tr = tb + pRes * p.rthResistor;
+            const double delta = std::max(std::fabs(tj - s.tj[i]), std::fabs(tr - s.tr[i]));
+            s.tj[i] = tj;
+            s.tr[i] = tr;
+
+            const bool runaway = !(tj < RUNAWAY_C) || !(tr < RUNAWAY_C);
+            if (delta <= p.toleranceC || runaway || k == p.maxIterations) {
+                finish(i, I, vf, pRes, k, delta <= p.toleranceC && !runaway);
+            } else {
+                s.active[keep++] = i;
+            }
+        }
+        s.active.resize(keep);
+    }
+}
+
+} // namespace
+
+double resistorDerating(const LedThermalParams &params, double temperature_C)
+{
+    if (temperature_C <= params.deratingStart_C) return 1.0;
+    if (!(params.deratingEnd_C > params.deratingStart_C) || temperature_C >= params.deratingEnd_C) return 0.0;
+    return (params.deratingEnd_C - temperature_C) / (params.deratingEnd_C - params.deratingStart_C);
+}
+
+LedThermalPoint ledThermalSolve(const LedThermalParams &params, int series, int parallel,
+                                double vcc, double R_ohm, double ambient_C)
+{
+    series = std::max(series, 1);
+    parallel = std::max(parallel, 1);
+    LedThermalPoint r;
+    LedThermalBatchIn in{ nullptr, nullptr, nullptr, vcc, R_ohm, ambient_C };
+    LedThermalBatchOut out{ &r.current_A, &r.vf_V, &r.tj_C, &r.tResistor_C,
+                            &r.resistorPower_W, &r.resistorAllowed_W, &r.iterations, &r.converged };
+    solveChunk(params, series, parallel, in, out, 0, 1);
+
+    // 單筆版本另外回報板溫與實際阻值
+    r.R_ohm = R_ohm * (1.0 + params.resistorTcr_ppm * 1e-6 * (r.tResistor_C - TCR_REFERENCE_C));
+    r.tBoard_C = r.tResistor_C - r.resistorPower_W * params.rthResistor;
+    r.ok = r.converged && r.tj_C <= params.tjMax_C && r.resistorPower_W <= r.resistorAllowed_W;
+    return r;
+}
+
+void ledThermalSolveBatch(const LedThermalParams &params, int series, int parallel, const LedThermalBatchIn &in,
+                          const LedThermalBatchOut &out, std::size_t n, unsigned threads)
+{
+    series = std::max(series, 1);
+    parallel = std::max(parallel, 1);
+    const std::size_t chunks = (n + CHUNK - 1) / CHUNK;
+    auto chunk = [&](std::size_t c) {
+        const std::size_t offset = c * CHUNK;
+        solveChunk(params, series, parallel, in, out, offset, std::min(CHUNK, n - offset));
+    };
+    if (chunks <= 1) {
+        for (std::size_t c = 0; c < chunks; ++c) chunk(c);
+    } else {
+        parallelFor(chunks, threads, chunk);
+    }
+}
+
+} // namespace sc
@@ -0,0 +1,86 @@
+#ifndef SC_LEDTHERMAL_H
+#define SC_LEDTHERMAL_H
+
+/**
+ * @file LedThermal.h
+ * @brief LED 電熱耦合：接面溫度與工作點互相影響的固定點
+ *
+ *   環境 Ta ── Rθba ── 板溫 Tb ──┬── Rθjb ── 每顆 LED 接面 Tj
+ *                                └── Rθr  ── 每顆限流電阻 Tr
+ *
+ * Tj 升高 -> Vf 下降 (溫度係數為負) -> 電流上升 -> 功耗與 Tj 再升高；
+ * 電阻溫度升高 -> 阻值 (TCR) 改變、允許功率依降額曲線下降。
+ * 每個工作條件反覆「熱 -> 電 -> 熱」直到溫度收斂，發散 (熱失控) 時標記出來。
+ */
+
+#include "LedModel.h"
+
+#include <cstddef>
+
+namespace sc {
+
+struct LedThermalParams {
+    LedModel model;                         // I-V 曲線 (在 model.temperature_C 下)
+    double vfTempco_V_per_C = -2e-3;        // Vf 溫度係數 (每顆)
+    double rthJunctionBoard = 30;           // 每顆 LED 接面到板 (°C/W)
+    double rthBoardAmbient = 20;            // 整片板子到環境 (°C/W)，所有 LED 與電阻的熱都經過這裡
+    double rthResistor = 150;               // 單顆電阻到板 (°C/W)
+    double resistorTcr_ppm = 100;           // 電阻溫度係數，參考溫度 25 °C
+    double resistorRating_W = 0.25;         // 電阻額定功率 (70 °C 以下)
+    bool sharedResistor = false;            // false = 每串各一顆電阻；true = 整組共用一顆 (LED 計算頁的接法)
+    double deratingStart_C = 70;            // 降額曲線：deratingStart 以下 100%，線性降到 deratingEnd 為 0
+    double deratingEnd_C = 155;
+    double tjMax_C = 125;                   // LED 接面溫度上限
+    double toleranceC = 1e-6;               // 收斂條件 (溫度變化 °C)
+    int maxIterations = 200;
+};
+
+struct LedThermalPoint {
+    double current_A;          // 每串電流
+    double vf_V;               // 單顆 LED 在 Tj 下的順向電壓
+    double tj_C;               // LED 接面溫度
+    double tBoard_C;           // 板溫
+    double tResistor_C;        // 電阻溫度
+    double R_ohm;              // 電阻在 tResistor 下的阻值
+    double resistorPower_W;    // 單顆電阻功耗 (共用時為那一顆的功耗)
+    double resistorAllowed_W;  // 單顆電阻在 tResistor 下降額後的允許功率
+    int iterations;
+    bool converged;            // false = 達到迭代上限仍未收斂 (熱失控)
+    bool ok;                   // 收斂、Tj <= tjMax 且電阻功耗不超過降額後的允許值
+};
+
+// 電阻降額：T <= start 為 1，線性降到 end 為 0
+double resistorDerating(const LedThermalParams &params, double temperature_C);
+
+// 單一工作條件：series 串 x parallel 並，R_ohm 為 25 °C 的標稱阻值
+LedThermalPoint ledThermalSolve(const LedThermalParams &params, int series, int parallel,
+                                double vcc, double R_ohm, double ambient_C);
+
+// 批次計算 (struct-of-arrays)：任一陣列為 nullptr 時改用對應的純量 (常見用法：只掃環境溫度)
+struct LedThermalBatchIn {
+    const double *vcc;
+    const double *R_ohm;
+    const double *ambient_C;
+    double vccScalar = 0;
+    double RScalar = 0;
+    double ambientScalar = 25;
+};
+
+struct LedThermalBatchOut {
+    double *current_A;
+    double *vf_V;
+    double *tj_C;
+    double *tResistor_C;         // 可為 nullptr
+    double *resistorPower_W;     // 可為 nullptr
+    double *resistorAllowed_W;   // 可為 nullptr
+    int *iterations;             // 可為 nullptr
+    bool *converged;             // 可為 nullptr
+};
+
+// 每一輪只對還沒收斂的工作點求解 (收斂的先移出去)，工作點分塊給多個執行緒
+void ledThermalSolveBatch(const LedThermalParams &params, int series, int parallel, const LedThermalBatchIn &in,
+                          const LedThermalBatchOut &out, std::size_t n, unsigned threads = 0);
+
+} // namespace sc
+
+#endif // SC_LEDTHERMAL_H
@@ -0,0 +1,169 @@
+/**
+ * @file MappedFile.cpp
+ * @brief 唯讀記憶體映射檔
+ *
+ * 空檔案無法建立映射，此時 open() 仍然成功，data() 為 nullptr、size() 為 0。
+ */
+
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sc {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    swap(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other) {
+        close();
+        swap(other);
+    }
+    return *this;
+}
+
+void MappedFile::swap(MappedFile &other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_open, other.m_open);
+    std::swap(m_error, other.m_error);
+#ifdef _WIN32
+    std::swap(m_file, other.m_file);
+    std::swap(m_mapping, other.m_mapping);
+#else
+    std::swap(m_fd, other.m_fd);
+#endif
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string &path)
+{
+    close();
+
+    // 路徑以 UTF-8 傳入，轉成寬字元以支援中文檔名
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring wpath(wlen > 0 ? wlen : 0, L'\0');
+    if (wlen > 0) MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wpath[0], wlen);
+
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        m_error = "cannot open " + path;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        m_error = "cannot stat " + path;
+        return false;
+    }
+
+    m_file = file;
+    m_open = true;
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size == 0) return true;
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        m_error = "cannot map " + path;
+        return false;
+    }
+    m_mapping = mapping;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        close();
+        m_error = "cannot map " + path;
+        return false;
+    }
+    m_data = static_cast<const char *>(view);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string &path)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_error = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        m_error = "cannot stat " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_open = true;
+    m_size = static_cast<std::size_t>(st.st_size);
+    if (m_size == 0) return true;
+
+    void *p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+        m_error = "cannot map " + path + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+    // 主要是循序讀取，提示核心提前預讀
+    ::madvise(p, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(p);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data) ::munmap(const_cast<char *>(m_data), m_size);
+    if (m_fd >= 0) ::close(m_fd);
+    m_data = nullptr;
+    m_fd = -1;
+    m_size = 0;
+    m_open = false;
+}
+
+#endif
+
+} // namespace sc
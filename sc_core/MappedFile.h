@@ -0,0 +1,50 @@
+#ifndef SC_MAPPEDFILE_H
+#define SC_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace sc {
+
+// 唯讀記憶體映射檔 (Windows: MapViewOfFile，其他: mmap)
+// 大檔案不必整個讀進記憶體，由作業系統依需要分頁載入。
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    // 失敗時回傳 false，錯誤訊息由 errorString() 取得
+    bool open(const std::string &path);
+    void close();
+
+    bool isOpen() const { return m_open; }
+    const char *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+    const std::string &errorString() const { return m_error; }
+
+private:
+    void swap(MappedFile &other) noexcept;
+
+    const char *m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+    std::string m_error;
+#ifdef _WIN32
+    void *m_file = nullptr;      // HANDLE
+    void *m_mapping = nullptr;   // HANDLE
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace sc
+
+#endif // SC_MAPPEDFILE_H
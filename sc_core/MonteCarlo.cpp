@@ -0,0 +1,355 @@
+/**
+ * @file MonteCarlo.cpp
+ * @brief 元件公差 Monte Carlo 分析的實現
+ *
+ * 【 1. 區塊 】
+ * 樣本依序號切成固定大小的區塊 (BLOCK_SAMPLES)，區塊是平行計算的單位：
+ *   1. 每個輸入以 Philox 批次產生亂數，轉成該分布的樣本 (struct-of-arrays)
+ *   2. 呼叫批次公式
+ *   3. 區塊內的平均/變異 (Welford)、極值、良率計數
+ * 區塊統計依區塊序號合併 (Chan 的平行變異數公式)，合併順序固定，所以浮點結果也與執行緒數無關。
+ *
+ * 【 2. 截斷常態 】
+ * Box-Muller 產生常態樣本，超出 ± sigmas 的樣本以下一個 round 的計數器重抽，
+ * 重抽只跟樣本序號有關，仍然可重現。3 sigma 截斷時只有 0.27% 的樣本需要重抽。
+ *
+ * 【 3. 直方圖 】
+ * 範圍未指定時先試算前 PILOT_SAMPLES 個樣本，由其極值決定 (左右各留 5%)，之後固定不變，
+ * 超出的樣本計入 underflow/overflow。試算的大小固定，所以直方圖與百分位數也不受 chunkSamples 影響。
+ */
+
+#include "MonteCarlo.h"
+#include "DividerCalc.h"
+#include "Parallel.h"
+#include "Philox.h"
+#include "ScConstants.h"
+#include "TraceCalc.h"
+#include "ViaCalc.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace sc {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t BLOCK_SAMPLES = 4096;
+// 自動決定直方圖範圍時先試算的樣本數 (BLOCK_SAMPLES 的整數倍)
+constexpr std::size_t PILOT_SAMPLES = 16 * BLOCK_SAMPLES;
+// 截斷常態最多重抽幾次 (之後夾在邊界上，實際上不會發生)
+constexpr std::uint32_t MAX_REDRAW_ROUNDS = 64;
+
+// 每個執行緒重複使用的暫存區，避免每個區塊都配置記憶體
+struct Scratch {
+    std::vector<std::uint32_t> r0, r1, r2, r3;
+    std::vector<double> inputs;
+    std::vector<const double *> inputPtrs;
+
+    void reserve(std::size_t inputCount)
+    {
+        if (r0.size() < BLOCK_SAMPLES) {
+            r0.resize(BLOCK_SAMPLES);
+            r1.resize(BLOCK_SAMPLES);
+            r2.resize(BLOCK_SAMPLES);
+            r3.resize(BLOCK_SAMPLES);
+        }
+        if (inputs.size() < inputCount * BLOCK_SAMPLES) inputs.resize(inputCount * BLOCK_SAMPLES);
+        inputPtrs.resize(inputCount);
+    }
+};
+
+Scratch &threadScratch()
+{
+    thread_local Scratch s;
+    return s;
+}
+
+inline double boxMuller(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d)
+{
+    // 1 - u 落在 (0, 1]，log 不會發散
+    const double u1 = 1.0 - philoxToUnit(a, b);
+    const double u2 = philoxToUnit(c, d);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * PI * u2);
+}
+
+struct BlockStats {
+    std::uint64_t valid = 0;
+    std::uint64_t invalid = 0;
+    std::uint64_t inSpec = 0;
+    double mean = 0;
+    double m2 = 0;          // 與平均值差的平方和
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+};
+
+// 合併兩組平均/變異 (Chan et al.)
+void mergeStats(BlockStats &a, const BlockStats &b)
+{
+    if (b.valid > 0) {
+        const double na = static_cast<double>(a.valid);
+        const double nb = static_cast<double>(b.valid);
+        const double n = na + nb;
+        const double delta = b.mean - a.mean;
+        a.mean += delta * (nb / n);
+        a.m2 += b.m2 + delta * delta * (na * nb / n);
+        a.valid += b.valid;
+        a.min = std::min(a.min, b.min);
+        a.max = std::max(a.max, b.max);
+    }
+    a.invalid += b.invalid;
+    a.inSpec += b.inSpec;
+}
+
+} // namespace
+
+void sampleDistribution(const InputDistribution &dist, std::uint64_t seed, std::uint32_t stream,
+                        std::uint64_t first, std::size_t n, double *out)
+{
+    const double nominal = dist.nominal;
+    const double tol = dist.tolerance;
+    if (dist.kind == Distribution::Fixed || tol == 0) {
+        std::fill(out, out + n, nominal);
+        return;
+    }
+
+    const PhiloxKey key = philoxKey(seed);
+    Scratch &s = threadScratch();
+    if (s.r0.size() < n) {
+        s.r0.resize(n);
+        s.r1.resize(n);
+        s.r2.resize(n);
+        s.r3.resize(n);
+    }
+    std::uint32_t *r0 = s.r0.data(), *r1 = s.r1.data(), *r2 = s.r2.data(), *r3 = s.r3.data();
+    philox4x32Batch(first, n, stream, 0, key, r0, r1, r2, r3);
+
+    if (dist.kind == Distribution::Uniform) {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = nominal * (1.0 + tol * (2.0 * philoxToUnit(r0[i], r1[i]) - 1.0));
+        return;
+    }
+
+    const double sigmas = dist.sigmas > 0 ? dist.sigmas : 3.0;
+    const double scale = tol / sigmas;
+    for (std::size_t i = 0; i < n; ++i) {
+        double z = boxMuller(r0[i], r1[i], r2[i], r3[i]);
+        if (dist.kind == Distribution::TruncatedNormal && std::fabs(z) > sigmas) {
+            // 超出截斷範圍：以同一個樣本序號、下一個 round 的計數器重抽
+            const std::uint64_t c = first + i;
+            std::uint32_t round = 1;
+            for (; round <= MAX_REDRAW_ROUNDS && std::fabs(z) > sigmas; ++round) {
+                const std::uint32_t ctr[4] = { static_cast<std::uint32_t>(c), static_cast<std::uint32_t>(c >> 32),
+                                               stream, round };
+                std::uint32_t r[4];
+                philox4x32(ctr, key, r);
+                z = boxMuller(r[0], r[1], r[2], r[3]);
+            }
+            z = std::clamp(z, -sigmas, sigmas);
+        }
+        out[i] = nominal * (1.0 + scale * z);
+    }
+}
+
+double MonteCarloResult::percentile(double p) const
+{
+    const std::uint64_t valid = samples - invalid;
+    if (valid == 0) return std::numeric_limits<double>::quiet_NaN();
+    p = std::clamp(p, 0.0, 1.0);
+    const double target = p * static_cast<double>(valid);
+
+    // 直方圖範圍外的部分以極值與範圍邊界線性內插
+    double cum = static_cast<double>(underflow);
+    if (target <= cum && underflow > 0) return min + (histMin - min) * (target / cum);
+
+    const double width = histogram.empty() ? 0 : (histMax - histMin) / static_cast<double>(histogram.size());
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+        const double h = static_cast<double>(histogram[i]);
+        if (h > 0 && cum + h >= target) {
+            const double x = histMin + (static_cast<double>(i) + (target - cum) / h) * width;
+            return std::clamp(x, min, max);
+        }
+        cum += h;
+    }
+    if (overflow > 0) return std::clamp(histMax + (max - histMax) * ((target - cum) / overflow), min, max);
+    return max;
+}
+
+MonteCarloResult runMonteCarlo(const std::vector<InputDistribution> &inputs, const MonteCarloModel &model,
+                               const MonteCarloOptions &options, const MonteCarloProgress &progress)
+{
+    const Clock::time_point start = Clock::now();
+    MonteCarloResult result;
+    const std::size_t bins = std::max<std::size_t>(options.bins, 1);
+    result.histogram.assign(bins, 0);
+    result.histMin = options.histMin;
+    result.histMax = options.histMax;
+    if (!model || options.samples == 0) {
+        result.complete = true;
+        return result;
+    }
+
+    // 每段取 BLOCK_SAMPLES 的整數倍，區塊邊界與段落無關，統計結果才不受 chunkSamples 影響
+    const std::uint64_t chunk = std::max<std::uint64_t>(
+        (options.chunkSamples + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES, 1) * BLOCK_SAMPLES;
+    const std::size_t inputCount = inputs.size();
+    bool rangeSet = options.histMax > options.histMin;
+
+    // 第 first ~ first+n-1 個樣本 (n <= BLOCK_SAMPLES) 的取樣 + 公式
+    auto evalBlock = [&](std::uint64_t first, std::size_t n, double *out) {
+        Scratch &s = threadScratch();
+        s.reserve(inputCount);
+        for (std::size_t j = 0; j < inputCount; ++j) {
+            double *dst = s.inputs.data() + j * BLOCK_SAMPLES;
+            sampleDistribution(inputs[j], options.seed, static_cast<std::uint32_t>(j), first, n, dst);
+            s.inputPtrs[j] = dst;
+        }
+        model(s.inputPtrs.data(), out, n);
+    };
+
+    // 直方圖範圍：前 PILOT_SAMPLES 個樣本的極值左右各留 5%。
+    // 試算區塊固定，與 chunkSamples、執行緒數無關，之後各段的分區間計數才會相同
+    std::vector<double> values;
+    if (!rangeSet) {
+        const std::size_t pilot = static_cast<std::size_t>(std::min<std::uint64_t>(PILOT_SAMPLES, options.samples));
+        const std::size_t blocks = (pilot + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES;
+        values.resize(pilot);
+        parallelFor(blocks, options.threads, [&](std::size_t b) {
+            const std::size_t offset = b * BLOCK_SAMPLES;
+            evalBlock(offset, std::min(BLOCK_SAMPLES, pilot - offset), values.data() + offset);
+        });
+        double lo = std::numeric_limits<double>::infinity(), hi = -lo;
+        for (double v : values) {
+            if (!std::isfinite(v)) continue;
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+        }
+        if (lo <= hi) {
+            double span = hi - lo;
+            if (!(span > 0)) span = std::max(std::fabs(hi) * 1e-6, 1e-12);
+            result.histMin = lo - span * 0.05;
+            result.histMax = hi + span * 0.05;
+            rangeSet = true;
+        }
+    }
+
+    BlockStats total;
+    std::vector<BlockStats> blockStats;
+    std::vector<std::uint64_t> blockHist;       // 每個區塊 bins + 2 (underflow、overflow)
+
+    for (std::uint64_t chunkStart = 0; chunkStart < options.samples; chunkStart += chunk) {
+        if (options.cancel && options.cancel->load(std::memory_order_relaxed)) break;
+
+        const std::size_t count = static_cast<std::size_t>(std::min(chunk, options.samples - chunkStart));
+        const std::size_t blocks = (count + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES;
+        values.resize(count);
+        blockStats.assign(blocks, BlockStats());
+
+        // 1. 取樣 + 公式 + 區塊統計
+        parallelFor(blocks, options.threads, [&](std::size_t b) {
+            const std::size_t offset = b * BLOCK_SAMPLES;
+            const std::size_t n = std::min(BLOCK_SAMPLES, count - offset);
+            double *out = values.data() + offset;
+            evalBlock(chunkStart + offset, n, out);
+
+            BlockStats &st = blockStats[b];
+            for (std::size_t i = 0; i < n; ++i) {
+                const double v = out[i];
+                if (!std::isfinite(v)) {
+                    ++st.invalid;
+                    continue;
+                }
+                ++st.valid;
+                const double delta = v - st.mean;
+                st.mean += delta / static_cast<double>(st.valid);
+                st.m2 += delta * (v - st.mean);
+                st.min = std::min(st.min, v);
+                st.max = std::max(st.max, v);
+                if (v >= options.specMin && v <= options.specMax) ++st.inSpec;
+            }
+        });
+
+        for (const BlockStats &st : blockStats) mergeStats(total, st);
+
+        // 2. 分區間計數 (整數加總，順序不影響結果)
+        if (rangeSet) {
+            const double lo = result.histMin;
+            const double scale = static_cast<double>(bins) / (result.histMax - result.histMin);
+            blockHist.assign(blocks * (bins + 2), 0);
+            parallelFor(blocks, options.threads, [&](std::size_t b) {
+                const std::size_t offset = b * BLOCK_SAMPLES;
+                const std::size_t n = std::min(BLOCK_SAMPLES, count - offset);
+                std::uint64_t *h = blockHist.data() + b * (bins + 2);
+                for (std::size_t i = 0; i < n; ++i) {
+                    const double v = values[offset + i];
+                    if (!std::isfinite(v)) continue;
+                    const double x = (v - lo) * scale;
+                    if (x < 0) ++h[bins];
+                    else if (x >= static_cast<double>(bins)) ++h[bins + 1];
+                    else ++h[static_cast<std::size_t>(x)];
+                }
+            });
+            for (std::size_t b = 0; b < blocks; ++b) {
+                const std::uint64_t *h = blockHist.data() + b * (bins + 2);
+                for (std::size_t k = 0; k < bins; ++k) result.histogram[k] += h[k];
+                result.underflow += h[bins];
+                result.overflow += h[bins + 1];
+            }
+        }
+
+        result.samples += count;
+        result.invalid = total.invalid;
+        result.inSpec = total.inSpec;
+        result.mean = total.mean;
+        result.stddev = total.valid > 1 ? std::sqrt(total.m2 / static_cast<double>(total.valid - 1)) : 0.0;
+        result.min = total.min;
+        result.max = total.max;
+        result.complete = result.samples == options.samples;
+        result.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (progress) progress(result);
+    }
+
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+// --- 各計算頁的公式 ---
+
+MonteCarloModel dividerVoModel()
+{
+    return [](const double *const *in, double *out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = dividerVo(in[0][i], in[1][i], in[2][i]);
+    };
+}
+
+MonteCarloModel ledBranchCurrentModel(int series, int parallel)
+{
+    const double s = series > 0 ? series : 1;
+    const double p = parallel > 0 ? parallel : 1;
+    return [s, p](const double *const *in, double *out, std::size_t n) {
+        // R = (Vcc - s * Vd) / (I * p) 的反算；電壓不足時 LED 不亮，電流為 0
+        for (std::size_t i = 0; i < n; ++i) {
+            const double headroom = in[0][i] - s * in[1][i];
+            out[i] = headroom > 0 ? headroom / (in[2][i] * p) : 0.0;
+        }
+    };
+}
+
+MonteCarloModel traceTempRiseModel(double k)
+{
+    return [k](const double *const *in, double *out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = traceTempRise(in[0][i], in[1][i], in[2][i], k);
+    };
+}
+
+MonteCarloModel viaTempRiseModel()
+{
+    return [](const double *const *in, double *out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = viaTempRise(in[0][i], viaArea(in[1][i], in[2][i]) * MM2_TO_SQMIL);
+    };
+}
+
+} // namespace sc
@@ -0,0 +1,110 @@
+#ifndef SC_MONTECARLO_H
+#define SC_MONTECARLO_H
+
+/**
+ * @file MonteCarlo.h
+ * @brief 元件公差的 Monte Carlo 分析 (分布、良率)，各計算頁共用
+ *
+ * 【 1. 輸入 】
+ * 每個輸入是「標稱值 + 相對公差 + 分布」，例如 1% 電阻 = 10k、0.01、截斷常態。
+ * 公式以批次函數 (struct-of-arrays) 提供，一次計算一個區塊的樣本。
+ *
+ * 【 2. 可重現 】
+ * 亂數使用 Philox4x32-10，第 i 個樣本的第 j 個輸入固定使用計數器 (i, j)，
+ * 所以相同的 seed 不論執行緒數量、進度回報的間隔，結果都逐位元相同。
+ *
+ * 【 3. 串流結果 】
+ * 每算完一段 (chunkSamples) 就以目前累積的統計呼叫進度回呼，GUI 可以看到分布逐漸收斂。
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace sc {
+
+enum class Distribution : std::uint8_t {
+    Fixed,              // 固定為標稱值
+    Uniform,            // 標稱值 ± 公差 內均勻分布
+    Normal,             // 常態分布，公差 = sigmas 個標準差
+    TruncatedNormal     // 同上，但截斷在 ± 公差 (出廠篩選過的元件)
+};
+
+struct InputDistribution {
+    Distribution kind = Distribution::Fixed;
+    double nominal = 0;
+    double tolerance = 0;       // 相對公差，0.01 = ±1%
+    double sigmas = 3;          // 常態分布時，公差對應幾個標準差
+};
+
+// 批次公式：inputs[j][i] 為第 i 個樣本的第 j 個輸入，結果寫入 out[i]；
+// 無效的結果 (例如 Vcc < Vd) 寫 NaN，會計入 invalid 且視為不良
+using MonteCarloModel = std::function<void(const double *const *inputs, double *out, std::size_t n)>;
+
+struct MonteCarloOptions {
+    std::uint64_t samples = 1000000;
+    std::uint64_t seed = 0;
+    unsigned threads = 0;                       // 0 = 全部硬體執行緒
+    std::size_t bins = 100;
+    double histMin = 0;                         // histMax <= histMin 時由前 65536 個樣本自動決定
+    double histMax = 0;
+    double specMin = -std::numeric_limits<double>::infinity();   // 良率的規格範圍
+    double specMax = std::numeric_limits<double>::infinity();
+    std::uint64_t chunkSamples = 1 << 18;       // 每段樣本數 (進度回報的間隔)
+    const std::atomic<bool> *cancel = nullptr;  // 外部取消 (可為 nullptr)
+};
+
+struct MonteCarloResult {
+    std::uint64_t samples = 0;      // 已完成的樣本數 (含無效)
+    std::uint64_t invalid = 0;      // 公式回傳 NaN / inf 的樣本
+    std::uint64_t inSpec = 0;       // 落在 [specMin, specMax] 的樣本
+    double mean = 0;
+    double stddev = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    double histMin = 0;
+    double histMax = 0;
+    std::vector<std::uint64_t> histogram;    // bins 個等寬區間
+    std::uint64_t underflow = 0;             // 小於 histMin 的有效樣本
+    std::uint64_t overflow = 0;              // 大於等於 histMax 的有效樣本
+
+    bool complete = false;          // 全部樣本都已完成 (未取消)
+    double elapsed_ms = 0;
+
+    double yield() const { return samples ? static_cast<double>(inSpec) / samples : 0.0; }
+
+    // 百分位數 (p = 0 ~ 1)，由直方圖線性內插，誤差在一個區間寬度以內
+    double percentile(double p) const;
+};
+
+using MonteCarloProgress = std::function<void(const MonteCarloResult &)>;
+
+MonteCarloResult runMonteCarlo(const std::vector<InputDistribution> &inputs, const MonteCarloModel &model,
+                               const MonteCarloOptions &options,
+                               const MonteCarloProgress &progress = MonteCarloProgress());
+
+// 產生第 first ~ first+n-1 個樣本的某個輸入 (stream = 輸入的序號)，runMonteCarlo 內部使用
+void sampleDistribution(const InputDistribution &dist, std::uint64_t seed, std::uint32_t stream,
+                        std::uint64_t first, std::size_t n, double *out);
+
+// --- 各計算頁的公式 ---
+
+// 分壓：inputs = { Vi, R1, R2 }，輸出 Vo
+MonteCarloModel dividerVoModel();
+
+// LED：inputs = { Vcc, Vd, R }，輸出每一串的電流 (A)
+MonteCarloModel ledBranchCurrentModel(int series, int parallel);
+
+// 走線：inputs = { 電流 (A), 線寬 (mm), 銅厚 (mm) }，輸出溫升 (°C)
+MonteCarloModel traceTempRiseModel(double k);
+
+// 貫孔：inputs = { 電流 (A), 孔徑 (mm), 孔壁厚 (mm) }，輸出溫升 (°C)
+MonteCarloModel viaTempRiseModel();
+
+} // namespace sc
+
+#endif // SC_MONTECARLO_H
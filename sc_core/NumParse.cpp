@@ -0,0 +1,156 @@
+/**
+ * @file NumParse.cpp
+ * @brief 與語系無關的浮點數解析
+ *
+ * 快速路徑 (Clinger)：有效位數 <= 15 且 10 的次方在 ±22 以內時，
+ * 尾數與 10^e 都能以 double 精確表示，一次乘/除即為正確捨入的結果。
+ * 其餘情況 (很長的尾數、極大/極小指數) 交給 classic locale 的 stream 解析；
+ * 超出 double 範圍的數字與 QString::toDouble 一樣視為失敗。
+ */
+
+#include "NumParse.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <locale>
+#include <sstream>
+#include <string>
+
+namespace sc {
+
+namespace {
+
+constexpr double POW10_EXACT[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+// 超出 double 範圍 (溢位) 時 stream 設 failbit 並給 ±DBL_MAX，當成解析失敗
+bool slowParse(const char *first, const char *last, double &out)
+{
+    std::istringstream ss(std::string(first, last));
+    ss.imbue(std::locale::classic());
+    double v = 0;
+    ss >> v;
+    if (ss.fail() || !std::isfinite(v)) return false;
+    out = v;
+    return true;
+}
+
+} // namespace
+
+const char *parseDouble(const char *first, const char *last, double &out)
+{
+    const char *p = first;
+    bool negative = false;
+    if (p != last && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;          // 已累計的有效位數
+    int dropped = 0;         // 超過 19 位而捨棄的整數位數
+    int fracExp = 0;         // 小數位數造成的負次方
+    bool any = false;
+
+    while (p != last && isDigit(*p)) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            if (mantissa) ++digits;
+        } else {
+            ++dropped;
+        }
+        ++p;
+    }
+    if (p != last && *p == '.') {
+        ++p;
+        while (p != last && isDigit(*p)) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                if (mantissa) ++digits;
+                --fracExp;
+            }
+            ++p;
+        }
+    }
+    if (!any) return first;
+
+    int exp10 = 0;
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool expNeg = false;
+        if (q != last && (*q == '+' || *q == '-')) {
+            expNeg = (*q == '-');
+            ++q;
+        }
+        if (q != last && isDigit(*q)) {
+            int e = 0;
+            while (q != last && isDigit(*q)) {
+                if (e < 100000) e = e * 10 + (*q - '0');
+                ++q;
+            }
+            exp10 = expNeg ? -e : e;
+            p = q;
+        }
+        // 'e' 後面沒有數字：只吃到 'e' 之前
+    }
+
+    int totalExp = exp10 + fracExp + dropped;
+    if (digits <= 15 && dropped == 0 && totalExp >= -22 && totalExp <= 22) {
+        double v = static_cast<double>(mantissa);
+        v = (totalExp < 0) ? v / POW10_EXACT[-totalExp] : v * POW10_EXACT[totalExp];
+        out = negative ? -v : v;
+    } else if (mantissa == 0) {
+        out = negative ? -0.0 : 0.0;
+    } else if (!slowParse(first, p, out)) {
+        return first;
+    }
+    return p;
+}
+
+bool parseNumber(std::string_view text, double &out)
+{
+    const char *first = text.data();
+    const char *last = first + text.size();
+    while (first != last && isSpace(*first)) ++first;
+    while (last != first && isSpace(last[-1])) --last;
+    if (first == last) return false;
+
+    double v = 0;
+    const char *end = parseDouble(first, last, v);
+    if (end == first || end != last) return false;
+    out = v;
+    return true;
+}
+
+char *formatDouble(char *buf, double value)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::to_chars_result r = std::to_chars(buf, buf + FORMAT_BUFFER_SIZE, value);
+    if (r.ec == std::errc()) return r.ptr;
+#endif
+    // 舊版標準函式庫沒有浮點數 to_chars：以 17 位有效數字保證可還原，
+    // 再把語系可能使用的 ',' 換回 '.'
+    int len = std::snprintf(buf, FORMAT_BUFFER_SIZE, "%.17g", value);
+    if (len < 0) len = 0;
+    if (len >= FORMAT_BUFFER_SIZE) len = FORMAT_BUFFER_SIZE - 1;
+    for (int i = 0; i < len; ++i) {
+        if (buf[i] == ',') buf[i] = '.';
+    }
+    return buf + len;
+}
+
+} // namespace sc
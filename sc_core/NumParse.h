@@ -0,0 +1,23 @@
+#ifndef SC_NUMPARSE_H
+#define SC_NUMPARSE_H
+
+#include <string_view>
+
+namespace sc {
+
+// 與語系無關的十進位浮點數解析 (小數點固定為 '.')
+// 解析 [first, last) 開頭的數字，成功時寫入 out 並回傳數字之後的位置，
+// 失敗 (含超出 double 範圍) 回傳 first。不接受前導空白。
+const char *parseDouble(const char *first, const char *last, double &out);
+
+// 整段字串 (允許前後空白) 必須是一個數字，行為同 QString::toDouble
+bool parseNumber(std::string_view text, double &out);
+
+// 以最短且可還原的十進位格式輸出 (與語系無關)，回傳寫入結尾
+// buf 至少需要 FORMAT_BUFFER_SIZE 個字元
+constexpr int FORMAT_BUFFER_SIZE = 32;
+char *formatDouble(char *buf, double value);
+
+} // namespace sc
+
+#endif // SC_NUMPARSE_H
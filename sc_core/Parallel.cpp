@@ -0,0 +1,57 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sc {
+
+unsigned hardwareThreads()
+{
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+void parallelFor(std::size_t count, unsigned threads, const std::function<void(std::size_t)> &fn)
+{
+    if (count == 0) return;
+    if (threads == 0) threads = hardwareThreads();
+    std::size_t workers = std::min<std::size_t>(threads, count);
+
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&] {
+        for (;;) {
+            std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) return;
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) firstError = std::current_exception();
+                next.store(count, std::memory_order_relaxed);   // 停止分配新工作
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t t = 0; t + 1 < workers; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread &th : pool) th.join();
+
+    if (firstError) std::rethrow_exception(firstError);
+}
+
+} // namespace sc
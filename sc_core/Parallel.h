@@ -0,0 +1,19 @@
+#ifndef SC_PARALLEL_H
+#define SC_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace sc {
+
+// 可用的硬體執行緒數 (至少 1)
+unsigned hardwareThreads();
+
+// 平行執行 fn(0) ... fn(count - 1)，以原子計數器動態分配工作。
+// threads 為 0 時使用 hardwareThreads()；呼叫端執行緒也會參與計算。
+// fn 必須是執行緒安全的；若 fn 擲出例外，第一個例外會在所有工作結束後重新擲出。
+void parallelFor(std::size_t count, unsigned threads, const std::function<void(std::size_t)> &fn);
+
+} // namespace sc
+
+#endif // SC_PARALLEL_H
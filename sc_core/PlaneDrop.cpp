@@ -0,0 +1,774 @@
+/**
+ * @file PlaneDrop.cpp
+ * @brief 鋪銅 IR drop：多邊形光柵化 + 電阻網路 (多重網格預條件共軛梯度)
+ *
+ * 【 1. 光柵化 】
+ * 外框範圍切成邊長 cell 的正方形格子，每一列以格心的 y 做掃描線：
+ * 求出所有外框 / 挖空邊與掃描線的交點，排序後奇偶配對，配對之間的格心就是銅。
+ * 各列互不相依，以列區塊分給多個執行緒。過孔的鑽孔 (格心在孔內) 再挖掉。
+ *
+ * 【 2. 電阻網路 】
+ * 正方形格子之間的電導就是片電導 σ = t / ρ(T) (與格子大小無關)，ρ 與走線頁相同：
+ * ρ = ρ20 * (1 + α (T - 20))。電源焊墊的格子固定為 0 V (消去，鄰格的電導加在對角線)，
+ * 負載焊墊的電流平均分給焊墊內的格子，過孔的電流分給孔壁周圍 (孔緣 1.5 格內) 的格子。
+ * 從電源做洪水填充，沒有連到電源的銅島在系統內的 diag 設為 0 (不參與計算)。
+ * 解的是相對電源的壓降 u：A u = I (抽出的電流為正)。
+ *
+ * 【 3. 求解 】
+ * 五點格式的對稱正定系統交給 GridSolver：線鬆弛 W-cycle 多重網格預條件的共軛梯度法，
+ * 迭代次數與網格大小無關 (不完全 Cholesky 的迭代數會隨格數的平方根增加，且三角求解無法平行)；
+ * 殘差、平滑、矩陣乘法在大網格時以列區塊平行。數百萬格約數秒。
+ *
+ * 【 4. 輸出 】
+ * 每格的電流密度取兩側面電流的平均 (x、y 分量)，除以面積 cell * t。
+ * 熱點：把網格切成邊長約為最小距離的方塊，取各方塊的最大值，由大到小挑出彼此距離夠遠的點。
+ */
+
+#include "PlaneDrop.h"
+#include "BufferedWriter.h"
+#include "GridSolver.h"
+#include "NumParse.h"
+#include "Parallel.h"
+#include "TraceCalc.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace sc {
+
+namespace {
+
+constexpr double MM_PER_MIL = 0.0254;
+constexpr double MM_PER_INCH = 25.4;
+
+// 過孔電流分給孔緣往外這麼多格以內的格子
+constexpr double VIA_RING_CELLS = 1.5;
+
+// 光柵化、電流密度每個工作區塊的列數
+constexpr int ROWS_PER_BLOCK = 64;
+
+// 熱點最小距離的預設值 (外框範圍的比例)
+constexpr double HOTSPOT_SEPARATION_FRACTION = 0.05;
+
+enum CellType : unsigned char { EMPTY, COPPER, SOURCE };
+
+bool unitScale(std::string_view name, double &scale)
+{
+    if (name == "mm") scale = 1;
+    else if (name == "mil" || name == "mils") scale = MM_PER_MIL;
+    else if (name == "inch" || name == "in") scale = MM_PER_INCH;
+    else return false;
+    return true;
+}
+
+// ---------------- 文字格式 ----------------
+
+// 逗號也當作空白
+std::vector<std::string_view> tokens(std::string_view line)
+{
+    std::vector<std::string_view> out;
+    std::size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && (std::isspace(static_cast<unsigned char>(line[i])) || line[i] == ',')) ++i;
+        const std::size_t s = i;
+        while (i < line.size() && !std::isspace(static_cast<unsigned char>(line[i])) && line[i] != ',') ++i;
+        if (i > s) out.push_back(line.substr(s, i - s));
+    }
+    return out;
+}
+
+bool parseText(std::string_view text, PlaneLayout &layout, std::string &error)
+{
+    double scale = 1;
+    std::size_t lineNo = 0;
+    std::size_t p = 0;
+    while (p < text.size()) {
+        std::size_t e = text.find('\n', p);
+        if (e == std::string_view::npos) e = text.size();
+        std::string_view line = text.substr(p, e - p);
+        p = e + 1;
+        ++lineNo;
+        const std::size_t hash = line.find('#');
+        if (hash != std::string_view::npos) line = line.substr(0, hash);
+        const std::vector<std::string_view> t = tokens(line);
+        if (t.empty()) continue;
+
+        auto fail = [&](const std::string &what) {
+            error = "line " + std::to_string(lineNo) + ": " + what;
+            return false;
+        };
+        std::vector<double> v(t.size() - 1);
+        for (std::size_t i = 1; i < t.size(); ++i) {
+            if (t[0] == "units") break;
+            if (!parseNumber(t[i], v[i - 1])) return fail("'" + std::string(t[i]) + "' is not a number");
+        }
+        const std::string_view key = t[0];
+        if (key == "units") {
+            if (t.size() != 2 || !unitScale(t[1], scale)) return fail("units must be mm, mil or inch");
+        } else if (key == "oz" || key == "thickness" || key == "temperature") {
+            if (v.size() != 1) return fail(std::string(key) + " needs one value");
+            if (key == "oz") layout.thickness_mm = v[0] * COPPER_MM_PER_OZ;
+            else if (key == "thickness") layout.thickness_mm = v[0] * scale;
+            else layout.temperature_C = v[0];
+        } else if (key == "outline" || key == "hole") {
+            if (v.size() < 6 || v.size() % 2) return fail(std::string(key) + " needs at least 3 x,y vertices");
+            std::vector<PlanePoint> poly;
+            for (std::size_t i = 0; i < v.size(); i += 2) poly.push_back({ v[i] * scale, v[i + 1] * scale });
+            (key == "outline" ? layout.outlines : layout.holes).push_back(std::move(poly));
+        } else if (key == "source") {
+            if (v.size() != 3) return fail("source needs x y diameter");
+            layout.sources.push_back({ v[0] * scale, v[1] * scale, v[2] * scale, 0 });
+        } else if (key == "sink" || key == "via") {
+            if (v.size() != 4) return fail(std::string(key) + " needs x y diameter current");
+            (key == "sink" ? layout.sinks : layout.vias).push_back({ v[0] * scale, v[1] * scale, v[2] * scale, v[3] });
+        } else {
+            return fail("unknown keyword '" + std::string(key) + "'");
+        }
+    }
+    return true;
+}
+
+// ---------------- JSON ----------------
+
+struct JsonValue {
+    enum Type { Null, Number, String, Array, Object } type = Null;
+    double number = 0;
+    std::string_view text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string_view, JsonValue>> members;
+    std::size_t line = 0;
+
+    const JsonValue *member(std::string_view name) const
+    {
+        for (const auto &m : members) {
+            if (m.first == name) return &m.second;
+        }
+        return nullptr;
+    }
+};
+
+// 遞迴下降的 JSON 解析 (字串的跳脫字元不還原；佈局檔只用到數字與簡單的鍵)
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string_view input) : p(input.data()), end(input.data() + input.size()) {}
+
+    std::string error;
+
+    bool parseDocument(JsonValue &out)
+    {
+        if (!parseValue(out, 0)) return false;
+        skipSpace();
+        return p == end || fail("unexpected text after the document");
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 16;
+    const char *p;
+    const char *end;
+    std::size_t line = 1;
+
+    void skipSpace()
+    {
+        for (; p < end; ++p) {
+            if (*p == '\n') ++line;
+            else if (*p != ' ' && *p != '\t' && *p != '\r') break;
+        }
+    }
+
+    bool fail(const char *what)
+    {
+        error = "line " + std::to_string(line) + ": " + what;
+        return false;
+    }
+
+    bool parseString(std::string_view &out)
+    {
+        ++p;
+        const char *s = p;
+        while (p < end && *p != '"') {
+            if (*p == '\\') ++p;
+            else if (*p == '\n') return fail("unterminated string");
+            ++p;
+        }
+        if (p >= end) return fail("unterminated string");
+        out = std::string_view(s, static_cast<std::size_t>(p - s));
+        ++p;
+        return true;
+    }
+
+    bool parseValue(JsonValue &out, int depth)
+    {
+        if (depth > MAX_DEPTH) return fail("nested too deeply");
+        skipSpace();
+        out.line = line;
+        if (p >= end) return fail("expected a value");
+        if (*p == '"') {
+            out.type = JsonValue::String;
+            return parseString(out.text);
+        }
+        if (*p == '[' || *p == '{') {
+            const bool object = (*p == '{');
+            const char close = object ? '}' : ']';
+            out.type = object ? JsonValue::Object : JsonValue::Array;
+            ++p;
+            skipSpace();
+            if (p < end && *p == close) {
+                ++p;
+                return true;
+            }
+            for (;;) {
+                skipSpace();
+                if (object) {
+                    std::string_view key;
+                    if (p >= end || *p != '"') return fail("expected a key");
+                    if (!parseString(key)) return false;
+                    skipSpace();
+                    if (p >= end || *p != ':') return fail("expected ':'");
+                    ++p;
+                    out.members.emplace_back(key, JsonValue());
+                    if (!parseValue(out.members.back().second, depth + 1)) return false;
+                } else {
+                    out.items.emplace_back();
+                    if (!parseValue(out.items.back(), depth + 1)) return false;
+                }
+                skipSpace();
+                if (p < end && *p == close) {
+                    ++p;
+                    return true;
+                }
+                if (p >= end || *p != ',') return fail(object ? "expected ',' or '}'" : "expected ',' or ']'");
+                ++p;
+            }
+        }
+        const char *s = p;
+        while (p < end && *p != ',' && *p != '}' && *p != ']' && !std::isspace(static_cast<unsigned char>(*p))) ++p;
+        const std::string_view word(s, static_cast<std::size_t>(p - s));
+        if (word == "null") return true;
+        out.type = JsonValue::Number;
+        return parseNumber(word, out.number) || fail("expected a number");
+    }
+};
+
+bool jsonFail(const JsonValue &v, const std::string &what, std::string &error)
+{
+    error = "line " + std::to_string(v.line) + ": " + what;
+    return false;
+}
+
+// 數字或數字字串
+bool jsonNumber(const JsonValue &v, double &out)
+{
+    if (v.type == JsonValue::Number) {
+        out = v.number;
+        return true;
+    }
+    return v.type == JsonValue::String && parseNumber(v.text, out);
+}
+
+bool jsonPolygon(const JsonValue &v, double scale, std::vector<PlanePoint> &poly, std::string &error)
+{
+    if (v.type != JsonValue::Array || v.items.size() < 3)
+        return jsonFail(v, "a polygon needs at least 3 [x, y] vertices", error);
+    for (const JsonValue &pt : v.items) {
+        double x, y;
+        if (pt.type != JsonValue::Array || pt.items.size() != 2 || !jsonNumber(pt.items[0], x)
+            || !jsonNumber(pt.items[1], y))
+            return jsonFail(pt, "a vertex must be [x, y]", error);
+        poly.push_back({ x * scale, y * scale });
+    }
+    return true;
+}
+
+// "outline": 單一多邊形 [[x,y],...] 或多邊形陣列 [[[x,y],...],...]
+bool jsonPolygons(const JsonValue &v, double scale, std::vector<std::vector<PlanePoint>> &out, std::string &error)
+{
+    const bool many = v.type == JsonValue::Array && !v.items.empty() && !v.items[0].items.empty()
+                      && v.items[0].items[0].type == JsonValue::Array;
+    if (!many) {
+        out.emplace_back();
+        return jsonPolygon(v, scale, out.back(), error);
+    }
+    for (const JsonValue &poly : v.items) {
+        out.emplace_back();
+        if (!jsonPolygon(poly, scale, out.back(), error)) return false;
+    }
+    return true;
+}
+
+bool jsonPads(const JsonValue &v, double scale, const char *diameterKey, bool needCurrent,
+              std::vector<PlanePad> &out, std::string &error)
+{
+    if (v.type != JsonValue::Array) return jsonFail(v, "expected an array of pads", error);
+    for (const JsonValue &pad : v.items) {
+        if (pad.type != JsonValue::Object) return jsonFail(pad, "a pad must be an object", error);
+        const JsonValue *x = pad.member("x");
+        const JsonValue *y = pad.member("y");
+        const JsonValue *d = pad.member(diameterKey);
+        if (!d) d = pad.member("diameter");
+        const JsonValue *i = pad.member("current");
+        PlanePad p{ 0, 0, 0, 0 };
+        if (!x || !y || !d || !jsonNumber(*x, p.x_mm) || !jsonNumber(*y, p.y_mm) || !jsonNumber(*d, p.diameter_mm))
+            return jsonFail(pad, std::string("a pad needs numeric x, y and ") + diameterKey, error);
+        if (needCurrent && (!i || !jsonNumber(*i, p.current_A)))
+            return jsonFail(pad, "a sink needs a numeric current", error);
+        if (!needCurrent && i) jsonNumber(*i, p.current_A);
+        p.x_mm *= scale;
+        p.y_mm *= scale;
+        p.diameter_mm *= scale;
+        out.push_back(p);
+    }
+    return true;
+}
+
+bool parseJson(std::string_view text, PlaneLayout &layout, std::string &error)
+{
+    JsonValue doc;
+    JsonParser parser(text);
+    if (!parser.parseDocument(doc)) {
+        error = parser.error;
+        return false;
+    }
+    if (doc.type != JsonValue::Object) return jsonFail(doc, "the document must be an object", error);
+
+    double scale = 1;
+    if (const JsonValue *u = doc.member("units")) {
+        if (u->type != JsonValue::String || !unitScale(u->text, scale))
+            return jsonFail(*u, "units must be mm, mil or inch", error);
+    }
+    double value;
+    if (const JsonValue *v = doc.member("oz")) {
+        if (!jsonNumber(*v, value)) return jsonFail(*v, "oz must be a number", error);
+        layout.thickness_mm = value * COPPER_MM_PER_OZ;
+    }
+    if (const JsonValue *v = doc.member("thickness")) {
+        if (!jsonNumber(*v, value)) return jsonFail(*v, "thickness must be a number", error);
+        layout.thickness_mm = value * scale;
+    }
+    if (const JsonValue *v = doc.member("temperature")) {
+        if (!jsonNumber(*v, layout.temperature_C)) return jsonFail(*v, "temperature must be a number", error);
+    }
+    for (const char *key : { "outline", "outlines" }) {
+        if (const JsonValue *v = doc.member(key)) {
+            if (!jsonPolygons(*v, scale, layout.outlines, error)) return false;
+        }
+    }
+    for (const char *key : { "hole", "holes" }) {
+        if (const JsonValue *v = doc.member(key)) {
+            if (!jsonPolygons(*v, scale, layout.holes, error)) return false;
+        }
+    }
+    if (const JsonValue *v = doc.member("sources")) {
+        if (!jsonPads(*v, scale, "d", false, layout.sources, error)) return false;
+    }
+    if (const JsonValue *v = doc.member("sinks")) {
+        if (!jsonPads(*v, scale, "d", true, layout.sinks, error)) return false;
+    }
+    if (const JsonValue *v = doc.member("vias")) {
+        if (!jsonPads(*v, scale, "drill", false, layout.vias, error)) return false;
+    }
+    return true;
+}
+
+// ---------------- 網格 ----------------
+
+struct Grid {
+    int nx;
+    int ny;
+    double x0;
+    double y0;
+    double h;
+
+    double cx(int i) const { return x0 + (i + 0.5) * h; }
+    double cy(int j) const { return y0 + (j + 0.5) * h; }
+    std::size_t index(int i, int j) const { return static_cast<std::size_t>(j) * nx + i; }
+};
+
+void forRowBlocks(int ny, unsigned threads, const std::function<void(int, int)> &fn)
+{
+    const std::size_t blocks = static_cast<std::size_t>((ny + ROWS_PER_BLOCK - 1) / ROWS_PER_BLOCK);
+    parallelFor(blocks, threads, [&](std::size_t b) {
+        const int j0 = static_cast<int>(b) * ROWS_PER_BLOCK;
+        fn(j0, std::min(ny, j0 + ROWS_PER_BLOCK));
+    });
+}
+
+// 奇偶規則的掃描線填充
+void rasterize(const PlaneLayout &layout, const Grid &g, unsigned threads, std::vector<unsigned char> &type)
+{
+    struct Edge {
+        double x1, y1, x2, y2;
+    };
+    std::vector<Edge> edges;
+    for (const auto *polys : { &layout.outlines, &layout.holes }) {
+        for (const std::vector<PlanePoint> &poly : *polys) {
+            for (std::size_t k = 0; k < poly.size(); ++k) {
+                const PlanePoint &a = poly[k];
+                const PlanePoint &b = poly[(k + 1) % poly.size()];
+                if (a.y != b.y) edges.push_back({ a.x, a.y, b.x, b.y });
+            }
+        }
+    }
+
+    forRowBlocks(g.ny, threads, [&](int j0, int j1) {
+        std::vector<double> xs;
+        for (int j = j0; j < j1; ++j) {
+            const double y = g.cy(j);
+            xs.clear();
+            for (const Edge &e : edges) {
+                if ((e.y1 <= y) != (e.y2 <= y)) xs.push_back(e.x1 + (y - e.y1) * (e.x2 - e.x1) / (e.y2 - e.y1));
+            }
+            std::sort(xs.begin(), xs.end());
+            for (std::size_t k = 0; k + 1 < xs.size(); k += 2) {
+                // 格心在 [xs[k], xs[k + 1]) 內的格子
+                const int i0 = std::max(0, static_cast<int>(std::ceil((xs[k] - g.x0) / g.h - 0.5)));
+                const int i1 = std::min(g.nx, static_cast<int>(std::ceil((xs[k + 1] - g.x0) / g.h - 0.5)));
+                for (int i = i0; i < i1; ++i) type[g.index(i, j)] ^= COPPER;
+            }
+        }
+    });
+}
+
+// 格心離 (x, y) 的距離在 [rIn, rOut) 內的格子
+template <typename Fn>
+void forCellsInRing(const Grid &g, double x, double y, double rIn, double rOut, Fn fn)
+{
+    const int i0 = std::max(0, static_cast<int>(std::floor((x - rOut - g.x0) / g.h)));
+    const int i1 = std::min(g.nx - 1, static_cast<int>(std::floor((x + rOut - g.x0) / g.h)));
+    const int j0 = std::max(0, static_cast<int>(std::floor((y - rOut - g.y0) / g.h)));
+    const int j1 = std::min(g.ny - 1, static_cast<int>(std::floor((y + rOut - g.y0) / g.h)));
+    for (int j = j0; j <= j1; ++j) {
+        for (int i = i0; i <= i1; ++i) {
+            const double r = std::hypot(g.cx(i) - x, g.cy(j) - y);
+            if (r >= rIn && r < rOut) fn(g.index(i, j));
+        }
+    }
+}
+
+// 焊墊涵蓋的銅格；焊墊比格子小而沒有涵蓋任何格心時，取焊墊範圍 (外加一格) 內最近的銅格
+std::vector<std::size_t> padCells(const Grid &g, const std::vector<unsigned char> &type, const PlanePad &pad)
+{
+    std::vector<std::size_t> cells;
+    const double r = 0.5 * pad.diameter_mm;
+    forCellsInRing(g, pad.x_mm, pad.y_mm, 0, r, [&](std::size_t k) {
+        if (type[k] != EMPTY) cells.push_back(k);
+    });
+    if (cells.empty()) {
+        double best = std::numeric_limits<double>::infinity();
+        forCellsInRing(g, pad.x_mm, pad.y_mm, 0, r + g.h, [&](std::size_t k) {
+            const int i = static_cast<int>(k % g.nx);
+            const int j = static_cast<int>(k / g.nx);
+            const double d = std::hypot(g.cx(i) - pad.x_mm, g.cy(j) - pad.y_mm);
+            if (type[k] != EMPTY && d < best) {
+                best = d;
+                cells.assign(1, k);
+            }
+        });
+    }
+    return cells;
+}
+
+// 從電源格做洪水填充，標記相連的銅
+std::vector<unsigned char> connectedCopper(const Grid &g, const std::vector<unsigned char> &type)
+{
+    const std::size_t n = type.size();
+    std::vector<unsigned char> reached(n, 0);
+    std::vector<std::size_t> stack;
+    for (std::size_t k = 0; k < n; ++k) {
+        if (type[k] == SOURCE) {
+            reached[k] = 1;
+            stack.push_back(k);
+        }
+    }
+    while (!stack.empty()) {
+        const std::size_t k = stack.back();
+        stack.pop_back();
+        const int i = static_cast<int>(k % g.nx);
+        const int j = static_cast<int>(k / g.nx);
+        auto visit = [&](std::size_t m) {
+            if (type[m] != EMPTY && !reached[m]) {
+                reached[m] = 1;
+                stack.push_back(m);
+            }
+        };
+        if (i > 0) visit(k - 1);
+        if (i + 1 < g.nx) visit(k + 1);
+        if (j > 0) visit(k - g.nx);
+        if (j + 1 < g.ny) visit(k + g.nx);
+    }
+    return reached;
+}
+
+// 負載 / 過孔的電流分給各格；回傳 false 代表落在沒有銅或不相連的地方
+bool injectCurrent(const std::vector<std::size_t> &cells, const std::vector<unsigned char> &type,
+                   const std::vector<unsigned char> &reached, double current, std::vector<double> &b,
+                   std::vector<std::size_t> &active)
+{
+    active.clear();
+    for (std::size_t k : cells) {
+        if (!reached[k]) return false;
+        if (type[k] == COPPER) active.push_back(k);
+    }
+    // 完全落在電源焊墊上的負載：電流直接流進電源，壓降為 0
+    for (std::size_t k : active) b[k] += current / static_cast<double>(active.size());
+    return !cells.empty();
+}
+
+double meanDrop(const std::vector<std::size_t> &cells, const std::vector<double> &u)
+{
+    if (cells.empty()) return 0;
+    double sum = 0;
+    for (std::size_t k : cells) sum += u[k];
+    return sum / static_cast<double>(cells.size());
+}
+
+std::vector<PlaneHotspot> findHotspots(const Grid &g, const std::vector<double> &density, int count, double separation)
+{
+    std::vector<PlaneHotspot> spots;
+    if (count <= 0) return spots;
+    const int tile = std::max(1, static_cast<int>(separation / g.h));
+    const int tx = (g.nx + tile - 1) / tile;
+    const int ty = (g.ny + tile - 1) / tile;
+    std::vector<PlaneHotspot> tiles;
+    for (int b = 0; b < ty; ++b) {
+        for (int a = 0; a < tx; ++a) {
+            PlaneHotspot best{ 0, 0, 0 };
+            for (int j = b * tile; j < std::min(g.ny, (b + 1) * tile); ++j) {
+                for (int i = a * tile; i < std::min(g.nx, (a + 1) * tile); ++i) {
+                    const double d = density[g.index(i, j)];
+                    if (d > best.density_A_per_mm2) best = { g.cx(i), g.cy(j), d };
+                }
+            }
+            if (best.density_A_per_mm2 > 0) tiles.push_back(best);
+        }
+    }
+    std::sort(tiles.begin(), tiles.end(), [](const PlaneHotspot &l, const PlaneHotspot &r) {
+        return l.density_A_per_mm2 > r.density_A_per_mm2;
+    });
+    for (const PlaneHotspot &c : tiles) {
+        bool farEnough = true;
+        for (const PlaneHotspot &s : spots) {
+            if (std::hypot(c.x_mm - s.x_mm, c.y_mm - s.y_mm) < separation) {
+                farEnough = false;
+                break;
+            }
+        }
+        if (farEnough) spots.push_back(c);
+        if (static_cast<int>(spots.size()) == count) break;
+    }
+    return spots;
+}
+
+} // namespace
+
+bool parsePlaneLayout(std::string_view text, PlaneLayout &layout, std::string &error)
+{
+    layout = PlaneLayout();
+    std::size_t i = 0;
+    while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i]))) ++i;
+    return (i < text.size() && text[i] == '{') ? parseJson(text, layout, error) : parseText(text, layout, error);
+}
+
+PlaneDropResult planeDropSolve(const PlaneLayout &layout, const PlaneDropOptions &options)
+{
+    PlaneDropResult result;
+    auto fail = [&](const std::string &what) {
+        result.error = what;
+        return result;
+    };
+    if (layout.outlines.empty()) return fail("no outline");
+    if (layout.sources.empty()) return fail("no source pad");
+    if (!(layout.thickness_mm > 0)) return fail("copper thickness must be positive");
+    for (const PlanePad &pad : layout.sources) {
+        if (!(pad.diameter_mm > 0)) return fail("pad diameters must be positive");
+    }
+    for (const auto *pads : { &layout.sinks, &layout.vias }) {
+        for (const PlanePad &pad : *pads) {
+            if (!(pad.diameter_mm > 0) || !std::isfinite(pad.current_A))
+                return fail("pad diameters must be positive and currents finite");
+        }
+    }
+
+    // ---- 網格 ----
+    double xMin = HUGE_VAL, yMin = HUGE_VAL, xMax = -HUGE_VAL, yMax = -HUGE_VAL;
+    for (const std::vector<PlanePoint> &poly : layout.outlines) {
+        for (const PlanePoint &pt : poly) {
+            xMin = std::min(xMin, pt.x);
+            xMax = std::max(xMax, pt.x);
+            yMin = std::min(yMin, pt.y);
+            yMax = std::max(yMax, pt.y);
+        }
+    }
+    if (!std::isfinite(xMax - xMin) || !std::isfinite(yMax - yMin) || !(xMax > xMin) || !(yMax > yMin))
+        return fail("the outline has no area");
+    const double width = xMax - xMin;
+    const double height = yMax - yMin;
+    const double h = (options.cell_mm > 0)
+                         ? options.cell_mm
+                         : std::sqrt(width * height / static_cast<double>(std::max<std::size_t>(options.targetCells, 1)));
+    const double nxD = std::ceil(width / h);
+    const double nyD = std::ceil(height / h);
+    if (nxD * nyD > static_cast<double>(options.maxCells))
+        return fail("the mesh would have " + std::to_string(static_cast<long long>(nxD * nyD))
+                    + " cells; use a larger cell size");
+    const Grid g{ static_cast<int>(nxD), static_cast<int>(nyD), xMin, yMin, h };
+    const std::size_t n = static_cast<std::size_t>(g.nx) * g.ny;
+    const unsigned threads = options.threads ? options.threads : hardwareThreads();
+    result.nx = g.nx;
+    result.ny = g.ny;
+    result.x0_mm = g.x0;
+    result.y0_mm = g.y0;
+    result.cell_mm = h;
+
+    // ---- 光柵化、鑽孔、電源 ----
+    std::vector<unsigned char> type(n, EMPTY);
+    rasterize(layout, g, threads, type);
+    for (const PlanePad &via : layout.vias) {
+        forCellsInRing(g, via.x_mm, via.y_mm, 0, 0.5 * via.diameter_mm, [&](std::size_t k) { type[k] = EMPTY; });
+    }
+    for (std::size_t s = 0; s < layout.sources.size(); ++s) {
+        const std::vector<std::size_t> cells = padCells(g, type, layout.sources[s]);
+        if (cells.empty()) return fail("source " + std::to_string(s + 1) + " is not on copper");
+        for (std::size_t k : cells) type[k] = SOURCE;
+    }
+    const std::vector<unsigned char> reached = connectedCopper(g, type);
+
+    // ---- 負載與過孔的電流 ----
+    std::vector<double> b(n, 0.0);
+    std::vector<std::vector<std::size_t>> sinkCells(layout.sinks.size()), viaCells(layout.vias.size());
+    for (std::size_t s = 0; s < layout.sinks.size(); ++s) {
+        const std::vector<std::size_t> cells = padCells(g, type, layout.sinks[s]);
+        if (!injectCurrent(cells, type, reached, layout.sinks[s].current_A, b, sinkCells[s]))
+            return fail("sink " + std::to_string(s + 1) + " is not on copper connected to a source");
+        result.totalCurrent_A += layout.sinks[s].current_A;
+    }
+    for (std::size_t v = 0; v < layout.vias.size(); ++v) {
+        const PlanePad &via = layout.vias[v];
+        const double r = 0.5 * via.diameter_mm;
+        std::vector<std::size_t> cells;
+        forCellsInRing(g, via.x_mm, via.y_mm, r, r + VIA_RING_CELLS * h, [&](std::size_t k) {
+            if (type[k] != EMPTY) cells.push_back(k);
+        });
+        if (!injectCurrent(cells, type, reached, via.current_A, b, viaCells[v]) && via.current_A != 0)
+            return fail("via " + std::to_string(v + 1) + " is not on copper connected to a source");
+        result.totalCurrent_A += via.current_A;
+    }
+
+    // ---- 電阻網路：相連的銅格之間的電導都是片電導 ----
+    const double rho_ohm_mm = COPPER_RHO_OHM_MM * (1 + COPPER_ALPHA * (layout.temperature_C - 20));
+    if (!(rho_ohm_mm > 0)) return fail("temperature is below the range of the copper resistivity model");
+    const double sigma = layout.thickness_mm / rho_ohm_mm;
+    result.sheetResistance_ohm = 1 / sigma;
+
+    GridSystem system;
+    system.nx = g.nx;
+    system.ny = g.ny;
+    system.gE.assign(n, 0.0);
+    system.gN.assign(n, 0.0);
+    system.diag.assign(n, 0.0);
+    forRowBlocks(g.ny, threads, [&](int j0, int j1) {
+        for (int j = j0; j < j1; ++j) {
+            for (int i = 0; i < g.nx; ++i) {
+                const std::size_t k = g.index(i, j);
+                if (!reached[k]) continue;
+                if (type[k] == COPPER) {
+                    int neighbours = 0;
+                    if (i > 0) neighbours += reached[k - 1];
+                    if (i + 1 < g.nx) neighbours += reached[k + 1];
+                    if (j > 0) neighbours += reached[k - g.nx];
+                    if (j + 1 < g.ny) neighbours += reached[k + g.nx];
+                    system.diag[k] = neighbours * sigma;
+                    if (i + 1 < g.nx && type[k + 1] == COPPER && reached[k + 1]) system.gE[k] = sigma;
+                    if (j + 1 < g.ny && type[k + g.nx] == COPPER && reached[k + g.nx]) system.gN[k] = sigma;
+                }
+            }
+        }
+    });
+    for (std::size_t k = 0; k < n; ++k) {
+        if (reached[k]) ++result.copperCells;
+        else if (type[k] != EMPTY) ++result.islandCells;
+    }
+
+    // ---- 求解 ----
+    std::vector<double> u(n, 0.0);
+    bool anyCurrent = false;
+    for (double v : b) {
+        if (v != 0) {
+            anyCurrent = true;
+            break;
+        }
+    }
+    if (anyCurrent) {
+        GridSolver solver(std::move(system), threads);
+        result.iterations = solver.solve(b, u, options.tolerance, options.maxIterations, &result.converged);
+    } else {
+        result.converged = true;
+    }
+
+    // ---- 壓降、電流密度 ----
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double perArea = sigma / (h * layout.thickness_mm);     // 電位差 -> 面電流密度
+    result.drop_V.assign(n, nan);
+    result.density_A_per_mm2.assign(n, nan);
+    forRowBlocks(g.ny, threads, [&](int j0, int j1) {
+        for (int j = j0; j < j1; ++j) {
+            for (int i = 0; i < g.nx; ++i) {
+                const std::size_t k = g.index(i, j);
+                if (!reached[k]) continue;
+                // 相鄰格不是銅時那一面的電流為 0
+                auto face = [&](std::size_t m) { return reached[m] ? u[k] - u[m] : 0.0; };
+                const double west = (i > 0) ? face(k - 1) : 0.0;
+                const double east = (i + 1 < g.nx) ? face(k + 1) : 0.0;
+                const double south = (j > 0) ? face(k - g.nx) : 0.0;
+                const double north = (j + 1 < g.ny) ? face(k + g.nx) : 0.0;
+                result.drop_V[k] = u[k];
+                result.density_A_per_mm2[k] = 0.5 * perArea * std::hypot(east - west, north - south);
+            }
+        }
+    });
+    for (std::size_t k = 0; k < n; ++k) {
+        if (!reached[k]) continue;
+        result.maxDrop_V = std::max(result.maxDrop_V, u[k]);
+        result.maxDensity_A_per_mm2 = std::max(result.maxDensity_A_per_mm2, result.density_A_per_mm2[k]);
+        result.power_W += b[k] * u[k];
+    }
+    for (const std::vector<std::size_t> &cells : sinkCells) result.sinkDrop_V.push_back(meanDrop(cells, u));
+    for (const std::vector<std::size_t> &cells : viaCells) result.viaDrop_V.push_back(meanDrop(cells, u));
+
+    const double separation = (options.hotspotSeparation_mm > 0) ? options.hotspotSeparation_mm
+                                                                 : HOTSPOT_SEPARATION_FRACTION * std::max(width, height);
+    std::vector<double> density = result.density_A_per_mm2;
+    for (double &d : density) {
+        if (std::isnan(d)) d = 0;
+    }
+    result.hotspots = findHotspots(g, density, options.hotspots, separation);
+    return result;
+}
+
+bool writePlaneMapCsv(const PlaneDropResult &result, BufferedWriter &out)
+{
+    out.write("x_mm,y_mm,drop_V,density_A_per_mm2\n");
+    char buf[4 * FORMAT_BUFFER_SIZE + 8];
+    for (int j = 0; j < result.ny; ++j) {
+        for (int i = 0; i < result.nx; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * result.nx + i;
+            if (std::isnan(result.drop_V[k])) continue;
+            char *p = formatDouble(buf, result.x0_mm + (i + 0.5) * result.cell_mm);
+            *p++ = ',';
+            p = formatDouble(p, result.y0_mm + (j + 0.5) * result.cell_mm);
+            *p++ = ',';
+            p = formatDouble(p, result.drop_V[k]);
+            *p++ = ',';
+            p = formatDouble(p, result.density_A_per_mm2[k]);
+            *p++ = '\n';
+            out.write(buf, static_cast<std::size_t>(p - buf));
+        }
+    }
+    return out.ok();
+}
+
+} // namespace sc
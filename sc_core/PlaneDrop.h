@@ -0,0 +1,123 @@
+#ifndef SC_PLANEDROP_H
+#define SC_PLANEDROP_H
+
+/**
+ * @file PlaneDrop.h
+ * @brief 銅箔鋪銅 (多邊形) 的直流壓降 (IR drop)
+ *
+ * 走線頁假設導體是均勻的長方形；大電流的電源常走不規則的鋪銅，中間有過孔、挖空與瓶頸。
+ * 這裡把鋪銅的外框光柵化成正方形格子的電阻網路 (片電導 t / ρ(T)，ρ 與走線頁相同)，
+ * 電源焊墊固定為 0 V，負載焊墊、過孔抽出電流，解出每一格相對電源的壓降與電流密度。
+ *
+ * 輸入 (parsePlaneLayout) 是簡單的文字格式或 JSON，兩者的內容相同：
+ *
+ *   # 註解
+ *   units mm                        長度單位 mm / mil / inch (影響之後所有的長度)
+ *   oz 1                            銅重，或 thickness 0.035 (銅厚)
+ *   temperature 25                  銅的溫度 (°C)，電阻率依此修正
+ *   outline 0,0 50,0 50,30 0,30     鋪銅外框 (頂點，逗號或空白分隔)，可以有多個
+ *   hole 20,10 24,10 24,14 20,14    挖空
+ *   source 2 15 4                   電源焊墊：中心 x y、直徑
+ *   sink 48 15 4 10                 負載焊墊：中心 x y、直徑、抽出電流 (A)
+ *   via 25 5 0.3 2                  過孔：中心 x y、鑽孔直徑、抽出電流 (A，0 = 只是挖孔)
+ *
+ *   { "units": "mm", "oz": 1, "temperature": 25,
+ *     "outline": [[0,0],[50,0],[50,30],[0,30]], "holes": [[[20,10],[24,10],[24,14],[20,14]]],
+ *     "sources": [{"x": 2, "y": 15, "d": 4}], "sinks": [{"x": 48, "y": 15, "d": 4, "current": 10}],
+ *     "vias": [{"x": 25, "y": 5, "drill": 0.3, "current": 2}] }
+ *
+ * 外框與挖空以奇偶規則 (even-odd) 合成，格心在內的格子就是銅。
+ * 與電源不相連的銅島不參與計算；負載或過孔落在銅島上是錯誤。
+ */
+
+#include "ScConstants.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+class BufferedWriter;
+
+struct PlanePoint {
+    double x;
+    double y;
+};
+
+// 圓形焊墊 / 過孔 (mm)；電源焊墊的 current_A 不使用
+struct PlanePad {
+    double x_mm;
+    double y_mm;
+    double diameter_mm;
+    double current_A;
+};
+
+struct PlaneLayout {
+    std::vector<std::vector<PlanePoint>> outlines;  // mm
+    std::vector<std::vector<PlanePoint>> holes;
+    std::vector<PlanePad> sources;
+    std::vector<PlanePad> sinks;
+    std::vector<PlanePad> vias;         // diameter_mm 為鑽孔直徑，孔內沒有銅；電流從孔壁周圍抽出
+    double thickness_mm = COPPER_MM_PER_OZ;
+    double temperature_C = 25;
+};
+
+// 依內容判斷格式 (第一個非空白字元是 '{' 為 JSON)；失敗時回傳 false，error 含行號
+bool parsePlaneLayout(std::string_view text, PlaneLayout &layout, std::string &error);
+
+struct PlaneDropOptions {
+    double cell_mm = 0;                 // 格子邊長，0 = 自動 (外框範圍約 targetCells 格)
+    std::size_t targetCells = 1000000;
+    std::size_t maxCells = 20000000;    // 超過時回報錯誤 (每格約 150 位元組)
+    int hotspots = 10;                  // 回報的電流密度熱點數
+    double hotspotSeparation_mm = 0;    // 熱點之間的最小距離，0 = 外框範圍的 5%
+    double tolerance = 1e-6;            // 共軛梯度的相對殘差 (壓降的誤差遠小於網格離散誤差)
+    int maxIterations = 1000;
+    unsigned threads = 0;               // 0 = 全部硬體執行緒
+};
+
+struct PlaneHotspot {
+    double x_mm;
+    double y_mm;
+    double density_A_per_mm2;
+};
+
+struct PlaneDropResult {
+    std::string error;                  // 不為空時其餘欄位無效
+
+    // 網格：列 j、欄 i 的格心在 (x0 + (i + 0.5) cell, y0 + (j + 0.5) cell)
+    int nx = 0;
+    int ny = 0;
+    double x0_mm = 0;
+    double y0_mm = 0;
+    double cell_mm = 0;
+    std::size_t copperCells = 0;        // 與電源相連的銅格數
+    std::size_t islandCells = 0;        // 不相連而被忽略的銅格數
+
+    // 每格相對電源的壓降 (V) 與電流密度大小 (A/mm²)；不是銅或不相連的格子為 NaN
+    std::vector<double> drop_V;
+    std::vector<double> density_A_per_mm2;
+
+    double maxDrop_V = 0;
+    double maxDensity_A_per_mm2 = 0;
+    double totalCurrent_A = 0;          // 所有負載與過孔的電流和
+    double power_W = 0;                 // 鋪銅的焦耳損耗
+    double sheetResistance_ohm = 0;     // 片電阻 ρ(T) / t (Ω/□)
+    std::vector<double> sinkDrop_V;     // 各負載焊墊的平均壓降 (與 layout.sinks 對應)
+    std::vector<double> viaDrop_V;      // 各過孔孔壁的平均壓降
+    std::vector<PlaneHotspot> hotspots; // 依電流密度由大到小
+
+    int iterations = 0;
+    bool converged = false;
+};
+
+PlaneDropResult planeDropSolve(const PlaneLayout &layout, const PlaneDropOptions &options = {});
+
+// 銅格的 x_mm, y_mm, drop_V, density_A_per_mm2 (CSV，含標題)；回傳 out.ok()
+bool writePlaneMapCsv(const PlaneDropResult &result, BufferedWriter &out);
+
+} // namespace sc
+
+#endif // SC_PLANEDROP_H
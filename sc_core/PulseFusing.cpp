@@ -0,0 +1,389 @@
+/**
+ * @file PulseFusing.cpp
+ * @brief 脈衝電流暫態：集總 RC 熱模型 + Dormand-Prince 5(4) 自動步長
+ *
+ * 【 1. 積分 】
+ * 波形每一段內 I(t) 是線性的，右手邊平滑，所以步長只在段內調整，跨段時截在轉折點上，
+ * 跳變 (相同時間的兩點) 不會被步長控制誤判成劇烈變化。FSAL：接受的步最後一個斜率就是下一步的第一個。
+ * 誤差 = |y5 - y4| / (absTolerance + relTolerance |T|)，步長係數 0.9 err^(-1/5)，限制在 0.2 ~ 5 倍。
+ *
+ * 【 2. 事件 】
+ * 每一步以兩端的值與斜率做三次 Hermite 內插：溫度越過熔點時二分求熔斷時間；
+ * 斜率由正轉負時在步內求峰值 (電流下降的脈衝，峰值常落在步的中間)。
+ *
+ * 【 3. 批次 】
+ * 每個 (波形, 導體) 組合互相獨立，交給 parallelFor；單一組合通常只要數十到數百步。
+ */
+
+#include "PulseFusing.h"
+#include "NumParse.h"
+#include "Parallel.h"
+#include "TraceCalc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sc {
+
+namespace {
+
+// Onderdonk 公式的常數 (面積以 circular mil、時間以秒)
+constexpr double ONDERDONK_INFERRED_ZERO_C = 234;
+constexpr double ONDERDONK_K = 33;
+constexpr double PREECE_K_COPPER = 80;          // d 以 mm (以英吋時為 10244)
+
+// 步長控制
+constexpr double STEP_SAFETY = 0.9;
+constexpr double STEP_MIN_FACTOR = 0.2;
+constexpr double STEP_MAX_FACTOR = 5;
+constexpr double INITIAL_STEPS_PER_SEGMENT = 16;
+constexpr int EVENT_BISECTIONS = 50;
+
+// 熔斷倍數的搜尋範圍與相對精度
+constexpr int SCALE_SEARCH_DOUBLINGS = 30;
+constexpr double SCALE_SEARCH_TOLERANCE = 1e-4;
+
+double circularMils(double area_mm2)
+{
+    return area_mm2 * MM2_TO_SQMIL * 4 / PI;
+}
+
+// C dT/dt = I² R20 (1 + α (T - 20)) - g (T - Ta)
+struct ThermalNode {
+    double r20;                 // 20°C 電阻
+    double g;                   // 1 / θ
+    double ambient;
+    double invC;
+    double slope(double I, double T) const
+    {
+        return (I * I * r20 * (1 + COPPER_ALPHA * (T - 20)) - g * (T - ambient)) * invC;
+    }
+};
+
+// 步內的三次 Hermite 內插，s 在 [0, 1]
+struct HermiteStep {
+    double y0, y1, hf0, hf1;
+    double value(double s) const
+    {
+        const double s2 = s * s, s3 = s2 * s;
+        return (2 * s3 - 3 * s2 + 1) * y0 + (s3 - 2 * s2 + s) * hf0 + (-2 * s3 + 3 * s2) * y1 + (s3 - s2) * hf1;
+    }
+    double derivative(double s) const
+    {
+        const double s2 = s * s;
+        return (6 * s2 - 6 * s) * (y0 - y1) + (3 * s2 - 4 * s + 1) * hf0 + (3 * s2 - 2 * s) * hf1;
+    }
+};
+
+bool validWaveform(const PulseWaveform &wave)
+{
+    if (wave.time_s.size() < 2 || wave.time_s.size() != wave.current_A.size()) return false;
+    for (std::size_t k = 0; k < wave.time_s.size(); ++k) {
+        if (!std::isfinite(wave.time_s[k]) || !std::isfinite(wave.current_A[k])) return false;
+        if (k > 0 && wave.time_s[k] < wave.time_s[k - 1]) return false;
+    }
+    return wave.time_s.back() > wave.time_s.front();
+}
+
+} // namespace
+
+double onderdonkFusingCurrent(double area_mm2, double time_s, double ambient_C)
+{
+    const double rise = std::log10(1 + (COPPER_MELT_C - ambient_C) / (ONDERDONK_INFERRED_ZERO_C + ambient_C));
+    return circularMils(area_mm2) * std::sqrt(rise / (ONDERDONK_K * time_s));
+}
+
+double onderdonkFusingTime(double current_A, double area_mm2, double ambient_C)
+{
+    const double rise = std::log10(1 + (COPPER_MELT_C - ambient_C) / (ONDERDONK_INFERRED_ZERO_C + ambient_C));
+    const double ratio = circularMils(area_mm2) / current_A;
+    return rise * ratio * ratio / ONDERDONK_K;
+}
+
+double preeceFusingCurrent(double area_mm2)
+{
+    const double d_mm = std::sqrt(4 * area_mm2 / PI);
+    return PREECE_K_COPPER * std::pow(d_mm, 1.5);
+}
+
+bool parsePulseWaveform(std::string_view text, PulseWaveform &wave, std::string &error)
+{
+    wave = PulseWaveform();
+    std::size_t lineNo = 0;
+    bool header = true;         // 第一筆資料之前，無法解析的列視為標題
+    while (!text.empty()) {
+        const std::size_t eol = text.find('\n');
+        std::string_view line = text.substr(0, eol);
+        text = (eol == std::string_view::npos) ? std::string_view() : text.substr(eol + 1);
+        ++lineNo;
+        const std::size_t hash = line.find('#');
+        if (hash != std::string_view::npos) line = line.substr(0, hash);
+
+        // 逗號、分號、tab、空白都是分隔符號
+        std::string_view fields[2];
+        int count = 0;
+        std::size_t i = 0;
+        while (i < line.size()) {
+            const auto sep = [](char c) { return c == ',' || c == ';' || c == '\t' || c == ' ' || c == '\r'; };
+            while (i < line.size() && sep(line[i])) ++i;
+            const std::size_t start = i;
+            while (i < line.size() && !sep(line[i])) ++i;
+            if (i > start) {
+                if (count < 2) fields[count] = line.substr(start, i - start);
+                ++count;
+            }
+        }
+        if (count == 0) continue;
+
+        double t, I;
+        if (count < 2 || !parseNumber(fields[0], t) || !parseNumber(fields[1], I)) {
+            if (header) continue;
+            error = "line " + std::to_string(lineNo) + ": expected time and current";
+            return false;
+        }
+        header = false;
+        if (!wave.time_s.empty() && t < wave.time_s.back()) {
+            error = "line " + std::to_string(lineNo) + ": time goes backwards";
+            return false;
+        }
+        wave.time_s.push_back(t);
+        wave.current_A.push_back(I);
+    }
+    if (!validWaveform(wave)) {
+        error = "the waveform needs at least two points spanning a positive time";
+        return false;
+    }
+    return true;
+}
+
+PulseWaveform rectangularPulse(double current_A, double width_s, double duration_s)
+{
+    PulseWaveform w;
+    w.time_s = { 0, width_s };
+    w.current_A = { current_A, current_A };
+    if (duration_s > width_s) {
+        w.time_s.insert(w.time_s.end(), { width_s, duration_s });
+        w.current_A.insert(w.current_A.end(), { 0.0, 0.0 });
+    }
+    return w;
+}
+
+PulseWaveform exponentialPulse(double peak_A, double tau_s, double duration_s, int points)
+{
+    // 對數間隔：前段變化快的地方點比較密；折線在凸函數上方，I²t 略為高估 (偏保守)
+    PulseWaveform w;
+    points = std::max(points, 3);
+    const double first = std::min(tau_s * 1e-3, duration_s / points);
+    w.time_s.push_back(0);
+    for (int k = 0; k < points - 1; ++k)
+        w.time_s.push_back(first * std::pow(duration_s / first, static_cast<double>(k) / (points - 2)));
+    for (double t : w.time_s) w.current_A.push_back(peak_A * std::exp(-t / tau_s));
+    return w;
+}
+
+double waveformI2t(const PulseWaveform &wave)
+{
+    double sum = 0;
+    for (std::size_t k = 1; k < wave.time_s.size() && k < wave.current_A.size(); ++k) {
+        const double a = wave.current_A[k - 1], b = wave.current_A[k];
+        sum += (wave.time_s[k] - wave.time_s[k - 1]) * (a * a + a * b + b * b) / 3;
+    }
+    return sum;
+}
+
+PulseConductor tracePulseConductor(double width_mm, double thickness_mm, double length_mm, bool internal,
+                                   TraceModel model, const Ipc2152Options &ipc, double ratingRise_C,
+                                   double ambient_C)
+{
+    PulseConductor c;
+    c.area_mm2 = width_mm * thickness_mm;
+    c.length_mm = length_mm;
+    c.ambient_C = ambient_C;
+    c.theta_C_per_W = traceThermalResistance(width_mm, thickness_mm, length_mm, internal, model, ipc, ratingRise_C,
+                                             ambient_C);
+    return c;
+}
+
+PulseConductor viaPulseConductor(double diameter_mm, double wallThick_mm, double boardThick_mm, TraceModel model,
+                                 double ratingRise_C, double ambient_C)
+{
+    PulseConductor c;
+    c.area_mm2 = viaArea(diameter_mm, wallThick_mm);
+    c.length_mm = boardThick_mm;
+    c.ambient_C = ambient_C;
+    c.theta_C_per_W = viaThermalResistance(diameter_mm, wallThick_mm, boardThick_mm, model, ratingRise_C, ambient_C);
+    return c;
+}
+
+PulseResult pulseSolve(const PulseWaveform &wave, const PulseConductor &conductor, const PulseOptions &options)
+{
+    PulseResult r;
+    if (!validWaveform(wave) || !(conductor.area_mm2 > 0) || !(conductor.length_mm > 0) ||
+        !std::isfinite(conductor.ambient_C) || !(conductor.ambient_C < COPPER_MELT_C))
+        return r;
+    r.valid = true;
+    r.i2t_A2s = waveformI2t(wave);
+
+    ThermalNode node;
+    node.r20 = copperResistance(conductor.area_mm2, conductor.length_mm, 20);
+    node.g = (conductor.theta_C_per_W > 0) ? 1 / conductor.theta_C_per_W : 0;
+    node.ambient = conductor.ambient_C;
+    node.invC = 1 / (COPPER_HEAT_CAPACITY_J_PER_MM3K * conductor.area_mm2 * conductor.length_mm);
+
+    double t = wave.time_s.front();
+    double T = conductor.ambient_C;
+    r.peak_C = T;
+    r.peakTime_s = t;
+    if (options.recordHistory) r.history.push_back({ t, T });
+    double h = (wave.time_s.back() - t) / INITIAL_STEPS_PER_SEGMENT;
+
+    for (std::size_t seg = 1; seg < wave.time_s.size(); ++seg) {
+        const double ta = wave.time_s[seg - 1], tb = wave.time_s[seg];
+        if (!(tb > ta)) continue;                   // 跳變
+        const double Ia = wave.current_A[seg - 1];
+        const double dI = (wave.current_A[seg] - Ia) / (tb - ta);
+        auto current = [&](double time) { return Ia + dI * (time - ta); };
+        h = std::min(h, (tb - ta));
+        double k1 = node.slope(current(t), T);
+
+        while (t < tb) {
+            if (r.steps + r.rejected >= options.maxSteps) {
+                r.completed = false;
+                r.final_C = T;
+                return r;
+            }
+            // 最後一步直接對齊轉折點，避免留下極短的尾巴
+            const bool last = t + h >= tb || tb - (t + h) < 1e-3 * h;
+            const double step = last ? tb - t : h;
+
+            const double k2 = node.slope(current(t + step / 5), T + step * (k1 / 5));
+            const double k3 = node.slope(current(t + step * 3 / 10), T + step * (3 * k1 / 40 + 9 * k2 / 40));
+            const double k4 = node.slope(current(t + step * 4 / 5),
+                                         T + step * (44 * k1 / 45 - 56 * k2 / 15 + 32 * k3 / 9));
+            const double k5 = node.slope(current(t + step * 8 / 9),
+                                         T + step * (19372 * k1 / 6561 - 25360 * k2 / 2187 + 64448 * k3 / 6561 -
+                                                     212 * k4 / 729));
+            const double k6 = node.slope(current(t + step),
+                                         T + step * (9017 * k1 / 3168 - 355 * k2 / 33 + 46732 * k3 / 5247 +
+                                                     49 * k4 / 176 - 5103 * k5 / 18656));
+            const double next = T + step * (35 * k1 / 384 + 500 * k3 / 1113 + 125 * k4 / 192 - 2187 * k5 / 6784 +
+                                            11 * k6 / 84);
+            const double k7 = node.slope(current(t + step), next);
+            const double errorEstimate = step * (71 * k1 / 57600 - 71 * k3 / 16695 + 71 * k4 / 1920 -
+                                                 17253 * k5 / 339200 + 22 * k6 / 525 - k7 / 40);
+
+            // 溢位 (I² R 或溫度變成 inf / NaN)：先縮小步長重試；
+            // 起點的斜率就已溢位或步長小到無法再縮時，溫度在這一點幾乎瞬間超過熔點，視為熔斷
+            if (!std::isfinite(next) || !std::isfinite(errorEstimate)) {
+                if (std::isfinite(k1) && step > 1e-12 * std::max(std::abs(t), tb - ta)) {
+                    ++r.rejected;
+                    h = step * STEP_MIN_FACTOR;
+                    continue;
+                }
+                r.fused = true;
+                r.fuseTime_s = t;
+                r.peak_C = r.final_C = COPPER_MELT_C;
+                r.peakTime_s = t;
+                if (options.recordHistory) r.history.push_back({ t, COPPER_MELT_C });
+                return r;
+            }
+            const double scale = options.absTolerance_C + options.relTolerance * std::max(std::abs(T), std::abs(next));
+            const double err = std::abs(errorEstimate) / scale;
+            const double factor = (err > 0) ? STEP_SAFETY * std::pow(err, -0.2) : STEP_MAX_FACTOR;
+
+            // 步長已經小到加不進時間時直接接受，避免無窮迴圈
+            if (err > 1 && step > 1e-12 * std::max(std::abs(t), tb - ta)) {
+                ++r.rejected;
+                h = step * std::max(STEP_MIN_FACTOR, factor);
+                continue;
+            }
+            ++r.steps;
+
+            const HermiteStep hermite{ T, next, step * k1, step * k7 };
+            if (next >= COPPER_MELT_C) {
+                double lo = 0, hi = 1;
+                for (int i = 0; i < EVENT_BISECTIONS; ++i) {
+                    const double mid = 0.5 * (lo + hi);
+                    (hermite.value(mid) < COPPER_MELT_C ? lo : hi) = mid;
+                }
+                r.fused = true;
+                r.fuseTime_s = t + hi * step;
+                r.peak_C = r.final_C = COPPER_MELT_C;
+                r.peakTime_s = r.fuseTime_s;
+                if (options.recordHistory) r.history.push_back({ r.fuseTime_s, COPPER_MELT_C });
+                return r;
+            }
+            if (k1 > 0 && k7 < 0) {
+                double lo = 0, hi = 1;
+                for (int i = 0; i < EVENT_BISECTIONS; ++i) {
+                    const double mid = 0.5 * (lo + hi);
+                    (hermite.derivative(mid) > 0 ? lo : hi) = mid;
+                }
+                const double peak = hermite.value(lo);
+                if (peak > r.peak_C) {
+                    r.peak_C = peak;
+                    r.peakTime_s = t + lo * step;
+                }
+            }
+            if (next > r.peak_C) {
+                r.peak_C = next;
+                r.peakTime_s = t + step;
+            }
+
+            t = last ? tb : t + step;
+            T = next;
+            k1 = k7;
+            if (options.recordHistory) r.history.push_back({ t, T });
+            // 截在轉折點的短步不代表步長需要變小
+            h = std::max(last ? h : 0.0, step * std::min(STEP_MAX_FACTOR, factor));
+        }
+    }
+    r.final_C = T;
+    return r;
+}
+
+double pulseFusingScale(const PulseWaveform &wave, const PulseConductor &conductor, const PulseOptions &options)
+{
+    PulseOptions opt = options;
+    opt.recordHistory = false;
+    PulseWaveform scaled = wave;
+    auto fusesAt = [&](double k) {
+        for (std::size_t i = 0; i < wave.current_A.size(); ++i) scaled.current_A[i] = k * wave.current_A[i];
+        return pulseSolve(scaled, conductor, opt).fused;
+    };
+    if (!validWaveform(wave)) return std::numeric_limits<double>::quiet_NaN();
+
+    // 先以 2 倍找出區間，再在對數座標上二分
+    double lo = 1, hi = 1;
+    if (fusesAt(1)) {
+        do {
+            hi = lo;
+            lo /= 2;
+        } while (lo > std::ldexp(1.0, -SCALE_SEARCH_DOUBLINGS) && fusesAt(lo));
+    } else {
+        do {
+            lo = hi;
+            hi *= 2;
+            if (hi > std::ldexp(1.0, SCALE_SEARCH_DOUBLINGS)) return std::numeric_limits<double>::infinity();
+        } while (!fusesAt(hi));
+    }
+    while (hi / lo > 1 + SCALE_SEARCH_TOLERANCE) {
+        const double mid = std::sqrt(lo * hi);
+        (fusesAt(mid) ? hi : lo) = mid;
+    }
+    return hi;
+}
+
+std::vector<PulseResult> pulseSolveBatch(const std::vector<PulseWaveform> &waves,
+                                         const std::vector<PulseConductor> &conductors, const PulseOptions &options)
+{
+    std::vector<PulseResult> results(waves.size() * conductors.size());
+    const std::size_t nc = conductors.size();
+    parallelFor(results.size(), options.threads, [&](std::size_t k) {
+        results[k] = pulseSolve(waves[k / nc], conductors[k % nc], options);
+    });
+    return results;
+}
+
+} // namespace sc
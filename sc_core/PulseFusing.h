@@ -0,0 +1,112 @@
+#ifndef SC_PULSEFUSING_H
+#define SC_PULSEFUSING_H
+
+/**
+ * @file PulseFusing.h
+ * @brief 走線 / 貫孔的脈衝電流暫態：湧浪、故障電流下的溫度與熔斷時間
+ *
+ * IPC 公式只有穩態；這裡把導體當成一個集總的熱節點：
+ *   C dT/dt = I(t)² R(T) - (T - Ta) / θ
+ *   C = 銅的體積熱容 x 截面積 x 長度 (不計板材，偏保守)，R(T) = ρ20 (1 + α (T - 20)) L / A，
+ *   θ 由載流模型在額定溫升的工作點換算 (穩態時與 IPC 一致)，θ <= 0 為絕熱 (Onderdonk 的假設)。
+ * 電流是分段線性波形 (時間可以重複，表示跳變)，以 Dormand-Prince 5(4) 自動步長積分，
+ * 步長不跨越波形的轉折點；溫度到達銅的熔點即視為熔斷並停止。
+ *
+ * 另外提供兩個經驗公式作為對照：Onderdonk (絕熱熔斷，短脈衝) 與 Preece (長時間熔斷電流)。
+ */
+
+#include "Ipc2152.h"
+#include "SelfHeating.h"
+#include "ViaCalc.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+constexpr double COPPER_MELT_C = 1085;
+
+// 銅的體積熱容 (J/(mm³·K))：8.96 g/cm³ x 0.385 J/(g·K)
+constexpr double COPPER_HEAT_CAPACITY_J_PER_MM3K = 3.45e-3;
+
+// Onderdonk：絕熱條件下 time_s 秒由 ambient_C 加熱到熔點的電流 (A)，與反函數 (秒)
+double onderdonkFusingCurrent(double area_mm2, double time_s, double ambient_C = VIA_AMBIENT_C);
+double onderdonkFusingTime(double current_A, double area_mm2, double ambient_C = VIA_AMBIENT_C);
+
+// Preece：I = 80 d^1.5 (d 為同截面積圓線的直徑，mm)，長時間通電的熔斷電流 (A)
+double preeceFusingCurrent(double area_mm2);
+
+// 分段線性電流波形；time_s 不遞減，相同時間的兩點表示跳變
+struct PulseWaveform {
+    std::vector<double> time_s;
+    std::vector<double> current_A;
+};
+
+// 兩欄文字 (時間 s、電流 A)，以逗號、分號、tab 或空白分隔；# 之後是註解，開頭無法解析的列視為標題
+bool parsePulseWaveform(std::string_view text, PulseWaveform &wave, std::string &error);
+
+// 矩形脈衝 (0 ~ width_s 為 current_A)，之後為 0 到 duration_s
+PulseWaveform rectangularPulse(double current_A, double width_s, double duration_s);
+
+// 指數衰減的湧浪 peak_A * exp(-t / tau_s)，以對數間隔的折線近似到 duration_s
+PulseWaveform exponentialPulse(double peak_A, double tau_s, double duration_s, int points = 64);
+
+// ∫ I² dt (A²·s)，分段線性波形的精確值
+double waveformI2t(const PulseWaveform &wave);
+
+struct PulseConductor {
+    double area_mm2 = 0;
+    double length_mm = 0;
+    double theta_C_per_W = 0;           // 到環境的熱阻，<= 0 = 絕熱
+    double ambient_C = VIA_AMBIENT_C;
+};
+
+// θ 由 traceThermalResistance / viaThermalResistance 換算 (SelfHeating.h)，穩態與自洽溫升相同
+PulseConductor tracePulseConductor(double width_mm, double thickness_mm, double length_mm, bool internal,
+                                   TraceModel model, const Ipc2152Options &ipc,
+                                   double ratingRise_C = THERMAL_RATING_RISE_C, double ambient_C = VIA_AMBIENT_C);
+PulseConductor viaPulseConductor(double diameter_mm, double wallThick_mm, double boardThick_mm, TraceModel model,
+                                 double ratingRise_C = THERMAL_RATING_RISE_C, double ambient_C = VIA_AMBIENT_C);
+
+struct PulseOptions {
+    double relTolerance = 1e-6;
+    double absTolerance_C = 1e-4;
+    std::size_t maxSteps = 1000000;
+    bool recordHistory = false;         // 保留每個接受的步 (時間、溫度)，畫圖用
+    unsigned threads = 0;               // 批次：0 = 全部硬體執行緒
+};
+
+struct PulseSample {
+    double time_s;
+    double temperature_C;
+};
+
+struct PulseResult {
+    bool valid = false;                 // 導體或波形無效時為 false，其餘欄位無意義
+    double peak_C = 0;
+    double peakTime_s = 0;
+    double final_C = 0;                 // 波形結束 (或熔斷) 時的溫度
+    double i2t_A2s = 0;                 // 整個波形的 I²t
+    bool fused = false;
+    double fuseTime_s = 0;              // 到達熔點的時間 (fused 時)
+    bool completed = true;              // maxSteps 用完時為 false
+    std::size_t steps = 0;
+    std::size_t rejected = 0;
+    std::vector<PulseSample> history;
+};
+
+PulseResult pulseSolve(const PulseWaveform &wave, const PulseConductor &conductor, const PulseOptions &options = {});
+
+// 波形整體放大幾倍時剛好熔斷 (二分，相對精度約 1e-4)；放大 2^30 倍仍不熔斷時回傳 inf
+double pulseFusingScale(const PulseWaveform &wave, const PulseConductor &conductor, const PulseOptions &options = {});
+
+// 所有 波形 x 導體 的組合平行積分，結果依 [波形 * 導體數 + 導體] 排列
+std::vector<PulseResult> pulseSolveBatch(const std::vector<PulseWaveform> &waves,
+                                         const std::vector<PulseConductor> &conductors,
+                                         const PulseOptions &options = {});
+
+} // namespace sc
+
+#endif // SC_PULSEFUSING_H
@@ -0,0 +1,34 @@
+#ifndef SC_CONSTANTS_H
+#define SC_CONSTANTS_H
+
+namespace sc {
+
+constexpr double PI = 3.14159265358979323846;
+
+// 1 mil = 0.0254 mm
+constexpr double MM_PER_MIL = 0.0254;
+
+// mm² -> mil²
+constexpr double MM2_TO_SQMIL = 1550.0031;
+
+// 1 oz 銅箔厚度 (mm)
+constexpr double COPPER_MM_PER_OZ = 0.0342867;
+
+// 銅電阻率 @ 20°C (Ohm-mm)，走線、貫孔、鋪銅與脈衝共用
+constexpr double COPPER_RHO_OHM_MM = 1.724e-5;
+
+// 銅的電阻溫度係數 (1/°C)
+constexpr double COPPER_ALPHA = 0.00393;
+
+// 熱電壓 Vt = k * T / q 的 k / q (V/K)
+constexpr double BOLTZMANN_OVER_Q = 8.617333262e-5;
+
+// 自由空間波阻抗 η0 = sqrt(μ0 / ε0) (Ohm)
+constexpr double FREE_SPACE_IMPEDANCE_OHM = 376.730313668;
+
+// °C -> K
+constexpr double KELVIN_OFFSET = 273.15;
+
+} // namespace sc
+
+#endif // SC_CONSTANTS_H
@@ -0,0 +1,203 @@
+/**
+ * @file ScaleKernels.cpp
+ * @brief 批次乘上常數的 SIMD 核心 (SSE2 / AVX2，執行期選擇)
+ *
+ * SI 前綴換算只是乘上同一個比值，比值在迴圈外算好之後，
+ * 剩下的工作完全受限於記憶體頻寬，因此一次處理 4 個向量暫存器，
+ * 並以非對齊讀寫處理任意位址的輸入。
+ *
+ * - x86/x64：SSE2 為基準，AVX2 以 target 屬性編譯，執行期由 CPUID 決定是否使用
+ * - 其他平台：只有純量迴圈 (編譯器仍可能自動向量化)
+ * 每個元素都是同一個 IEEE 乘法，所以各實作的結果逐位元相同。
+ */
+
+#include "ScaleKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SC_SCALE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SC_TARGET_AVX2
+#else
+#define SC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace sc {
+
+namespace {
+
+template <class T>
+void scaleScalar(const T *in, T *out, std::size_t n, T k)
+{
+    for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * k;
+}
+
+#ifdef SC_SCALE_X86
+
+void scaleSse2(const double *in, double *out, std::size_t n, double k)
+{
+    const __m128d vk = _mm_set1_pd(k);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128d a = _mm_loadu_pd(in + i);
+        __m128d b = _mm_loadu_pd(in + i + 2);
+        __m128d c = _mm_loadu_pd(in + i + 4);
+        __m128d d = _mm_loadu_pd(in + i + 6);
+        _mm_storeu_pd(out + i,     _mm_mul_pd(a, vk));
+        _mm_storeu_pd(out + i + 2, _mm_mul_pd(b, vk));
+        _mm_storeu_pd(out + i + 4, _mm_mul_pd(c, vk));
+        _mm_storeu_pd(out + i + 6, _mm_mul_pd(d, vk));
+    }
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(in + i), vk));
+    for (; i < n; ++i) out[i] = in[i] * k;
+}
+
+void scaleSse2(const float *in, float *out, std::size_t n, float k)
+{
+    const __m128 vk = _mm_set1_ps(k);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128 a = _mm_loadu_ps(in + i);
+        __m128 b = _mm_loadu_ps(in + i + 4);
+        __m128 c = _mm_loadu_ps(in + i + 8);
+        __m128 d = _mm_loadu_ps(in + i + 12);
+        _mm_storeu_ps(out + i,      _mm_mul_ps(a, vk));
+        _mm_storeu_ps(out + i + 4,  _mm_mul_ps(b, vk));
+        _mm_storeu_ps(out + i + 8,  _mm_mul_ps(c, vk));
+        _mm_storeu_ps(out + i + 12, _mm_mul_ps(d, vk));
+    }
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), vk));
+    for (; i < n; ++i) out[i] = in[i] * k;
+}
+
+SC_TARGET_AVX2 void scaleAvx2(const double *in, double *out, std::size_t n, double k)
+{
+    const __m256d vk = _mm256_set1_pd(k);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256d a = _mm256_loadu_pd(in + i);
+        __m256d b = _mm256_loadu_pd(in + i + 4);
+        __m256d c = _mm256_loadu_pd(in + i + 8);
+        __m256d d = _mm256_loadu_pd(in + i + 12);
+        _mm256_storeu_pd(out + i,      _mm256_mul_pd(a, vk));
+        _mm256_storeu_pd(out + i + 4,  _mm256_mul_pd(b, vk));
+        _mm256_storeu_pd(out + i + 8,  _mm256_mul_pd(c, vk));
+        _mm256_storeu_pd(out + i + 12, _mm256_mul_pd(d, vk));
+    }
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(in + i), vk));
+    for (; i < n; ++i) out[i] = in[i] * k;
+}
+
+SC_TARGET_AVX2 void scaleAvx2(const float *in, float *out, std::size_t n, float k)
+{
+    const __m256 vk = _mm256_set1_ps(k);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256 a = _mm256_loadu_ps(in + i);
+        __m256 b = _mm256_loadu_ps(in + i + 8);
+        __m256 c = _mm256_loadu_ps(in + i + 16);
+        __m256 d = _mm256_loadu_ps(in + i + 24);
+        _mm256_storeu_ps(out + i,      _mm256_mul_ps(a, vk));
+        _mm256_storeu_ps(out + i + 8,  _mm256_mul_ps(b, vk));
+        _mm256_storeu_ps(out + i + 16, _mm256_mul_ps(c, vk));
+        _mm256_storeu_ps(out + i + 24, _mm256_mul_ps(d, vk));
+    }
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), vk));
+    for (; i < n; ++i) out[i] = in[i] * k;
+}
+
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4] = {0, 0, 0, 0};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    // 作業系統必須有保存 YMM 暫存器
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // SC_SCALE_X86
+
+SimdLevel clampLevel(SimdLevel level)
+{
+    SimdLevel best = detectedSimdLevel();
+    return static_cast<int>(level) > static_cast<int>(best) ? best : level;
+}
+
+template <class T>
+void dispatch(SimdLevel level, const T *in, T *out, std::size_t n, T k)
+{
+    switch (level) {
+#ifdef SC_SCALE_X86
+    case SimdLevel::AVX2:
+        scaleAvx2(in, out, n, k);
+        return;
+    case SimdLevel::SSE2:
+        scaleSse2(in, out, n, k);
+        return;
+#endif
+    default:
+        scaleScalar(in, out, n, k);
+        return;
+    }
+}
+
+} // namespace
+
+SimdLevel detectedSimdLevel()
+{
+#ifdef SC_SCALE_X86
+    static const SimdLevel level = cpuHasAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::AVX2: return "AVX2";
+    case SimdLevel::SSE2: return "SSE2";
+    default: return "Scalar";
+    }
+}
+
+void scaleArray(const double *in, double *out, std::size_t n, double k)
+{
+    dispatch(detectedSimdLevel(), in, out, n, k);
+}
+
+void scaleArray(const float *in, float *out, std::size_t n, float k)
+{
+    dispatch(detectedSimdLevel(), in, out, n, k);
+}
+
+void scaleArrayWith(SimdLevel level, const double *in, double *out, std::size_t n, double k)
+{
+    dispatch(clampLevel(level), in, out, n, k);
+}
+
+void scaleArrayWith(SimdLevel level, const float *in, float *out, std::size_t n, float k)
+{
+    dispatch(clampLevel(level), in, out, n, k);
+}
+
+} // namespace sc
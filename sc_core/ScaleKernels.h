@@ -0,0 +1,30 @@
+#ifndef SC_SCALEKERNELS_H
+#define SC_SCALEKERNELS_H
+
+#include <cstddef>
+
+namespace sc {
+
+// 向量化的 out[i] = in[i] * k，供大量單位換算使用
+// in 與 out 可以是同一塊記憶體 (原地換算)，其餘情況不可重疊
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// 目前 CPU 可用的最高指令集 (第一次呼叫時偵測，之後快取)
+SimdLevel detectedSimdLevel();
+const char *simdLevelName(SimdLevel level);
+
+// 依偵測結果自動選擇實作
+void scaleArray(const double *in, double *out, std::size_t n, double k);
+void scaleArray(const float *in, float *out, std::size_t n, float k);
+
+// 指定實作 (基準測試用)；CPU 不支援的等級會退回可用的最高等級
+void scaleArrayWith(SimdLevel level, const double *in, double *out, std::size_t n, double k);
+void scaleArrayWith(SimdLevel level, const float *in, float *out, std::size_t n, float k);
+
+} // namespace sc
+
+#endif // SC_SCALEKERNELS_H
@@ -0,0 +1,175 @@
+/**
+ * @file SelfHeating.cpp
+ * @brief 電熱耦合的固定點 (Newton，分塊批次，移除已收斂的 lane)
+ *
+ * 【 1. 固定點 】
+ * F(x) = x - ΔT0 (1 + c x)，ΔT0 = θ I² R(Ta)，c = α / (1 + α (Ta - 20))。
+ * F 是線性的，從 x = 0 做 Newton 一步就落在根上，第二步確認收斂；斜率 1 - c ΔT0 <= 0 代表沒有根 = 熱失控。
+ * 保留一般的 Newton 迴圈與收斂判斷，之後換成非線性的熱阻 (例如隨溫度變化的 θ) 時不必改批次結構。
+ *
+ * 【 2. 批次 】
+ * 每 LANES_PER_BLOCK 個 lane 一塊，塊內保留還沒收斂的索引清單，每一輪只更新清單上的 lane 並壓縮清單，
+ * 大部分 lane 幾輪就收斂，少數接近熱失控的不會拖慢其他 lane；各塊交給 parallelFor。
+ */
+
+#include "SelfHeating.h"
+#include "Parallel.h"
+#include "TraceCalc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace sc {
+
+namespace {
+
+constexpr std::size_t LANES_PER_BLOCK = 1024;
+
+double resistanceSlope(double ambient_C)
+{
+    return COPPER_ALPHA / (1 + COPPER_ALPHA * (ambient_C - 20));
+}
+
+double linearTheta(double ratingRise_C, double rated_A, double area_mm2, double length_mm, double ambient_C)
+{
+    const double R = copperResistance(area_mm2, length_mm, ambient_C + ratingRise_C);
+    return ratingRise_C / (rated_A * rated_A * R);
+}
+
+} // namespace
+
+double copperResistance(double area_mm2, double length_mm, double temperature_C)
+{
+    return COPPER_RHO_OHM_MM * length_mm / area_mm2 * (1 + COPPER_ALPHA * (temperature_C - 20));
+}
+
+double traceThermalResistance(double width_mm, double thickness_mm, double length_mm, bool internal,
+                              TraceModel model, const Ipc2152Options &ipc, double ratingRise_C, double ambient_C)
+{
+    const double rated = (model == TraceModel::IPC2152)
+                             ? ipc2152CurrentFromWidth(width_mm, thickness_mm, ratingRise_C, ipc)
+                             : traceCurrentFromWidth(width_mm, thickness_mm, ratingRise_C,
+                                                     internal ? IPC2221_K_INTERNAL : IPC2221_K_EXTERNAL);
+    return linearTheta(ratingRise_C, rated, width_mm * thickness_mm, length_mm, ambient_C);
+}
+
+double viaThermalResistance(double diameter_mm, double wallThick_mm, double boardThick_mm, TraceModel model,
+                            double ratingRise_C, double ambient_C)
+{
+    const double area = viaArea(diameter_mm, wallThick_mm);
+    const double rated = (model == TraceModel::IPC2152)
+                             ? viaMaxCurrentIpc2152(diameter_mm, wallThick_mm, ratingRise_C, boardThick_mm)
+                             : viaMaxCurrent(area * MM2_TO_SQMIL, ratingRise_C);
+    return linearTheta(ratingRise_C, rated, area, boardThick_mm, ambient_C);
+}
+
+namespace {
+
+// 一塊 lane：work 是還沒收斂的索引
+void solveBlock(const SelfHeatingBatchIn &in, const SelfHeatingBatchOut &out, std::size_t begin, std::size_t end,
+                const SelfHeatingOptions &opt, int *iterations)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<std::size_t> work;
+    work.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+        out.deltaT[i] = 0;
+        if (!(in.theta_C_per_W[i] >= 0) || !(in.resistance20_ohm[i] >= 0) || !std::isfinite(in.ambient_C[i])) {
+            out.status[i] = SelfHeatingStatus::Runaway;
+        } else {
+            out.status[i] = SelfHeatingStatus::NotConverged;
+            work.push_back(i);
+        }
+    }
+
+    int iter = 0;
+    for (; iter < opt.maxIterations && !work.empty(); ++iter) {
+        std::size_t kept = 0;
+        for (std::size_t i : work) {
+            const double x = out.deltaT[i];
+            const double I = in.current_A[i];
+            const double Ta = in.ambient_C[i];
+            const double c = resistanceSlope(Ta);
+            const double d0 = in.theta_C_per_W[i] * I * I * in.resistance20_ohm[i] * (1 + COPPER_ALPHA * (Ta - 20));
+            const double g = d0 * (1 + c * x);
+            const double slope = 1 - c * d0;
+            if (!(slope > 0)) {
+                out.status[i] = SelfHeatingStatus::Runaway;
+                continue;
+            }
+            const double step = (x - g) / slope;
+            const double next = x - step;
+            out.deltaT[i] = next;
+            if (!(next <= opt.maxRise_C)) {
+                out.status[i] = SelfHeatingStatus::Runaway;
+            } else if (std::abs(step) <= opt.tolerance_C) {
+                out.status[i] = SelfHeatingStatus::Converged;
+            } else {
+                work[kept++] = i;
+            }
+        }
+        work.resize(kept);
+    }
+    if (iterations) *iterations = iter;
+
+    for (std::size_t i = begin; i < end; ++i) {
+        if (out.status[i] == SelfHeatingStatus::Runaway) {
+            out.deltaT[i] = out.resistance_ohm[i] = out.voltageDrop_V[i] = out.power_W[i] = nan;
+            continue;
+        }
+        const double I = in.current_A[i];
+        out.resistance_ohm[i] = in.resistance20_ohm[i] * (1 + COPPER_ALPHA * (in.ambient_C[i] + out.deltaT[i] - 20));
+        out.voltageDrop_V[i] = I * out.resistance_ohm[i];
+        out.power_W[i] = I * out.voltageDrop_V[i];
+    }
+}
+
+} // namespace
+
+SelfHeatingLane traceSelfHeatingLane(double current_A, double width_mm, double thickness_mm, double length_mm,
+                                     bool internal, TraceModel model, const Ipc2152Options &ipc, double ambient_C,
+                                     double ratingRise_C)
+{
+    SelfHeatingLane lane;
+    lane.current_A = current_A;
+    lane.theta_C_per_W = traceThermalResistance(width_mm, thickness_mm, length_mm, internal, model, ipc,
+                                                ratingRise_C, ambient_C);
+    lane.resistance20_ohm = copperResistance(width_mm * thickness_mm, length_mm, 20);
+    lane.ambient_C = ambient_C;
+    return lane;
+}
+
+SelfHeatingLane viaSelfHeatingLane(double current_A, double diameter_mm, double wallThick_mm,
+                                   double boardThick_mm, TraceModel model, double ambient_C, double ratingRise_C)
+{
+    SelfHeatingLane lane;
+    lane.current_A = current_A;
+    lane.theta_C_per_W = viaThermalResistance(diameter_mm, wallThick_mm, boardThick_mm, model, ratingRise_C, ambient_C);
+    lane.resistance20_ohm = copperResistance(viaArea(diameter_mm, wallThick_mm), boardThick_mm, 20);
+    lane.ambient_C = ambient_C;
+    return lane;
+}
+
+SelfHeatingResult selfHeatingSolve(const SelfHeatingLane &lane, const SelfHeatingOptions &options)
+{
+    SelfHeatingResult r;
+    const SelfHeatingBatchIn in{ &lane.current_A, &lane.theta_C_per_W, &lane.resistance20_ohm, &lane.ambient_C };
+    const SelfHeatingBatchOut out{ &r.deltaT, &r.resistance_ohm, &r.voltageDrop_V, &r.power_W, &r.status };
+    solveBlock(in, out, 0, 1, options, &r.iterations);
+    return r;
+}
+
+std::size_t selfHeatingSolveBatch(const SelfHeatingBatchIn &in, const SelfHeatingBatchOut &out, std::size_t n,
+                                  const SelfHeatingOptions &options)
+{
+    const std::size_t blocks = (n + LANES_PER_BLOCK - 1) / LANES_PER_BLOCK;
+    const unsigned threads = blocks > 1 ? options.threads : 1;
+    parallelFor(blocks, threads, [&](std::size_t b) {
+        solveBlock(in, out, b * LANES_PER_BLOCK, std::min(n, (b + 1) * LANES_PER_BLOCK), options, nullptr);
+    });
+    return static_cast<std::size_t>(std::count(out.status, out.status + n, SelfHeatingStatus::Runaway));
+}
+
+} // namespace sc
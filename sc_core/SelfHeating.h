@@ -0,0 +1,102 @@
+#ifndef SC_SELFHEATING_H
+#define SC_SELFHEATING_H
+
+/**
+ * @file SelfHeating.h
+ * @brief 走線 / 貫孔的電熱耦合：由自身 I²R 決定的溫升 (自洽解)
+ *
+ * 走線頁與貫孔頁先假設溫升再算電阻；這裡反過來，給定電流與幾何求實際溫升：
+ *   - IPC 圖表本身就是在導體發熱 (電阻已隨溫度上升) 的狀態下量的，不能再乘一次電阻溫度係數。
+ *     所以由載流模型在額定溫升 ratingRise_C 的工作點換算線性熱阻 θ = ΔT / (I² R(Ta + ΔT))，
+ *     與脈衝頁 (PulseFusing.h) 的穩態完全相同；
+ *   - 電阻隨溫度上升 R(T) = R20 (1 + α (T - 20))，固定點 ΔT = θ I² R(Ta + ΔT)。
+ * 右邊對 ΔT 是線性的，θ I² R20 α >= 1 時沒有交點 = 熱失控。
+ *
+ * 每一條走線 / 每一顆貫孔化成一個 SelfHeatingLane (四個數)，之後的疊代與種類無關；
+ * 批次版本是 struct-of-arrays，已收斂的 lane 從工作清單移除，只疊代還沒收斂的。
+ */
+
+#include "Ipc2152.h"
+#include "ViaCalc.h"
+
+#include <cstddef>
+
+namespace sc {
+
+// 換算熱阻用的額定溫升 (°C)：走線頁、貫孔頁與脈衝頁共用，穩態溫升才會一致
+constexpr double THERMAL_RATING_RISE_C = 10;
+
+// 銅導體在 temperature_C 的電阻 (Ohm)
+double copperResistance(double area_mm2, double length_mm, double temperature_C);
+
+// 由載流模型在 ratingRise_C 的工作點換算到環境的熱阻 (°C/W)：θ = ΔT / (I² R(Ta + ΔT))
+double traceThermalResistance(double width_mm, double thickness_mm, double length_mm, bool internal,
+                              TraceModel model, const Ipc2152Options &ipc,
+                              double ratingRise_C = THERMAL_RATING_RISE_C, double ambient_C = VIA_AMBIENT_C);
+double viaThermalResistance(double diameter_mm, double wallThick_mm, double boardThick_mm, TraceModel model,
+                            double ratingRise_C = THERMAL_RATING_RISE_C, double ambient_C = VIA_AMBIENT_C);
+
+struct SelfHeatingOptions {
+    double maxRise_C = 1000;            // 超過視為熱失控 (銅在 1085°C 熔化)
+    double tolerance_C = 1e-6;          // 溫升的收斂條件
+    int maxIterations = 100;
+    unsigned threads = 0;               // 批次：0 = 全部硬體執行緒
+};
+
+// 一條走線或一顆貫孔：電流、到環境的熱阻、20°C 的電阻與環境溫度
+struct SelfHeatingLane {
+    double current_A = 0;
+    double theta_C_per_W = 0;
+    double resistance20_ohm = 0;
+    double ambient_C = VIA_AMBIENT_C;
+};
+
+SelfHeatingLane traceSelfHeatingLane(double current_A, double width_mm, double thickness_mm, double length_mm,
+                                     bool internal, TraceModel model, const Ipc2152Options &ipc,
+                                     double ambient_C = VIA_AMBIENT_C,
+                                     double ratingRise_C = THERMAL_RATING_RISE_C);
+
+SelfHeatingLane viaSelfHeatingLane(double current_A, double diameter_mm, double wallThick_mm,
+                                   double boardThick_mm, TraceModel model, double ambient_C = VIA_AMBIENT_C,
+                                   double ratingRise_C = THERMAL_RATING_RISE_C);
+
+enum class SelfHeatingStatus : unsigned char {
+    Converged,
+    Runaway,                            // 沒有固定點或超過 maxRise_C：結果欄位是 NaN
+    NotConverged,                       // maxIterations 用完 (非常接近熱失控的邊界)：結果是最後一次的值
+};
+
+struct SelfHeatingResult {
+    double deltaT = 0;                  // 自洽溫升 (°C)
+    double resistance_ohm = 0;          // 該溫度下的電阻
+    double voltageDrop_V = 0;
+    double power_W = 0;
+    int iterations = 0;
+    SelfHeatingStatus status = SelfHeatingStatus::Converged;
+};
+
+SelfHeatingResult selfHeatingSolve(const SelfHeatingLane &lane, const SelfHeatingOptions &options = {});
+
+// 批次 (struct-of-arrays)：每個欄位都是長度 n 的連續陣列
+struct SelfHeatingBatchIn {
+    const double *current_A;
+    const double *theta_C_per_W;
+    const double *resistance20_ohm;
+    const double *ambient_C;
+};
+
+struct SelfHeatingBatchOut {
+    double *deltaT;
+    double *resistance_ohm;
+    double *voltageDrop_V;
+    double *power_W;
+    SelfHeatingStatus *status;
+};
+
+// 回傳熱失控的數量
+std::size_t selfHeatingSolveBatch(const SelfHeatingBatchIn &in, const SelfHeatingBatchOut &out, std::size_t n,
+                                  const SelfHeatingOptions &options = {});
+
+} // namespace sc
+
+#endif // SC_SELFHEATING_H
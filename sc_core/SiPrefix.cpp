@@ -0,0 +1,38 @@
+#include "SiPrefix.h"
+
+namespace sc {
+
+namespace {
+
+const SiPrefix PREFIXES[] = {
+    {"q", "quecto", -30}, {"r", "ronto", -27}, {"y", "yocto", -24}, {"z", "zepto", -21},
+    {"a", "atto",   -18}, {"f", "femto", -15}, {"p", "pico",  -12}, {"n", "nano",   -9},
+    {"u", "micro",   -6}, {"m", "milli",  -3}, {"",  "",        0}, {"k", "kilo",    3},
+    {"M", "mega",     6}, {"G", "giga",    9}, {"T", "tera",   12}, {"P", "peta",   15},
+    {"E", "exa",     18}, {"Z", "zetta",  21}, {"Y", "yotta",  24}, {"R", "ronna",  27},
+    {"Q", "quetta",  30},
+};
+
+} // namespace
+
+const SiPrefix *siPrefixes() { return PREFIXES; }
+
+std::size_t siPrefixCount() { return sizeof(PREFIXES) / sizeof(PREFIXES[0]); }
+
+bool siPrefixExponent(std::string_view symbol, int &exponent)
+{
+    // 常見的別名
+    if (symbol == "1") { exponent = 0; return true; }
+    if (symbol == "K") { exponent = 3; return true; }
+    if (symbol == "\xC2\xB5" || symbol == "\xCE\xBC") { exponent = -6; return true; }  // µ (U+00B5) / μ (U+03BC)
+
+    for (const SiPrefix &p : PREFIXES) {
+        if (symbol == p.symbol || symbol == p.name) {
+            exponent = p.exponent;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace sc
@@ -0,0 +1,25 @@
+#ifndef SC_SIPREFIX_H
+#define SC_SIPREFIX_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace sc {
+
+// 完整的 SI 前綴 (quecto 10⁻³⁰ ~ quetta 10³⁰)，依指數由小到大排列
+struct SiPrefix {
+    const char *symbol;   // "q", "r", ..., "", "k", ..., "Q"
+    const char *name;     // "quecto", ..., "quetta"
+    int exponent;
+};
+
+const SiPrefix *siPrefixes();
+std::size_t siPrefixCount();
+
+// 由符號查指數："u" / "µ" / "μ" -> -6，"" / "1" -> 0，"K" 視同 "k"
+// 找不到時回傳 false
+bool siPrefixExponent(std::string_view symbol, int &exponent);
+
+} // namespace sc
+
+#endif // SC_SIPREFIX_H
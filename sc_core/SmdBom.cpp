@@ -0,0 +1,125 @@
+/**
+ * @file SmdBom.cpp
+ * @brief 大量 SMD 代碼的平行解析
+ *
+ * 【 流程 】
+ * 1. 輸入切成數個區塊，切點往後對齊到下一個 '\n'，每列完整落在單一區塊。
+ * 2. 各執行緒以 string_view 逐列取出代碼欄位並解析，結果寫入自己的區塊緩衝區，
+ *    過程中不建立任何字串。
+ * 3. 依區塊順序合併，並把區塊內的列編號換算成檔案行號。
+ */
+
+#include "SmdBom.h"
+#include "CsvScale.h"
+#include "Parallel.h"
+#include "SmdCode.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace sc {
+
+namespace {
+
+// 每個區塊至少這麼大，避免小檔案被切得太碎
+constexpr std::size_t MIN_BLOCK_BYTES = std::size_t(64) << 10;
+// 每個執行緒分到的區塊數，讓動態分配可以平衡各區塊的解析成本
+constexpr unsigned BLOCKS_PER_THREAD = 4;
+
+struct BlockResult {
+    std::vector<double> values;
+    std::vector<SmdBomFailure> failures;     // line 暫存區塊內的列索引
+};
+
+const char *nextLineStart(const char *p, const char *end)
+{
+    if (p >= end) return end;
+    const void *nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+    return nl ? static_cast<const char *>(nl) + 1 : end;
+}
+
+bool isBlankLine(const char *p, const char *end)
+{
+    for (; p != end; ++p) {
+        if (*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') return false;
+    }
+    return true;
+}
+
+void decodeBlock(const SmdBomOptions &opt, const char *begin, const char *end, BlockResult &r)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const char *line = begin;
+    while (line < end) {
+        const char *next = nextLineStart(line, end);
+        const std::size_t row = r.values.size();
+        if (isBlankLine(line, next)) {
+            r.values.push_back(nan);
+        } else {
+            std::string_view code = csvFieldView(std::string_view(line, static_cast<std::size_t>(next - line)),
+                                                 opt.delimiter, opt.column);
+            double v = 0;
+            if (decodeSmdCodeStrict(code, v)) {
+                r.values.push_back(v);
+            } else {
+                r.values.push_back(nan);
+                r.failures.push_back({row, code});
+            }
+        }
+        line = next;
+    }
+}
+
+} // namespace
+
+SmdBomResult decodeSmdBom(std::string_view input, const SmdBomOptions &options)
+{
+    SmdBomResult result;
+    const char *p = input.data();
+    const char *end = p + input.size();
+
+    std::size_t firstLine = 1;
+    if (options.hasHeader && p != end) {
+        p = nextLineStart(p, end);
+        firstLine = 2;
+    }
+
+    // 1. 切出區塊邊界 (對齊列尾)
+    const unsigned threads = options.threads ? options.threads : hardwareThreads();
+    const std::size_t bytes = static_cast<std::size_t>(end - p);
+    const std::size_t block = std::max(MIN_BLOCK_BYTES, bytes / (std::size_t(threads) * BLOCKS_PER_THREAD) + 1);
+    std::vector<const char *> bounds{p};
+    while (bounds.back() < end) {
+        const char *from = bounds.back();
+        const char *target = (static_cast<std::size_t>(end - from) > block) ? from + block : end;
+        bounds.push_back(target == end ? end : nextLineStart(target, end));
+    }
+    const std::size_t blocks = bounds.size() - 1;
+
+    // 2. 平行解析
+    std::vector<BlockResult> partial(blocks);
+    parallelFor(blocks, threads, [&](std::size_t i) {
+        BlockResult &r = partial[i];
+        // 以平均每列 16 bytes 粗估，減少重新配置
+        r.values.reserve(static_cast<std::size_t>(bounds[i + 1] - bounds[i]) / 16 + 16);
+        decodeBlock(options, bounds[i], bounds[i + 1], r);
+    });
+
+    // 3. 依原順序合併，列索引換成檔案行號
+    std::size_t rows = 0, failures = 0;
+    for (const BlockResult &r : partial) {
+        rows += r.values.size();
+        failures += r.failures.size();
+    }
+    result.values.reserve(rows);
+    result.failures.reserve(failures);
+    for (const BlockResult &r : partial) {
+        const std::size_t base = firstLine + result.values.size();
+        for (const SmdBomFailure &f : r.failures) result.failures.push_back({base + f.line, f.code});
+        result.values.insert(result.values.end(), r.values.begin(), r.values.end());
+    }
+    return result;
+}
+
+} // namespace sc
@@ -0,0 +1,34 @@
+#ifndef SC_SMDBOM_H
+#define SC_SMDBOM_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+// 整份 BOM / 置件檔的 SMD 代碼正規化
+struct SmdBomOptions {
+    char delimiter = ',';
+    bool hasHeader = false;          // 第一列是標題，不解析
+    std::size_t column = 0;          // 代碼所在欄位 (0 起算)；每列一個代碼的純文字檔用 0
+    unsigned threads = 0;            // 0 = 全部硬體執行緒
+};
+
+struct SmdBomFailure {
+    std::size_t line;                // 檔案中的行號 (1 起算，含標題列)
+    std::string_view code;           // 指向輸入內容，不另外複製
+};
+
+struct SmdBomResult {
+    std::vector<double> values;              // 每個資料列一筆 (Ohm / pF)，失敗或空白列為 NaN
+    std::vector<SmdBomFailure> failures;     // 依行號排序
+};
+
+// input 通常是 MappedFile::view()，回傳的 failures 會指向 input，使用期間 input 必須有效。
+// 代碼以 decodeSmdCodeStrict 解析；完全空白的列不算失敗
+SmdBomResult decodeSmdBom(std::string_view input, const SmdBomOptions &options);
+
+} // namespace sc
+
+#endif // SC_SMDBOM_H
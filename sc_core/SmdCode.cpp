@@ -0,0 +1,154 @@
+/**
+ * @file SmdCode.cpp
+ * @brief SMD 電阻/電容代碼解析 - 不依賴 Qt 的核心實現
+ *
+ * 【 1. 一般解析 (decodeSmdCode，GUI 輸入框用) 】
+ * 0. EIA-96 代碼查表 (01C = 10k)
+ * 1. 帶有 R / P / N 的代碼把字母當成小數點 (4R7 = 4.7)
+ * 2. 三位數以上：最後一碼是 10 的次方，其餘為有效數字 (103 = 10 * 10^3)
+ * 3. 兩位數以下直接視為數值
+ *
+ * 【 2. 嚴格解析 (decodeSmdCodeStrict，BOM 批次用) 】
+ * 只接受真正的代碼格式，其他內容一律回報失敗，讓呼叫端可以列出錯誤的列。
+ * 整個過程只掃描字元一次，不建立暫存字串，也不呼叫 std::pow。
+ */
+
+#include "SmdCode.h"
+#include "ESeries.h"
+#include "NumParse.h"
+#include "Units.h"
+
+#include <limits>
+
+namespace sc {
+
+namespace {
+
+constexpr double POW10_DIGIT[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool isDecimalMark(char c)
+{
+    return c == 'R' || c == 'r' || c == 'P' || c == 'p' || c == 'N' || c == 'n';
+}
+
+double toNumberOrZero(std::string_view text)
+{
+    double v = 0;
+    return parseNumber(text, v) ? v : 0;
+}
+
+// mant * 10^exp；負指數以除法計算，結果是最接近的 double (4R7 正好等於 4.7)
+inline double scalePow10(double mant, int exp)
+{
+    return (exp >= 0) ? mant * units::pow10(exp) : mant / units::pow10(-exp);
+}
+
+// RKM 字母的倍率 (10 的指數，電阻為 Ohm、電容為 pF)，不是 RKM 字母回傳 false
+bool rkmExponent(char c, int &exp)
+{
+    switch (c) {
+    case 'R': case 'r': case 'p': case 'P': exp = 0; return true;
+    case 'm': exp = -3; return true;
+    case 'K': case 'k': case 'n': case 'N': exp = 3; return true;
+    case 'M': case 'u': case 'U': exp = 6; return true;
+    case 'G': exp = 9; return true;
+    default: return false;
+    }
+}
+
+} // namespace
+
+double decodeSmdCode(std::string_view code)
+{
+    if (code.empty()) return 0;
+
+    // 0. EIA-96 代碼 (01C、68X)；結尾 R 仍視為小數點 (47R = 47)
+    double eia = 0;
+    if (code.back() != 'R' && eia96Decode(code, eia)) return eia;
+
+    // 1. 帶有小數點字母的代碼：在堆疊緩衝區內把字母換成 '.'
+    for (char c : code) {
+        if (isDecimalMark(c)) {
+            char temp[32];
+            if (code.size() >= sizeof(temp)) return 0;
+            for (std::size_t i = 0; i < code.size(); ++i)
+                temp[i] = isDecimalMark(code[i]) ? '.' : code[i];
+            return toNumberOrZero(std::string_view(temp, code.size()));
+        }
+    }
+
+    // 2. 標準三位數代碼：前幾位 * 10 的 (最後一碼) 次方
+    if (code.size() >= 3) {
+        char last = code.back();
+        int exponent = isDigit(last) ? last - '0' : 0;
+        double prefix = toNumberOrZero(code.substr(0, code.size() - 1));
+        return prefix * POW10_DIGIT[exponent];
+    }
+
+    return toNumberOrZero(code);
+}
+
+void decodeSmdCodeBatch(const std::string_view *codes, double *out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) out[i] = decodeSmdCode(codes[i]);
+}
+
+bool decodeSmdCodeStrict(std::string_view code, double &value)
+{
+    std::size_t b = 0, e = code.size();
+    while (b < e && (code[b] == ' ' || code[b] == '\t')) ++b;
+    while (e > b && (code[e - 1] == ' ' || code[e - 1] == '\t')) --e;
+    const char *s = code.data() + b;
+    const std::size_t n = e - b;
+    if (n == 0 || n > 8) return false;
+
+    // 找出唯一的非數字字元
+    std::size_t letterPos = n;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (isDigit(s[i])) continue;
+        if (letterPos != n) return false;
+        letterPos = i;
+    }
+
+    // 1. 純數字：1~2 位直接是數值，3 位 / 4 位最後一碼為 10 的次方
+    if (letterPos == n) {
+        if (n > 4) return false;
+        int mant = 0;
+        const std::size_t digits = (n >= 3) ? n - 1 : n;
+        for (std::size_t i = 0; i < digits; ++i) mant = mant * 10 + (s[i] - '0');
+        value = (n >= 3) ? mant * POW10_DIGIT[s[n - 1] - '0'] : mant;
+        return true;
+    }
+
+    // 2. EIA-96：兩位數索引 + 倍率字母 (編譯期完美雜湊表)
+    if (n == 3 && letterPos == 2 && s[2] != 'R' && eia96Decode(std::string_view(s, 3), value))
+        return true;
+
+    // 3. RKM：字母兩側是整數與小數部分，數字串當成整數再乘上 10 的次方
+    int exp = 0;
+    if (n < 2 || !rkmExponent(s[letterPos], exp)) return false;
+    double mant = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i != letterPos) mant = mant * 10 + (s[i] - '0');
+    }
+    value = scalePow10(mant, exp - static_cast<int>(n - 1 - letterPos));
+    return true;
+}
+
+std::size_t decodeSmdCodeStrictBatch(const std::string_view *codes, double *out, bool *ok, std::size_t n)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        double v = 0;
+        bool good = decodeSmdCodeStrict(codes[i], v);
+        out[i] = good ? v : nan;
+        if (ok) ok[i] = good;
+        if (!good) ++failed;
+    }
+    return failed;
+}
+
+} // namespace sc
@@ -0,0 +1,34 @@
+#ifndef SC_SMDCODE_H
+#define SC_SMDCODE_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace sc {
+
+// 解析 SMD 代碼，回傳基準單位數值 (電阻為 Ohm, 電容為 pF)
+//  - EIA-96 代碼：01C = 10k、68X = 49.9
+//  - 小數點代碼：4R7 / 4p7 / 1n2 (R、P、N 視為小數點)
+//  - 三位/四位數代碼：103 = 10 * 10^3
+// 無法解析時回傳 0
+double decodeSmdCode(std::string_view code);
+
+// 批次解析：codes 與 out 皆為長度 n 的連續陣列
+void decodeSmdCodeBatch(const std::string_view *codes, double *out, std::size_t n);
+
+// 嚴格解析 (BOM 正規化用)，不配置記憶體；無法辨識時回傳 false
+//  - 三位數 103 = 10 * 10^3、四位數 1002 = 100 * 10^2 (Ohm)
+//  - RKM：R 為小數點 (4R7、R47、47R)，K/M/G/m 同時是小數點與倍率 (4K7、2M2)，單位 Ohm；
+//         p/n/u 為電容 (4p7、1n2、2u2)，換算成 pF
+//  - EIA-96：兩位數索引 + 倍率字母 (01C = 100 * 100)，倍率 Z Y X S A B H C D E F；
+//            R 不當 EIA-96 倍率 (與 RKM 的 10R、47R 衝突)
+// 前後空白會被忽略
+bool decodeSmdCodeStrict(std::string_view code, double &value);
+
+// 批次嚴格解析：失敗的項目 out 為 NaN、ok 為 false (ok 可為 nullptr)
+// 回傳失敗的數量
+std::size_t decodeSmdCodeStrictBatch(const std::string_view *codes, double *out, bool *ok, std::size_t n);
+
+} // namespace sc
+
+#endif // SC_SMDCODE_H
@@ -0,0 +1,285 @@
+/**
+ * @file ThermalVia.cpp
+ * @brief 散熱孔陣列熱阻網路：帶狀 Cholesky (含焊墊的外框列) 分解一次，多次求解
+ *
+ * 【 1. 排列 】
+ * 單元依短邊方向連續編號 (cols <= rows 時 r * cols + c，否則轉置)，每個單元的各層節點相鄰，
+ * 橫向鄰格的索引差為 層數 或 短邊 * 層數，所以下三角的頻寬 = 短邊 * 層數。
+ * 理想散熱器時底層銅是固定溫度，不是未知數。
+ *
+ * 【 2. 分解 】
+ * 焊墊節點和頂層所有單元耦合，放進帶狀矩陣會破壞頻寬，所以寫成外框形式
+ *   [ B  c ] [ x ]   [ f ]
+ *   [ cᵀ d ] [ y ] = [ g ]
+ * B = L Lᵀ 是帶狀 Cholesky (逐列計算，內層是兩列的連續內積)，再預先算好 w = L⁻¹ c、s = d - w·w。
+ * 求解：z = L⁻¹ f，y = (g - w·z) / s，x = L⁻ᵀ (z - w y)，成本 O(節點數 * 頻寬)。
+ * 分解 O(節點數 * 頻寬²)：50 x 50 顆、4 層銅、理想散熱器 (7500 節點、頻寬 150) 約 0.08 秒，單次求解約 3 毫秒。
+ */
+
+#include "ThermalVia.h"
+#include "ScConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sc {
+
+ThermalViaStack evenThermalStack(int layers, double board_mm, double outerCopper_mm, double innerCopper_mm,
+                                 double innerCoverage)
+{
+    ThermalViaStack s;
+    layers = std::max(layers, 2);
+    s.copper_mm.assign(static_cast<std::size_t>(layers), innerCopper_mm);
+    s.copper_mm.front() = s.copper_mm.back() = outerCopper_mm;
+    s.coverage.assign(static_cast<std::size_t>(layers), innerCoverage);
+    s.coverage.front() = s.coverage.back() = 1;
+    double copper = 0;
+    for (double t : s.copper_mm) copper += t;
+    s.dielectric_mm.assign(static_cast<std::size_t>(layers - 1), (board_mm - copper) / (layers - 1));
+    return s;
+}
+
+struct ThermalViaField::Impl {
+    bool valid = false;
+    int rows = 0;
+    int cols = 0;
+    int layers = 0;                     // 銅層數
+    int unknownLayers = 0;              // 理想散熱器時少一層
+    int inner = 0;                      // 短邊的單元數
+    std::size_t n = 0;
+    std::size_t bw = 0;
+
+    double gPad = 0;                    // 每個單元：焊墊 -> 頂層
+    double gBottom = 0;                 // 每個單元：底層 -> 參考溫度 (hBottom > 0)
+    std::vector<double> gVert;          // 層 l -> l + 1
+    std::vector<double> gBarrel;        // gVert 中孔壁與塞孔的部分
+    std::vector<double> gLat;           // 層內相鄰單元
+
+    std::vector<double> band;           // 下三角帶狀 Cholesky 因子：列 i 的欄 i - bw .. i
+    std::vector<double> w;              // L⁻¹ c
+    double schur = 0;                   // d - w·w
+
+    std::size_t cellOrder(int r, int c) const
+    {
+        return (cols <= rows) ? static_cast<std::size_t>(r) * cols + c : static_cast<std::size_t>(c) * rows + r;
+    }
+    double &at(std::size_t i, std::size_t j) { return band[i * (bw + 1) + (j + bw - i)]; }
+    double at(std::size_t i, std::size_t j) const { return band[i * (bw + 1) + (j + bw - i)]; }
+
+    void assemble();
+    bool factor();
+    void forward(std::vector<double> &v) const;     // v <- L⁻¹ v
+    void backward(std::vector<double> &v) const;    // v <- L⁻ᵀ v
+};
+
+void ThermalViaField::Impl::assemble()
+{
+    band.assign(n * (bw + 1), 0.0);
+    const int outer = (cols <= rows) ? rows : cols;
+    for (int a = 0; a < outer; ++a) {
+        for (int b = 0; b < inner; ++b) {
+            const std::size_t o = static_cast<std::size_t>(a) * inner + b;
+            // 四個方向的鄰格數 (邊、角的單元較少)
+            const int neighbours = (a > 0) + (a + 1 < outer) + (b > 0) + (b + 1 < inner);
+            for (int l = 0; l < unknownLayers; ++l) {
+                const std::size_t i = o * unknownLayers + l;
+                double diag = neighbours * gLat[l];
+                if (l == 0) diag += gPad;
+                if (l > 0) {
+                    diag += gVert[l - 1];
+                    at(i, i - 1) = -gVert[l - 1];
+                }
+                if (l + 1 < layers) diag += gVert[l];       // 含接到固定溫度底層的那一段
+                if (l == layers - 1) diag += gBottom;
+                at(i, i) = diag;
+                if (b > 0) at(i, i - unknownLayers) = -gLat[l];
+                if (a > 0) at(i, i - static_cast<std::size_t>(inner) * unknownLayers) = -gLat[l];
+            }
+        }
+    }
+}
+
+bool ThermalViaField::Impl::factor()
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j0 = (i > bw) ? i - bw : 0;
+        for (std::size_t j = j0; j <= i; ++j) {
+            // 兩列在 [max(i, j) - bw, j) 的重疊部分
+            const std::size_t k0 = std::max(j0, (j > bw) ? j - bw : 0);
+            const double *li = &band[i * (bw + 1) + (k0 + bw - i)];
+            const double *lj = &band[j * (bw + 1) + (k0 + bw - j)];
+            double s = at(i, j);
+            for (std::size_t k = 0; k < j - k0; ++k) s -= li[k] * lj[k];
+            if (j < i) {
+                at(i, j) = s / at(j, j);
+            } else {
+                if (!(s > 0)) return false;
+                at(i, i) = std::sqrt(s);
+            }
+        }
+    }
+    return true;
+}
+
+void ThermalViaField::Impl::forward(std::vector<double> &v) const
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j0 = (i > bw) ? i - bw : 0;
+        const double *li = &band[i * (bw + 1) + (j0 + bw - i)];
+        double s = v[i];
+        for (std::size_t k = 0; k < i - j0; ++k) s -= li[k] * v[j0 + k];
+        v[i] = s / at(i, i);
+    }
+}
+
+void ThermalViaField::Impl::backward(std::vector<double> &v) const
+{
+    for (std::size_t i = n; i-- > 0;) {
+        v[i] /= at(i, i);
+        const std::size_t j0 = (i > bw) ? i - bw : 0;
+        const double *li = &band[i * (bw + 1) + (j0 + bw - i)];
+        const double vi = v[i];
+        for (std::size_t k = 0; k < i - j0; ++k) v[j0 + k] -= li[k] * vi;
+    }
+}
+
+ThermalViaField::ThermalViaField(const ThermalViaStack &stack, const ThermalViaArray &array,
+                                 const ThermalViaBoundary &boundary) :
+    d(new Impl)
+{
+    Impl &m = *d;
+    const int layers = static_cast<int>(stack.copper_mm.size());
+    if (array.rows < 1 || array.cols < 1 || layers < 2 ||
+        stack.dielectric_mm.size() != static_cast<std::size_t>(layers - 1) ||
+        (!stack.coverage.empty() && stack.coverage.size() != static_cast<std::size_t>(layers)))
+        return;
+    if (!(array.pitch_mm > 0) || !(array.drill_mm > 0) || !(array.wall_mm > 0) || !(array.kFill >= 0) ||
+        !(stack.kCopper > 0) || !(stack.kDielectric >= 0) || !(boundary.solder_mm > 0) || !(boundary.kSolder > 0))
+        return;
+    for (double t : stack.copper_mm) {
+        if (!(t > 0)) return;
+    }
+    for (double t : stack.dielectric_mm) {
+        if (!(t > 0)) return;
+    }
+
+    // SI 單位 (m、W/K)
+    const double p = array.pitch_mm * 1e-3;
+    const double D = array.drill_mm * 1e-3;
+    const double t = array.wall_mm * 1e-3;
+    const double cell = p * p;
+    const double barrel = PI * (D + t) * t;
+    const double fill = 0.25 * PI * D * D;
+    const double hole = 0.25 * PI * (D + 2 * t) * (D + 2 * t);
+    if (hole >= cell) return;       // 中心距小於孔外徑
+
+    m.rows = array.rows;
+    m.cols = array.cols;
+    m.layers = layers;
+    m.unknownLayers = (boundary.hBottom > 0) ? layers : layers - 1;
+    m.inner = std::min(array.rows, array.cols);
+    m.n = static_cast<std::size_t>(array.rows) * array.cols * m.unknownLayers;
+    m.bw = static_cast<std::size_t>(m.inner) * m.unknownLayers;
+
+    m.gPad = boundary.kSolder * cell / (boundary.solder_mm * 1e-3);
+    m.gBottom = (boundary.hBottom > 0) ? boundary.hBottom * cell : 0;
+    for (int l = 0; l < layers; ++l) {
+        const double cu = stack.copper_mm[l] * 1e-3;
+        const double coverage = stack.coverage.empty() ? 1.0 : std::clamp(stack.coverage[l], 0.0, 1.0);
+        m.gLat.push_back(stack.kCopper * cu * coverage);
+        if (l + 1 < layers) {
+            const double gap = stack.dielectric_mm[l] * 1e-3;
+            const double length = gap + 0.5 * (cu + stack.copper_mm[l + 1] * 1e-3);
+            const double g = (stack.kCopper * barrel + array.kFill * fill) / length;
+            m.gBarrel.push_back(g);
+            m.gVert.push_back(g + stack.kDielectric * (cell - hole) / gap);
+        }
+    }
+
+    m.assemble();
+    if (!m.factor()) return;
+
+    // 外框：c = -gPad (頂層)，d = 單元數 * gPad
+    m.w.assign(m.n, 0.0);
+    for (std::size_t o = 0; o < m.n / m.unknownLayers; ++o) m.w[o * m.unknownLayers] = -m.gPad;
+    m.forward(m.w);
+    double ww = 0;
+    for (double v : m.w) ww += v * v;
+    m.schur = static_cast<double>(array.rows) * array.cols * m.gPad - ww;
+    m.valid = m.schur > 0;
+}
+
+ThermalViaField::~ThermalViaField() = default;
+
+bool ThermalViaField::valid() const
+{
+    return d->valid;
+}
+
+std::size_t ThermalViaField::nodes() const
+{
+    return d->valid ? d->n + 1 : 0;
+}
+
+std::size_t ThermalViaField::bandwidth() const
+{
+    return d->bw;
+}
+
+int ThermalViaField::layers() const
+{
+    return d->layers;
+}
+
+ThermalViaSolution ThermalViaField::solve(double padPower_W, const std::vector<double> &cellHeat_W) const
+{
+    ThermalViaSolution s;
+    const Impl &m = *d;
+    if (!m.valid) return s;
+    const std::size_t cells = static_cast<std::size_t>(m.rows) * m.cols;
+    const int Lu = m.unknownLayers;
+
+    // 右手邊：頂層的熱源 (依自然順序給，換成求解順序)
+    std::vector<double> z(m.n, 0.0);
+    s.totalPower_W = padPower_W;
+    if (cellHeat_W.size() == cells) {
+        for (int r = 0; r < m.rows; ++r) {
+            for (int c = 0; c < m.cols; ++c) {
+                const double q = cellHeat_W[static_cast<std::size_t>(r) * m.cols + c];
+                z[m.cellOrder(r, c) * Lu] = q;
+                s.totalPower_W += q;
+            }
+        }
+    }
+    m.forward(z);
+    double wz = 0;
+    for (std::size_t i = 0; i < m.n; ++i) wz += m.w[i] * z[i];
+    const double pad = (padPower_W - wz) / m.schur;
+    for (std::size_t i = 0; i < m.n; ++i) z[i] -= m.w[i] * pad;
+    m.backward(z);
+
+    // 依自然順序整理輸出
+    s.padRise_C = pad;
+    s.rise_C.assign(cells * m.layers, 0.0);
+    s.viaHeat_W.resize(cells);
+    s.viaBarrelHeat_W.resize(cells);
+    double bottomSum = 0;
+    for (int r = 0; r < m.rows; ++r) {
+        for (int c = 0; c < m.cols; ++c) {
+            const std::size_t k = static_cast<std::size_t>(r) * m.cols + c;
+            const double *x = &z[m.cellOrder(r, c) * Lu];
+            double *rise = &s.rise_C[k * m.layers];
+            for (int l = 0; l < Lu; ++l) rise[l] = x[l];
+            s.viaHeat_W[k] = m.gPad * (pad - rise[0]);
+            s.viaBarrelHeat_W[k] = m.gBarrel[0] * (rise[0] - rise[1]);
+            bottomSum += rise[m.layers - 1];
+        }
+    }
+    if (s.totalPower_W != 0) {
+        s.thetaPadBottom = (pad - bottomSum / cells) / s.totalPower_W;
+        s.thetaPadAmbient = pad / s.totalPower_W;
+    }
+    return s;
+}
+
+} // namespace sc
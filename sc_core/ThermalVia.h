@@ -0,0 +1,87 @@
+#ifndef SC_THERMALVIA_H
+#define SC_THERMALVIA_H
+
+/**
+ * @file ThermalVia.h
+ * @brief 散熱孔陣列 (QFN / 功率 MOSFET 的裸露焊墊下方) 的熱阻網路
+ *
+ * 焊墊下方 rows x cols 顆貫孔，中心距 p。每顆貫孔佔一個 p x p 的單元，每個單元在每一層銅各有一個節點：
+ *   垂直：相鄰銅層之間，孔壁銅 (π (D + t) t)、塞孔材料 (π D² / 4) 與單元內其餘的介質並聯；
+ *   橫向：同一層相鄰單元之間的銅 (k t x 覆蓋率，正方形單元與 p 無關)；
+ *   焊墊：封裝的裸露焊墊視為等溫節點，經焊錫層接到頂層每個單元；
+ *   底面：底層銅經 hBottom 接到散熱器 / 環境，hBottom <= 0 時底層銅固定在參考溫度 (理想散熱器)。
+ * 範圍只到陣列 (焊墊) 本身，陣列外的銅平面擴散不計，結果偏保守。
+ *
+ * 節點數 rows * cols * 層數 + 1 (焊墊)。節點依 (單元, 層) 排列、層在最內層，矩陣是頻寬
+ * min(rows, cols) * 層數 的帶狀矩陣加上焊墊的一列 (bordered band)：建構時做一次帶狀 Cholesky 分解並快取，
+ * 之後每個功率 / 熱源分布只需要前代、回代。
+ */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace sc {
+
+struct ThermalViaStack {
+    std::vector<double> copper_mm = { 0.035, 0.035 };   // 各銅層厚度，由上 (焊墊層) 到下，至少 2 層
+    std::vector<double> coverage;                       // 各銅層在陣列範圍內的覆蓋率 (0 ~ 1)，空白 = 全部 1
+    std::vector<double> dielectric_mm = { 1.53 };       // 相鄰銅層之間的介質厚度 (copper_mm.size() - 1 個)
+    double kCopper = 385;                               // W/(m·K)
+    double kDielectric = 0.3;                           // 介質厚度方向
+};
+
+// 板厚平均分給 layers - 1 層介質，外層 / 內層銅厚與內層覆蓋率 (內層電源 / 地平面)
+ThermalViaStack evenThermalStack(int layers, double board_mm, double outerCopper_mm, double innerCopper_mm,
+                                 double innerCoverage = 1);
+
+struct ThermalViaArray {
+    int rows = 3;
+    int cols = 3;
+    double pitch_mm = 1.0;
+    double drill_mm = 0.3;              // 成品孔徑
+    double wall_mm = 0.025;             // 孔壁電鍍厚度
+    double kFill = 0;                   // 塞孔材料：0 空氣、約 0.25 樹脂、3 ~ 8 導熱膠、385 填銅
+};
+
+struct ThermalViaBoundary {
+    double solder_mm = 0.05;            // 裸露焊墊與頂層銅之間的焊錫厚度
+    double kSolder = 50;                // W/(m·K)，SAC305 約 58
+    double hBottom = 0;                 // 底層銅到散熱器 / 環境 (W/(m²·K))，<= 0 = 理想散熱器
+};
+
+struct ThermalViaSolution {
+    double totalPower_W = 0;
+    double padRise_C = 0;               // 焊墊相對參考溫度 (散熱器 / 環境) 的溫升
+    double thetaPadBottom = 0;          // (焊墊 - 底層銅平均) / 功率 (°C/W)
+    double thetaPadAmbient = 0;         // 焊墊 / 功率；理想散熱器時與 thetaPadBottom 相同
+    std::vector<double> viaHeat_W;      // 各單元從焊墊流入的熱 (rows x cols，列優先)
+    std::vector<double> viaBarrelHeat_W;    // 各單元第一層介質中由孔壁與塞孔帶走的部分
+    std::vector<double> rise_C;         // 節點溫升：(單元 * 層數 + 層)
+};
+
+class ThermalViaField
+{
+public:
+    ThermalViaField(const ThermalViaStack &stack, const ThermalViaArray &array, const ThermalViaBoundary &boundary);
+    ~ThermalViaField();
+    ThermalViaField(const ThermalViaField &) = delete;
+    ThermalViaField &operator=(const ThermalViaField &) = delete;
+
+    // 輸入無效 (尺寸不是正數、層數不符…) 時為 false，solve 回傳全 0 的結果
+    bool valid() const;
+    std::size_t nodes() const;
+    std::size_t bandwidth() const;
+    int layers() const;
+
+    // padPower_W 由等溫焊墊流入；cellHeat_W (rows x cols，可以空白) 直接加在頂層各單元 (例如晶片熱點)
+    ThermalViaSolution solve(double padPower_W, const std::vector<double> &cellHeat_W = {}) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> d;
+};
+
+} // namespace sc
+
+#endif // SC_THERMALVIA_H
@@ -0,0 +1,83 @@
+/**
+ * @file TraceCalc.cpp
+ * @brief PCB 走線電流計算 (IPC-2221) - 不依賴 Qt 的核心實現
+ *
+ * 公式：I = k * ΔT^0.44 * A^0.725
+ *   - I：電流 (A)
+ *   - ΔT：允許溫升 (°C)
+ *   - A：截面積 (mil²)
+ *   - k：外層 0.048，內層 0.024
+ *
+ * 電阻：R = ρ * L / A，ρ = ρ20 * (1 + α * ΔT)
+ * 呼叫端需確保 deltaT 與銅厚為正值。
+ */
+
+#include "TraceCalc.h"
+
+#include <cmath>
+
+namespace sc {
+
+double traceCurrentFromWidth(double width_mm, double thickness_mm, double deltaT, double k)
+{
+    double area_mil2 = (width_mm / MM_PER_MIL) * (thickness_mm / MM_PER_MIL);
+    return k * std::pow(deltaT, 0.44) * std::pow(area_mil2, 0.725);
+}
+
+double traceWidthFromCurrent(double current_A, double thickness_mm, double deltaT, double k)
+{
+    double area_mil2 = std::pow(current_A / (k * std::pow(deltaT, 0.44)), 1.0 / 0.725);
+    return (area_mil2 / (thickness_mm / MM_PER_MIL)) * MM_PER_MIL;
+}
+
+double traceTempRise(double current_A, double width_mm, double thickness_mm, double k)
+{
+    double area_mil2 = (width_mm / MM_PER_MIL) * (thickness_mm / MM_PER_MIL);
+    return std::pow(current_A / (k * std::pow(area_mil2, 0.725)), 1.0 / 0.44);
+}
+
+double traceResistance(double width_mm, double thickness_mm, double length_mm, double deltaT)
+{
+    // 銅電阻率單位是 Ohm-mm，長度、截面積都用 mm
+    double rho = COPPER_RHO_OHM_MM * (1 + COPPER_ALPHA * deltaT);
+    return rho * length_mm / (width_mm * thickness_mm);
+}
+
+TraceResult traceSolve(double current_A, double thickness_mm, double deltaT, double length_mm)
+{
+    TraceResult r;
+    r.widthExt_mm = traceWidthFromCurrent(current_A, thickness_mm, deltaT, IPC2221_K_EXTERNAL);
+    r.widthInt_mm = traceWidthFromCurrent(current_A, thickness_mm, deltaT, IPC2221_K_INTERNAL);
+    r.resistance_ohm = traceResistance(r.widthExt_mm, thickness_mm, length_mm, deltaT);
+    r.voltageDrop_V = current_A * r.resistance_ohm;
+    r.power_W = current_A * current_A * r.resistance_ohm;
+    return r;
+}
+
+void traceSolveBatch(const TraceBatchIn &in, const TraceBatchOut &out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        TraceResult r = traceSolve(in.current_A[i], in.thickness_mm[i], in.deltaT[i], in.length_mm[i]);
+        out.widthExt_mm[i] = r.widthExt_mm;
+        out.widthInt_mm[i] = r.widthInt_mm;
+        out.resistance_ohm[i] = r.resistance_ohm;
+        out.voltageDrop_V[i] = r.voltageDrop_V;
+        out.power_W[i] = r.power_W;
+    }
+}
+
+Interval traceCurrentInterval(const Interval &width_mm, const Interval &thickness_mm, const Interval &deltaT, double k)
+{
+    const Interval area_mil2 = (width_mm / MM_PER_MIL) * (thickness_mm / MM_PER_MIL);
+    return k * pow(deltaT, 0.44) * pow(area_mil2, 0.725);
+}
+
+Interval traceResistanceInterval(const Interval &width_mm, const Interval &thickness_mm,
+                                 const Interval &length_mm, const Interval &deltaT)
+{
+    // 與 traceResistance 相同的 mm 單位，各變數只出現一次
+    const Interval rho = COPPER_RHO_OHM_MM * (COPPER_ALPHA * deltaT + 1.0);
+    return rho * length_mm / (width_mm * thickness_mm);
+}
+
+} // namespace sc
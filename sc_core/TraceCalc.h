@@ -0,0 +1,70 @@
+#ifndef SC_TRACECALC_H
+#define SC_TRACECALC_H
+
+#include "Interval.h"
+#include "ScConstants.h"
+
+#include <cstddef>
+
+namespace sc {
+
+// IPC-2221 係數：外層 0.048、內層 0.024
+constexpr double IPC2221_K_EXTERNAL = 0.048;
+constexpr double IPC2221_K_INTERNAL = 0.024;
+
+// 走線頁的環境溫度 (°C)：traceResistance 的溫升以 20°C 的電阻率為基準
+constexpr double TRACE_AMBIENT_C = 20.0;
+
+// 由線寬反推最大電流 (A)：I = k * dT^0.44 * Area^0.725 (Area 為 mil²)
+double traceCurrentFromWidth(double width_mm, double thickness_mm, double deltaT, double k);
+
+// 由電流求線寬 (mm)
+double traceWidthFromCurrent(double current_A, double thickness_mm, double deltaT, double k);
+
+// 給定電流與線寬求溫升 (°C)：ΔT = (I / (k * Area^0.725))^(1 / 0.44)
+double traceTempRise(double current_A, double width_mm, double thickness_mm, double k);
+
+// 走線電阻 (Ohm)，電阻率以溫升 deltaT 修正
+double traceResistance(double width_mm, double thickness_mm, double length_mm, double deltaT);
+
+struct TraceResult {
+    double widthExt_mm;
+    double widthInt_mm;
+    double resistance_ohm;   // 以外層線寬計算
+    double voltageDrop_V;
+    double power_W;
+};
+
+// 單筆計算：給定電流求內外層線寬，並以外層線寬算電阻/壓降/功耗
+TraceResult traceSolve(double current_A, double thickness_mm, double deltaT, double length_mm);
+
+// 批次計算 (struct-of-arrays)：每個欄位都是長度 n 的連續陣列
+struct TraceBatchIn {
+    const double *current_A;
+    const double *thickness_mm;
+    const double *deltaT;
+    const double *length_mm;
+};
+
+struct TraceBatchOut {
+    double *widthExt_mm;
+    double *widthInt_mm;
+    double *resistance_ohm;
+    double *voltageDrop_V;
+    double *power_W;
+};
+
+void traceSolveBatch(const TraceBatchIn &in, const TraceBatchOut &out, std::size_t n);
+
+// --- 最差情況 (區間運算)：線寬 (蝕刻)、銅厚 (電鍍)、溫升的範圍 ---
+
+// 載流能力的範圍 (A)
+Interval traceCurrentInterval(const Interval &width_mm, const Interval &thickness_mm, const Interval &deltaT, double k);
+
+// 走線電阻的範圍 (Ohm)
+Interval traceResistanceInterval(const Interval &width_mm, const Interval &thickness_mm,
+                                 const Interval &length_mm, const Interval &deltaT);
+
+} // namespace sc
+
+#endif // SC_TRACECALC_H
@@ -0,0 +1,613 @@
+/**
+ * @file TraceNetlist.cpp
+ * @brief 網路清單批次線寬計算 (串流、多執行緒、保持列順序)
+ *
+ * 【 1. CSV 】
+ * 與 CsvScale 相同的視窗流程：每個視窗 = 執行緒數 * chunkBytes，切點對齊到列尾，
+ * 各執行緒把自己的區塊算完寫到獨立的輸出字串，再依區塊順序寫出，記憶體用量與檔案大小無關。
+ * 欄位以 string_view 取出，過程中不建立字串。
+ *
+ * 【 2. JSON 】
+ * 語法只能循序掃描：主執行緒每次掃出一個視窗的物件 (欄位同樣是指向輸入的 string_view)，
+ * 再把這些物件分塊交給執行緒計算，之後同樣依順序寫出。
+ *
+ * 【 3. 行號 】
+ * 失敗的列先記區塊內的索引，寫出時換算成檔案行號。
+ *
+ * 【 4. 自洽溫升 】
+ * 區塊內先逐列求線寬，再把整塊的 lane 一次交給 selfHeatingSolveBatch (struct-of-arrays)，最後依序輸出。
+ */
+
+#include "TraceNetlist.h"
+#include "BufferedWriter.h"
+#include "CsvScale.h"
+#include "NumParse.h"
+#include "Parallel.h"
+#include "ScConstants.h"
+#include "SelfHeating.h"
+#include "TraceCalc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace sc {
+
+namespace {
+
+enum Field { NET, CURRENT, LAYER, OZ, LENGTH, DELTA_T, FIELD_COUNT };
+
+constexpr std::size_t NO_COLUMN = std::size_t(-1);
+
+// JSON 每個執行緒一次處理的物件數
+constexpr std::size_t JSON_ROWS_PER_BLOCK = 16384;
+
+// 輸出的結果欄位數：width, resistance, drop, power；自洽溫升另加 actualRise, actualDrop, actualPower
+constexpr std::size_t RESULT_COLUMNS = 4;
+constexpr std::size_t SELF_HEATING_COLUMNS = 3;
+
+struct FieldName {
+    Field field;
+    const char *name;
+};
+
+const FieldName FIELD_NAMES[] = {
+    { NET, "net" }, { NET, "name" },
+    { CURRENT, "current" }, { CURRENT, "current_a" },
+    { LAYER, "layer" },
+    { OZ, "oz" }, { OZ, "copper_oz" },
+    { LENGTH, "length" }, { LENGTH, "length_mm" },
+    { DELTA_T, "dt" }, { DELTA_T, "deltat" }, { DELTA_T, "deltat_c" }, { DELTA_T, "rise" },
+};
+
+const char *const LAYER_EXTERNAL[] = { "outer", "external", "ext", "top", "bottom", "外層" };
+const char *const LAYER_INTERNAL[] = { "inner", "internal", "int", "內層" };
+
+bool equalsIgnoreCase(std::string_view a, const char *b)
+{
+    const std::size_t n = std::strlen(b);
+    if (a.size() != n) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        char c = a[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != b[i]) return false;
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+int fieldForName(std::string_view name)
+{
+    name = trim(name);
+    for (const FieldName &f : FIELD_NAMES) {
+        if (equalsIgnoreCase(name, f.name)) return f.field;
+    }
+    return -1;
+}
+
+// 一個網路的原始欄位 (指向輸入內容)
+struct RawNet {
+    std::string_view text[FIELD_COUNT];
+    bool csvEscaped = false;                // 欄位來自 CSV：去掉外層雙引號，但內部的 "" 尚未還原
+};
+
+// 空白使用預設值；有內容但不是數字時回傳 false
+bool fieldNumber(std::string_view text, double fallback, double &out)
+{
+    if (trim(text).empty()) {
+        out = fallback;
+        return true;
+    }
+    return parseNumber(text, out);
+}
+
+bool fieldLayer(std::string_view text, bool &internal)
+{
+    text = trim(text);
+    internal = false;
+    if (text.empty()) return true;
+    for (const char *name : LAYER_EXTERNAL) {
+        if (equalsIgnoreCase(text, name)) return true;
+    }
+    for (const char *name : LAYER_INTERNAL) {
+        if (equalsIgnoreCase(text, name)) {
+            internal = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseNet(const RawNet &raw, const TraceNetlistOptions &opt, TraceNet &net)
+{
+    return parseNumber(raw.text[CURRENT], net.current_A) && net.current_A > 0 && std::isfinite(net.current_A)
+        && fieldLayer(raw.text[LAYER], net.internal)
+        && fieldNumber(raw.text[OZ], opt.defaultCopperOz, net.copperOz) && net.copperOz > 0
+        && fieldNumber(raw.text[LENGTH], 0.0, net.length_mm)
+        && fieldNumber(raw.text[DELTA_T], opt.defaultDeltaT, net.deltaT) && net.deltaT > 0;
+}
+
+// 文字欄位：含分隔符號或雙引號時加上雙引號 (內部的 " 變成 "")
+// csvEscaped 時內部已經是 "" 的跳脫形式，原樣寫出，不再重複跳脫
+void appendText(std::string &out, std::string_view text, char delimiter, bool csvEscaped)
+{
+    text = trim(text);
+    if (text.find(delimiter) == std::string_view::npos && text.find('"') == std::string_view::npos) {
+        out.append(text.data(), text.size());
+        return;
+    }
+    out.push_back('"');
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c == '"') {
+            out.push_back('"');
+            if (csvEscaped && i + 1 < text.size() && text[i + 1] == '"') ++i;
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+void appendNumber(std::string &out, double v)
+{
+    char num[FORMAT_BUFFER_SIZE];
+    if (!std::isnan(v)) out.append(num, formatDouble(num, v));
+}
+
+void appendHeader(std::string &out, const TraceNetlistOptions &opt)
+{
+    const char d = opt.delimiter;
+    const char *const names[] = { "net", "current_A", "layer", "copper_oz", "length_mm", "deltaT_C",
+                                  "width_mm", "resistance_ohm", "voltageDrop_V", "power_W",
+                                  "actualRise_C", "actualDrop_V", "actualPower_W" };
+    const std::size_t count = opt.selfHeating ? std::size(names) : std::size(names) - SELF_HEATING_COLUMNS;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i) out.push_back(d);
+        out.append(names[i]);
+    }
+    out.push_back('\n');
+}
+
+struct BlockResult {
+    std::string output;
+    std::size_t rows = 0;
+    std::size_t lines = 0;                  // 區塊內的行數 (含空白列)
+    std::vector<std::size_t> failed;        // 區塊內的行索引
+    std::size_t runaway = 0;
+};
+
+// 一塊網路的自洽溫升 (struct-of-arrays)；沒有長度或無法計算的列電流為 0，直接收斂在 0
+struct BlockHeating {
+    std::vector<double> current, theta, r20, ambient;
+    std::vector<double> deltaT, resistance, drop, power;
+    std::vector<SelfHeatingStatus> status;
+
+    void resize(std::size_t n)
+    {
+        for (std::vector<double> *v : { &current, &theta, &r20, &ambient, &deltaT, &resistance, &drop, &power })
+            v->assign(n, 0.0);
+        status.assign(n, SelfHeatingStatus::Converged);
+    }
+};
+
+// 輸出一列
+void appendNet(const RawNet &raw, const TraceNet &net, const TraceNetResult *r, const BlockHeating *heat,
+               std::size_t k, const TraceNetlistOptions &opt, std::string &out)
+{
+    const char d = opt.delimiter;
+    appendText(out, raw.text[NET], d, raw.csvEscaped);
+    if (r) {
+        out.push_back(d);
+        appendNumber(out, net.current_A);
+        out.push_back(d);
+        out.append(net.internal ? "internal" : "external");
+        out.push_back(d);
+        appendNumber(out, net.copperOz);
+        out.push_back(d);
+        appendNumber(out, net.length_mm);
+        out.push_back(d);
+        appendNumber(out, net.deltaT);
+        out.push_back(d);
+        appendNumber(out, r->width_mm);
+        out.push_back(d);
+        appendNumber(out, r->resistance_ohm);
+        out.push_back(d);
+        appendNumber(out, r->voltageDrop_V);
+        out.push_back(d);
+        appendNumber(out, r->power_W);
+        if (heat) {
+            out.push_back(d);
+            if (net.length_mm <= 0) {
+                out.append(SELF_HEATING_COLUMNS - 1, d);
+            } else if (heat->status[k] == SelfHeatingStatus::Runaway) {
+                out.append("runaway");
+                out.append(SELF_HEATING_COLUMNS - 1, d);
+            } else {
+                appendNumber(out, heat->deltaT[k]);
+                out.push_back(d);
+                appendNumber(out, heat->drop[k]);
+                out.push_back(d);
+                appendNumber(out, heat->power[k]);
+            }
+        }
+    } else {
+        for (int f = CURRENT; f < FIELD_COUNT; ++f) {
+            out.push_back(d);
+            appendText(out, raw.text[f], d, raw.csvEscaped);
+        }
+        out.append(heat ? RESULT_COLUMNS + SELF_HEATING_COLUMNS : RESULT_COLUMNS, d);
+    }
+    out.push_back('\n');
+}
+
+// 計算並輸出一塊網路：先逐列求線寬，自洽溫升時整塊交給 selfHeatingSolveBatch，再依序輸出；
+// 失敗的列把 lineOf[k] 記到 failed
+void evalNets(const RawNet *raws, const std::size_t *lineOf, std::size_t n, const TraceNetlistOptions &opt,
+              BlockResult &b)
+{
+    std::vector<TraceNet> nets(n);
+    std::vector<TraceNetResult> results(n);
+    std::vector<char> ok(n);
+    BlockHeating heat;
+    if (opt.selfHeating) heat.resize(n);
+
+    for (std::size_t k = 0; k < n; ++k) {
+        ok[k] = parseNet(raws[k], opt, nets[k]);
+        if (!ok[k]) continue;
+        results[k] = traceNetSolve(nets[k], opt);
+        if (opt.selfHeating && nets[k].length_mm > 0) {
+            const double thickness_mm = nets[k].copperOz * COPPER_MM_PER_OZ;
+            const SelfHeatingLane lane = traceSelfHeatingLane(
+                nets[k].current_A, results[k].width_mm, thickness_mm, nets[k].length_mm, nets[k].internal,
+                opt.model, opt.ipc2152, TRACE_AMBIENT_C);
+            heat.current[k] = lane.current_A;
+            heat.theta[k] = lane.theta_C_per_W;
+            heat.r20[k] = lane.resistance20_ohm;
+            heat.ambient[k] = lane.ambient_C;
+        }
+    }
+
+    if (opt.selfHeating) {
+        SelfHeatingOptions heatOpt;
+        heatOpt.threads = 1;                // 區塊本身已經在 parallelFor 裡
+        b.runaway += selfHeatingSolveBatch(
+            { heat.current.data(), heat.theta.data(), heat.r20.data(), heat.ambient.data() },
+            { heat.deltaT.data(), heat.resistance.data(), heat.drop.data(), heat.power.data(), heat.status.data() },
+            n, heatOpt);
+    }
+
+    for (std::size_t k = 0; k < n; ++k) {
+        appendNet(raws[k], nets[k], ok[k] ? &results[k] : nullptr, opt.selfHeating ? &heat : nullptr, k, opt,
+                  b.output);
+        if (!ok[k]) b.failed.push_back(lineOf[k]);
+    }
+}
+
+// 依區塊順序寫出並把失敗的行索引換成檔案行號
+void flushBlocks(std::vector<BlockResult> &blocks, std::size_t count, BufferedWriter &out,
+                 std::size_t &nextLine, TraceNetlistStats &stats)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        BlockResult &b = blocks[i];
+        out.write(b.output);
+        stats.rows += b.rows;
+        stats.runaway += b.runaway;
+        for (std::size_t f : b.failed) stats.failedLines.push_back(nextLine + f);
+        nextLine += b.lines;
+    }
+}
+
+// ---------------- CSV ----------------
+
+const char *nextLineStart(const char *p, const char *end)
+{
+    if (p >= end) return end;
+    const void *nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+    return nl ? static_cast<const char *>(nl) + 1 : end;
+}
+
+void evalCsvBlock(const std::size_t (&columns)[FIELD_COUNT], const TraceNetlistOptions &opt,
+                  const char *begin, const char *end, BlockResult &r)
+{
+    std::vector<RawNet> raws;
+    std::vector<std::size_t> lineOf;
+    const char *line = begin;
+    while (line < end) {
+        const char *next = nextLineStart(line, end);
+        const std::string_view text(line, static_cast<std::size_t>(next - line));
+        if (!trim(text.substr(0, text.find('\n'))).empty()) {
+            RawNet &raw = raws.emplace_back();
+            raw.csvEscaped = true;
+            for (int f = 0; f < FIELD_COUNT; ++f) {
+                if (columns[f] != NO_COLUMN) raw.text[f] = csvFieldView(text, opt.delimiter, columns[f]);
+            }
+            lineOf.push_back(r.lines);
+        }
+        ++r.lines;
+        line = next;
+    }
+    r.rows = raws.size();
+    evalNets(raws.data(), lineOf.data(), raws.size(), opt, r);
+}
+
+bool traceNetlistCsv(std::string_view input, BufferedWriter &out, const TraceNetlistOptions &opt,
+                     TraceNetlistStats &stats)
+{
+    const char *p = input.data();
+    const char *end = p + input.size();
+    std::size_t nextLine = 1;
+
+    std::size_t columns[FIELD_COUNT];
+    if (opt.hasHeader) {
+        std::fill(std::begin(columns), std::end(columns), NO_COLUMN);
+        const char *headerEnd = nextLineStart(p, end);
+        const std::vector<std::string> header =
+            splitCsvLine(std::string_view(p, static_cast<std::size_t>(headerEnd - p)), opt.delimiter);
+        for (std::size_t c = 0; c < header.size(); ++c) {
+            const int f = fieldForName(header[c]);
+            if (f >= 0 && columns[f] == NO_COLUMN) columns[f] = c;
+        }
+        if (columns[CURRENT] == NO_COLUMN) {
+            stats.error = "current column not found in the header";
+            return false;
+        }
+        p = headerEnd;
+        nextLine = 2;
+    } else {
+        for (int f = 0; f < FIELD_COUNT; ++f) columns[f] = static_cast<std::size_t>(f);
+    }
+
+    std::string header;
+    appendHeader(header, opt);
+    out.write(header);
+
+    const unsigned threads = opt.threads ? opt.threads : hardwareThreads();
+    const std::size_t chunk = std::max<std::size_t>(opt.chunkBytes, 4096);
+    std::vector<const char *> bounds;
+    std::vector<BlockResult> blocks(threads);
+
+    while (p < end && out.ok()) {
+        // 1. 切出本視窗的區塊邊界 (對齊列尾)
+        bounds.clear();
+        bounds.push_back(p);
+        for (unsigned t = 0; t < threads && bounds.back() < end; ++t) {
+            const char *from = bounds.back();
+            const char *target = (static_cast<std::size_t>(end - from) > chunk) ? from + chunk : end;
+            bounds.push_back(target == end ? end : nextLineStart(target, end));
+        }
+        const std::size_t count = bounds.size() - 1;
+
+        // 2. 平行計算
+        parallelFor(count, threads, [&](std::size_t i) {
+            BlockResult &b = blocks[i];
+            b = BlockResult();
+            b.output.reserve(static_cast<std::size_t>(bounds[i + 1] - bounds[i]) * 3 + 64);
+            evalCsvBlock(columns, opt, bounds[i], bounds[i + 1], b);
+        });
+
+        // 3. 依原順序寫出
+        flushBlocks(blocks, count, out, nextLine, stats);
+        p = bounds.back();
+    }
+    return out.ok();
+}
+
+// ---------------- JSON ----------------
+
+// 扁平物件陣列的循序掃描器
+class JsonScanner
+{
+public:
+    JsonScanner(std::string_view input) : p(input.data()), end(input.data() + input.size()) {}
+
+    std::size_t line = 1;
+    std::string error;
+
+    bool begin()
+    {
+        skipSpace();
+        return expect('[');
+    }
+
+    // 取出下一個物件；陣列結束或錯誤時回傳 false (錯誤時 error 不為空)
+    bool next(RawNet &raw, std::size_t &objectLine)
+    {
+        skipSpace();
+        if (first) {
+            first = false;
+            if (peek(']')) return finish();
+        } else {
+            if (peek(']')) return finish();
+            if (!expect(',')) return false;
+            skipSpace();
+        }
+        objectLine = line;
+        if (!expect('{')) return false;
+        raw = RawNet();
+        skipSpace();
+        if (peek('}')) {
+            ++p;
+            return true;
+        }
+        for (;;) {
+            skipSpace();
+            std::string_view key, value;
+            if (!readString(key)) return false;
+            skipSpace();
+            if (!expect(':')) return false;
+            skipSpace();
+            if (!readScalar(value)) return false;
+            const int f = fieldForName(key);
+            if (f >= 0) raw.text[f] = value;
+            skipSpace();
+            if (peek('}')) {
+                ++p;
+                return true;
+            }
+            if (!expect(',')) return false;
+        }
+    }
+
+private:
+    const char *p;
+    const char *end;
+    bool first = true;
+
+    void skipSpace()
+    {
+        for (; p < end; ++p) {
+            if (*p == '\n') ++line;
+            else if (*p != ' ' && *p != '\t' && *p != '\r') break;
+        }
+    }
+
+    bool peek(char c) const { return p < end && *p == c; }
+
+    bool fail(const char *what)
+    {
+        error = "line " + std::to_string(line) + ": " + what;
+        return false;
+    }
+
+    bool expect(char c)
+    {
+        if (!peek(c)) return fail((std::string("expected '") + c + "'").c_str());
+        ++p;
+        return true;
+    }
+
+    bool finish()
+    {
+        ++p;
+        return false;
+    }
+
+    // 字串內容 (不含雙引號，跳脫字元不還原)
+    bool readString(std::string_view &out)
+    {
+        if (!expect('"')) return false;
+        const char *s = p;
+        while (p < end && *p != '"') {
+            if (*p == '\\') ++p;
+            else if (*p == '\n') return fail("unterminated string");
+            ++p;
+        }
+        if (p >= end) return fail("unterminated string");
+        out = std::string_view(s, static_cast<std::size_t>(p - s));
+        ++p;
+        return true;
+    }
+
+    // 字串、數字或 true / false / null；不支援巢狀的物件與陣列
+    bool readScalar(std::string_view &out)
+    {
+        if (peek('"')) return readString(out);
+        if (peek('{') || peek('[')) return fail("nested objects and arrays are not supported");
+        const char *s = p;
+        while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\r'
+               && *p != '\n') {
+            ++p;
+        }
+        if (p == s) return fail("expected a value");
+        out = std::string_view(s, static_cast<std::size_t>(p - s));
+        if (out == "null") out = std::string_view();
+        return true;
+    }
+};
+
+bool traceNetlistJson(std::string_view input, BufferedWriter &out, const TraceNetlistOptions &opt,
+                      TraceNetlistStats &stats)
+{
+    JsonScanner json(input);
+    if (!json.begin()) {
+        stats.error = json.error;
+        return false;
+    }
+
+    std::string header;
+    appendHeader(header, opt);
+    out.write(header);
+
+    const unsigned threads = opt.threads ? opt.threads : hardwareThreads();
+    const std::size_t window = JSON_ROWS_PER_BLOCK * threads;
+    std::vector<RawNet> nets(window);
+    std::vector<std::size_t> lines(window);
+    std::vector<BlockResult> blocks(threads);
+    bool more = true;
+
+    while (more && out.ok()) {
+        // 1. 循序掃出一個視窗的物件
+        std::size_t n = 0;
+        while (n < window && (more = json.next(nets[n], lines[n]))) ++n;
+        if (!json.error.empty()) {
+            stats.error = json.error;
+            return false;
+        }
+
+        // 2. 平行計算 (失敗的列直接記物件所在的行號)
+        const std::size_t count = (n + JSON_ROWS_PER_BLOCK - 1) / JSON_ROWS_PER_BLOCK;
+        parallelFor(count, threads, [&](std::size_t i) {
+            BlockResult &b = blocks[i];
+            b = BlockResult();
+            const std::size_t from = i * JSON_ROWS_PER_BLOCK;
+            const std::size_t to = std::min(n, from + JSON_ROWS_PER_BLOCK);
+            b.output.reserve((to - from) * 96);
+            evalNets(nets.data() + from, lines.data() + from, to - from, opt, b);
+            b.rows = to - from;
+        });
+
+        // 3. 依原順序寫出
+        std::size_t base = 0;
+        flushBlocks(blocks, count, out, base, stats);
+    }
+    return out.ok();
+}
+
+} // namespace
+
+TraceNetResult traceNetSolve(const TraceNet &net, const TraceNetlistOptions &options)
+{
+    const double thickness_mm = net.copperOz * COPPER_MM_PER_OZ;
+    TraceNetResult r;
+    if (options.model == TraceModel::IPC2152) {
+        r.width_mm = ipc2152WidthFromCurrent(net.current_A, thickness_mm, net.deltaT, options.ipc2152);
+    } else {
+        r.width_mm = traceWidthFromCurrent(net.current_A, thickness_mm, net.deltaT,
+                                           net.internal ? IPC2221_K_INTERNAL : IPC2221_K_EXTERNAL);
+    }
+    if (net.length_mm > 0) {
+        r.resistance_ohm = traceResistance(r.width_mm, thickness_mm, net.length_mm, net.deltaT);
+        r.voltageDrop_V = net.current_A * r.resistance_ohm;
+        r.power_W = net.current_A * r.voltageDrop_V;
+    } else {
+        r.resistance_ohm = r.voltageDrop_V = r.power_W = std::numeric_limits<double>::quiet_NaN();
+    }
+    return r;
+}
+
+bool traceNetlist(std::string_view input, BufferedWriter &out, const TraceNetlistOptions &options,
+                  TraceNetlistStats *stats)
+{
+    TraceNetlistStats local;
+    TraceNetlistStats &s = stats ? *stats : local;
+    s = TraceNetlistStats();
+
+    // 去掉 UTF-8 BOM (試算表軟體匯出的 CSV 常有)
+    if (input.size() >= 3 && input.compare(0, 3, "\xEF\xBB\xBF") == 0) input.remove_prefix(3);
+
+    std::size_t i = 0;
+    while (i < input.size() && (input[i] == ' ' || input[i] == '\t' || input[i] == '\r' || input[i] == '\n'))
+        ++i;
+    const bool json = i < input.size() && input[i] == '[';
+    return json ? traceNetlistJson(input, out, options, s) : traceNetlistCsv(input, out, options, s);
+}
+
+} // namespace sc
@@ -0,0 +1,78 @@
+#ifndef SC_TRACENETLIST_H
+#define SC_TRACENETLIST_H
+
+/**
+ * @file TraceNetlist.h
+ * @brief 網路清單的批次線寬計算 (CSV / JSON)
+ *
+ * 每個網路一列：名稱、電流、層 (外層 / 內層)、銅重、長度、允許溫升，
+ * 輸出線寬、電阻、壓降與功耗，公式與走線頁相同 (TraceCalc.h / Ipc2152.h)。
+ *
+ * 欄位名稱 (不分大小寫)：
+ *   net / name、current / current_a (A)、layer (outer / external / top / bottom 或 inner / internal)、
+ *   oz / copper_oz (銅重)、length / length_mm (mm)、dt / deltat / rise (°C)
+ * 只有 current 是必要的，其餘缺少或空白時使用預設值 (外層、defaultCopperOz、不算電阻、defaultDeltaT)。
+ */
+
+#include "Ipc2152.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sc {
+
+class BufferedWriter;
+
+struct TraceNetlistOptions {
+    char delimiter = ',';                // CSV 分隔符號 (輸出也用同一個)
+    bool hasHeader = true;               // CSV 第一列是欄位名稱；沒有標題時欄位順序固定為
+                                         // net, current, layer, oz, length, dt
+    TraceModel model = TraceModel::IPC2221;
+    Ipc2152Options ipc2152;
+    double defaultDeltaT = 10;           // 沒有溫升欄位 (或空白) 時使用
+    double defaultCopperOz = 1;          // 沒有銅重欄位 (或空白) 時使用
+    bool selfHeating = false;            // 另外輸出算出線寬下的自洽溫升、壓降與功耗 (SelfHeating.h，環境 20°C)
+    unsigned threads = 0;                // 0 = 全部硬體執行緒
+    std::size_t chunkBytes = std::size_t(4) << 20;   // 每個工作區塊大小
+};
+
+// 單一網路 (長度 <= 0 時只算線寬，電阻、壓降、功耗為 NaN)
+struct TraceNet {
+    double current_A;
+    bool internal;                       // 內層 (IPC-2221 係數 0.024)
+    double copperOz;
+    double length_mm;
+    double deltaT;
+};
+
+struct TraceNetResult {
+    double width_mm;
+    double resistance_ohm;
+    double voltageDrop_V;
+    double power_W;
+};
+
+TraceNetResult traceNetSolve(const TraceNet &net, const TraceNetlistOptions &options);
+
+struct TraceNetlistStats {
+    std::size_t rows = 0;                // 資料列 (JSON 為物件) 數
+    std::vector<std::size_t> failedLines;    // 無法計算的列的檔案行號 (1 起算)，依行號排序
+    std::size_t runaway = 0;             // selfHeating：熱失控的網路數
+    std::string error;                   // 格式錯誤 (例如 JSON 語法、找不到電流欄位)
+};
+
+// 依內容判斷格式：第一個非空白字元是 '[' 為 JSON 陣列，否則為 CSV。
+// JSON 是扁平物件的陣列，鍵與 CSV 標題相同 (數值可以是數字或字串，字串內的跳脫字元原樣輸出)。
+// 輸出一律是 CSV：net, current_A, layer, copper_oz, length_mm, deltaT_C (套用預設值後的輸入)
+// 加上 width_mm, resistance_ohm, voltageDrop_V, power_W，列的順序與輸入相同；
+// selfHeating 時再加上 actualRise_C, actualDrop_V, actualPower_W (沒有長度時留空，熱失控時溫升為 runaway)；
+// 無法計算的列 (電流不是正數、層名稱不認得…) 輸入欄位原樣輸出、結果留空，並記在 failedLines。
+// 回傳 false 代表格式錯誤 (stats.error) 或寫入失敗 (out.errorString())
+bool traceNetlist(std::string_view input, BufferedWriter &out, const TraceNetlistOptions &options,
+                  TraceNetlistStats *stats = nullptr);
+
+} // namespace sc
+
+#endif // SC_TRACENETLIST_H
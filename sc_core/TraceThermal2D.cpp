@@ -0,0 +1,214 @@
+/**
+ * @file TraceThermal2D.cpp
+ * @brief 走線截面 2D 熱傳導：有限體積離散 + 多重網格預條件的共軛梯度法
+ *
+ * 【 1. 網格 】
+ * 張量積網格：x 方向走線內等間距 (cellsAcrossTrace 格)，走線外以 grading 倍率逐格放大到邊界；
+ * y 方向依材料分層 (FR-4、銅平面、走線層)，銅層 cellsPerCopper 格，介電層從兩側介面往中間放大。
+ * 每格一個溫度 (格心)，相鄰兩格之間的熱導是兩個半格熱阻的串聯 (係數不連續時仍守恆)，
+ * 上下表面再串一個對流熱阻 1 / (h * dx)。所有量都是沿走線方向每公尺的值。
+ *
+ * 【 2. 求解 】
+ * 熱導矩陣是五點格式的對稱正定系統，以 GridSolver (線鬆弛 W-cycle 多重網格預條件的共軛梯度法) 求解，
+ * 走線外放大的網格長寬比很大也不影響收斂，迭代次數與網格大小無關。
+ *
+ * 【 3. 電阻率 】
+ * ρ = ρ20 * (1 + α (T - 20))，T 取走線平均溫度。方程式對熱源是線性的，
+ * 所以只解一次單位功率的溫升場，ρ(T) 的定點直接由走線平均溫升 / 瓦 解出 (迴路增益 >= 1 為熱失控)。
+ */
+
+#include "TraceThermal2D.h"
+#include "GridSolver.h"
+#include "ScConstants.h"
+#include "TraceCalc.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sc {
+
+namespace {
+
+// 自動截面寬度：至少 50 mm，且至少 20 倍線寬
+constexpr double AUTO_DOMAIN_MIN_MM = 50;
+constexpr double AUTO_DOMAIN_TRACE_WIDTHS = 20;
+
+enum class Band { Board, Plane, TraceRow };
+
+struct Material {
+    double kx;
+    double ky;
+};
+
+} // namespace
+
+TraceThermalResult traceThermalSolve(const TraceThermalGeometry &geometry, double current_A,
+                                     const TraceThermalMaterial &material, const TraceThermalOptions &options)
+{
+    TraceThermalResult result;
+    const double w = geometry.traceWidth_mm;
+    const double t = geometry.traceThickness_mm;
+    const double H = geometry.boardThickness_mm;
+    if (!(w > 0) || !(t > 0) || !(H > 0)) return result;
+
+    const int across = std::max(options.cellsAcrossTrace, 1);
+    const int perCopper = std::max(options.cellsPerCopper, 1);
+    const double grading = std::max(options.grading, 1.0);
+
+    // ---- x 網格 (mm)：走線中心為 0，左右對稱 ----
+    double domain = geometry.domainWidth_mm;
+    if (!(domain > w)) domain = std::max(AUTO_DOMAIN_MIN_MM, AUTO_DOMAIN_TRACE_WIDTHS * w);
+    const double dx0 = w / across;
+    const std::vector<double> side = gradedCells(0.5 * (domain - w), dx0, grading);
+    std::vector<double> &xe = result.xEdges_mm;
+    xe.push_back(-0.5 * domain);
+    appendEdges(xe, std::vector<double>(side.rbegin(), side.rend()));
+    xe.back() = -0.5 * w;
+    appendEdges(xe, std::vector<double>(static_cast<std::size_t>(across), dx0));
+    xe.back() = 0.5 * w;
+    appendEdges(xe, side);
+    xe.back() = 0.5 * domain;
+
+    // ---- y 網格 (mm)：由下往上的材料分層 ----
+    const double dy0 = t / perCopper;
+    const double traceBottom = geometry.internal ? 0.5 * (H - t) : H;
+    struct Layer {
+        double thickness;
+        Band band;
+    };
+    std::vector<Layer> layers;
+    const double planeTop = traceBottom - geometry.planeDistance_mm;
+    const double planeBottom = std::max(planeTop - geometry.planeThickness_mm, 0.0);
+    if (geometry.planeDistance_mm > 0 && planeTop > planeBottom) {
+        if (planeBottom > 0) layers.push_back({ planeBottom, Band::Board });
+        layers.push_back({ planeTop - planeBottom, Band::Plane });
+        layers.push_back({ traceBottom - planeTop, Band::Board });
+    } else if (traceBottom > 0) {
+        layers.push_back({ traceBottom, Band::Board });
+    }
+    layers.push_back({ t, Band::TraceRow });
+    if (geometry.internal) layers.push_back({ H - traceBottom - t, Band::Board });
+
+    std::vector<double> &ye = result.yEdges_mm;
+    std::vector<Band> rowBand;
+    ye.push_back(0.0);
+    for (const Layer &layer : layers) {
+        if (!(layer.thickness > 0)) continue;
+        const std::vector<double> cells = (layer.band == Band::Board)
+                                              ? gradedBothEnds(layer.thickness, dy0, grading)
+                                              : std::vector<double>(static_cast<std::size_t>(perCopper),
+                                                                    layer.thickness / perCopper);
+        appendEdges(ye, cells);
+        rowBand.insert(rowBand.end(), cells.size(), layer.band);
+    }
+
+    const int nx = static_cast<int>(xe.size()) - 1;
+    const int ny = static_cast<int>(ye.size()) - 1;
+    result.nx = nx;
+    result.ny = ny;
+    const std::size_t n = static_cast<std::size_t>(nx) * ny;
+
+    // ---- 材料與熱導 (SI 單位，每公尺長) ----
+    const Material copper{ material.kCopper, material.kCopper };
+    const Material board{ material.kBoardInPlane, material.kBoardThrough };
+    const Material beside = geometry.internal ? board : Material{ material.kAir, material.kAir };
+    std::vector<double> dx(nx), dy(ny);
+    for (int i = 0; i < nx; ++i) dx[i] = (xe[i + 1] - xe[i]) * 1e-3;
+    for (int j = 0; j < ny; ++j) dy[j] = (ye[j + 1] - ye[j]) * 1e-3;
+    const int traceI0 = static_cast<int>(side.size());
+    const int traceI1 = traceI0 + across;
+
+    std::vector<Material> mat(n);
+    std::vector<char> isTrace(n, 0);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * nx + i;
+            switch (rowBand[j]) {
+            case Band::Board: mat[k] = board; break;
+            case Band::Plane: mat[k] = copper; break;
+            case Band::TraceRow:
+                isTrace[k] = (i >= traceI0 && i < traceI1);
+                mat[k] = isTrace[k] ? copper : beside;
+                break;
+            }
+        }
+    }
+
+    GridSystem fine;
+    fine.nx = nx;
+    fine.ny = ny;
+    fine.gE.assign(n, 0.0);
+    fine.gN.assign(n, 0.0);
+    fine.diag.assign(n, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * nx + i;
+            if (i + 1 < nx) {
+                const double rth = 0.5 * dx[i] / (mat[k].kx * dy[j]) + 0.5 * dx[i + 1] / (mat[k + 1].kx * dy[j]);
+                fine.gE[k] = 1.0 / rth;
+                fine.diag[k] += fine.gE[k];
+                fine.diag[k + 1] += fine.gE[k];
+            }
+            if (j + 1 < ny) {
+                const std::size_t up = k + nx;
+                const double rth = 0.5 * dy[j] / (mat[k].ky * dx[i]) + 0.5 * dy[j + 1] / (mat[up].ky * dx[i]);
+                fine.gN[k] = 1.0 / rth;
+                fine.diag[k] += fine.gN[k];
+                fine.diag[up] += fine.gN[k];
+            }
+            // 上下表面對流
+            if (j == 0 && material.hBottom > 0)
+                fine.diag[k] += 1.0 / (1.0 / (material.hBottom * dx[i]) + 0.5 * dy[j] / (mat[k].ky * dx[i]));
+            if (j == ny - 1 && material.hTop > 0)
+                fine.diag[k] += 1.0 / (1.0 / (material.hTop * dx[i]) + 0.5 * dy[j] / (mat[k].ky * dx[i]));
+        }
+    }
+
+    GridSolver solver(std::move(fine), options.threads);
+
+    // ---- 焦耳熱與 ρ(T) ----
+    // 走線內電流密度均勻 (ρ 取走線平均溫度)，溫升場與功率成正比：先解每公尺 1 W 的溫升場，
+    // 再解 P = I² ρ20 (1 + α (Ta + P u - 20)) / A 的定點 (u = 每瓦的走線平均溫升)，只需要解一次
+    const double area_m2 = w * t * 1e-6;
+    const double rho20 = COPPER_RHO_OHM_MM * 1e-3;   // Ohm-m
+    std::vector<double> b(n, 0.0), T(n, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = traceI0; i < traceI1; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * nx + i;
+            if (isTrace[k]) b[k] = dx[i] * dy[j] / area_m2;
+        }
+    }
+    result.iterations = solver.solve(b, T, options.tolerance, options.maxIterations, &result.converged);
+
+    double sum = 0;
+    for (int j = 0; j < ny; ++j) {
+        for (int i = traceI0; i < traceI1; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * nx + i;
+            if (isTrace[k]) sum += T[k] * dx[i] * dy[j];
+        }
+    }
+    const double risePerWatt = sum / area_m2;
+    const double i2r = current_A * current_A * rho20 / area_m2;     // 20 °C 時的每公尺功率
+    double power = i2r * (1 + COPPER_ALPHA * (material.ambient_C - 20));
+    if (options.temperatureDependentResistivity) {
+        const double loopGain = i2r * COPPER_ALPHA * risePerWatt;
+        if (loopGain >= 1) {
+            // 電阻增加的功率比散掉的還多：沒有穩態 (熱失控)
+            result.runaway = true;
+            result.converged = false;
+            result.maxRise_C = result.traceRise_C = HUGE_VAL;
+            return result;
+        }
+        power /= 1 - loopGain;
+    }
+    for (double &v : T) v *= power;
+
+    result.traceRise_C = power * risePerWatt;
+    result.maxRise_C = *std::max_element(T.begin(), T.end());
+    result.power_W_per_m = power;
+    result.resistance_ohm_per_m = power / (current_A * current_A);
+    result.rise_C.swap(T);
+    return result;
+}
+
+} // namespace sc
@@ -0,0 +1,73 @@
+#ifndef SC_TRACETHERMAL2D_H
+#define SC_TRACETHERMAL2D_H
+
+/**
+ * @file TraceThermal2D.h
+ * @brief 走線截面的 2D 穩態熱傳導 (有限體積 + 多重網格預條件共軛梯度)
+ *
+ * IPC 公式是實驗數據的擬合，短走線、大面積銅、靠近銅平面時偏差很大。
+ * 這裡直接解截面 (沿走線方向視為無限長) 的熱傳導：
+ *   銅 (走線、銅平面)、FR-4 (面內 / 厚度方向不同的熱傳導係數)、上下表面對流，
+ *   走線的焦耳熱 I^2 ρ(T) / A，ρ 取走線平均溫度。
+ * 回報最高溫升與走線平均溫升，可以和同一頁的 IPC-2221 溫升直接比較。
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace sc {
+
+struct TraceThermalGeometry {
+    double traceWidth_mm = 0.25;
+    double traceThickness_mm = 0.035;
+    double boardThickness_mm = 1.6;
+    bool internal = false;              // 內層：走線在板厚中央；外層：走線在板子上表面
+    double planeDistance_mm = 0;        // 走線下方銅平面的距離 (<= 0 表示沒有)
+    double planeThickness_mm = 0.035;
+    double domainWidth_mm = 0;          // 截面寬度，0 = 自動 (遠大於熱擴散長度)
+};
+
+struct TraceThermalMaterial {
+    double kCopper = 385;               // W/(m·K)
+    double kBoardInPlane = 0.8;         // FR-4 面內
+    double kBoardThrough = 0.3;         // FR-4 厚度方向
+    double kAir = 0.026;                // 外層走線旁邊的空氣
+    double hTop = 10;                   // 上表面對流 + 輻射 (W/(m²·K))
+    double hBottom = 10;                // 下表面
+    double ambient_C = 25;
+};
+
+struct TraceThermalOptions {
+    int cellsAcrossTrace = 32;          // 走線寬度方向的格數
+    int cellsPerCopper = 4;             // 銅厚方向的格數
+    double grading = 1.1;               // 走線以外的網格每格放大的倍率 (1 = 全部等間距)
+    double tolerance = 1e-8;            // 共軛梯度的相對殘差
+    int maxIterations = 500;
+    bool temperatureDependentResistivity = true;    // false = ρ 固定在環境溫度
+    unsigned threads = 0;               // 0 = 全部硬體執行緒
+};
+
+struct TraceThermalResult {
+    double maxRise_C = 0;               // 截面最高溫升
+    double traceRise_C = 0;             // 走線平均溫升
+    double resistance_ohm_per_m = 0;    // 走線在平均溫度下的每公尺電阻
+    double power_W_per_m = 0;           // 每公尺焦耳熱
+    int nx = 0;
+    int ny = 0;
+    int iterations = 0;                 // 共軛梯度迭代數
+    bool converged = false;
+    bool runaway = false;               // ρ(T) 使溫升沒有穩態 (熱失控)，溫升為無限大
+
+    // 溫升場 (ny 列 x nx 欄，列 0 在板子底部) 與格子邊界座標 (mm，x 以走線中心為 0)
+    std::vector<double> rise_C;
+    std::vector<double> xEdges_mm;      // nx + 1 個
+    std::vector<double> yEdges_mm;      // ny + 1 個
+};
+
+TraceThermalResult traceThermalSolve(const TraceThermalGeometry &geometry, double current_A,
+                                     const TraceThermalMaterial &material = {},
+                                     const TraceThermalOptions &options = {});
+
+} // namespace sc
+
+#endif // SC_TRACETHERMAL2D_H
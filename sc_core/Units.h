@@ -0,0 +1,250 @@
+#ifndef SC_UNITS_H
+#define SC_UNITS_H
+
+/**
+ * @file Units.h
+ * @brief 編譯期單位系統
+ *
+ * 【 1. 量 (Quantity) 】
+ * Quantity<Dim> 內部一律以基準單位儲存 (長度 mm、電流 A、電壓 V、電阻 Ohm、
+ * 電容 F、功率 W、能量 J、溫度 °C)。不同維度是不同型別，把 mil 當成 mm 傳進去、
+ * 或把電流加到長度上，都會在編譯時期報錯。
+ *
+ * 【 2. 單位 (Unit) 】
+ * 每個單位以 std::ratio 記錄「1 單位 = 多少基準單位」，換算係數在編譯期算出：
+ *    convert<mil, mm>(x)  ->  x * 0.0254  (常數摺疊，沒有 std::pow)
+ * 溫度另有 offset (K、°F 是仿射換算)。
+ *
+ * 【 3. 下拉選單 (UnitList) 】
+ * UnitList<mm, mil, um> 把 ComboBox 的 index 對應到預先算好的係數表，
+ * 執行期換算只是一次查表 + 乘加，沒有 if-else 分支，適合放在批次迴圈內。
+ */
+
+#include <array>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+
+namespace sc {
+namespace units {
+
+// --- 維度 ---
+struct Length {};
+struct Current {};
+struct Voltage {};
+struct Resistance {};
+struct Capacitance {};
+struct Power {};
+struct Temperature {};
+struct Energy {};
+
+// --- 10 的次方查表 (取代 std::pow(10, n)) ---
+constexpr int POW10_MIN = -60;
+constexpr int POW10_MAX = 60;
+
+namespace detail {
+
+constexpr double exactPow10(int n)    // 0 <= n：10^22 以內每一步都是精確值
+{
+    double v = 1.0;
+    for (int i = 0; i < n; ++i) v *= 10.0;
+    return v;
+}
+
+constexpr std::array<double, POW10_MAX - POW10_MIN + 1> makePow10Table()
+{
+    std::array<double, POW10_MAX - POW10_MIN + 1> t{};
+    for (int n = POW10_MIN; n <= POW10_MAX; ++n) {
+        t[static_cast<std::size_t>(n - POW10_MIN)] = (n >= 0) ? exactPow10(n) : 1.0 / exactPow10(-n);
+    }
+    return t;
+}
+
+template <class R>
+constexpr double ratioValue() { return static_cast<double>(R::num) / static_cast<double>(R::den); }
+
+} // namespace detail
+
+inline constexpr std::array<double, POW10_MAX - POW10_MIN + 1> POW10_TABLE = detail::makePow10Table();
+
+// 10^n，n 需在 [POW10_MIN, POW10_MAX] 之間
+constexpr double pow10(int n) { return POW10_TABLE[static_cast<std::size_t>(n - POW10_MIN)]; }
+
+// --- 量 ---
+template <class Dim>
+class Quantity
+{
+public:
+    using dimension = Dim;
+
+    constexpr Quantity() = default;
+    static constexpr Quantity fromBase(double v) { Quantity q; q.m_value = v; return q; }
+
+    constexpr double base() const { return m_value; }
+
+    template <class U>
+    constexpr double in() const
+    {
+        static_assert(std::is_same<typename U::dimension, Dim>::value, "unit dimension mismatch");
+        return (m_value - U::offset) * U::inverse;
+    }
+
+    constexpr Quantity operator+(Quantity o) const { return fromBase(m_value + o.m_value); }
+    constexpr Quantity operator-(Quantity o) const { return fromBase(m_value - o.m_value); }
+    constexpr Quantity operator*(double k) const { return fromBase(m_value * k); }
+    constexpr Quantity operator/(double k) const { return fromBase(m_value / k); }
+    constexpr double operator/(Quantity o) const { return m_value / o.m_value; }
+
+    constexpr bool operator<(Quantity o) const { return m_value < o.m_value; }
+    constexpr bool operator>(Quantity o) const { return m_value > o.m_value; }
+    constexpr bool operator<=(Quantity o) const { return m_value <= o.m_value; }
+    constexpr bool operator>=(Quantity o) const { return m_value >= o.m_value; }
+
+private:
+    double m_value = 0;
+};
+
+template <class Dim>
+constexpr Quantity<Dim> operator*(double k, Quantity<Dim> q) { return q * k; }
+
+// 歐姆定律與功率
+constexpr Quantity<Voltage> operator*(Quantity<Current> i, Quantity<Resistance> r)
+{ return Quantity<Voltage>::fromBase(i.base() * r.base()); }
+constexpr Quantity<Voltage> operator*(Quantity<Resistance> r, Quantity<Current> i) { return i * r; }
+constexpr Quantity<Resistance> operator/(Quantity<Voltage> v, Quantity<Current> i)
+{ return Quantity<Resistance>::fromBase(v.base() / i.base()); }
+constexpr Quantity<Current> operator/(Quantity<Voltage> v, Quantity<Resistance> r)
+{ return Quantity<Current>::fromBase(v.base() / r.base()); }
+constexpr Quantity<Power> operator*(Quantity<Voltage> v, Quantity<Current> i)
+{ return Quantity<Power>::fromBase(v.base() * i.base()); }
+constexpr Quantity<Power> operator*(Quantity<Current> i, Quantity<Voltage> v) { return v * i; }
+
+// --- 單位 ---
+// Factor：1 單位 = Factor 個基準單位；Offset：仿射換算的偏移 (基準單位)
+template <class Dim, class Factor, class Offset = std::ratio<0>>
+struct Unit
+{
+    using dimension = Dim;
+    using factor_ratio = Factor;
+    using offset_ratio = Offset;
+    static constexpr double factor = detail::ratioValue<Factor>();
+    static constexpr double inverse = static_cast<double>(Factor::den) / static_cast<double>(Factor::num);
+    static constexpr double offset = detail::ratioValue<Offset>();
+};
+
+#define SC_DEFINE_UNIT(NAME, SYMBOL, ...)                         \
+    struct NAME : Unit<__VA_ARGS__> {                             \
+        static constexpr const char *symbol = SYMBOL;             \
+    }
+
+// 長度 (基準 mm)
+SC_DEFINE_UNIT(um,   "um",   Length, std::ratio<1, 1000>);
+SC_DEFINE_UNIT(mm,   "mm",   Length, std::ratio<1>);
+SC_DEFINE_UNIT(cm,   "cm",   Length, std::ratio<10>);
+SC_DEFINE_UNIT(m,    "m",    Length, std::ratio<1000>);
+SC_DEFINE_UNIT(mil,  "mil",  Length, std::ratio<254, 10000>);
+SC_DEFINE_UNIT(inch, "inch", Length, std::ratio<254, 10>);
+
+// 電流 (基準 A)
+SC_DEFINE_UNIT(uA, "uA", Current, std::micro);
+SC_DEFINE_UNIT(mA, "mA", Current, std::milli);
+SC_DEFINE_UNIT(A,  "A",  Current, std::ratio<1>);
+
+// 電壓 (基準 V)
+SC_DEFINE_UNIT(uV, "uV", Voltage, std::micro);
+SC_DEFINE_UNIT(mV, "mV", Voltage, std::milli);
+SC_DEFINE_UNIT(V,  "V",  Voltage, std::ratio<1>);
+SC_DEFINE_UNIT(kV, "kV", Voltage, std::kilo);
+
+// 電阻 (基準 Ohm)
+SC_DEFINE_UNIT(mOhm, "mΩ", Resistance, std::milli);
+SC_DEFINE_UNIT(Ohm,  "Ω",  Resistance, std::ratio<1>);
+SC_DEFINE_UNIT(kOhm, "kΩ", Resistance, std::kilo);
+SC_DEFINE_UNIT(MOhm, "MΩ", Resistance, std::mega);
+
+// 電容 (基準 F)
+SC_DEFINE_UNIT(pF, "pF", Capacitance, std::pico);
+SC_DEFINE_UNIT(nF, "nF", Capacitance, std::nano);
+SC_DEFINE_UNIT(uF, "μF", Capacitance, std::micro);
+SC_DEFINE_UNIT(F,  "F",  Capacitance, std::ratio<1>);
+
+// 功率 (基準 W)
+SC_DEFINE_UNIT(mW, "mW", Power, std::milli);
+SC_DEFINE_UNIT(W,  "W",  Power, std::ratio<1>);
+
+// 能量 (基準 J)
+SC_DEFINE_UNIT(mJ,  "mJ",  Energy, std::milli);
+SC_DEFINE_UNIT(J,   "J",   Energy, std::ratio<1>);
+SC_DEFINE_UNIT(kJ,  "kJ",  Energy, std::kilo);
+SC_DEFINE_UNIT(mWh, "mWh", Energy, std::ratio<36, 10>);
+SC_DEFINE_UNIT(Wh,  "Wh",  Energy, std::ratio<3600>);
+SC_DEFINE_UNIT(kWh, "kWh", Energy, std::ratio<3600000>);
+
+// 溫度 (基準 °C)：K = °C + 273.15，°F = °C * 9/5 + 32
+SC_DEFINE_UNIT(degC, "°C", Temperature, std::ratio<1>);
+SC_DEFINE_UNIT(K,    "K",  Temperature, std::ratio<1>, std::ratio<-27315, 100>);
+SC_DEFINE_UNIT(degF, "°F", Temperature, std::ratio<5, 9>, std::ratio<-160, 9>);
+
+#undef SC_DEFINE_UNIT
+
+template <class U>
+constexpr Quantity<typename U::dimension> quantity(double v)
+{
+    return Quantity<typename U::dimension>::fromBase(v * U::factor + U::offset);
+}
+
+// 編譯期已知兩端單位的換算：比例在編譯期化簡成單一常數
+template <class From, class To>
+constexpr double convert(double v)
+{
+    static_assert(std::is_same<typename From::dimension, typename To::dimension>::value,
+                  "unit dimension mismatch");
+    using R = std::ratio_divide<typename From::factor_ratio, typename To::factor_ratio>;
+    constexpr double k = detail::ratioValue<R>();
+    constexpr double shift = (From::offset - To::offset) * To::inverse;
+    return v * k + shift;
+}
+
+// --- 執行期 index -> 單位 (ComboBox 用) ---
+template <class First, class... Rest>
+struct UnitList
+{
+    using dimension = typename First::dimension;
+    static_assert((std::is_same<typename Rest::dimension, dimension>::value && ...),
+                  "UnitList mixes dimensions");
+
+    static constexpr std::size_t size = 1 + sizeof...(Rest);
+    static constexpr std::array<double, size> factors = { First::factor, Rest::factor... };
+    static constexpr std::array<double, size> inverses = { First::inverse, Rest::inverse... };
+    static constexpr std::array<double, size> offsets = { First::offset, Rest::offset... };
+    static constexpr std::array<const char *, size> symbols = { First::symbol, Rest::symbol... };
+
+    // 超出範圍的 index (例如空的 ComboBox 回傳 -1) 視為第一個單位
+    static constexpr std::size_t slot(int idx)
+    {
+        return static_cast<std::size_t>(idx) < size ? static_cast<std::size_t>(idx) : 0;
+    }
+
+    static constexpr Quantity<dimension> from(double v, int idx)
+    {
+        std::size_t s = slot(idx);
+        return Quantity<dimension>::fromBase(v * factors[s] + offsets[s]);
+    }
+
+    static constexpr double to(Quantity<dimension> q, int idx)
+    {
+        std::size_t s = slot(idx);
+        return (q.base() - offsets[s]) * inverses[s];
+    }
+
+    // 兩個 index 之間的換算 (同一個清單內)
+    static constexpr double convert(double v, int fromIdx, int toIdx)
+    {
+        return to(from(v, fromIdx), toIdx);
+    }
+};
+
+} // namespace units
+} // namespace sc
+
+#endif // SC_UNITS_H
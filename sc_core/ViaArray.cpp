@@ -0,0 +1,183 @@
+/**
+ * @file ViaArray.cpp
+ * @brief 貫孔陣列搜尋 (標準孔徑表 x 電鍍選項，平行)
+ *
+ * 【 1. 單孔 】
+ * 孔徑與孔壁厚決定單孔的載流能力與電阻 (ViaCalc.h)，與中心距無關，每個組合只算一次。
+ *
+ * 【 2. 中心距 】
+ * 群組係數只在 2 ~ 3 倍孔徑之間變化，中心距從最小值 (孔徑 + 孔間距) 以 pitchStep 的格點掃到 3 倍孔徑，
+ * 另外加上 2 倍、3 倍孔徑兩個轉折點；再大只會增加面積。
+ * 每個中心距所需的孔數 N = ceil(I / (I_via * f))，排列列舉 rows (cols = ceil(N / rows))，
+ * 外框 ((cols - 1) p + 焊墊) x ((rows - 1) p + 焊墊)，焊墊範圍可以旋轉 90 度放入。
+ *
+ * 【 3. 平行 】
+ * 每個 (孔徑, 電鍍) 組合是獨立的工作，交給 parallelFor 寫到各自的表格列，結果與執行緒數無關。
+ */
+
+#include "ViaArray.h"
+#include "Parallel.h"
+#include "ViaCalc.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sc {
+
+namespace {
+
+// 群組係數的轉折點 (中心距 / 孔徑) 與密排時的減額
+constexpr double GROUP_FULL_RATIO = 3.0;
+constexpr double GROUP_DERATED_RATIO = 2.0;
+constexpr double GROUP_DERATING = 0.8;
+
+// 避免 I / (I_via f) 剛好是整數時因捨入多算一孔
+constexpr double COUNT_EPSILON = 1e-9;
+
+// a 比 b 好：面積小、孔數少、電阻小
+bool better(const ViaArrayDesign &a, const ViaArrayDesign &b)
+{
+    if (a.area_mm2 != b.area_mm2) return a.area_mm2 < b.area_mm2;
+    if (a.count() != b.count()) return a.count() < b.count();
+    return a.resistance_ohm < b.resistance_ohm;
+}
+
+bool fits(double w, double h, const ViaArrayOptions &opt)
+{
+    const bool wOk = !(opt.maxWidth_mm > 0) || w <= opt.maxWidth_mm;
+    const bool hOk = !(opt.maxHeight_mm > 0) || h <= opt.maxHeight_mm;
+    return wOk && hOk;
+}
+
+// 中心距候選：最小中心距、格點、2 倍與 3 倍孔徑
+std::vector<double> pitchCandidates(double drill, const ViaArrayOptions &opt)
+{
+    const double pMin = drill + std::max(opt.holeSpacing_mm, 0.0);
+    const double pMax = GROUP_FULL_RATIO * drill;
+    std::vector<double> pitches{ pMin };
+    if (opt.pitchStep_mm > 0) {
+        for (double p = std::ceil(pMin / opt.pitchStep_mm) * opt.pitchStep_mm; p < pMax; p += opt.pitchStep_mm) {
+            if (p > pMin) pitches.push_back(p);
+        }
+    }
+    for (double ratio : { GROUP_DERATED_RATIO, GROUP_FULL_RATIO }) {
+        if (ratio * drill > pMin) pitches.push_back(ratio * drill);
+    }
+    std::sort(pitches.begin(), pitches.end());
+    pitches.erase(std::unique(pitches.begin(), pitches.end()), pitches.end());
+    return pitches;
+}
+
+ViaArrayDesign searchCombination(double drill, double wall, const ViaArrayOptions &opt)
+{
+    ViaArrayDesign base;
+    base.drill_mm = drill;
+    base.wallThick_mm = wall;
+    const double area = viaArea(drill, wall);
+    base.viaCurrent_A = (opt.model == TraceModel::IPC2152)
+                            ? viaMaxCurrentIpc2152(drill, wall, opt.deltaT, opt.boardThick_mm)
+                            : viaMaxCurrent(area * MM2_TO_SQMIL, opt.deltaT);
+    const double viaR = viaResistance(area, opt.boardThick_mm, opt.deltaT);
+    const double pad = drill + 2 * std::max(opt.annularRing_mm, 0.0);
+    if (!(base.viaCurrent_A > 0)) return base;
+
+    auto finish = [&](ViaArrayDesign d, double pitch, int rows, int cols, double factor) {
+        d.pitch_mm = pitch;
+        d.rows = rows;
+        d.cols = cols;
+        d.groupFactor = factor;
+        d.capacity_A = d.count() * d.viaCurrent_A * factor;
+        d.width_mm = (cols - 1) * pitch + pad;
+        d.height_mm = (rows - 1) * pitch + pad;
+        d.area_mm2 = d.width_mm * d.height_mm;
+        d.resistance_ohm = viaR / d.count();
+        d.voltageDrop_V = opt.current_A * d.resistance_ohm;
+        d.power_W = opt.current_A * d.voltageDrop_V;
+        return d;
+    };
+
+    // 單孔就夠 (不減額、沒有中心距)
+    if (base.viaCurrent_A >= opt.current_A) {
+        ViaArrayDesign d = finish(base, 0, 1, 1, 1);
+        d.feasible = fits(pad, pad, opt);
+        return d;
+    }
+
+    ViaArrayDesign bestFit, bestAny;
+    bool haveFit = false, haveAny = false;
+    for (double p : pitchCandidates(drill, opt)) {
+        const double f = viaGroupFactor(p, drill);
+        const double needed = std::ceil(opt.current_A / (base.viaCurrent_A * f) - COUNT_EPSILON);
+        if (needed > opt.maxVias) continue;
+        const int n = static_cast<int>(needed);
+        for (int rows = 1; rows <= n; ++rows) {
+            const int cols = (n + rows - 1) / rows;
+            if (cols < rows) break;                     // 其餘是旋轉後的同一個排列
+            if ((rows - 1) * cols >= n) continue;       // 最後一列是空的
+            ViaArrayDesign d = finish(base, p, rows, cols, f);
+            if (!haveAny || better(d, bestAny)) {
+                bestAny = d;
+                haveAny = true;
+            }
+            const bool upright = fits(d.width_mm, d.height_mm, opt);
+            if (!upright && !fits(d.height_mm, d.width_mm, opt)) continue;
+            if (!upright) {
+                std::swap(d.rows, d.cols);
+                std::swap(d.width_mm, d.height_mm);
+            }
+            d.feasible = true;
+            if (!haveFit || better(d, bestFit)) {
+                bestFit = d;
+                haveFit = true;
+            }
+        }
+    }
+    if (haveFit) return bestFit;
+    return haveAny ? bestAny : base;
+}
+
+} // namespace
+
+double viaGroupFactor(double pitch_mm, double diameter_mm)
+{
+    const double ratio = pitch_mm / diameter_mm;
+    if (!(ratio < GROUP_FULL_RATIO)) return 1.0;
+    if (ratio <= GROUP_DERATED_RATIO) return GROUP_DERATING;
+    return GROUP_DERATING + (1.0 - GROUP_DERATING) * (ratio - GROUP_DERATED_RATIO)
+                                / (GROUP_FULL_RATIO - GROUP_DERATED_RATIO);
+}
+
+const std::vector<double> &standardDrills_mm()
+{
+    // 機鑽的常用成品孔徑 (0.15 mm 以下為雷射孔，不列入)
+    static const std::vector<double> drills = { 0.15, 0.2, 0.25, 0.3, 0.35, 0.4, 0.45, 0.5, 0.55, 0.6, 0.65, 0.7,
+                                                0.8, 0.9, 1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 1.6, 1.8, 2.0 };
+    return drills;
+}
+
+ViaArrayResult viaArraySearch(const ViaArrayOptions &options)
+{
+    ViaArrayResult result;
+    const std::vector<double> &drills = options.drills_mm.empty() ? standardDrills_mm() : options.drills_mm;
+    std::vector<double> walls;
+    for (double w : options.wallThick_mm) {
+        if (w > 0) walls.push_back(w);
+    }
+    if (!(options.current_A > 0) || !(options.deltaT > 0) || !(options.boardThick_mm > 0) || walls.empty())
+        return result;
+
+    const std::size_t nw = walls.size();
+    result.table.resize(drills.size() * nw);
+    parallelFor(result.table.size(), options.threads, [&](std::size_t k) {
+        const double drill = drills[k / nw];
+        if (drill > 0) result.table[k] = searchCombination(drill, walls[k % nw], options);
+    });
+
+    for (std::size_t k = 0; k < result.table.size(); ++k) {
+        const ViaArrayDesign &d = result.table[k];
+        if (d.feasible && (result.best < 0 || better(d, result.table[result.best]))) result.best = static_cast<int>(k);
+    }
+    return result;
+}
+
+} // namespace sc
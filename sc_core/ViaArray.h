@@ -0,0 +1,74 @@
+#ifndef SC_VIAARRAY_H
+#define SC_VIAARRAY_H
+
+/**
+ * @file ViaArray.h
+ * @brief 貫孔陣列：總電流分給多個貫孔時的孔數、孔徑與中心距搜尋
+ *
+ * 單孔的載流能力與 ViaCalc.h 相同 (IPC-2221 或 IPC-2152)。貫孔排得太擠時熱會互相堆疊，
+ * 依設計筆記 (DOC/演算法筆記.txt) 的群組係數減額：中心距 >= 3 倍孔徑為 100%，
+ * <= 2 倍孔徑乘 0.8，兩者之間線性內插。
+ *
+ * 搜尋：對標準鑽孔尺寸表 x 孔壁電鍍選項的每個組合，掃描中心距 (最小孔間距到 3 倍孔徑)，
+ * 求出滿足總電流的孔數與 rows x cols 排列，取外框 (焊墊外緣) 面積最小、放得進焊墊範圍的設計。
+ */
+
+#include "Ipc2152.h"
+
+#include <vector>
+
+namespace sc {
+
+// 群組減額係數 (1 顆貫孔不減額)
+double viaGroupFactor(double pitch_mm, double diameter_mm);
+
+// 常用的成品孔徑 (mm)，由小到大
+const std::vector<double> &standardDrills_mm();
+
+struct ViaArrayOptions {
+    double current_A = 5;               // 總電流
+    double deltaT = 10;                 // 允許溫升 (°C)
+    double boardThick_mm = 1.6;         // 貫孔長度
+    std::vector<double> wallThick_mm = { 0.02, 0.025 };  // 孔壁電鍍厚度的選項
+    std::vector<double> drills_mm;      // 孔徑選項，空白 = standardDrills_mm()
+    double annularRing_mm = 0.15;       // 焊墊直徑 = 孔徑 + 2 * 孔環
+    double holeSpacing_mm = 0.25;       // 相鄰孔壁的最小距離 (製程能力)
+    double pitchStep_mm = 0.05;         // 中心距的掃描間隔 (擺放格點)
+    double maxWidth_mm = 0;             // 可放置貫孔的焊墊範圍，<= 0 表示不限
+    double maxHeight_mm = 0;
+    int maxVias = 400;
+    TraceModel model = TraceModel::IPC2221;
+    unsigned threads = 0;               // 0 = 全部硬體執行緒
+};
+
+struct ViaArrayDesign {
+    double drill_mm = 0;
+    double wallThick_mm = 0;
+    double pitch_mm = 0;
+    int rows = 0;
+    int cols = 0;
+    double groupFactor = 1;
+    double viaCurrent_A = 0;            // 單孔載流能力 (減額前)
+    double capacity_A = 0;              // rows * cols * viaCurrent_A * groupFactor
+    double width_mm = 0;                // 外框 (含焊墊)
+    double height_mm = 0;
+    double area_mm2 = 0;
+    double resistance_ohm = 0;          // 並聯電阻 (溫升後的電阻率)
+    double voltageDrop_V = 0;
+    double power_W = 0;
+    bool feasible = false;              // 放得進焊墊範圍且孔數 <= maxVias
+
+    int count() const { return rows * cols; }
+};
+
+struct ViaArrayResult {
+    // 每個 (孔徑, 電鍍) 組合的最佳設計，依孔徑、電鍍排序；放不下時為不受範圍限制的最小設計 (feasible = false)
+    std::vector<ViaArrayDesign> table;
+    int best = -1;                      // table 中面積最小的可行設計，沒有時為 -1
+};
+
+ViaArrayResult viaArraySearch(const ViaArrayOptions &options);
+
+} // namespace sc
+
+#endif // SC_VIAARRAY_H
@@ -0,0 +1,100 @@
+/**
+ * @file ViaCalc.cpp
+ * @brief 貫孔電流計算 (IPC-2221) - 不依賴 Qt 的核心實現
+ *
+ * 1. 截面積：A = π * (D + t) * t (mm²)，IPC 公式再換算為 mil²
+ * 2. 最大電流：I = 0.048 * ΔT^0.44 * A^0.725；或以 IPC-2152 查表 (Ipc2152.h)
+ * 3. 電阻：R = ρ(T) * H / A，ρ(T) = ρ20 * (1 + 0.00393 * (T - 20))，T = 25 + ΔT
+ */
+
+#include "ViaCalc.h"
+#include "Ipc2152.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sc {
+
+double viaArea(double diameter_mm, double wallThick_mm)
+{
+    return PI * (diameter_mm + wallThick_mm) * wallThick_mm;
+}
+
+double viaMaxCurrent(double area_sqMil, double deltaT)
+{
+    return 0.048 * std::pow(deltaT, 0.44) * std::pow(area_sqMil, 0.725);
+}
+
+double viaMaxCurrentIpc2152(double diameter_mm, double wallThick_mm, double deltaT, double boardThick_mm)
+{
+    Ipc2152Options opt;
+    opt.boardThickness_mm = boardThick_mm;
+    return ipc2152CurrentFromArea(viaArea(diameter_mm, wallThick_mm) * MM2_TO_SQMIL, deltaT,
+                                  wallThick_mm / COPPER_MM_PER_OZ, opt);
+}
+
+double viaTempRise(double current_A, double area_sqMil)
+{
+    return std::pow(current_A / (0.048 * std::pow(area_sqMil, 0.725)), 1.0 / 0.44);
+}
+
+double viaResistance(double area_mm2, double boardThick_mm, double deltaT)
+{
+    double temp_final = VIA_AMBIENT_C + deltaT;
+    double rho_hot = COPPER_RHO_OHM_MM * (1.0 + COPPER_ALPHA * (temp_final - 20.0));
+    return rho_hot * (boardThick_mm / area_mm2);
+}
+
+ViaResult viaSolve(double current_A, double deltaT, double boardThick_mm,
+                   double diameter_mm, double wallThick_mm)
+{
+    ViaResult r;
+    r.area_mm2 = viaArea(diameter_mm, wallThick_mm);
+    r.maxCurrent_A = viaMaxCurrent(r.area_mm2 * MM2_TO_SQMIL, deltaT);
+    r.resistance_ohm = viaResistance(r.area_mm2, boardThick_mm, deltaT);
+    r.voltageDrop_V = current_A * r.resistance_ohm;
+    r.power_W = current_A * current_A * r.resistance_ohm;
+    r.overCurrent = current_A > r.maxCurrent_A;
+    return r;
+}
+
+void viaSolveBatch(const ViaBatchIn &in, const ViaBatchOut &out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        ViaResult r = viaSolve(in.current_A[i], in.deltaT[i], in.boardThick_mm[i],
+                               in.diameter_mm[i], in.wallThick_mm[i]);
+        out.maxCurrent_A[i] = r.maxCurrent_A;
+        out.resistance_ohm[i] = r.resistance_ohm;
+        out.voltageDrop_V[i] = r.voltageDrop_V;
+        out.power_W[i] = r.power_W;
+    }
+}
+
+Interval viaAreaInterval(const Interval &diameter_mm, const Interval &wallThick_mm)
+{
+    // 物理上皆為正值：下界夾在 0，(D + t) * t 對 t 才是單調遞增
+    const Interval t = interval(std::max(wallThick_mm.lower(), 0.0), wallThick_mm.upper());
+    const Interval d = interval(std::max(diameter_mm.lower(), 0.0), diameter_mm.upper());
+    return PI * ((d + t) * t);
+}
+
+Interval viaMaxCurrentInterval(const Interval &diameter_mm, const Interval &wallThick_mm, const Interval &deltaT)
+{
+    return 0.048 * pow(deltaT, 0.44) * pow(viaAreaInterval(diameter_mm, wallThick_mm) * MM2_TO_SQMIL, 0.725);
+}
+
+Interval viaMaxCurrentIpc2152Interval(const Interval &diameter_mm, const Interval &wallThick_mm,
+                                      const Interval &deltaT, double boardThick_mm)
+{
+    return interval(viaMaxCurrentIpc2152(diameter_mm.lower(), wallThick_mm.lower(), deltaT.lower(), boardThick_mm),
+                    viaMaxCurrentIpc2152(diameter_mm.upper(), wallThick_mm.upper(), deltaT.upper(), boardThick_mm));
+}
+
+Interval viaResistanceInterval(const Interval &diameter_mm, const Interval &wallThick_mm,
+                               const Interval &boardThick_mm, const Interval &deltaT)
+{
+    const Interval rhoHot = COPPER_RHO_OHM_MM * (COPPER_ALPHA * (deltaT + (VIA_AMBIENT_C - 20.0)) + 1.0);
+    return rhoHot * (boardThick_mm / viaAreaInterval(diameter_mm, wallThick_mm));
+}
+
+} // namespace sc
@@ -0,0 +1,77 @@
+#ifndef SC_VIACALC_H
+#define SC_VIACALC_H
+
+#include "Interval.h"
+#include "ScConstants.h"
+
+#include <cstddef>
+
+namespace sc {
+
+// 預設環境溫度 (°C)
+constexpr double VIA_AMBIENT_C = 25.0;
+
+// 貫孔截面積 (mm²)：圓柱管攤平成長方形，Area = π * (D + t) * t
+double viaArea(double diameter_mm, double wallThick_mm);
+
+// 最大許可電流 (A)，IPC-2221 外層係數 0.048
+double viaMaxCurrent(double area_sqMil, double deltaT);
+
+// IPC-2152 的最大許可電流 (A)：孔壁攤平成走線，銅重由孔壁厚換算，板厚修正取貫孔長度 (板厚)
+double viaMaxCurrentIpc2152(double diameter_mm, double wallThick_mm, double deltaT, double boardThick_mm);
+
+// 給定電流求溫升 (°C)，viaMaxCurrent 的反函數
+double viaTempRise(double current_A, double area_sqMil);
+
+// 貫孔電阻 (Ohm)，以環境溫度 + 溫升修正電阻率
+double viaResistance(double area_mm2, double boardThick_mm, double deltaT);
+
+struct ViaResult {
+    double area_mm2;
+    double maxCurrent_A;
+    double resistance_ohm;
+    double voltageDrop_V;
+    double power_W;
+    bool overCurrent;        // 輸入電流超過 I_max
+};
+
+ViaResult viaSolve(double current_A, double deltaT, double boardThick_mm,
+                   double diameter_mm, double wallThick_mm);
+
+// 批次計算 (struct-of-arrays)
+struct ViaBatchIn {
+    const double *current_A;
+    const double *deltaT;
+    const double *boardThick_mm;
+    const double *diameter_mm;
+    const double *wallThick_mm;
+};
+
+struct ViaBatchOut {
+    double *maxCurrent_A;
+    double *resistance_ohm;
+    double *voltageDrop_V;
+    double *power_W;
+};
+
+void viaSolveBatch(const ViaBatchIn &in, const ViaBatchOut &out, std::size_t n);
+
+// --- 最差情況 (區間運算)：孔徑、孔壁厚、溫升的範圍 ---
+
+// 截面積的範圍 (mm²)；孔壁厚出現兩次，但兩處都是遞增，所以仍是精確範圍
+Interval viaAreaInterval(const Interval &diameter_mm, const Interval &wallThick_mm);
+
+// 最大許可電流的範圍 (A)
+Interval viaMaxCurrentInterval(const Interval &diameter_mm, const Interval &wallThick_mm, const Interval &deltaT);
+
+// IPC-2152 最大許可電流的範圍 (A)：對孔徑、孔壁厚、溫升都是遞增，取兩端
+Interval viaMaxCurrentIpc2152Interval(const Interval &diameter_mm, const Interval &wallThick_mm,
+                                      const Interval &deltaT, double boardThick_mm);
+
+// 貫孔電阻的範圍 (Ohm)
+Interval viaResistanceInterval(const Interval &diameter_mm, const Interval &wallThick_mm,
+                               const Interval &boardThick_mm, const Interval &deltaT);
+
+} // namespace sc
+
+#endif // SC_VIACALC_H
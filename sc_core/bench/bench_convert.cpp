@@ -0,0 +1,122 @@
+/**
+ * @file bench_convert.cpp
+ * @brief SI 前綴批次換算的微基準測試
+ *
+ * 比較：
+ *   1. 舊的純量路徑：每個元素都呼叫 std::pow(10, e1 - e2) (等同 UnitConverterHandler::convert 原本的寫法)
+ *   2. 比值提到迴圈外的純量迴圈
+ *   3. SSE2 / AVX2 核心與自動選擇 (dispatch)
+ * 輸出每秒處理的元素數 (Melem/s)。
+ *
+ * 用法：bench_convert [元素數量，預設 16777216]
+ */
+
+#include "ScaleKernels.h"
+#include "Units.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <class Fn>
+double bestSeconds(Fn &&fn, int reps = 7)
+{
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = Clock::now();
+        fn();
+        auto t1 = Clock::now();
+        double s = std::chrono::duration<double>(t1 - t0).count();
+        if (s < best) best = s;
+    }
+    return best;
+}
+
+volatile double g_sink = 0;
+
+// 舊的 UnitConverterHandler::convert：單位 index 在執行期才知道，每次都重算比值
+const std::vector<int> kExponents = {-12, -9, -6, -3, 0, 3, 6};
+
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+double legacyConvert(double value, int sourceIdx, int targetIdx)
+{
+    double ratio = std::pow(10, kExponents[sourceIdx] - kExponents[targetIdx]);
+    return value * ratio;
+}
+
+template <class T>
+void touch(const std::vector<T> &v)
+{
+    g_sink = g_sink + static_cast<double>(v[v.size() / 2]);
+}
+
+void report(const char *name, std::size_t n, double seconds)
+{
+    std::printf("  %-28s %10.1f Melem/s  (%.3f ms)\n", name, n / seconds / 1e6, seconds * 1e3);
+}
+
+template <class T>
+void runSuite(const char *typeName, std::size_t n)
+{
+    // 來源/目標單位由執行期決定 (volatile 避免編譯器把 std::pow 提出迴圈)
+    volatile int srcIdxV = 2;   // u
+    volatile int dstIdxV = 3;   // m
+    const int srcIdx = srcIdxV;
+    const int dstIdx = dstIdxV;
+
+    std::vector<T> in(n), out(n);
+    for (std::size_t i = 0; i < n; ++i) in[i] = static_cast<T>((i % 1000) * 0.25 + 1);
+
+    std::printf("%s, n = %zu\n", typeName, n);
+
+    report("scalar std::pow per element", n, bestSeconds([&] {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = static_cast<T>(legacyConvert(in[i], srcIdx, dstIdx));
+        touch(out);
+    }));
+
+    const T k = static_cast<T>(sc::units::pow10(kExponents[srcIdx] - kExponents[dstIdx]));
+    report("scalar hoisted ratio", n, bestSeconds([&] {
+        sc::scaleArrayWith(sc::SimdLevel::Scalar, in.data(), out.data(), n, k);
+        touch(out);
+    }));
+    report("SSE2", n, bestSeconds([&] {
+        sc::scaleArrayWith(sc::SimdLevel::SSE2, in.data(), out.data(), n, k);
+        touch(out);
+    }));
+    report("AVX2", n, bestSeconds([&] {
+        sc::scaleArrayWith(sc::SimdLevel::AVX2, in.data(), out.data(), n, k);
+        touch(out);
+    }));
+    report("dispatch", n, bestSeconds([&] {
+        sc::scaleArray(in.data(), out.data(), n, k);
+        touch(out);
+    }));
+    report("dispatch in-place", n, bestSeconds([&] {
+        sc::scaleArray(in.data(), in.data(), n, k);
+        touch(in);
+    }));
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 24);
+    if (n == 0) n = 1;
+
+    std::printf("detected SIMD level: %s\n", sc::simdLevelName(sc::detectedSimdLevel()));
+    runSuite<double>("double", n);
+    runSuite<float>("float", n);
+    return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef SC_CLI_COMMANDS_H
+#define SC_CLI_COMMANDS_H
+
+#include <string>
+#include <vector>
+
+// sc_cli 的子指令，args 不含程式名稱與子指令名稱，回傳值即程式結束碼
+int runConvert(const std::vector<std::string> &args);
+int runBom(const std::vector<std::string> &args);
+int runTraces(const std::vector<std::string> &args);
+int runPlane(const std::vector<std::string> &args);
+int runPulse(const std::vector<std::string> &args);
+
+#endif // SC_CLI_COMMANDS_H
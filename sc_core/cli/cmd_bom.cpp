@@ -0,0 +1,215 @@
+/**
+ * @file cmd_bom.cpp
+ * @brief sc_cli bom：整份 BOM / 置件檔的 SMD 代碼正規化
+ *
+ *   sc_cli bom --header --column Code bom.csv normalized.csv
+ *
+ * 代碼欄位以 3 位數、4 位數、RKM 與 EIA-96 規則解析，輸出時在每列最後加上
+ * 解析出的數值 (電阻 Ohm、電容 pF)，無法解析的代碼依行號列在 stderr。
+ */
+
+#include "Commands.h"
+
+#include "BufferedWriter.h"
+#include "CsvScale.h"
+#include "MappedFile.h"
+#include "NumParse.h"
+#include "SmdBom.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printBomUsage()
+{
+    std::fprintf(stderr,
+        "usage: sc_cli bom [options] <input> [<output>]\n"
+        "\n"
+        "  --column <c>       1-based column number or header name of the code (default 1)\n"
+        "  --header           first row is a header\n"
+        "  --delimiter <c>    field delimiter (default ',', use 'tab' for tab)\n"
+        "  --threads <n>      worker threads (default: all cores)\n"
+        "  --max-errors <n>   number of failed lines to print (default 20, 0 = all)\n"
+        "  --quiet            do not print statistics\n"
+        "\n"
+        "Codes: 3/4 digit (103, 1002), RKM (4R7, 4K7, 4p7, 1n2) and EIA-96 (01C).\n"
+        "With <output>, every row is copied with the decoded value (Ohm / pF) appended;\n"
+        "'-' writes to standard output. Exit status is 3 when some codes failed to decode.\n");
+}
+
+bool isAllDigits(const std::string &s)
+{
+    if (s.empty()) return false;
+    for (char c : s) {
+        if (c < '0' || c > '9') return false;
+    }
+    return true;
+}
+
+// 輸入原樣輸出，每列最後加上一個欄位
+bool writeAnnotated(std::string_view input, const sc::SmdBomOptions &opt,
+                    const std::vector<double> &values, sc::BufferedWriter &out)
+{
+    const char *p = input.data();
+    const char *end = p + input.size();
+    char num[sc::FORMAT_BUFFER_SIZE];
+    bool header = opt.hasHeader;
+    std::size_t row = 0;
+
+    while (p < end && out.ok()) {
+        const char *nl = static_cast<const char *>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        const char *lineEnd = nl ? nl : end;
+        const char *content = lineEnd;
+        if (content > p && content[-1] == '\r') --content;
+
+        out.write(p, static_cast<std::size_t>(content - p));
+        if (content == p && !header) {
+            ++row;                                  // 空白列原樣保留
+        } else if (header) {
+            out.write(&opt.delimiter, 1);
+            out.write("value");
+            header = false;
+        } else {
+            out.write(&opt.delimiter, 1);
+            double v = values[row++];
+            if (!std::isnan(v)) out.write(num, static_cast<std::size_t>(sc::formatDouble(num, v) - num));
+        }
+        out.write(content, static_cast<std::size_t>((nl ? nl + 1 : end) - content));
+        p = nl ? nl + 1 : end;
+    }
+    return out.ok();
+}
+
+} // namespace
+
+int runBom(const std::vector<std::string> &args)
+{
+    std::string columnArg = "1", inputPath, outputPath;
+    sc::SmdBomOptions opt;
+    std::size_t maxErrors = 20;
+    bool quiet = false;
+
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string &a = args[i];
+        auto value = [&](std::string &dst) {
+            if (i + 1 >= args.size()) {
+                std::fprintf(stderr, "sc_cli bom: %s needs a value\n", a.c_str());
+                return false;
+            }
+            dst = args[++i];
+            return true;
+        };
+        std::string v;
+        if (a == "--help" || a == "-h") {
+            printBomUsage();
+            return 0;
+        } else if (a == "--column") {
+            if (!value(columnArg)) return 2;
+        } else if (a == "--header") {
+            opt.hasHeader = true;
+        } else if (a == "--delimiter") {
+            if (!value(v)) return 2;
+            if (v == "tab" || v == "\\t") opt.delimiter = '\t';
+            else if (v.size() == 1) opt.delimiter = v[0];
+            else {
+                std::fprintf(stderr, "sc_cli bom: delimiter must be a single character\n");
+                return 2;
+            }
+        } else if (a == "--threads") {
+            if (!value(v)) return 2;
+            opt.threads = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "--max-errors") {
+            if (!value(v)) return 2;
+            maxErrors = static_cast<std::size_t>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "--quiet") {
+            quiet = true;
+        } else if (!a.empty() && a[0] == '-' && a != "-") {
+            std::fprintf(stderr, "sc_cli bom: unknown option %s\n", a.c_str());
+            return 2;
+        } else if (inputPath.empty()) {
+            inputPath = a;
+        } else if (outputPath.empty()) {
+            outputPath = a;
+        } else {
+            std::fprintf(stderr, "sc_cli bom: too many arguments\n");
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        printBomUsage();
+        return 2;
+    }
+
+    sc::MappedFile input;
+    if (!input.open(inputPath)) {
+        std::fprintf(stderr, "sc_cli bom: %s\n", input.errorString().c_str());
+        return 1;
+    }
+
+    // 欄位可以是編號 (1 起算) 或標題名稱
+    if (isAllDigits(columnArg)) {
+        unsigned long n = std::strtoul(columnArg.c_str(), nullptr, 10);
+        if (n == 0) {
+            std::fprintf(stderr, "sc_cli bom: column numbers start at 1\n");
+            return 2;
+        }
+        opt.column = n - 1;
+    } else {
+        std::vector<std::string> header;
+        if (opt.hasHeader) {
+            std::string_view all = input.view();
+            header = sc::splitCsvLine(all.substr(0, all.find('\n')), opt.delimiter);
+        }
+        std::size_t k = 0;
+        while (k < header.size() && header[k] != columnArg) ++k;
+        if (k == header.size()) {
+            std::fprintf(stderr, "sc_cli bom: column '%s' not found%s\n", columnArg.c_str(),
+                         opt.hasHeader ? "" : " (use --header to select by name)");
+            return 2;
+        }
+        opt.column = k;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    sc::SmdBomResult result = sc::decodeSmdBom(input.view(), opt);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const std::size_t shown = (maxErrors == 0) ? result.failures.size()
+                                               : std::min(maxErrors, result.failures.size());
+    for (std::size_t i = 0; i < shown; ++i) {
+        const sc::SmdBomFailure &f = result.failures[i];
+        std::fprintf(stderr, "line %zu: cannot decode '%.*s'\n", f.line,
+                     static_cast<int>(f.code.size()), f.code.data());
+    }
+    if (shown < result.failures.size())
+        std::fprintf(stderr, "... %zu more\n", result.failures.size() - shown);
+
+    if (!outputPath.empty()) {
+        sc::BufferedWriter out;
+        if (!out.open(outputPath)) {
+            std::fprintf(stderr, "sc_cli bom: %s\n", out.errorString().c_str());
+            return 1;
+        }
+        bool ok = writeAnnotated(input.view(), opt, result.values, out);
+        ok = out.close() && ok;
+        if (!ok) {
+            std::fprintf(stderr, "sc_cli bom: %s\n", out.errorString().c_str());
+            return 1;
+        }
+    }
+
+    if (!quiet) {
+        std::fprintf(stderr, "%zu rows, %zu failed, %.1f MB/s\n",
+                     result.values.size(), result.failures.size(),
+                     seconds > 0 ? input.size() / seconds / 1e6 : 0.0);
+    }
+    return result.failures.empty() ? 0 : 3;
+}
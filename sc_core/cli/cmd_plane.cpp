@@ -0,0 +1,168 @@
+/**
+ * @file cmd_plane.cpp
+ * @brief sc_cli plane：鋪銅多邊形的直流壓降 (IR drop)
+ *
+ *   sc_cli plane --cell 0.02 --map drop.csv rail.txt
+ *
+ * 輸入格式見 PlaneDrop.h (文字或 JSON)。標準輸出為摘要：網格、最大壓降、各負載 / 過孔壓降、
+ * 功耗與電流密度熱點；--map 另外輸出每個銅格的壓降與電流密度 (CSV)。
+ */
+
+#include "Commands.h"
+
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+#include "NumParse.h"
+#include "PlaneDrop.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printPlaneUsage()
+{
+    std::fprintf(stderr,
+        "usage: sc_cli plane [options] <input>\n"
+        "\n"
+        "  --cell <mm>        mesh cell size (default: about --cells cells over the outline)\n"
+        "  --cells <n>        target cell count for the automatic cell size (default 1000000)\n"
+        "  --temp <C>         copper temperature, overrides the input file\n"
+        "  --hotspots <n>     current density hotspots to report (default 10)\n"
+        "  --map <file>       write x_mm,y_mm,drop_V,density_A_per_mm2 of every copper cell\n"
+        "  --tolerance <r>    relative residual of the solver (default 1e-6)\n"
+        "  --threads <n>      worker threads (default: all cores)\n"
+        "\n"
+        "The input is a text or JSON description of the copper pour: outline and hole polygons,\n"
+        "source pads (0 V), sink pads and vias with the current they draw. Text example:\n"
+        "  units mm\n"
+        "  oz 2\n"
+        "  outline 0,0 50,0 50,30 0,30\n"
+        "  source 2 15 4\n"
+        "  sink 48 15 4 10\n"
+        "  via 25 5 0.3 2\n"
+        "Exit status is 3 when the solver did not converge.\n");
+}
+
+} // namespace
+
+int runPlane(const std::vector<std::string> &args)
+{
+    std::string inputPath, mapPath;
+    sc::PlaneDropOptions opt;
+    double temperature = 0;
+    bool hasTemperature = false;
+
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string &a = args[i];
+        auto value = [&](std::string &dst) {
+            if (i + 1 >= args.size()) {
+                std::fprintf(stderr, "sc_cli plane: %s needs a value\n", a.c_str());
+                return false;
+            }
+            dst = args[++i];
+            return true;
+        };
+        auto number = [&](double &dst, bool positive) {
+            std::string v;
+            if (!value(v)) return false;
+            if (!sc::parseNumber(v, dst) || (positive && !(dst > 0))) {
+                std::fprintf(stderr, "sc_cli plane: %s must be a %snumber\n", a.c_str(), positive ? "positive " : "");
+                return false;
+            }
+            return true;
+        };
+        std::string v;
+        double d;
+        if (a == "--help" || a == "-h") {
+            printPlaneUsage();
+            return 0;
+        } else if (a == "--cell") {
+            if (!number(opt.cell_mm, true)) return 2;
+        } else if (a == "--cells") {
+            if (!number(d, true)) return 2;
+            opt.targetCells = static_cast<std::size_t>(d);
+            if (opt.targetCells > opt.maxCells) opt.maxCells = opt.targetCells;
+        } else if (a == "--temp") {
+            if (!number(temperature, false)) return 2;
+            hasTemperature = true;
+        } else if (a == "--hotspots") {
+            if (!value(v)) return 2;
+            opt.hotspots = std::atoi(v.c_str());
+        } else if (a == "--map") {
+            if (!value(mapPath)) return 2;
+        } else if (a == "--tolerance") {
+            if (!number(opt.tolerance, true)) return 2;
+        } else if (a == "--threads") {
+            if (!value(v)) return 2;
+            opt.threads = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (!a.empty() && a[0] == '-') {
+            std::fprintf(stderr, "sc_cli plane: unknown option %s\n", a.c_str());
+            return 2;
+        } else if (inputPath.empty()) {
+            inputPath = a;
+        } else {
+            std::fprintf(stderr, "sc_cli plane: too many arguments\n");
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        printPlaneUsage();
+        return 2;
+    }
+
+    sc::MappedFile input;
+    if (!input.open(inputPath)) {
+        std::fprintf(stderr, "sc_cli plane: %s\n", input.errorString().c_str());
+        return 1;
+    }
+    sc::PlaneLayout layout;
+    std::string error;
+    if (!sc::parsePlaneLayout(input.view(), layout, error)) {
+        std::fprintf(stderr, "sc_cli plane: %s: %s\n", inputPath.c_str(), error.c_str());
+        return 1;
+    }
+    if (hasTemperature) layout.temperature_C = temperature;
+
+    auto t0 = std::chrono::steady_clock::now();
+    const sc::PlaneDropResult r = sc::planeDropSolve(layout, opt);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (!r.error.empty()) {
+        std::fprintf(stderr, "sc_cli plane: %s\n", r.error.c_str());
+        return 1;
+    }
+
+    std::printf("mesh            %d x %d cells of %.4g mm, %zu copper", r.nx, r.ny, r.cell_mm, r.copperCells);
+    if (r.islandCells) std::printf(", %zu in unconnected islands (ignored)", r.islandCells);
+    std::printf("\nsheet resistance %.4g mOhm/sq at %.4g C\n", r.sheetResistance_ohm * 1e3, layout.temperature_C);
+    std::printf("total current   %.6g A\n", r.totalCurrent_A);
+    std::printf("max drop        %.6g mV\n", r.maxDrop_V * 1e3);
+    std::printf("power loss      %.6g W\n", r.power_W);
+    std::printf("max density     %.6g A/mm^2\n", r.maxDensity_A_per_mm2);
+    for (std::size_t s = 0; s < r.sinkDrop_V.size(); ++s) {
+        const sc::PlanePad &p = layout.sinks[s];
+        std::printf("sink %-4zu       (%g, %g) %g A: %.6g mV\n", s + 1, p.x_mm, p.y_mm, p.current_A, r.sinkDrop_V[s] * 1e3);
+    }
+    for (std::size_t v = 0; v < r.viaDrop_V.size(); ++v) {
+        const sc::PlanePad &p = layout.vias[v];
+        std::printf("via %-5zu       (%g, %g) %g A: %.6g mV\n", v + 1, p.x_mm, p.y_mm, p.current_A, r.viaDrop_V[v] * 1e3);
+    }
+    for (std::size_t h = 0; h < r.hotspots.size(); ++h) {
+        const sc::PlaneHotspot &s = r.hotspots[h];
+        std::printf("hotspot %-3zu     (%.4g, %.4g) mm: %.4g A/mm^2\n", h + 1, s.x_mm, s.y_mm, s.density_A_per_mm2);
+    }
+    std::printf("solver          %d iterations%s, %.3f s\n", r.iterations, r.converged ? "" : " (NOT converged)", seconds);
+
+    if (!mapPath.empty()) {
+        sc::BufferedWriter out;
+        if (!out.open(mapPath) || !sc::writePlaneMapCsv(r, out) || !out.close()) {
+            std::fprintf(stderr, "sc_cli plane: %s\n", out.errorString().c_str());
+            return 1;
+        }
+    }
+    return r.converged ? 0 : 3;
+}
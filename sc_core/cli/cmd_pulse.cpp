@@ -0,0 +1,278 @@
+/**
+ * @file cmd_pulse.cpp
+ * @brief sc_cli pulse：脈衝 / 故障電流下走線與貫孔的溫度與熔斷時間 (波形 x 導體 批次)
+ *
+ *   sc_cli pulse --conductor trace:0.5,0.035,20 --conductor via:0.3,0.025,1.6 inrush.csv fault.csv
+ *   sc_cli pulse --conductors nets.txt --rect 30,0.01 -o result.csv
+ *
+ * 每個波形 (檔案或 --rect) 和每個導體組合各算一次 (PulseFusing.h)，輸出 CSV：
+ * wave, conductor, peak_C, peak_time_s, final_C, i2t_A2s, fused, fuse_time_s, onderdonk_time_s, steps
+ */
+
+#include "Commands.h"
+
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+#include "NumParse.h"
+#include "PulseFusing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printPulseUsage()
+{
+    std::fprintf(stderr,
+        "usage: sc_cli pulse [options] [waveform files...]\n"
+        "\n"
+        "  --conductor <spec>   trace:<width_mm>,<thickness_mm>,<length_mm>[,inner] or\n"
+        "                       via:<drill_mm>,<wall_mm>,<board_mm> (repeatable)\n"
+        "  --conductors <file>  one conductor spec per line (# comments)\n"
+        "  --rect <A>,<s>       rectangular pulse of the given current and width (repeatable)\n"
+        "  --rise <C>           temperature rise the thermal resistance is rated at (default 10)\n"
+        "  --ambient <C>        ambient temperature (default 25)\n"
+        "  --model <name>       ipc2221 (default) or ipc2152, for the thermal resistance\n"
+        "  --adiabatic          no cooling (Onderdonk assumption)\n"
+        "  --threads <n>        worker threads (default: all cores)\n"
+        "  -o, --output <file>  CSV output (default: standard output)\n"
+        "\n"
+        "A waveform file has two columns, time (s) and current (A), separated by commas, semicolons,\n"
+        "tabs or spaces; repeating a time makes a step. Every waveform is run on every conductor.\n"
+        "Exit status is 3 when any combination fuses.\n");
+}
+
+// 導體規格：trace:w,t,l[,inner] 或 via:d,t,h
+bool parseConductor(std::string_view spec, const sc::TraceModel model, double rise, double ambient, bool adiabatic,
+                    sc::PulseConductor &c)
+{
+    const std::size_t colon = spec.find(':');
+    if (colon == std::string_view::npos) return false;
+    const std::string_view kind = spec.substr(0, colon);
+    std::vector<double> values;
+    bool inner = false;
+    std::string_view rest = spec.substr(colon + 1);
+    while (!rest.empty()) {
+        const std::size_t comma = rest.find(',');
+        const std::string_view field = rest.substr(0, comma);
+        rest = (comma == std::string_view::npos) ? std::string_view() : rest.substr(comma + 1);
+        double v;
+        if (field == "inner") {
+            inner = true;
+        } else if (sc::parseNumber(field, v) && v > 0) {
+            values.push_back(v);
+        } else {
+            return false;
+        }
+    }
+    if (values.size() != 3) return false;
+    if (kind == "trace") {
+        c = sc::tracePulseConductor(values[0], values[1], values[2], inner, model, sc::Ipc2152Options(), rise, ambient);
+    } else if (kind == "via" && !inner) {
+        c = sc::viaPulseConductor(values[0], values[1], values[2], model, rise, ambient);
+    } else {
+        return false;
+    }
+    if (adiabatic) c.theta_C_per_W = 0;
+    return true;
+}
+
+void writeNumber(sc::BufferedWriter &out, double v)
+{
+    char buf[sc::FORMAT_BUFFER_SIZE];
+    out.write(buf, sc::formatDouble(buf, v) - buf);
+}
+
+} // namespace
+
+int runPulse(const std::vector<std::string> &args)
+{
+    std::vector<std::string> conductorSpecs, conductorFiles, waveFiles, rects;
+    std::string outputPath = "-";
+    sc::TraceModel model = sc::TraceModel::IPC2221;
+    double rise = 10, ambient = sc::VIA_AMBIENT_C;
+    bool adiabatic = false;
+    sc::PulseOptions opt;
+
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string &a = args[i];
+        auto value = [&](std::string &dst) {
+            if (i + 1 >= args.size()) {
+                std::fprintf(stderr, "sc_cli pulse: %s needs a value\n", a.c_str());
+                return false;
+            }
+            dst = args[++i];
+            return true;
+        };
+        auto number = [&](double &dst, bool positive) {
+            std::string v;
+            if (!value(v)) return false;
+            if (!sc::parseNumber(v, dst) || (positive && !(dst > 0))) {
+                std::fprintf(stderr, "sc_cli pulse: %s must be a %snumber\n", a.c_str(), positive ? "positive " : "");
+                return false;
+            }
+            return true;
+        };
+        std::string v;
+        if (a == "--help" || a == "-h") {
+            printPulseUsage();
+            return 0;
+        } else if (a == "--conductor") {
+            if (!value(v)) return 2;
+            conductorSpecs.push_back(v);
+        } else if (a == "--conductors") {
+            if (!value(v)) return 2;
+            conductorFiles.push_back(v);
+        } else if (a == "--rect") {
+            if (!value(v)) return 2;
+            rects.push_back(v);
+        } else if (a == "--rise") {
+            if (!number(rise, true)) return 2;
+        } else if (a == "--ambient") {
+            if (!number(ambient, false)) return 2;
+        } else if (a == "--model") {
+            if (!value(v)) return 2;
+            if (v == "ipc2221") {
+                model = sc::TraceModel::IPC2221;
+            } else if (v == "ipc2152") {
+                model = sc::TraceModel::IPC2152;
+            } else {
+                std::fprintf(stderr, "sc_cli pulse: unknown model %s\n", v.c_str());
+                return 2;
+            }
+        } else if (a == "--adiabatic") {
+            adiabatic = true;
+        } else if (a == "--threads") {
+            if (!value(v)) return 2;
+            opt.threads = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "-o" || a == "--output") {
+            if (!value(outputPath)) return 2;
+        } else if (!a.empty() && a[0] == '-') {
+            std::fprintf(stderr, "sc_cli pulse: unknown option %s\n", a.c_str());
+            return 2;
+        } else {
+            waveFiles.push_back(a);
+        }
+    }
+
+    // 導體：命令列與檔案
+    std::vector<sc::PulseConductor> conductors;
+    std::vector<std::string> conductorNames;
+    auto addConductor = [&](std::string_view spec, const std::string &where) {
+        sc::PulseConductor c;
+        if (!parseConductor(spec, model, rise, ambient, adiabatic, c)) {
+            std::fprintf(stderr, "sc_cli pulse: %s: bad conductor '%.*s'\n", where.c_str(),
+                         static_cast<int>(spec.size()), spec.data());
+            return false;
+        }
+        conductors.push_back(c);
+        conductorNames.emplace_back(spec);
+        return true;
+    };
+    for (const std::string &s : conductorSpecs) {
+        if (!addConductor(s, "--conductor")) return 2;
+    }
+    for (const std::string &path : conductorFiles) {
+        sc::MappedFile file;
+        if (!file.open(path)) {
+            std::fprintf(stderr, "sc_cli pulse: %s\n", file.errorString().c_str());
+            return 1;
+        }
+        std::string_view text = file.view();
+        std::size_t lineNo = 0;
+        while (!text.empty()) {
+            const std::size_t eol = text.find('\n');
+            std::string_view line = text.substr(0, eol);
+            text = (eol == std::string_view::npos) ? std::string_view() : text.substr(eol + 1);
+            ++lineNo;
+            line = line.substr(0, line.find('#'));
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+                line.remove_suffix(1);
+            while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) line.remove_prefix(1);
+            if (line.empty()) continue;
+            if (!addConductor(line, path + ":" + std::to_string(lineNo))) return 1;
+        }
+    }
+
+    // 波形：檔案與 --rect
+    std::vector<sc::PulseWaveform> waves;
+    std::vector<std::string> waveNames;
+    for (const std::string &path : waveFiles) {
+        sc::MappedFile file;
+        if (!file.open(path)) {
+            std::fprintf(stderr, "sc_cli pulse: %s\n", file.errorString().c_str());
+            return 1;
+        }
+        sc::PulseWaveform w;
+        std::string error;
+        if (!sc::parsePulseWaveform(file.view(), w, error)) {
+            std::fprintf(stderr, "sc_cli pulse: %s: %s\n", path.c_str(), error.c_str());
+            return 1;
+        }
+        waves.push_back(std::move(w));
+        waveNames.push_back(path);
+    }
+    for (const std::string &r : rects) {
+        const std::size_t comma = r.find(',');
+        double current, width;
+        if (comma == std::string::npos || !sc::parseNumber(std::string_view(r).substr(0, comma), current) ||
+            !sc::parseNumber(std::string_view(r).substr(comma + 1), width) || !(width > 0)) {
+            std::fprintf(stderr, "sc_cli pulse: --rect needs <A>,<s>, got '%s'\n", r.c_str());
+            return 2;
+        }
+        waves.push_back(sc::rectangularPulse(current, width, width));
+        waveNames.push_back("rect:" + r);
+    }
+
+    if (waves.empty() || conductors.empty()) {
+        printPulseUsage();
+        return 2;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    const std::vector<sc::PulseResult> results = sc::pulseSolveBatch(waves, conductors, opt);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    sc::BufferedWriter out;
+    if (!out.open(outputPath)) {
+        std::fprintf(stderr, "sc_cli pulse: %s\n", out.errorString().c_str());
+        return 1;
+    }
+    out.write("wave,conductor,peak_C,peak_time_s,final_C,i2t_A2s,fused,fuse_time_s,onderdonk_time_s,steps\n");
+    std::size_t fused = 0;
+    for (std::size_t w = 0; w < waves.size(); ++w) {
+        double peakCurrent = 0;
+        for (double I : waves[w].current_A) peakCurrent = std::max(peakCurrent, std::abs(I));
+        for (std::size_t c = 0; c < conductors.size(); ++c) {
+            const sc::PulseResult &r = results[w * conductors.size() + c];
+            out.write("\"" + waveNames[w] + "\",\"" + conductorNames[c] + "\",");
+            writeNumber(out, r.peak_C);
+            out.write(",");
+            writeNumber(out, r.peakTime_s);
+            out.write(",");
+            writeNumber(out, r.final_C);
+            out.write(",");
+            writeNumber(out, r.i2t_A2s);
+            out.write(r.fused ? ",1," : ",0,");
+            if (r.fused) writeNumber(out, r.fuseTime_s);
+            out.write(",");
+            // 以峰值電流估的 Onderdonk 熔斷時間 (絕熱，對照用)
+            if (peakCurrent > 0) writeNumber(out, sc::onderdonkFusingTime(peakCurrent, conductors[c].area_mm2, ambient));
+            out.write(",");
+            writeNumber(out, static_cast<double>(r.steps));
+            out.write("\n");
+            fused += r.fused;
+        }
+    }
+    if (!out.close()) {
+        std::fprintf(stderr, "sc_cli pulse: %s\n", out.errorString().c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "sc_cli pulse: %zu combinations, %zu fused, %.3f s\n", results.size(), fused, seconds);
+    return fused ? 3 : 0;
+}
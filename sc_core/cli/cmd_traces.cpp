@@ -0,0 +1,179 @@
+/**
+ * @file cmd_traces.cpp
+ * @brief sc_cli traces：網路清單 (CSV / JSON) 的批次線寬計算
+ *
+ *   sc_cli traces --model 2152 --board 1.6 nets.csv widths.csv
+ *
+ * 每個網路輸出線寬、電阻、壓降與功耗 (與走線頁相同的公式)，無法計算的列依行號列在 stderr；
+ * --self-heating 另外輸出該線寬下的自洽溫升、壓降與功耗 (走線頁的「自洽溫升」)。
+ */
+
+#include "Commands.h"
+
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+#include "NumParse.h"
+#include "TraceNetlist.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printTracesUsage()
+{
+    std::fprintf(stderr,
+        "usage: sc_cli traces [options] <input> [<output>]\n"
+        "\n"
+        "  --model <m>        2221 (default) or 2152\n"
+        "  --board <mm>       board thickness for IPC-2152 (default 1.6)\n"
+        "  --plane <mm>       distance to the nearest copper plane for IPC-2152 (default: none)\n"
+        "  --dt <C>           temperature rise when the row has none (default 10)\n"
+        "  --oz <oz>          copper weight when the row has none (default 1)\n"
+        "  --self-heating     also write the self-consistent rise, drop and power at the sized width\n"
+        "  --no-header        CSV has no header; columns are net,current,layer,oz,length,dt\n"
+        "  --delimiter <c>    CSV field delimiter (default ',', use 'tab' for tab)\n"
+        "  --threads <n>      worker threads (default: all cores)\n"
+        "  --max-errors <n>   number of failed lines to print (default 20, 0 = all)\n"
+        "  --quiet            do not print statistics\n"
+        "\n"
+        "The input is a CSV with a header (net, current, layer, oz, length, dt; only current is\n"
+        "required) or a JSON array of objects with the same keys. Layer is outer/inner.\n"
+        "The output is a CSV with width_mm, resistance_ohm, voltageDrop_V and power_W per net;\n"
+        "With --self-heating, actualRise_C, actualDrop_V and actualPower_W follow (20 C ambient;\n"
+        "'runaway' when there is no fixed point).\n"
+        "'-' or no <output> writes to standard output. Exit status is 3 when some rows failed.\n");
+}
+
+bool parsePositive(const std::string &text, double &out)
+{
+    return sc::parseNumber(text, out) && out > 0;
+}
+
+} // namespace
+
+int runTraces(const std::vector<std::string> &args)
+{
+    std::string inputPath, outputPath;
+    sc::TraceNetlistOptions opt;
+    std::size_t maxErrors = 20;
+    bool quiet = false;
+
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string &a = args[i];
+        auto value = [&](std::string &dst) {
+            if (i + 1 >= args.size()) {
+                std::fprintf(stderr, "sc_cli traces: %s needs a value\n", a.c_str());
+                return false;
+            }
+            dst = args[++i];
+            return true;
+        };
+        auto number = [&](double &dst) {
+            std::string v;
+            if (!value(v)) return false;
+            if (!parsePositive(v, dst)) {
+                std::fprintf(stderr, "sc_cli traces: %s must be a positive number\n", a.c_str());
+                return false;
+            }
+            return true;
+        };
+        std::string v;
+        if (a == "--help" || a == "-h") {
+            printTracesUsage();
+            return 0;
+        } else if (a == "--model") {
+            if (!value(v)) return 2;
+            if (v == "2221" || v == "ipc2221") opt.model = sc::TraceModel::IPC2221;
+            else if (v == "2152" || v == "ipc2152") opt.model = sc::TraceModel::IPC2152;
+            else {
+                std::fprintf(stderr, "sc_cli traces: model must be 2221 or 2152\n");
+                return 2;
+            }
+        } else if (a == "--board") {
+            if (!number(opt.ipc2152.boardThickness_mm)) return 2;
+        } else if (a == "--plane") {
+            if (!number(opt.ipc2152.planeDistance_mm)) return 2;
+        } else if (a == "--dt") {
+            if (!number(opt.defaultDeltaT)) return 2;
+        } else if (a == "--oz") {
+            if (!number(opt.defaultCopperOz)) return 2;
+        } else if (a == "--self-heating") {
+            opt.selfHeating = true;
+        } else if (a == "--no-header") {
+            opt.hasHeader = false;
+        } else if (a == "--delimiter") {
+            if (!value(v)) return 2;
+            if (v == "tab" || v == "\\t") opt.delimiter = '\t';
+            else if (v.size() == 1) opt.delimiter = v[0];
+            else {
+                std::fprintf(stderr, "sc_cli traces: delimiter must be a single character\n");
+                return 2;
+            }
+        } else if (a == "--threads") {
+            if (!value(v)) return 2;
+            opt.threads = static_cast<unsigned>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "--max-errors") {
+            if (!value(v)) return 2;
+            maxErrors = static_cast<std::size_t>(std::strtoul(v.c_str(), nullptr, 10));
+        } else if (a == "--quiet") {
+            quiet = true;
+        } else if (!a.empty() && a[0] == '-' && a != "-") {
+            std::fprintf(stderr, "sc_cli traces: unknown option %s\n", a.c_str());
+            return 2;
+        } else if (inputPath.empty()) {
+            inputPath = a;
+        } else if (outputPath.empty()) {
+            outputPath = a;
+        } else {
+            std::fprintf(stderr, "sc_cli traces: too many arguments\n");
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        printTracesUsage();
+        return 2;
+    }
+    if (outputPath.empty()) outputPath = "-";
+
+    sc::MappedFile input;
+    if (!input.open(inputPath)) {
+        std::fprintf(stderr, "sc_cli traces: %s\n", input.errorString().c_str());
+        return 1;
+    }
+    sc::BufferedWriter out;
+    if (!out.open(outputPath)) {
+        std::fprintf(stderr, "sc_cli traces: %s\n", out.errorString().c_str());
+        return 1;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    sc::TraceNetlistStats stats;
+    bool ok = sc::traceNetlist(input.view(), out, opt, &stats);
+    ok = out.close() && ok;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (!ok) {
+        std::fprintf(stderr, "sc_cli traces: %s\n",
+                     stats.error.empty() ? out.errorString().c_str() : stats.error.c_str());
+        return 1;
+    }
+
+    const std::size_t shown = (maxErrors == 0) ? stats.failedLines.size()
+                                               : std::min(maxErrors, stats.failedLines.size());
+    for (std::size_t i = 0; i < shown; ++i)
+        std::fprintf(stderr, "line %zu: cannot size this net\n", stats.failedLines[i]);
+    if (shown < stats.failedLines.size())
+        std::fprintf(stderr, "... %zu more\n", stats.failedLines.size() - shown);
+
+    if (!quiet) {
+        std::fprintf(stderr, "%zu nets, %zu failed, %.3f s\n", stats.rows, stats.failedLines.size(), seconds);
+        if (opt.selfHeating && stats.runaway)
+            std::fprintf(stderr, "%zu nets in thermal runaway\n", stats.runaway);
+    }
+    return stats.failedLines.empty() ? 0 : 3;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file main.cpp
+ * @brief sc_cli：不需要 GUI 的命令列工具，處理 GUI 開不動的大量資料
+ */
+
+#include "Commands.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Command {
+    const char *name;
+    const char *summary;
+    int (*run)(const std::vector<std::string> &);
+};
+
+const Command COMMANDS[] = {
+    {"convert", "convert SI prefixes of selected CSV columns", runConvert},
+    {"bom",     "decode SMD resistor/capacitor codes of a BOM", runBom},
+    {"traces",  "size the trace of every net in a CSV/JSON net list", runTraces},
+    {"plane",   "DC IR drop of a copper pour with source/sink pads and vias", runPlane},
+    {"pulse",   "pulse/fault current temperature and fusing time of traces and vias", runPulse},
+};
+
+void printUsage()
+{
+    std::fprintf(stderr, "usage: sc_cli <command> [options]\n\ncommands:\n");
+    for (const Command &c : COMMANDS) std::fprintf(stderr, "  %-10s %s\n", c.name, c.summary);
+    std::fprintf(stderr, "\nrun 'sc_cli <command> --help' for command options\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || !std::strcmp(argv[1], "--help") || !std::strcmp(argv[1], "-h")) {
+        printUsage();
+        return argc < 2 ? 2 : 0;
+    }
+
+    std::vector<std::string> args(argv + 2, argv + argc);
+    for (const Command &c : COMMANDS) {
+        if (!std::strcmp(argv[1], c.name)) return c.run(args);
+    }
+
+    std::fprintf(stderr, "sc_cli: unknown command '%s'\n", argv[1]);
+    printUsage();
+    return 2;
+}
@@ -1,6 +1,32 @@
 #include "via_current_cal.h"
 #include "ui_via_current_cal.h"
 
+#include "ViaCalc.h"
+#include "SelfHeating.h"
+#include "MonteCarloDialog.h"
+#include "ViaArrayDialog.h"
+#include "PulseDialog.h"
+#include "ThermalViaDialog.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QPushButton>
+
+namespace {
+// 長度下拉選單：0 = um, 1 = mm, 2 = mil
+using ViaLengthUnits = sc::units::UnitList<sc::units::um, sc::units::mm, sc::units::mil>;
+using ViaCurrentUnits = sc::units::UnitList<sc::units::A, sc::units::mA>;
+
+// 公差分析的輸入名稱與預設公差 (最差情況範圍共用)
+const char *const TOL_CURRENT = "電流 (A)";
+const char *const TOL_DIAMETER = "孔徑 (mm)";
+const char *const TOL_WALL = "孔壁厚 (mm)";
+constexpr double DEFAULT_CURRENT_TOL = 0.1;
+constexpr double DEFAULT_DIAMETER_TOL = 0.1;    // 鑽孔
+constexpr double DEFAULT_WALL_TOL = 0.2;        // 孔壁電鍍
+}
+
 Via_Current_cal::Via_Current_cal(UnitConverterHandler *h, QWidget *parent) :
     QWidget(parent),
     ui(new Ui::Via_Current_cal),
@@ -28,6 +54,59 @@ Via_Current_cal::Via_Current_cal(UnitConverterHandler *h, QWidget *parent) :
     connect(ui->Mass_lineEdit, &QLineEdit::textChanged, this, &Via_Current_cal::onCopperMassChanged);
     connect(ui->thickness_lineEdit, &QLineEdit::textChanged, this, &Via_Current_cal::onCopperThicknessChanged);
 
+    // 公差分析：給定電流下貫孔實際溫升的分布
+    QPushButton *toleranceButton = new QPushButton(tr("公差分析..."), this);
+    toleranceButton->setGeometry(10, 20, 211, 31);
+    toleranceDialog = new MonteCarloDialog(handler, tr("貫孔溫升公差分析"), this);
+    connect(toleranceButton, &QPushButton::clicked, this, &Via_Current_cal::openToleranceAnalysis);
+
+    worstCase_label = new QLabel(this);
+    worstCase_label->setGeometry(10, 515, 391, 31);
+    worstCase_label->setToolTip(tr("孔徑與孔壁厚公差下的最大電流 (依選擇的模型)"));
+    connect(toleranceDialog, &MonteCarloDialog::tolerancesChanged, this, &Via_Current_cal::onInputsChanged);
+
+    // 最大許可電流的模型 (IPC-2152 以板厚作為板厚修正，孔壁厚換算銅重)
+    model_comboBox = new QComboBox(this);
+    model_comboBox->setGeometry(10, 55, 211, 28);
+    model_comboBox->addItems({ tr("IPC-2221"), tr("IPC-2152") });
+    connect(model_comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &Via_Current_cal::onInputsChanged);
+
+    // 貫孔陣列：單孔不夠時，搜尋標準孔徑表的孔數與排列
+    QPushButton *arrayButton = new QPushButton(tr("貫孔陣列..."), this);
+    arrayButton->setGeometry(10, 555, 211, 31);
+    arrayButton->setToolTip(tr("總電流分給多顆貫孔：搜尋孔徑、電鍍、孔數與中心距的最小面積排列"));
+    arrayDialog = new ViaArrayDialog(handler, this);
+    connect(arrayButton, &QPushButton::clicked, this, &Via_Current_cal::openViaArray);
+
+    // 自洽溫升：電阻 / 壓降 / 功耗改用 I²R 與溫升的固定點
+    selfHeating_checkBox = new QCheckBox(tr("自洽溫升"), this);
+    selfHeating_checkBox->setGeometry(10, 595, 120, 24);
+    selfHeating_checkBox->setToolTip(tr("以目前的電流求 ΔT = θ I² R(25°C + ΔT) 的固定點 (含熱失控判斷)，"
+                                        "θ 取載流模型在 10°C 溫升的工作點，與脈衝頁的穩態相同；"
+                                        "電阻、壓降與功耗改用實際溫度"));
+    selfHeating_label = new QLabel(this);
+    selfHeating_label->setGeometry(10, 620, 395, 18);
+    connect(selfHeating_checkBox, &QCheckBox::toggled, this, [this](bool on) {
+        if (!on) {
+            selfHeating_label->clear();
+            selfHeating_label->setStyleSheet("");
+        }
+        onInputsChanged();
+    });
+
+    // 散熱孔熱阻：θ(焊墊 -> 底層) 與各孔的熱流
+    QPushButton *thermalButton = new QPushButton(tr("散熱孔熱阻..."), this);
+    thermalButton->setGeometry(230, 555, 211, 31);
+    thermalButton->setToolTip(tr("裸露焊墊下方的散熱孔陣列：孔壁、塞孔與各層銅的熱阻網路"));
+    thermalDialog = new ThermalViaDialog(handler, this);
+    connect(thermalButton, &QPushButton::clicked, this, &Via_Current_cal::openThermalVia);
+
+    // 脈衝 / 熔斷：IPC 只給穩態，湧浪與故障電流另外積分
+    QPushButton *pulseButton = new QPushButton(tr("脈衝 / 熔斷..."), this);
+    pulseButton->setGeometry(230, 592, 175, 31);
+    pulseButton->setToolTip(tr("湧浪、短路電流波形下孔壁的溫度曲線與熔斷時間"));
+    pulseDialog = new PulseDialog(handler, this);
+    connect(pulseButton, &QPushButton::clicked, this, &Via_Current_cal::openPulse);
 }
 
 Via_Current_cal::~Via_Current_cal()
@@ -40,13 +119,13 @@ void Via_Current_cal::initUI()
 {
     // 1. 電流單位：手動加入 A 和 mA
     ui->Current_comboBox->clear();
-    ui->Current_comboBox->addItems({"A", "mA"});
+    ui->Current_comboBox->addItems(unitSymbols<ViaCurrentUnits>());
     ui->Current_comboBox->setCurrentIndex(0); // 預設 A
 
     // 2. 長度單位：從 handler 獲取 (假設你的 handler->units 包含 mm, mil, um)
     // 為了精確，建議直接手動設定，確保 index 與 handler 內部邏輯一致
-    QStringList lengthUnits = {"um", "mm", "mil"};
-    // 注意：這裡的清單順序必須跟你的 UnitConverterHandler 內部的陣列順序一模一樣
+    // 清單直接由 ViaLengthUnits 產生，順序與換算表一定一致
+    QStringList lengthUnits = unitSymbols<ViaLengthUnits>();
 
     auto setupLenBox = [&](QComboBox* cb, int defaultIdx) {
         cb->clear();
@@ -84,7 +163,7 @@ void Via_Current_cal::onCopperMassChanged()
     isUpdating = true;
 
     bool ok;
-    double oz = ui->Mass_lineEdit->text().toDouble(&ok);
+    double oz = handler->parseValue(ui->Mass_lineEdit->text(), &ok);
     if (ok) {
         // 1oz = 35um
         double um = oz * 35.0;
@@ -104,7 +183,7 @@ void Via_Current_cal::onCopperThicknessChanged()
     isUpdating = true;
 
     bool ok;
-    double um = ui->thickness_lineEdit->text().toDouble(&ok);
+    double um = handler->parseValue(ui->thickness_lineEdit->text(), &ok);
     if (ok) {
         double oz = um / 35.0;
         ui->Mass_lineEdit->setText(QString::number(oz, 'g', 3));
@@ -120,27 +199,23 @@ void Via_Current_cal::onInputsChanged()
     // 1. 取得輸入並統一轉為標準單位 (mm)
 
     // --- 1. 取得並處理電流 (處理 A / mA 轉換) ---
-    double rawI = ui->Current_lineEdit->text().toDouble(&ok);
+    double rawI = handler->parseValue(ui->Current_lineEdit->text(), &ok);
     if (!ok) rawI = 0;
-    double i_input = (ui->Current_comboBox->currentIndex() == 1) ? (rawI / 1000.0) : rawI; // 轉為 Amps
+    double i_input = ViaCurrentUnits::from(rawI, ui->Current_comboBox->currentIndex()).in<sc::units::A>(); // 轉為 Amps
 
 
     // --- 2. 取得溫升 ---
-    double deltaT = ui->temp_lineEdit->text().toDouble(&ok);
+    double deltaT = handler->parseValue(ui->temp_lineEdit->text(), &ok);
     if (!ok || deltaT <= 0) deltaT = 10.0; // 預設溫升 10 度
 
     //double i_input = ui->Current_lineEdit->text().toDouble(&ok);
     //double deltaT = ui->temp_lineEdit->text().toDouble();
 
     // --- 3. 長度換算輔助 Lambda (統一轉成 mm) ---
-    // 索引對應：0=um, 1=mm, 2=mil
+    // 索引對應：0=um, 1=mm, 2=mil，由 ViaLengthUnits 查表換算
     auto getValInMM = [&](QLineEdit* edit, QComboBox* combo) -> double {
-        double val = edit->text().toDouble();
-        int idx = combo->currentIndex();
-        if (idx == 0) return val / 1000.0;    // um -> mm
-        if (idx == 1) return val;             // mm -> mm
-        if (idx == 2) return val * 0.0254;    // mil -> mm
-        return val;
+        double val = handler->parseValue(edit->text());
+        return ViaLengthUnits::from(val, combo->currentIndex()).in<sc::units::mm>();
     };
 
     double boardL_mm = getValInMM(ui->BoardThickness, ui->BoardThickness_comboBox);
@@ -160,49 +235,141 @@ void Via_Current_cal::onInputsChanged()
     }
 
 
-    // 2. 計算截面積 (Area) - 圓柱管攤平長方形
-    // Area = PI * (D + t) * t
-    double area_mm2 = M_PI * (viaD_mm + wallT_mm) * wallT_mm;
-
-    // 轉換為 sq mil (IPC 公式標準單位)
-    double area_sqMil = area_mm2 * 1550.0031;
-
-    // 3. IPC-2221 公式計算最大許可電流 (I_max)
-    // I = k * (deltaT^0.44) * (Area^0.725)
-    // k 取 0.048 (對應外層/貫孔)
-    double i_max = 0.048 * qPow(deltaT, 0.44) * qPow(area_sqMil, 0.725);
-
-    // 4. 計算電阻 (Resistance)
-    // 銅電阻率 @ 20C = 1.72e-8 Ohm-m = 1.72e-5 Ohm-mm
-    double rho_20 = 1.724e-5;
-    // 考慮溫度補償 (預設環境 25C + 溫升)
-    double temp_final = 25.0 + deltaT;
-    double rho_hot = rho_20 * (1.0 + 0.00393 * (temp_final - 20.0));
-
-    double resistance = rho_hot * (boardL_mm / area_mm2); // Ohm
-
-    // 5. 計算壓降與功耗 (基於使用者輸入的電流)
-    double v_drop = i_input * resistance;
-    double p_loss = i_input * i_input * resistance;
+    // 2~5. 截面積、IPC-2221 最大電流、溫度修正電阻、壓降與功耗
+    sc::ViaResult r = sc::viaSolve(i_input, deltaT, boardL_mm, viaD_mm, wallT_mm);
+    double resistance = r.resistance_ohm;
+    double v_drop = r.voltageDrop_V;
+    double p_loss = r.power_W;
+    const bool ipc2152 = model_comboBox && model_comboBox->currentIndex() == 1;
+
+    // 自洽溫升：電阻改用這個電流實際的 I²R 溫升，而不是允許溫升
+    bool runaway = false;
+    if (selfHeating_checkBox && selfHeating_checkBox->isChecked()) {
+        const sc::SelfHeatingLane lane = sc::viaSelfHeatingLane(
+            i_input, viaD_mm, wallT_mm, boardL_mm, ipc2152 ? sc::TraceModel::IPC2152 : sc::TraceModel::IPC2221,
+            sc::VIA_AMBIENT_C);
+        const sc::SelfHeatingResult heat = sc::selfHeatingSolve(lane);
+        runaway = heat.status == sc::SelfHeatingStatus::Runaway;
+        if (runaway) {
+            selfHeating_label->setText(tr("熱失控：找不到 電阻 <-> 溫升 的固定點"));
+            selfHeating_label->setStyleSheet("color: red; font-weight: bold;");
+        } else {
+            resistance = heat.resistance_ohm;
+            v_drop = heat.voltageDrop_V;
+            p_loss = heat.power_W;
+            selfHeating_label->setText(tr("實際溫升 %1 °C").arg(heat.deltaT, 0, 'f', 1));
+            selfHeating_label->setStyleSheet(heat.deltaT > deltaT ? "color: red;" : "");
+        }
+    }
+    if (ipc2152) {
+        r.maxCurrent_A = sc::viaMaxCurrentIpc2152(viaD_mm, wallT_mm, deltaT, boardL_mm);
+        r.overCurrent = i_input > r.maxCurrent_A;
+    }
 
     // 6. 顯示結果
     // 電阻顯示為 mOhm
-    ui->ViaImpedance_lineEdit->setText(QString::number(resistance * 1000.0, 'f', 2));
+    ui->ViaImpedance_lineEdit->setText(QString::number(sc::units::quantity<sc::units::Ohm>(resistance).in<sc::units::mOhm>(), 'f', 2));
 
     // 壓降與功耗
     ui->ViaVoltageDrop_lineEdit->setText(QString::number(v_drop, 'f', 4));
     ui->ViaConsumption_lineEdit->setText(QString::number(p_loss, 'f', 4));
+    if (runaway) {
+        ui->ViaImpedance_lineEdit->clear();
+        ui->ViaVoltageDrop_lineEdit->clear();
+        ui->ViaConsumption_lineEdit->clear();
+    }
 
     // 如果輸入電流超過 I_max，改變文字顏色提醒 (選做)
-    if (i_input > i_max) {
+    if (r.overCurrent) {
         ui->ViaConsumption_lineEdit->setStyleSheet("color: red; font-weight: bold;");
     } else {
         ui->ViaConsumption_lineEdit->setStyleSheet("");
     }
+
+    // 7. 最差情況：公差下的最大電流範圍
+    if (!worstCase_label) return;
+    const sc::Interval diameter = sc::tolerance(viaD_mm, toleranceDialog->toleranceFor(TOL_DIAMETER, DEFAULT_DIAMETER_TOL));
+    const sc::Interval wall = sc::tolerance(wallT_mm, toleranceDialog->toleranceFor(TOL_WALL, DEFAULT_WALL_TOL));
+    const sc::Interval iMax = ipc2152 ? sc::viaMaxCurrentIpc2152Interval(diameter, wall, sc::point(deltaT), boardL_mm)
+                                      : sc::viaMaxCurrentInterval(diameter, wall, sc::point(deltaT));
+    worstCase_label->setText(tr("I_max 最差情況：%1 ~ %2 A (標稱 %3 A)")
+                                 .arg(iMax.lower(), 0, 'g', 4).arg(iMax.upper(), 0, 'g', 4)
+                                 .arg(r.maxCurrent_A, 0, 'g', 4));
+    worstCase_label->setStyleSheet(i_input > iMax.lower() ? "color: red;" : "");
 }
 
 void Via_Current_cal::clearResults() {
+    if (worstCase_label) worstCase_label->clear();
     ui->ViaImpedance_lineEdit->clear();
     ui->ViaVoltageDrop_lineEdit->clear();
     ui->ViaConsumption_lineEdit->clear();
 }
+
+void Via_Current_cal::openToleranceAnalysis()
+{
+    bool okI, okD, okW;
+    const double current = ViaCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text(), &okI),
+                                                 ui->Current_comboBox->currentIndex()).in<sc::units::A>();
+    const double viaD_mm = ViaLengthUnits::from(handler->parseValue(ui->ViaDiameter->text(), &okD),
+                                                ui->ViaDiameter_comboBox->currentIndex()).in<sc::units::mm>();
+    const double wallT_mm = ViaLengthUnits::from(handler->parseValue(ui->HoleWallThickness->text(), &okW),
+                                                 ui->HoleWallThickness_comboBox->currentIndex()).in<sc::units::mm>();
+
+    if (okI && okD && okW && current > 0 && viaD_mm > 0 && wallT_mm > 0) {
+        const double nominal = sc::viaTempRise(current, sc::viaArea(viaD_mm, wallT_mm) * sc::MM2_TO_SQMIL);
+        toleranceDialog->setModel({ { TOL_CURRENT, current, DEFAULT_CURRENT_TOL, sc::Distribution::Uniform },
+                                    { TOL_DIAMETER, viaD_mm, DEFAULT_DIAMETER_TOL, sc::Distribution::Normal },
+                                    { TOL_WALL, wallT_mm, DEFAULT_WALL_TOL, sc::Distribution::Normal } },
+                                  tr("溫升 (°C)"), sc::viaTempRiseModel(), nominal);
+    }
+    toleranceDialog->show();
+    toleranceDialog->raise();
+}
+
+void Via_Current_cal::openViaArray()
+{
+    bool okI, okT, okB, okW;
+    const double current = ViaCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text(), &okI),
+                                                 ui->Current_comboBox->currentIndex()).in<sc::units::A>();
+    const double deltaT = handler->parseValue(ui->temp_lineEdit->text(), &okT);
+    const double boardL_mm = ViaLengthUnits::from(handler->parseValue(ui->BoardThickness->text(), &okB),
+                                                  ui->BoardThickness_comboBox->currentIndex()).in<sc::units::mm>();
+    const double wallT_mm = ViaLengthUnits::from(handler->parseValue(ui->HoleWallThickness->text(), &okW),
+                                                 ui->HoleWallThickness_comboBox->currentIndex()).in<sc::units::mm>();
+    arrayDialog->setVia(okI ? current : 0, okT ? deltaT : 0, okB ? boardL_mm : 0, okW ? wallT_mm : 0,
+                        model_comboBox->currentIndex());
+    arrayDialog->show();
+    arrayDialog->raise();
+}
+
+void Via_Current_cal::openThermalVia()
+{
+    bool okD, okB, okW, okC;
+    const double viaD_mm = ViaLengthUnits::from(handler->parseValue(ui->ViaDiameter->text(), &okD),
+                                                ui->ViaDiameter_comboBox->currentIndex()).in<sc::units::mm>();
+    const double boardL_mm = ViaLengthUnits::from(handler->parseValue(ui->BoardThickness->text(), &okB),
+                                                  ui->BoardThickness_comboBox->currentIndex()).in<sc::units::mm>();
+    const double wallT_mm = ViaLengthUnits::from(handler->parseValue(ui->HoleWallThickness->text(), &okW),
+                                                 ui->HoleWallThickness_comboBox->currentIndex()).in<sc::units::mm>();
+    const double copper_um = handler->parseValue(ui->thickness_lineEdit->text(), &okC);
+    thermalDialog->setVia(okD ? viaD_mm : 0, okW ? wallT_mm : 0, okB ? boardL_mm : 0, okC ? copper_um / 1000 : 0);
+    thermalDialog->show();
+    thermalDialog->raise();
+}
+
+void Via_Current_cal::openPulse()
+{
+    bool okI, okD, okB, okW;
+    const double current = ViaCurrentUnits::from(handler->parseValue(ui->Current_lineEdit->text(), &okI),
+                                                 ui->Current_comboBox->currentIndex()).in<sc::units::A>();
+    const double viaD_mm = ViaLengthUnits::from(handler->parseValue(ui->ViaDiameter->text(), &okD),
+                                                ui->ViaDiameter_comboBox->currentIndex()).in<sc::units::mm>();
+    const double boardL_mm = ViaLengthUnits::from(handler->parseValue(ui->BoardThickness->text(), &okB),
+                                                  ui->BoardThickness_comboBox->currentIndex()).in<sc::units::mm>();
+    const double wallT_mm = ViaLengthUnits::from(handler->parseValue(ui->HoleWallThickness->text(), &okW),
+                                                 ui->HoleWallThickness_comboBox->currentIndex()).in<sc::units::mm>();
+    pulseDialog->setVia(okD ? viaD_mm : 0, okW ? wallT_mm : 0, okB ? boardL_mm : 0, model_comboBox->currentIndex(),
+                        okI ? current : 0, sc::VIA_AMBIENT_C);
+    pulseDialog->show();
+    pulseDialog->raise();
+}
@@ -4,6 +4,14 @@
 #include "UnitConverterHandler.h"
 #include <QWidget>
 
+class MonteCarloDialog;
+class ViaArrayDialog;
+class ThermalViaDialog;
+class PulseDialog;
+class QCheckBox;
+class QComboBox;
+class QLabel;
+
 namespace Ui {
 class Via_Current_cal;
 }
@@ -24,16 +32,7 @@ public:
 
     UnitConverterHandler *handler;
 
-    // --- 內部數學工具函數 ---
-
-    // 計算貫孔截面積 (sq mils) - IPC 公式通常使用英制 mil 為單位
-    double calculateViaArea(double diameter_mm, double wallThick_mm);
-
-    // 計算最大許可電流 (Amps) - 依據 IPC-2221
-    double calculateMaxCurrent(double area_sqMil, double tempRise_C);
-
-    // 計算貫孔電阻 (Ohms)
-    double calculateResistance(double area_mm2, double boardThick_mm, double temp_C);
+    // 數學公式位於 sc_core (ViaCalc.h)
 
     void clearResults();
 
@@ -43,6 +42,28 @@ public:
     // 阻斷訊號用的旗標，防止連動更新時產生無窮迴圈
     bool isUpdating = false;
 
+    // 公差分析 (Monte Carlo)：電流、鑽孔孔徑、孔壁鍍銅厚度的公差對溫升的影響
+    MonteCarloDialog *toleranceDialog = nullptr;
+
+    // 最差情況載流範圍 (區間運算)，公差與公差分析視窗共用
+    QLabel *worstCase_label = nullptr;
+
+    // 最大許可電流的模型：IPC-2221 或 IPC-2152
+    QComboBox *model_comboBox = nullptr;
+
+    // 貫孔陣列：總電流分給多顆貫孔時的孔數、孔徑與中心距 (含群組減額)
+    ViaArrayDialog *arrayDialog = nullptr;
+
+    // 散熱孔陣列：焊墊下方 N x M 顆貫孔穿過疊構的熱阻
+    ThermalViaDialog *thermalDialog = nullptr;
+
+    // 自洽溫升 (電熱耦合)：勾選時電阻、壓降、功耗用實際溫升計算
+    QCheckBox *selfHeating_checkBox = nullptr;
+    QLabel *selfHeating_label = nullptr;
+
+    // 脈衝 / 熔斷：湧浪、短路電流下貫孔孔壁的暫態溫度與熔斷時間
+    PulseDialog *pulseDialog = nullptr;
+
 
 
 
@@ -54,6 +75,11 @@ private slots:
     void onCopperMassChanged();
     void onCopperThicknessChanged();
 
+    void openToleranceAnalysis();
+    void openViaArray();
+    void openThermalVia();
+    void openPulse();
+
 
 
 